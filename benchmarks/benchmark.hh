@@ -0,0 +1,281 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+// Shared parts of the google-benchmark based benchmarks: the generated test problems, the iteration over the backend
+// type lists of container.hh and the handling of the problem sizes given on the command line.
+
+#ifndef DUNE_XT_LA_BENCHMARKS_BENCHMARK_HH
+#define DUNE_XT_LA_BENCHMARKS_BENCHMARK_HH
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <boost/tuple/tuple.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <dune/xt/common/exceptions.hh>
+#include <dune/xt/common/matrix.hh>
+#include <dune/xt/common/type_traits.hh>
+
+#include <dune/xt/la/container/pattern.hh>
+
+namespace Dune {
+namespace XT {
+namespace LA {
+namespace Benchmarks {
+
+
+//! The problem sizes of a benchmark run, see parse_options().
+struct Options
+{
+  //! sizes of the vectors for the BLAS-1 operations
+  std::vector<size_t> vector_sizes = {1000, 100000, 10000000};
+  //! number of grid points per direction of the generated 2d problems, which have grid_size^2 unknowns
+  std::vector<size_t> grid_sizes = {32, 128, 512};
+  //! dense matrices (and their solvers) are only benchmarked up to this number of unknowns
+  size_t max_dense_unknowns = 4096;
+  //! numbers of threads for the concurrent assembly
+  std::vector<size_t> threads = {1, std::max(size_t(1), size_t(std::thread::hardware_concurrency()))};
+}; // struct Options
+
+
+namespace internal {
+
+
+inline std::vector<size_t> parse_size_list(const std::string& option, const char* value)
+{
+  std::vector<size_t> ret;
+  std::stringstream stream(value);
+  std::string token;
+  while (std::getline(stream, token, ',')) {
+    char* end = nullptr;
+    const auto size = std::strtoul(token.c_str(), &end, 10);
+    if (token.empty() || *end != '\0')
+      DUNE_THROW(Common::Exceptions::wrong_input_given,
+                 "Expected a comma separated list of sizes for " << option << ", got '" << value << "'!");
+    ret.push_back(size);
+  }
+  return ret;
+} // ... parse_size_list(...)
+
+
+} // namespace internal
+
+
+/**
+ * \brief Removes the options of this suite (--vector_sizes=1000,100000, --grid_sizes=32,128,
+ *        --max_dense_unknowns=4096 and --threads=1,4) from the command line, all other arguments are left for
+ *        google-benchmark.
+ */
+inline Options parse_options(int& argc, char** argv)
+{
+  Options ret;
+  int kept = 1;
+  for (int ii = 1; ii < argc; ++ii) {
+    const std::string argument(argv[ii]);
+    const auto value = argument.find('=') == std::string::npos ? nullptr : argv[ii] + argument.find('=') + 1;
+    const auto option = argument.substr(0, argument.find('='));
+    if (value && option == "--vector_sizes")
+      ret.vector_sizes = internal::parse_size_list(option, value);
+    else if (value && option == "--grid_sizes")
+      ret.grid_sizes = internal::parse_size_list(option, value);
+    else if (value && option == "--max_dense_unknowns")
+      ret.max_dense_unknowns = internal::parse_size_list(option, value).at(0);
+    else if (value && option == "--threads")
+      ret.threads = internal::parse_size_list(option, value);
+    else
+      argv[kept++] = argv[ii];
+  }
+  argc = kept;
+  return ret;
+} // ... parse_options(...)
+
+
+/**
+ * \brief Calls Registrar<T>::apply(options) for each type T of the given boost::tuple, e.g.
+ *        AvailableVectorTypes<double>.
+ */
+template <class TypeList, template <class> class Registrar>
+struct RegisterForEach
+{
+  static void apply(const Options& options)
+  {
+    Registrar<typename TypeList::head_type>::apply(options);
+    RegisterForEach<typename TypeList::tail_type, Registrar>::apply(options);
+  }
+}; // struct RegisterForEach
+
+template <template <class> class Registrar>
+struct RegisterForEach<boost::tuples::null_type, Registrar>
+{
+  static void apply(const Options& /*options*/)
+  {
+  }
+}; // struct RegisterForEach<null_type, ...>
+
+
+//! The name of a benchmark, e.g. "vector/CommonDenseVector<double>/axpy", google-benchmark appends the size.
+template <class C>
+std::string name(const std::string& group, const std::string& operation)
+{
+  return group + "/" + Common::Typename<C>::value() + "/" + operation;
+}
+
+
+//! Registers the benchmark for each of the given sizes, which the benchmark obtains as state.range(0).
+template <class FunctionType>
+benchmark::internal::Benchmark*
+register_benchmark(const std::string& name, const std::vector<size_t>& sizes, FunctionType&& function)
+{
+  auto benchmark = benchmark::RegisterBenchmark(name.c_str(), std::forward<FunctionType>(function));
+  for (const auto& size : sizes)
+    benchmark->Arg(static_cast<int64_t>(size));
+  return benchmark;
+}
+
+
+//! The grid sizes of options, without those exceeding Options::max_dense_unknowns if MatrixType is dense.
+template <class MatrixType>
+std::vector<size_t> grid_sizes(const Options& options)
+{
+  const auto layout = Common::MatrixAbstraction<MatrixType>::storage_layout;
+  if (layout != Common::StorageLayout::dense_row_major && layout != Common::StorageLayout::dense_column_major)
+    return options.grid_sizes;
+  std::vector<size_t> ret;
+  for (const auto& grid_size : options.grid_sizes)
+    if (grid_size * grid_size <= options.max_dense_unknowns)
+      ret.push_back(grid_size);
+  return ret;
+} // ... grid_sizes(...)
+
+
+/**
+ * \brief Inserts the five point stencil on a grid_size x grid_size grid (with lexicographically numbered unknowns)
+ *        into the given SparsityPatternDefault or SparsityPatternBuilder.
+ */
+template <class PatternType>
+void insert_five_point_pattern(PatternType& pattern, const size_t grid_size)
+{
+  for (size_t yy = 0; yy < grid_size; ++yy)
+    for (size_t xx = 0; xx < grid_size; ++xx) {
+      const size_t ii = yy * grid_size + xx;
+      if (yy > 0)
+        pattern.insert(ii, ii - grid_size);
+      if (xx > 0)
+        pattern.insert(ii, ii - 1);
+      pattern.insert(ii, ii);
+      if (xx + 1 < grid_size)
+        pattern.insert(ii, ii + 1);
+      if (yy + 1 < grid_size)
+        pattern.insert(ii, ii + grid_size);
+    }
+} // ... insert_five_point_pattern(...)
+
+
+//! \sa insert_five_point_pattern
+inline SparsityPatternDefault five_point_pattern(const size_t grid_size)
+{
+  SparsityPatternDefault pattern(grid_size * grid_size);
+  insert_five_point_pattern(pattern, grid_size);
+  return pattern;
+}
+
+
+/**
+ * \brief Adds the finite difference discretization of -laplace(u) + b * grad(u) on the unit square (with homogeneous
+ *        Dirichlet boundary values and b = (convection, convection / 2)) to matrix, scaled by h^2.
+ *
+ * The convection is discretized by upwinding, so the matrix is an M-matrix for all convection >= 0, which is
+ * symmetric (the Poisson problem) only for convection = 0. The matrix has to contain five_point_pattern(grid_size).
+ */
+template <class MatrixType>
+void assemble_convection_diffusion(MatrixType& matrix, const size_t grid_size, const double convection)
+{
+  const double hh = 1. / (grid_size + 1.);
+  const double bx = hh * convection;
+  const double by = hh * convection / 2.;
+  for (size_t yy = 0; yy < grid_size; ++yy)
+    for (size_t xx = 0; xx < grid_size; ++xx) {
+      const size_t ii = yy * grid_size + xx;
+      matrix.add_to_entry(ii, ii, 4. + bx + by);
+      if (yy > 0)
+        matrix.add_to_entry(ii, ii - grid_size, -1. - by);
+      if (xx > 0)
+        matrix.add_to_entry(ii, ii - 1, -1. - bx);
+      if (xx + 1 < grid_size)
+        matrix.add_to_entry(ii, ii + 1, -1.);
+      if (yy + 1 < grid_size)
+        matrix.add_to_entry(ii, ii + grid_size, -1.);
+    }
+} // ... assemble_convection_diffusion(...)
+
+
+template <class MatrixType>
+MatrixType create_convection_diffusion(const size_t grid_size, const double convection)
+{
+  const size_t size = grid_size * grid_size;
+  MatrixType matrix(size, size, five_point_pattern(grid_size));
+  assemble_convection_diffusion(matrix, grid_size, convection);
+  return matrix;
+}
+
+
+/**
+ * \brief The four vertices of the given cell of a grid_size x grid_size grid of vertices (with lexicographically
+ *        numbered cells and vertices), i.e. the rows written to by assemble_cell().
+ */
+inline std::array<size_t, 4> cell_vertices(const size_t grid_size, const size_t cell)
+{
+  const size_t lower_left = (cell / (grid_size - 1)) * grid_size + cell % (grid_size - 1);
+  return {{lower_left, lower_left + 1, lower_left + grid_size, lower_left + grid_size + 1}};
+}
+
+
+//! The nine point stencil, i.e. the pattern of the cell-wise assembly of assemble_cell().
+inline SparsityPatternDefault nine_point_pattern(const size_t grid_size)
+{
+  SparsityPatternDefault pattern(grid_size * grid_size);
+  for (size_t cell = 0; cell < (grid_size - 1) * (grid_size - 1); ++cell)
+    for (const auto& ii : cell_vertices(grid_size, cell))
+      for (const auto& jj : cell_vertices(grid_size, cell))
+        pattern.insert(ii, jj);
+  pattern.sort();
+  return pattern;
+} // ... nine_point_pattern(...)
+
+
+/**
+ * \brief Calls add(ii, jj, value) for the element matrix of the bilinear finite elements for -laplace(u) on the given
+ *        cell, as in the element-wise assembly of finite element codes, where neighboring cells share rows.
+ */
+template <class AddType>
+void assemble_cell(const size_t grid_size, const size_t cell, const AddType& add)
+{
+  const auto vertices = cell_vertices(grid_size, cell);
+  for (size_t ii = 0; ii < 4; ++ii)
+    for (size_t jj = 0; jj < 4; ++jj) {
+      // the vertices 0 and 3 as well as 1 and 2 are opposite corners
+      const double value = (ii == jj) ? 2. / 3. : ((ii + jj == 3) ? -1. / 3. : -1. / 6.);
+      add(vertices[ii], vertices[jj], value);
+    }
+} // ... assemble_cell(...)
+
+
+} // namespace Benchmarks
+} // namespace LA
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_LA_BENCHMARKS_BENCHMARK_HH
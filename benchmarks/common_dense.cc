@@ -0,0 +1,218 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+// Compares the vectorized BLAS-1/2 kernels of CommonDenseVector and CommonDenseMatrix against the portable loops
+// (which are what these operations did before), and the blocked matrix-matrix product of CommonDenseMatrix (with the
+// given numbers of threads) against a naive triple loop. The dense matrices are of size n x n for each n of the grid
+// sizes up to max_dense_unknowns.
+// Usage: bench_common_dense [--vector_sizes=...] [--grid_sizes=...] [--max_dense_unknowns=...] [--threads=...]
+//                           [google-benchmark flags]
+
+#include "config.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <dune/xt/la/container/common.hh>
+
+#include "benchmark.hh"
+
+using namespace Dune;
+using namespace Dune::XT::LA::Benchmarks;
+using XT::LA::internal::SimdInstructionSet;
+
+
+using VectorType = XT::LA::CommonDenseVector<double>;
+using MatrixType = XT::LA::CommonDenseMatrix<double>;
+
+
+static std::string name(const SimdInstructionSet instruction_set)
+{
+  switch (instruction_set) {
+    case SimdInstructionSet::avx512:
+      return "avx512";
+    case SimdInstructionSet::avx2:
+      return "avx2";
+    default:
+      return "portable";
+  }
+}
+
+
+static VectorType create_vector(const size_t size, const double offset)
+{
+  VectorType vector(size, 0.);
+  for (size_t ii = 0; ii < size; ++ii)
+    vector[ii] = std::sin(double(ii) + offset);
+  return vector;
+}
+
+
+static MatrixType create_matrix(const size_t size, const double offset)
+{
+  MatrixType matrix(size, size);
+  for (size_t ii = 0; ii < size; ++ii)
+    for (size_t jj = 0; jj < size; ++jj)
+      matrix.set_entry(ii, jj, std::sin(double(ii + 2 * jj) + offset));
+  return matrix;
+}
+
+
+static std::vector<size_t> dense_sizes(const Options& options)
+{
+  std::vector<size_t> ret;
+  for (const auto& size : options.grid_sizes)
+    if (size <= options.max_dense_unknowns)
+      ret.push_back(size);
+  return ret;
+}
+
+
+/**
+ * The operations of CommonDenseVector and CommonDenseMatrix with the kernels of the given instruction set, which is
+ * selected at the start of each benchmark and reset to the detected one at its end.
+ */
+struct KernelBenchmarks
+{
+  // the number of bytes each operation reads or writes per entry
+  template <class OperationType>
+  static void add_vector(const Options& options,
+                         const SimdInstructionSet instruction_set,
+                         const std::string& operation_name,
+                         const size_t bytes,
+                         OperationType op)
+  {
+    register_benchmark(name<VectorType>("kernels", operation_name + "/" + name(instruction_set)),
+                       options.vector_sizes,
+                       [=](benchmark::State& state) {
+                         const size_t size = state.range(0);
+                         auto xx = create_vector(size, 0.);
+                         const auto yy = create_vector(size, 1.);
+                         const auto detected = XT::LA::internal::detected_simd_instruction_set();
+                         XT::LA::internal::set_simd_instruction_set(instruction_set);
+                         for (auto _ : state)
+                           op(xx, yy);
+                         XT::LA::internal::set_simd_instruction_set(detected);
+                         state.SetBytesProcessed(state.iterations() * size * bytes);
+                       });
+  } // ... add_vector(...)
+
+  template <class OperationType>
+  static void add_matrix(const Options& options,
+                         const SimdInstructionSet instruction_set,
+                         const std::string& operation_name,
+                         OperationType op)
+  {
+    register_benchmark(name<MatrixType>("kernels", operation_name + "/" + name(instruction_set)),
+                       dense_sizes(options),
+                       [=](benchmark::State& state) {
+                         const size_t size = state.range(0);
+                         const auto matrix = create_matrix(size, 0.);
+                         const VectorType xx(size, 1.);
+                         VectorType yy(size, 0.);
+                         const auto detected = XT::LA::internal::detected_simd_instruction_set();
+                         XT::LA::internal::set_simd_instruction_set(instruction_set);
+                         for (auto _ : state)
+                           op(matrix, xx, yy);
+                         XT::LA::internal::set_simd_instruction_set(detected);
+                         state.SetItemsProcessed(state.iterations() * size * size);
+                       });
+  } // ... add_matrix(...)
+
+  static void apply(const Options& options, const SimdInstructionSet instruction_set)
+  {
+    const size_t entry = sizeof(double);
+    add_vector(options, instruction_set, "scal", 2 * entry, [](VectorType& xx, const VectorType& /*yy*/) {
+      xx.scal(1.);
+    });
+    add_vector(options, instruction_set, "axpy", 3 * entry, [](VectorType& xx, const VectorType& yy) {
+      xx.axpy(1e-16, yy);
+    });
+    add_vector(options, instruction_set, "dot", 2 * entry, [](VectorType& xx, const VectorType& yy) {
+      benchmark::DoNotOptimize(xx.dot(yy));
+    });
+    add_vector(options, instruction_set, "l1_norm", entry, [](VectorType& xx, const VectorType& /*yy*/) {
+      benchmark::DoNotOptimize(xx.l1_norm());
+    });
+    add_vector(options, instruction_set, "l2_norm", entry, [](VectorType& xx, const VectorType& /*yy*/) {
+      benchmark::DoNotOptimize(xx.l2_norm());
+    });
+    add_vector(options, instruction_set, "amax", entry, [](VectorType& xx, const VectorType& /*yy*/) {
+      benchmark::DoNotOptimize(xx.amax());
+    });
+    add_vector(options, instruction_set, "mean", entry, [](VectorType& xx, const VectorType& /*yy*/) {
+      benchmark::DoNotOptimize(xx.mean());
+    });
+    add_matrix(options, instruction_set, "mv", [](const MatrixType& matrix, const VectorType& xx, VectorType& yy) {
+      matrix.mv(xx, yy);
+    });
+    add_matrix(options, instruction_set, "mtv", [](const MatrixType& matrix, const VectorType& xx, VectorType& yy) {
+      matrix.mtv(xx, yy);
+    });
+  } // ... apply(...)
+}; // struct KernelBenchmarks
+
+
+//! C += A * B via a naive triple loop and via CommonDenseGemm, the flops are reported as items.
+struct GemmBenchmarks
+{
+  using Gemm = XT::LA::internal::CommonDenseGemm<double>;
+
+  template <class ProductType>
+  static benchmark::internal::Benchmark*
+  add(const Options& options, const std::string& product_name, ProductType product)
+  {
+    const auto benchmark_name = name<MatrixType>("gemm", product_name);
+    return register_benchmark(benchmark_name, dense_sizes(options), [=](benchmark::State& state) {
+      const size_t size = state.range(0);
+      const auto lhs = create_matrix(size, 0.);
+      const auto rhs = create_matrix(size, 1.);
+      MatrixType result(size, size, 0.);
+      // the entries of the result keep growing, which does not affect the timing
+      for (auto _ : state)
+        product(lhs, rhs, result);
+      state.SetItemsProcessed(state.iterations() * 2 * size * size * size);
+    });
+  } // ... add(...)
+
+  static void apply(const Options& options)
+  {
+    add(options, "naive", [](const MatrixType& lhs, const MatrixType& rhs, MatrixType& result) {
+      const size_t size = lhs.rows();
+      for (size_t ii = 0; ii < size; ++ii)
+        for (size_t kk = 0; kk < size; ++kk)
+          for (size_t jj = 0; jj < size; ++jj)
+            result.get_entry_ref(ii, jj) += lhs.get_entry(ii, kk) * rhs.get_entry(kk, jj);
+    });
+    for (const auto& threads : options.threads)
+      add(options,
+          "blocked/threads:" + std::to_string(threads),
+          [threads](const MatrixType& lhs, const MatrixType& rhs, MatrixType& result) {
+            const size_t size = lhs.rows();
+            Gemm::apply(
+                size, size, size, lhs.data(), size, 1, rhs.data(), size, 1, result.data(), size, 1, threads);
+          })
+          ->UseRealTime();
+  } // ... apply(...)
+}; // struct GemmBenchmarks
+
+
+int main(int argc, char** argv)
+{
+  const auto options = parse_options(argc, argv);
+  const auto detected = XT::LA::internal::detected_simd_instruction_set();
+  KernelBenchmarks::apply(options, SimdInstructionSet::portable);
+  if (detected != SimdInstructionSet::portable)
+    KernelBenchmarks::apply(options, detected);
+  GemmBenchmarks::apply(options);
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+} // ... main(...)
@@ -0,0 +1,256 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+// Benchmarks the BLAS-1 operations of all AvailableVectorTypes and the pattern construction, the assembly via
+// add_to_entry and the matrix-vector products of all AvailableDenseMatrixTypes and AvailableSparseMatrixTypes, as well
+// as the concurrent assembly into the sparse matrices (requires TBB).
+// Usage: bench_containers [--vector_sizes=...] [--grid_sizes=...] [--max_dense_unknowns=...] [--threads=...]
+//                         [google-benchmark flags]
+
+#include "config.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#if HAVE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#endif
+
+#include <dune/xt/la/container.hh>
+
+#include "benchmark.hh"
+
+using namespace Dune;
+using namespace Dune::XT::LA::Benchmarks;
+
+
+template <class VectorType>
+struct VectorBenchmarks
+{
+  static VectorType create(const size_t size, const double offset)
+  {
+    VectorType vector(size, 0.);
+    for (size_t ii = 0; ii < size; ++ii)
+      vector[ii] = std::sin(double(ii) + offset);
+    return vector;
+  }
+
+  // the number of bytes each operation reads or writes per entry
+  template <class OperationType>
+  static void add(const Options& options, const std::string& operation_name, const size_t bytes, OperationType op)
+  {
+    register_benchmark(name<VectorType>("vector", operation_name), options.vector_sizes, [=](benchmark::State& state) {
+      const size_t size = state.range(0);
+      auto xx = create(size, 0.);
+      const auto yy = create(size, 1.);
+      for (auto _ : state)
+        op(xx, yy);
+      state.SetBytesProcessed(state.iterations() * size * bytes);
+    });
+  } // ... add(...)
+
+  static void apply(const Options& options)
+  {
+    const size_t entry = sizeof(typename VectorType::ScalarType);
+    add(options, "scal", 2 * entry, [](VectorType& xx, const VectorType& /*yy*/) { xx.scal(1.); });
+    add(options, "axpy", 3 * entry, [](VectorType& xx, const VectorType& yy) { xx.axpy(1e-16, yy); });
+    add(options, "dot", 2 * entry, [](VectorType& xx, const VectorType& yy) {
+      benchmark::DoNotOptimize(xx.dot(yy));
+    });
+    add(options, "l1_norm", entry, [](VectorType& xx, const VectorType& /*yy*/) {
+      benchmark::DoNotOptimize(xx.l1_norm());
+    });
+    add(options, "l2_norm", entry, [](VectorType& xx, const VectorType& /*yy*/) {
+      benchmark::DoNotOptimize(xx.l2_norm());
+    });
+    add(options, "sup_norm", entry, [](VectorType& xx, const VectorType& /*yy*/) {
+      benchmark::DoNotOptimize(xx.sup_norm());
+    });
+  } // ... apply(...)
+}; // struct VectorBenchmarks
+
+
+template <class MatrixType>
+struct MatrixBenchmarks
+{
+  using VectorType = typename XT::LA::Container<typename MatrixType::ScalarType, MatrixType::vector_type>::VectorType;
+
+  static void apply(const Options& options)
+  {
+    const auto sizes = grid_sizes<MatrixType>(options);
+    register_benchmark(name<MatrixType>("matrix", "from_pattern"), sizes, [](benchmark::State& state) {
+      const size_t grid_size = state.range(0);
+      const auto pattern = five_point_pattern(grid_size);
+      for (auto _ : state) {
+        MatrixType matrix(grid_size * grid_size, grid_size * grid_size, pattern);
+        benchmark::DoNotOptimize(matrix);
+      }
+    });
+    register_benchmark(name<MatrixType>("matrix", "assemble"), sizes, [](benchmark::State& state) {
+      const size_t grid_size = state.range(0);
+      MatrixType matrix(grid_size * grid_size, grid_size * grid_size, five_point_pattern(grid_size));
+      // the entries keep growing, which does not affect the timing
+      for (auto _ : state)
+        assemble_convection_diffusion(matrix, grid_size, 1.);
+      state.SetItemsProcessed(state.iterations() * (5 * grid_size * grid_size - 4 * grid_size));
+    });
+    register_benchmark(name<MatrixType>("matrix", "mv"), sizes, [](benchmark::State& state) {
+      const size_t grid_size = state.range(0);
+      const auto matrix = create_convection_diffusion<MatrixType>(grid_size, 1.);
+      VectorType xx(matrix.cols(), 1.), yy(matrix.rows(), 0.);
+      for (auto _ : state)
+        matrix.mv(xx, yy);
+      state.SetItemsProcessed(state.iterations() * matrix.non_zeros());
+    });
+    register_benchmark(name<MatrixType>("matrix", "mtv"), sizes, [](benchmark::State& state) {
+      const size_t grid_size = state.range(0);
+      const auto matrix = create_convection_diffusion<MatrixType>(grid_size, 1.);
+      VectorType xx(matrix.rows(), 1.), yy(matrix.cols(), 0.);
+      for (auto _ : state)
+        matrix.mtv(xx, yy);
+      state.SetItemsProcessed(state.iterations() * matrix.non_zeros());
+    });
+  } // ... apply(...)
+}; // struct MatrixBenchmarks
+
+
+#if HAVE_TBB
+
+/**
+ * The cell-wise assembly of assemble_cell() with the given numbers of threads, where neighboring cells add to the same
+ * rows: via add_to_entry() with mutexes ("locked"), via atomic_add_to_entry() without mutexes ("atomic") and via
+ * add_to_entry() without mutexes, where the cells are processed color by color of a RowColoring ("colored").
+ */
+template <class MatrixType>
+struct ConcurrentAssemblyBenchmarks
+{
+  static void apply(const Options& options)
+  {
+    for (const auto& threads : options.threads) {
+      const std::string suffix = "/threads:" + std::to_string(threads);
+      // the rows are sharded over the mutexes, more mutexes than threads keep the contention low
+      register_benchmark(
+          name<MatrixType>("assembly", "locked" + suffix), options.grid_sizes, [threads](benchmark::State& state) {
+            const size_t grid_size = state.range(0);
+            const size_t size = grid_size * grid_size;
+            MatrixType matrix(size, size, nine_point_pattern(grid_size), 16 * threads);
+            run(state, threads, [&] {
+              parallel_for_each_cell(grid_size, [&](const size_t cell) {
+                assemble_cell(grid_size, cell, [&](const size_t ii, const size_t jj, const double value) {
+                  matrix.add_to_entry(ii, jj, value);
+                });
+              });
+            });
+          })
+          ->UseRealTime();
+      register_benchmark(
+          name<MatrixType>("assembly", "atomic" + suffix), options.grid_sizes, [threads](benchmark::State& state) {
+            const size_t grid_size = state.range(0);
+            const size_t size = grid_size * grid_size;
+            MatrixType matrix(size, size, nine_point_pattern(grid_size), 0);
+            run(state, threads, [&] {
+              parallel_for_each_cell(grid_size, [&](const size_t cell) {
+                assemble_cell(grid_size, cell, [&](const size_t ii, const size_t jj, const double value) {
+                  matrix.atomic_add_to_entry(ii, jj, value);
+                });
+              });
+            });
+          })
+          ->UseRealTime();
+      register_benchmark(
+          name<MatrixType>("assembly", "colored" + suffix), options.grid_sizes, [threads](benchmark::State& state) {
+            const size_t grid_size = state.range(0);
+            const size_t size = grid_size * grid_size;
+            MatrixType matrix(size, size, nine_point_pattern(grid_size), 0);
+            // the coloring is computed once and reused in each assembly
+            const XT::LA::RowColoring coloring(
+                size, num_cells(grid_size), [&](const size_t cell) { return cell_vertices(grid_size, cell); });
+            run(state, threads, [&] {
+              XT::LA::for_each_colored_task(coloring, [&](const size_t cell) {
+                assemble_cell(grid_size, cell, [&](const size_t ii, const size_t jj, const double value) {
+                  matrix.add_to_entry(ii, jj, value);
+                });
+              });
+            });
+          })
+          ->UseRealTime();
+    }
+  } // ... apply(...)
+
+private:
+  static size_t num_cells(const size_t grid_size)
+  {
+    return (grid_size - 1) * (grid_size - 1);
+  }
+
+  template <class FunctorType>
+  static void parallel_for_each_cell(const size_t grid_size, const FunctorType& functor)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_cells(grid_size)),
+                      [&](const tbb::blocked_range<size_t>& range) {
+                        for (size_t cell = range.begin(); cell != range.end(); ++cell)
+                          functor(cell);
+                      });
+  }
+
+  // runs the assembly within an arena of the given number of threads, the entries keep growing as for "assemble"
+  template <class AssemblyType>
+  static void run(benchmark::State& state, const size_t threads, const AssemblyType& assembly)
+  {
+    tbb::task_arena arena(static_cast<int>(threads));
+    for (auto _ : state)
+      arena.execute(assembly);
+    state.SetItemsProcessed(state.iterations() * 16 * num_cells(state.range(0)));
+  }
+}; // struct ConcurrentAssemblyBenchmarks
+
+#endif // HAVE_TBB
+
+
+// the patterns themselves do not depend on the backend
+static void register_pattern_benchmarks(const Options& options)
+{
+  register_benchmark("pattern/SparsityPatternDefault/five_point", options.grid_sizes, [](benchmark::State& state) {
+    for (auto _ : state) {
+      auto pattern = five_point_pattern(state.range(0));
+      pattern.sort();
+      benchmark::DoNotOptimize(pattern);
+    }
+  });
+  register_benchmark("pattern/SparsityPatternBuilder/five_point", options.grid_sizes, [](benchmark::State& state) {
+    const size_t grid_size = state.range(0);
+    for (auto _ : state) {
+      XT::LA::SparsityPatternBuilder builder(grid_size * grid_size);
+      insert_five_point_pattern(builder, grid_size);
+      benchmark::DoNotOptimize(builder.finalize());
+    }
+  });
+} // ... register_pattern_benchmarks(...)
+
+
+int main(int argc, char** argv)
+{
+  const auto options = parse_options(argc, argv);
+  RegisterForEach<XT::LA::AvailableVectorTypes<double>, VectorBenchmarks>::apply(options);
+  register_pattern_benchmarks(options);
+  RegisterForEach<XT::LA::AvailableDenseMatrixTypes<double>, MatrixBenchmarks>::apply(options);
+  RegisterForEach<XT::LA::AvailableSparseMatrixTypes<double>, MatrixBenchmarks>::apply(options);
+#if HAVE_TBB
+  ConcurrentAssemblyBenchmarks<XT::LA::CommonSparseMatrix<double>>::apply(options);
+#  if HAVE_DUNE_ISTL
+  ConcurrentAssemblyBenchmarks<XT::LA::IstlRowMajorSparseMatrix<double>>::apply(options);
+#  endif
+#endif
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+} // ... main(...)
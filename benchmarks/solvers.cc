@@ -0,0 +1,171 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+// Benchmarks each type of each Solver on the generated Poisson and convection-diffusion problems (setup and solve, and
+// separately, where the solver can reuse its setup, the setup alone and the solve with a prepared setup).
+// Types which fail for a problem (e.g. cg for the nonsymmetric convection-diffusion matrix) are reported as errors.
+// Usage: bench_solvers [--grid_sizes=...] [--max_dense_unknowns=...] [google-benchmark flags]
+
+#include "config.h"
+
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dune/xt/la/container.hh>
+#include <dune/xt/la/solver.hh>
+
+#include "benchmark.hh"
+
+using namespace Dune;
+using namespace Dune::XT::LA::Benchmarks;
+
+
+// there is no Solver for CommonSparseMatrix
+using SolverMatrixTypes = boost::tuple<XT::LA::CommonDenseMatrix<double>,
+                                       XT::LA::IstlRowMajorSparseMatrix<double>
+#if HAVE_EIGEN
+                                       ,
+                                       XT::LA::EigenDenseMatrix<double>,
+                                       XT::LA::EigenRowMajorSparseMatrix<double>
+#endif
+                                       >;
+
+
+// the solvers which can reuse their setup (see e.g. Solver<IstlRowMajorSparseMatrix>::prepare())
+template <class SolverType, class = void>
+struct is_preparable : public std::false_type
+{};
+
+template <class SolverType>
+struct is_preparable<SolverType,
+                     decltype(std::declval<SolverType&>().prepare(std::declval<const XT::Common::Configuration&>()))>
+  : public std::true_type
+{};
+
+
+/**
+ * \brief Registers "problem/type" (creating the solver and applying it, i.e. setup and solve), and, for the solvers
+ *        which can reuse their setup, "problem/type/setup" (prepare() only) and "problem/type/prepared_apply"
+ *        (apply() with the setup computed once before).
+ */
+template <class MatrixType>
+struct SolverBenchmarks
+{
+  using SolverType = XT::LA::Solver<MatrixType>;
+  using VectorType = typename XT::LA::Container<typename MatrixType::ScalarType, MatrixType::vector_type>::VectorType;
+
+  static void apply(const Options& options)
+  {
+    const std::vector<std::pair<std::string, double>> problems = {{"poisson", 0.}, {"convection_diffusion", 100.}};
+    for (const auto& problem : problems)
+      for (const auto& type : SolverType::types()) {
+        const std::string benchmark_name = problem.first + "/" + type;
+        const double convection = problem.second;
+        const auto solver_options = SolverType::options(type);
+        register_benchmark(name<MatrixType>("solver", benchmark_name),
+                           grid_sizes<MatrixType>(options),
+                           [=](benchmark::State& state) {
+                             run(state, convection, [&](const MatrixType& matrix, const VectorType& rhs) {
+                               VectorType solution(matrix.cols(), 0.);
+                               for (auto _ : state) {
+                                 // iterative solvers would otherwise start from the previous solution
+                                 solution.scal(0.);
+                                 const SolverType solver(matrix);
+                                 solver.apply(rhs, solution, solver_options);
+                               }
+                               return solution;
+                             });
+                           })
+            ->Unit(benchmark::kMillisecond);
+        register_prepared(options, benchmark_name, convection, solver_options, is_preparable<SolverType>());
+      }
+  } // ... apply(...)
+
+private:
+  static void register_prepared(const Options& /*options*/,
+                                const std::string& /*benchmark_name*/,
+                                const double /*convection*/,
+                                const XT::Common::Configuration& /*solver_options*/,
+                                std::false_type)
+  {}
+
+  static void register_prepared(const Options& options,
+                                const std::string& benchmark_name,
+                                const double convection,
+                                const XT::Common::Configuration& solver_options,
+                                std::true_type)
+  {
+    register_benchmark(name<MatrixType>("solver", benchmark_name + "/setup"),
+                       grid_sizes<MatrixType>(options),
+                       [=](benchmark::State& state) {
+                         run(state, convection, [&](const MatrixType& matrix, const VectorType& rhs) {
+                           SolverType solver(matrix);
+                           for (auto _ : state)
+                             solver.prepare(solver_options);
+                           VectorType solution(matrix.cols(), 0.);
+                           solver.apply(rhs, solution, solver_options);
+                           return solution;
+                         });
+                       })
+        ->Unit(benchmark::kMillisecond);
+    register_benchmark(name<MatrixType>("solver", benchmark_name + "/prepared_apply"),
+                       grid_sizes<MatrixType>(options),
+                       [=](benchmark::State& state) {
+                         run(state, convection, [&](const MatrixType& matrix, const VectorType& rhs) {
+                           SolverType solver(matrix);
+                           solver.prepare(solver_options);
+                           VectorType solution(matrix.cols(), 0.);
+                           for (auto _ : state) {
+                             solution.scal(0.);
+                             solver.apply(rhs, solution, solver_options);
+                           }
+                           return solution;
+                         });
+                       })
+        ->Unit(benchmark::kMillisecond);
+  } // ... register_prepared(...)
+
+  /**
+   * \brief Creates the problem and calls solve(matrix, rhs), which runs the benchmark loop and returns the solution.
+   *
+   * Types which fail are reported as errors, otherwise the residual of the solution is reported (which allows to spot
+   * solvers which got faster by getting less accurate).
+   */
+  template <class SolveType>
+  static void run(benchmark::State& state, const double convection, const SolveType& solve)
+  {
+    const size_t grid_size = state.range(0);
+    const auto matrix = create_convection_diffusion<MatrixType>(grid_size, convection);
+    const VectorType rhs(matrix.rows(), 1.);
+    try {
+      const VectorType solution = solve(matrix, rhs);
+      VectorType residual(matrix.rows(), 0.);
+      matrix.mv(solution, residual);
+      residual -= rhs;
+      state.counters["residual"] = residual.sup_norm();
+    } catch (const Dune::Exception& ee) {
+      std::stringstream message;
+      message << ee.what();
+      state.SkipWithError(message.str().c_str());
+    }
+  } // ... run(...)
+}; // struct SolverBenchmarks
+
+
+int main(int argc, char** argv)
+{
+  const auto options = parse_options(argc, argv);
+  RegisterForEach<SolverMatrixTypes, SolverBenchmarks>::apply(options);
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+} // ... main(...)
@@ -15,9 +15,12 @@
 #include <boost/tuple/tuple.hpp>
 
 #include "container/interfaces.hh"
+#include "container/assembly.hh"
+#include "container/block-matrix.hh"
 #include "container/common.hh"
 #include "container/eigen.hh"
 #include "container/istl.hh"
+#include "container/linear-operator.hh"
 
 namespace Dune {
 namespace XT {
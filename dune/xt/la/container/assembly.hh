@@ -0,0 +1,129 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_LA_CONTAINER_ASSEMBLY_HH
+#define DUNE_XT_LA_CONTAINER_ASSEMBLY_HH
+
+#include <vector>
+
+#if HAVE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+#include <dune/xt/common/exceptions.hh>
+
+namespace Dune {
+namespace XT {
+namespace LA {
+
+
+/**
+ * \brief Greedy coloring of assembly tasks (e.g. the elements of a grid), such that no two tasks of the same color
+ *        write to the same row.
+ *
+ * All tasks of one color may thus add to the same matrices and vectors concurrently without any synchronization, see
+ * for_each_colored_task(). The coloring only depends on the rows each task writes to, so it may be computed once and
+ * reused for all subsequent assemblies (e.g. in each time step). There are two ways to assemble concurrently:
+ *
+ * - construct the containers with num_mutexes = 0 and use a RowColoring, which avoids any synchronization, but
+ *   requires the tasks of each color to provide enough work and leaves caches cold in between the colors;
+ * - use atomic_add_to_entry() of the sparse matrices, which works for any distribution of the tasks to the threads.
+ *
+ * Both are usually much faster than add_to_entry() with mutexes (see bench_containers), which lock each addition.
+ */
+class RowColoring
+{
+public:
+  /**
+   * \param rows_of_task rows_of_task(tt) returns the rows task tt writes to (as a range of indices), for each
+   *                     0 <= tt < num_tasks.
+   */
+  template <class RowsOfTaskType>
+  RowColoring(const size_t num_rows, const size_t num_tasks, const RowsOfTaskType& rows_of_task)
+    : num_tasks_(num_tasks)
+  {
+    // the colors of the tasks writing to each row so far
+    std::vector<std::vector<size_t>> colors_of_row(num_rows);
+    // forbidden[color] == tt iff task tt shares a row with a task of this color
+    std::vector<size_t> forbidden;
+    for (size_t tt = 0; tt < num_tasks; ++tt) {
+      const auto& rows = rows_of_task(tt);
+      for (const auto& rr : rows) {
+        if (size_t(rr) >= num_rows)
+          DUNE_THROW(Common::Exceptions::index_out_of_range,
+                     "Task " << tt << " writes to row " << rr << ", but there are only " << num_rows << " rows!");
+        for (const auto& color : colors_of_row[rr])
+          forbidden[color] = tt;
+      }
+      size_t color = 0;
+      while (color < forbidden.size() && forbidden[color] == tt)
+        ++color;
+      if (color == forbidden.size()) {
+        forbidden.push_back(num_tasks);
+        tasks_.emplace_back();
+      }
+      tasks_[color].push_back(tt);
+      for (const auto& rr : rows)
+        colors_of_row[rr].push_back(color);
+    }
+  } // RowColoring(...)
+
+  size_t num_tasks() const
+  {
+    return num_tasks_;
+  }
+
+  size_t num_colors() const
+  {
+    return tasks_.size();
+  }
+
+  //! The tasks of the given color, in ascending order.
+  const std::vector<size_t>& tasks(const size_t color) const
+  {
+    if (color >= num_colors())
+      DUNE_THROW(Common::Exceptions::index_out_of_range,
+                 "color = " << color << " is not smaller than num_colors() = " << num_colors() << "!");
+    return tasks_[color];
+  }
+
+private:
+  size_t num_tasks_;
+  std::vector<std::vector<size_t>> tasks_;
+}; // class RowColoring
+
+
+/**
+ * \brief Calls assemble(tt) for all tasks tt of the coloring, one color after the other.
+ *
+ * The tasks of each color are processed in parallel (requires TBB, otherwise everything is serial), so assemble may
+ * add to the rows of task tt without synchronization, e.g. by add_to_entry() of containers without mutexes.
+ */
+template <class FunctorType>
+void for_each_colored_task(const RowColoring& coloring, const FunctorType& assemble)
+{
+  for (size_t color = 0; color < coloring.num_colors(); ++color) {
+    const auto& tasks = coloring.tasks(color);
+#if HAVE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, tasks.size()), [&](const tbb::blocked_range<size_t>& range) {
+      for (size_t ii = range.begin(); ii != range.end(); ++ii)
+        assemble(tasks[ii]);
+    });
+#else
+    for (const auto& tt : tasks)
+      assemble(tt);
+#endif
+  }
+} // ... for_each_colored_task(...)
+
+
+} // namespace LA
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_LA_CONTAINER_ASSEMBLY_HH
@@ -0,0 +1,429 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_LA_CONTAINER_BLOCK_MATRIX_HH
+#define DUNE_XT_LA_CONTAINER_BLOCK_MATRIX_HH
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <dune/xt/common/exceptions.hh>
+#include <dune/xt/common/matrix.hh>
+
+#include "pattern.hh"
+
+namespace Dune {
+namespace XT {
+namespace LA {
+
+
+// forwards, required for the specializations below
+template <class ScalarImp, Common::StorageLayout layout, class IndexImp>
+class CommonSparseMatrix;
+
+template <class ScalarImp>
+class IstlRowMajorSparseMatrix;
+
+template <class ScalarImp>
+class EigenRowMajorSparseMatrix;
+
+
+namespace internal {
+
+
+/**
+ * \brief Access to the stored entries of a sparse matrix, in the order of its storage.
+ *
+ * This default implementation works for arbitrary matrices entry by entry (via the pattern), the specializations
+ * below use the backend arrays directly (and set backend_access).
+ */
+template <class MatrixType>
+struct SparseEntryAccess
+{
+  using ScalarType = typename MatrixType::ScalarType;
+  static constexpr bool backend_access = false;
+
+  //! Calls functor(ii, jj, value) for all stored entries.
+  template <class FunctorType>
+  static void for_each(const MatrixType& matrix, const FunctorType& functor)
+  {
+    for_each_in_block(matrix, 0, matrix.rows(), 0, matrix.cols(), functor);
+  }
+
+  //! Calls functor(ii, jj, value) for all stored entries with first_row <= ii < past_last_row (and likewise for jj).
+  template <class FunctorType>
+  static void for_each_in_block(const MatrixType& matrix,
+                                const size_t first_row,
+                                const size_t past_last_row,
+                                const size_t first_col,
+                                const size_t past_last_col,
+                                const FunctorType& functor)
+  {
+    const auto pattern = matrix.pattern();
+    for (size_t ii = first_row; ii < past_last_row; ++ii)
+      for (const auto& jj : pattern.inner(ii))
+        if (jj >= first_col && jj < past_last_col)
+          functor(ii, jj, matrix.get_entry(ii, jj));
+  }
+
+  //! Sets the kk-th stored entry (in the order of for_each()) to values[kk].
+  static void assign(MatrixType& matrix, const std::vector<ScalarType>& values)
+  {
+    const auto pattern = matrix.pattern();
+    size_t kk = 0;
+    for (size_t ii = 0; ii < pattern.size(); ++ii)
+      for (const auto& jj : pattern.inner(ii))
+        matrix.set_entry(ii, jj, values[kk++]);
+  }
+}; // struct SparseEntryAccess
+
+
+template <class S, Common::StorageLayout layout, class I>
+struct SparseEntryAccess<CommonSparseMatrix<S, layout, I>>
+{
+  using MatrixType = CommonSparseMatrix<S, layout, I>;
+  static constexpr bool backend_access = true;
+
+  template <class FunctorType>
+  static void for_each(const MatrixType& matrix, const FunctorType& functor)
+  {
+    for_each_in_block(matrix, 0, matrix.rows(), 0, matrix.cols(), functor);
+  }
+
+  template <class FunctorType>
+  static void for_each_in_block(const MatrixType& matrix,
+                                const size_t first_row,
+                                const size_t past_last_row,
+                                const size_t first_col,
+                                const size_t past_last_col,
+                                const FunctorType& functor)
+  {
+    const auto* outer_index_ptr = matrix.outer_index_ptr();
+    const auto* inner_index_ptr = matrix.inner_index_ptr();
+    const auto* entries = matrix.entries();
+    const bool row_major = (layout == Common::StorageLayout::csr);
+    const size_t first_outer = row_major ? first_row : first_col;
+    const size_t past_last_outer = row_major ? past_last_row : past_last_col;
+    const size_t first_inner = row_major ? first_col : first_row;
+    const size_t past_last_inner = row_major ? past_last_col : past_last_row;
+    for (size_t oo = first_outer; oo < past_last_outer; ++oo)
+      for (size_t kk = outer_index_ptr[oo]; kk < static_cast<size_t>(outer_index_ptr[oo + 1]); ++kk) {
+        const size_t inner_index = inner_index_ptr[kk];
+        if (inner_index < first_inner || inner_index >= past_last_inner)
+          continue;
+        if (row_major)
+          functor(oo, inner_index, entries[kk]);
+        else
+          functor(inner_index, oo, entries[kk]);
+      }
+  } // ... for_each_in_block(...)
+
+  static void assign(MatrixType& matrix, const std::vector<S>& values)
+  {
+    std::copy(values.begin(), values.end(), matrix.entries());
+  }
+}; // struct SparseEntryAccess<CommonSparseMatrix<...>>
+
+
+template <class S>
+struct SparseEntryAccess<IstlRowMajorSparseMatrix<S>>
+{
+  using MatrixType = IstlRowMajorSparseMatrix<S>;
+  static constexpr bool backend_access = true;
+
+  template <class FunctorType>
+  static void for_each(const MatrixType& matrix, const FunctorType& functor)
+  {
+    for_each_in_block(matrix, 0, matrix.rows(), 0, matrix.cols(), functor);
+  }
+
+  template <class FunctorType>
+  static void for_each_in_block(const MatrixType& matrix,
+                                const size_t first_row,
+                                const size_t past_last_row,
+                                const size_t first_col,
+                                const size_t past_last_col,
+                                const FunctorType& functor)
+  {
+    const auto& backend = matrix.backend();
+    for (size_t ii = first_row; ii < past_last_row; ++ii) {
+      if (backend.getrowsize(ii) > 0) {
+        const auto& row = backend[ii];
+        const auto it_end = row.end();
+        for (auto it = row.begin(); it != it_end; ++it)
+          if (it.index() >= first_col && it.index() < past_last_col)
+            functor(ii, it.index(), (*it)[0][0]);
+      }
+    }
+  } // ... for_each_in_block(...)
+
+  static void assign(MatrixType& matrix, const std::vector<S>& values)
+  {
+    auto& backend = matrix.backend();
+    size_t kk = 0;
+    for (size_t ii = 0; ii < backend.N(); ++ii) {
+      if (backend.getrowsize(ii) > 0) {
+        auto& row = backend[ii];
+        const auto it_end = row.end();
+        for (auto it = row.begin(); it != it_end; ++it)
+          (*it)[0][0] = values[kk++];
+      }
+    }
+  } // ... assign(...)
+}; // struct SparseEntryAccess<IstlRowMajorSparseMatrix<...>>
+
+
+template <class S>
+struct SparseEntryAccess<EigenRowMajorSparseMatrix<S>>
+{
+  using MatrixType = EigenRowMajorSparseMatrix<S>;
+  static constexpr bool backend_access = true;
+
+  template <class FunctorType>
+  static void for_each(const MatrixType& matrix, const FunctorType& functor)
+  {
+    for_each_in_block(matrix, 0, matrix.rows(), 0, matrix.cols(), functor);
+  }
+
+  template <class FunctorType>
+  static void for_each_in_block(const MatrixType& matrix,
+                                const size_t first_row,
+                                const size_t past_last_row,
+                                const size_t first_col,
+                                const size_t past_last_col,
+                                const FunctorType& functor)
+  {
+    using BackendType = typename MatrixType::BackendType;
+    const auto& backend = matrix.backend();
+    for (size_t ii = first_row; ii < past_last_row; ++ii)
+      for (typename BackendType::InnerIterator it(backend, static_cast<typename BackendType::Index>(ii)); it; ++it) {
+        const size_t jj = static_cast<size_t>(it.col());
+        if (jj >= first_col && jj < past_last_col)
+          functor(ii, jj, it.value());
+      }
+  } // ... for_each_in_block(...)
+
+  static void assign(MatrixType& matrix, const std::vector<S>& values)
+  {
+    using BackendType = typename MatrixType::BackendType;
+    auto& backend = matrix.backend();
+    size_t kk = 0;
+    for (typename BackendType::Index ii = 0; ii < backend.outerSize(); ++ii)
+      for (typename BackendType::InnerIterator it(backend, ii); it; ++it)
+        it.valueRef() = values[kk++];
+  }
+}; // struct SparseEntryAccess<EigenRowMajorSparseMatrix<...>>
+
+
+} // namespace internal
+
+
+/**
+ * \brief Assembles a sparse matrix from sparse blocks, e.g. the saddle point matrix (A B1; B2^T C), by copying the
+ *        stored entries of each block directly from its backend (see internal::SparseEntryAccess).
+ *
+ * assemble() computes the structure of the matrix, i.e. its pattern and the position of each entry of each block.
+ * After the entries (but not the patterns) of the blocks have changed, update() copies the new values without
+ * recomputing the structure. The blocks are kept by reference, overlapping blocks are added up.
+ */
+template <class MatrixType>
+class BlockMatrixAssembler
+{
+  using AccessType = internal::SparseEntryAccess<MatrixType>;
+
+public:
+  using ScalarType = typename MatrixType::ScalarType;
+
+  BlockMatrixAssembler(const size_t num_rows, const size_t num_cols)
+    : rows_(num_rows)
+    , cols_(num_cols)
+  {}
+
+  //! Places the given block (or its transpose) such that its upper left entry is at (row_offset, col_offset).
+  void
+  add_block(const size_t row_offset, const size_t col_offset, const MatrixType& block, const bool transposed = false)
+  {
+    add_sub_block(row_offset, col_offset, block, 0, block.rows(), 0, block.cols(), transposed);
+  }
+
+  /**
+   * \brief Places the rows [first_row, past_last_row) and columns [first_col, past_last_col) of the given matrix (or
+   *        the transpose of this sub block) such that its upper left entry is at (row_offset, col_offset).
+   */
+  void add_sub_block(const size_t row_offset,
+                     const size_t col_offset,
+                     const MatrixType& matrix,
+                     const size_t first_row,
+                     const size_t past_last_row,
+                     const size_t first_col,
+                     const size_t past_last_col,
+                     const bool transposed = false)
+  {
+    if (first_row > past_last_row || past_last_row > matrix.rows() || first_col > past_last_col
+        || past_last_col > matrix.cols())
+      DUNE_THROW(Common::Exceptions::index_out_of_range,
+                 "The rows [" << first_row << ", " << past_last_row << ") and columns [" << first_col << ", "
+                              << past_last_col
+                              << ") do not form a sub block of a "
+                              << matrix.rows()
+                              << "x"
+                              << matrix.cols()
+                              << " matrix!");
+    const size_t block_rows = transposed ? past_last_col - first_col : past_last_row - first_row;
+    const size_t block_cols = transposed ? past_last_row - first_row : past_last_col - first_col;
+    if (row_offset + block_rows > rows_ || col_offset + block_cols > cols_)
+      DUNE_THROW(Common::Exceptions::shapes_do_not_match,
+                 "A " << block_rows << "x" << block_cols << " block at (" << row_offset << ", " << col_offset
+                      << ") does not fit into a " << rows_ << "x" << cols_ << " matrix!");
+    blocks_.push_back(
+        {row_offset, col_offset, &matrix, first_row, past_last_row, first_col, past_last_col, transposed});
+    matrix_ = nullptr;
+  } // ... add_sub_block(...)
+
+  //! Computes the structure and the entries of the matrix.
+  void assemble()
+  {
+    SparsityPatternBuilder builder(rows_);
+    for_each_block_entry(
+        [&](const size_t ii, const size_t jj, const ScalarType& /*value*/) { builder.insert(ii, jj); });
+    std::vector<size_t> row_offsets, column_indices;
+    builder.finalize(row_offsets, column_indices);
+    const SparsityPatternCompressed<size_t> pattern(std::move(row_offsets), std::move(column_indices));
+    matrix_ = std::make_unique<MatrixType>(rows_, cols_, pattern);
+    // the position of each entry of the pattern in the storage of the matrix, which may contain additional entries
+    // (e.g., eigen stores an entry in each empty row), these are skipped and kept at zero
+    std::vector<size_t> storage_positions(pattern.non_zeros());
+    size_t kk = 0;
+    size_t found = 0;
+    AccessType::for_each(*matrix_, [&](const size_t ii, const size_t jj, const ScalarType& /*value*/) {
+      const size_t pos = position(pattern, ii, jj);
+      if (pos < pattern.row_offsets()[ii + 1] && pattern.column_indices()[pos] == jj) {
+        storage_positions[pos] = kk;
+        ++found;
+      }
+      ++kk;
+    });
+    if (found != pattern.non_zeros())
+      DUNE_THROW(Common::Exceptions::internal_error,
+                 "The matrix stores " << found << " of the " << pattern.non_zeros() << " entries of its pattern!");
+    targets_.clear();
+    checksum_ = 0;
+    for_each_block_entry([&](const size_t ii, const size_t jj, const ScalarType& /*value*/) {
+      targets_.push_back(storage_positions[position(pattern, ii, jj)]);
+      combine(checksum_, ii, jj);
+    });
+    values_.resize(kk);
+    update();
+  } // ... assemble(...)
+
+  /**
+   * \brief Copies the entries of the blocks, their patterns must not have changed since assemble().
+   *
+   * A changed pattern is detected by the number of entries of the blocks and by a checksum of the positions of the
+   * entries, computed during the copy. In that case, the matrix is left unchanged.
+   */
+  void update()
+  {
+    if (!assembled())
+      DUNE_THROW(Common::Exceptions::you_are_using_this_wrong, "Call assemble() before calling update()!");
+    std::fill(values_.begin(), values_.end(), ScalarType(0));
+    size_t kk = 0;
+    size_t checksum = 0;
+    for_each_block_entry([&](const size_t ii, const size_t jj, const ScalarType& value) {
+      if (kk < targets_.size())
+        values_[targets_[kk]] += value;
+      combine(checksum, ii, jj);
+      ++kk;
+    });
+    if (kk != targets_.size())
+      DUNE_THROW(Common::Exceptions::you_are_using_this_wrong,
+                 "The blocks have " << kk << " entries instead of " << targets_.size()
+                                    << ", call assemble() after changing their patterns!");
+    if (checksum != checksum_)
+      DUNE_THROW(Common::Exceptions::you_are_using_this_wrong,
+                 "The positions of the entries of the blocks have changed, call assemble() after changing their "
+                 "patterns!");
+    AccessType::assign(*matrix_, values_);
+  } // ... update(...)
+
+  bool assembled() const
+  {
+    return matrix_ != nullptr;
+  }
+
+  const MatrixType& matrix() const
+  {
+    if (!assembled())
+      DUNE_THROW(Common::Exceptions::you_are_using_this_wrong, "Call assemble() before calling matrix()!");
+    return *matrix_;
+  }
+
+private:
+  struct Block
+  {
+    size_t row_offset;
+    size_t col_offset;
+    const MatrixType* matrix;
+    size_t first_row;
+    size_t past_last_row;
+    size_t first_col;
+    size_t past_last_col;
+    bool transposed;
+  };
+
+  // calls functor(ii, jj, value) for all stored entries of all blocks, with ii and jj the indices in the matrix
+  template <class FunctorType>
+  void for_each_block_entry(const FunctorType& functor) const
+  {
+    for (const auto& block : blocks_)
+      AccessType::for_each_in_block(*block.matrix,
+                                    block.first_row,
+                                    block.past_last_row,
+                                    block.first_col,
+                                    block.past_last_col,
+                                    [&](const size_t ii, const size_t jj, const ScalarType& value) {
+                                      const size_t local_ii = ii - block.first_row;
+                                      const size_t local_jj = jj - block.first_col;
+                                      if (block.transposed)
+                                        functor(block.row_offset + local_jj, block.col_offset + local_ii, value);
+                                      else
+                                        functor(block.row_offset + local_ii, block.col_offset + local_jj, value);
+                                    });
+  } // ... for_each_block_entry(...)
+
+  // order dependent checksum of the positions of the entries, see update()
+  static void combine(size_t& checksum, const size_t ii, const size_t jj)
+  {
+    checksum ^= ii + 0x9e3779b9 + (checksum << 6) + (checksum >> 2);
+    checksum ^= jj + 0x9e3779b9 + (checksum << 6) + (checksum >> 2);
+  }
+
+  static size_t position(const SparsityPatternCompressed<size_t>& pattern, const size_t ii, const size_t jj)
+  {
+    const auto& column_indices = pattern.column_indices();
+    const auto row_begin = column_indices.begin() + pattern.row_offsets()[ii];
+    const auto row_end = column_indices.begin() + pattern.row_offsets()[ii + 1];
+    return static_cast<size_t>(std::lower_bound(row_begin, row_end, jj) - column_indices.begin());
+  }
+
+  const size_t rows_;
+  const size_t cols_;
+  std::vector<Block> blocks_;
+  std::unique_ptr<MatrixType> matrix_;
+  // the position of each entry of the blocks (in the order of for_each_block_entry()) in the storage of matrix_
+  std::vector<size_t> targets_;
+  size_t checksum_ = 0;
+  std::vector<ScalarType> values_;
+}; // class BlockMatrixAssembler
+
+
+} // namespace LA
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_LA_CONTAINER_BLOCK_MATRIX_HH
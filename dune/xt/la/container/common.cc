@@ -18,8 +18,11 @@
 template class Dune::XT::LA::CommonDenseVector<double>;
 template class Dune::XT::LA::CommonDenseMatrix<double>;
 template class Dune::XT::LA::CommonSparseVector<double>;
+template class Dune::XT::LA::CommonSparseVector<double, uint32_t>;
 template class Dune::XT::LA::CommonSparseMatrix<double, Dune::XT::Common::StorageLayout::csr>;
 template class Dune::XT::LA::CommonSparseMatrix<double, Dune::XT::Common::StorageLayout::csc>;
+template class Dune::XT::LA::CommonSparseMatrix<double, Dune::XT::Common::StorageLayout::csr, uint32_t>;
+template class Dune::XT::LA::CommonSparseMatrix<double, Dune::XT::Common::StorageLayout::csc, uint32_t>;
 
 // template void Dune::XT::LA::CommonSparseMatrix<double>::mv(const Dune::XT::LA::CommonDenseVector<double>&,
 //                                                           Dune::XT::LA::CommonDenseVector<double>) const;
@@ -0,0 +1,205 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_LA_CONTAINER_COMMON_GEMM_HH
+#define DUNE_XT_LA_CONTAINER_COMMON_GEMM_HH
+
+#include <algorithm>
+#include <vector>
+
+#if HAVE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+#include <dune/common/unused.hh>
+
+#include <dune/xt/common/parallel/threadmanager.hh>
+
+#include <dune/xt/la/container/common/kernels.hh>
+
+namespace Dune {
+namespace XT {
+namespace LA {
+namespace internal {
+
+
+//! Default value of rows * cols * inner dimension from which on CommonDenseGemm runs in parallel.
+static const constexpr size_t common_dense_gemm_parallel_threshold = 128 * 128 * 128;
+
+
+/**
+ * \brief Dense matrix-matrix product C += A * B on strided memory, cache blocked and packed as in BLIS/GotoBLAS.
+ *
+ * Entry (ii, jj) of each matrix X is expected at X[ii * row_stride + jj * col_stride], which covers row and column
+ * major storage (and transposes). The columns of B and C are split into blocks of nc_max columns, the inner
+ * dimension into blocks of kc_max and the rows of A and C into blocks of (at most) mc_max rows. The current block of
+ * B is packed into panels of common_dense_gemm_nr columns (to stay in L3), each block of A into panels of
+ * common_dense_gemm_mr rows (to stay in L2), and CommonDenseKernels<ScalarType>::gemm_micro_kernel() computes one
+ * register block of C from two panels at a time.
+ *
+ * For large products, the row blocks are processed in parallel (requires TBB), see num_threads().
+ */
+template <class ScalarType>
+class CommonDenseGemm
+{
+  using Kernels = CommonDenseKernels<ScalarType>;
+  static const constexpr size_t mr = common_dense_gemm_mr;
+  static const constexpr size_t nr = common_dense_gemm_nr;
+  static const constexpr size_t mc_max = 128;
+  static const constexpr size_t kc_max = 256;
+  static const constexpr size_t nc_max = 2048;
+
+public:
+  //! The number of threads apply() uses by default, 1 for small products or without TBB.
+  static size_t num_threads(const size_t mm,
+                            const size_t nn,
+                            const size_t kk,
+                            const size_t threshold = common_dense_gemm_parallel_threshold)
+  {
+#if HAVE_TBB
+    if (mm * nn * kk < threshold)
+      return 1;
+    return std::max(size_t(1), size_t(Common::threadManager().max_threads()));
+#else
+    DUNE_UNUSED_PARAMETER(mm);
+    DUNE_UNUSED_PARAMETER(nn);
+    DUNE_UNUSED_PARAMETER(kk);
+    DUNE_UNUSED_PARAMETER(threshold);
+    return 1;
+#endif
+  } // ... num_threads(...)
+
+  /**
+   * \brief Computes C += A * B for A of size mm x kk, B of size kk x nn and C of size mm x nn.
+   */
+  static void apply(const size_t mm,
+                    const size_t nn,
+                    const size_t kk,
+                    const ScalarType* aa,
+                    const size_t row_stride_a,
+                    const size_t col_stride_a,
+                    const ScalarType* bb,
+                    const size_t row_stride_b,
+                    const size_t col_stride_b,
+                    ScalarType* cc,
+                    const size_t row_stride_c,
+                    const size_t col_stride_c,
+                    const size_t threads)
+  {
+    if (mm == 0 || nn == 0 || kk == 0)
+      return;
+    // use smaller row blocks if there would not be enough of them for all threads
+    const size_t mc = std::max(mr, std::min(mc_max, round_up((mm + threads - 1) / threads, mr)));
+    const size_t num_row_blocks = (mm + mc - 1) / mc;
+    std::vector<ScalarType> packed_b(std::min(kc_max, kk) * round_up(std::min(nc_max, nn), nr));
+    for (size_t jc = 0; jc < nn; jc += nc_max) {
+      const size_t nc = std::min(nc_max, nn - jc);
+      for (size_t pc = 0; pc < kk; pc += kc_max) {
+        const size_t kc = std::min(kc_max, kk - pc);
+        pack_b(kc, nc, bb + pc * row_stride_b + jc * col_stride_b, row_stride_b, col_stride_b, packed_b.data());
+        const auto process_row_block = [&](const size_t block, std::vector<ScalarType>& packed_a) {
+          const size_t ic = block * mc;
+          const size_t mcb = std::min(mc, mm - ic);
+          packed_a.resize(round_up(mcb, mr) * kc);
+          pack_a(mcb, kc, aa + ic * row_stride_a + pc * col_stride_a, row_stride_a, col_stride_a, packed_a.data());
+          ScalarType acc[mr * nr];
+          for (size_t jr = 0; jr < nc; jr += nr) {
+            const size_t nrb = std::min(nr, nc - jr);
+            for (size_t ir = 0; ir < mcb; ir += mr) {
+              const size_t mrb = std::min(mr, mcb - ir);
+              Kernels::gemm_micro_kernel(kc, packed_a.data() + ir * kc, packed_b.data() + jr * kc, acc);
+              ScalarType* cc_block = cc + (ic + ir) * row_stride_c + (jc + jr) * col_stride_c;
+              for (size_t ii = 0; ii < mrb; ++ii)
+                for (size_t jj = 0; jj < nrb; ++jj)
+                  cc_block[ii * row_stride_c + jj * col_stride_c] += acc[ii * nr + jj];
+            }
+          }
+        };
+#if HAVE_TBB
+        if (threads > 1 && num_row_blocks > 1) {
+          tbb::parallel_for(tbb::blocked_range<size_t>(0, num_row_blocks, 1),
+                            [&](const tbb::blocked_range<size_t>& range) {
+                              std::vector<ScalarType> packed_a;
+                              for (size_t block = range.begin(); block != range.end(); ++block)
+                                process_row_block(block, packed_a);
+                            });
+          continue;
+        }
+#endif
+        std::vector<ScalarType> packed_a;
+        for (size_t block = 0; block < num_row_blocks; ++block)
+          process_row_block(block, packed_a);
+      }
+    }
+  } // ... apply(...)
+
+private:
+  static size_t round_up(const size_t value, const size_t multiple)
+  {
+    return ((value + multiple - 1) / multiple) * multiple;
+  }
+
+  // panels of mr rows, each panel holding the kc columns one after another, zero padded
+  static void pack_a(const size_t mcb,
+                     const size_t kc,
+                     const ScalarType* aa,
+                     const size_t row_stride,
+                     const size_t col_stride,
+                     ScalarType* packed)
+  {
+    for (size_t ir = 0; ir < mcb; ir += mr) {
+      const size_t mrb = std::min(mr, mcb - ir);
+      for (size_t pp = 0; pp < kc; ++pp) {
+        for (size_t ii = 0; ii < mrb; ++ii)
+          packed[ii] = aa[(ir + ii) * row_stride + pp * col_stride];
+        for (size_t ii = mrb; ii < mr; ++ii)
+          packed[ii] = ScalarType(0);
+        packed += mr;
+      }
+    }
+  } // ... pack_a(...)
+
+  // panels of nr columns, each panel holding the kc rows one after another, zero padded
+  static void pack_b(const size_t kc,
+                     const size_t nc,
+                     const ScalarType* bb,
+                     const size_t row_stride,
+                     const size_t col_stride,
+                     ScalarType* packed)
+  {
+    for (size_t jr = 0; jr < nc; jr += nr) {
+      const size_t nrb = std::min(nr, nc - jr);
+      for (size_t pp = 0; pp < kc; ++pp) {
+        for (size_t jj = 0; jj < nrb; ++jj)
+          packed[jj] = bb[pp * row_stride + (jr + jj) * col_stride];
+        for (size_t jj = nrb; jj < nr; ++jj)
+          packed[jj] = ScalarType(0);
+        packed += nr;
+      }
+    }
+  } // ... pack_b(...)
+}; // class CommonDenseGemm
+
+template <class S>
+const constexpr size_t CommonDenseGemm<S>::mr;
+template <class S>
+const constexpr size_t CommonDenseGemm<S>::nr;
+template <class S>
+const constexpr size_t CommonDenseGemm<S>::mc_max;
+template <class S>
+const constexpr size_t CommonDenseGemm<S>::kc_max;
+template <class S>
+const constexpr size_t CommonDenseGemm<S>::nc_max;
+
+
+} // namespace internal
+} // namespace LA
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_LA_CONTAINER_COMMON_GEMM_HH
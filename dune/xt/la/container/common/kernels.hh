@@ -0,0 +1,672 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_LA_CONTAINER_COMMON_KERNELS_HH
+#define DUNE_XT_LA_CONTAINER_COMMON_KERNELS_HH
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+#include <dune/common/ftraits.hh>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DUNE_XT_LA_COMMON_KERNELS_X86 1
+#include <immintrin.h>
+#define DUNE_XT_LA_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define DUNE_XT_LA_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define DUNE_XT_LA_COMMON_KERNELS_X86 0
+#endif
+
+namespace Dune {
+namespace XT {
+namespace LA {
+namespace internal {
+
+
+/**
+ * \brief Instruction sets the kernels of the common dense containers can be dispatched to.
+ *
+ * \note The order matters, each one is expected to be a superset of the previous ones.
+ */
+enum class SimdInstructionSet
+{
+  portable,
+  avx2,
+  avx512
+};
+
+
+/// The best instruction set supported by the cpu we are running on.
+inline SimdInstructionSet detected_simd_instruction_set()
+{
+#if DUNE_XT_LA_COMMON_KERNELS_X86
+  __builtin_cpu_init();
+  if (!(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")))
+    return SimdInstructionSet::portable;
+  if (__builtin_cpu_supports("avx512f"))
+    return SimdInstructionSet::avx512;
+  return SimdInstructionSet::avx2;
+#endif
+  return SimdInstructionSet::portable;
+} // ... detected_simd_instruction_set(...)
+
+
+inline SimdInstructionSet& simd_instruction_set_storage()
+{
+  static SimdInstructionSet instruction_set = detected_simd_instruction_set();
+  return instruction_set;
+}
+
+
+/// The instruction set currently used by CommonDenseKernels, defaults to the detected one.
+inline SimdInstructionSet simd_instruction_set()
+{
+  return simd_instruction_set_storage();
+}
+
+
+/**
+ * \brief Restricts the instruction set used by CommonDenseKernels, e.g. to compare against the portable kernels.
+ *
+ * Requests beyond the detected instruction set are reduced to the detected one.
+ * \note  Not thread safe, meant to be used by tests and benchmarks before any computation is started.
+ */
+inline void set_simd_instruction_set(const SimdInstructionSet instruction_set)
+{
+  const auto detected = detected_simd_instruction_set();
+  simd_instruction_set_storage() = (instruction_set > detected) ? detected : instruction_set;
+}
+
+
+//! Number of rows of the register blocks computed by CommonDenseKernels::gemm_micro_kernel().
+static const constexpr size_t common_dense_gemm_mr = 4;
+
+//! Number of columns of the register blocks computed by CommonDenseKernels::gemm_micro_kernel().
+static const constexpr size_t common_dense_gemm_nr = 8;
+
+
+/**
+ * \brief Straightforward loops, used for all scalar types and as a fallback for the vectorized kernels.
+ */
+template <class ScalarType>
+struct PortableCommonDenseKernels
+{
+  using RealType = typename Dune::FieldTraits<ScalarType>::real_type;
+
+  /// xx *= alpha
+  static void scal(const size_t nn, const ScalarType& alpha, ScalarType* xx)
+  {
+    for (size_t ii = 0; ii < nn; ++ii)
+      xx[ii] *= alpha;
+  }
+
+  /// yy += alpha * xx
+  static void axpy(const size_t nn, const ScalarType& alpha, const ScalarType* xx, ScalarType* yy)
+  {
+    for (size_t ii = 0; ii < nn; ++ii)
+      yy[ii] += alpha * xx[ii];
+  }
+
+  /// \note Does not conjugate, just as the Dune::DenseVector::operator*.
+  static ScalarType dot(const size_t nn, const ScalarType* xx, const ScalarType* yy)
+  {
+    ScalarType result(0);
+    for (size_t ii = 0; ii < nn; ++ii)
+      result += xx[ii] * yy[ii];
+    return result;
+  }
+
+  static RealType asum(const size_t nn, const ScalarType* xx)
+  {
+    using std::abs;
+    RealType result(0);
+    for (size_t ii = 0; ii < nn; ++ii)
+      result += abs(xx[ii]);
+    return result;
+  }
+
+  static RealType nrm2(const size_t nn, const ScalarType* xx)
+  {
+    using std::abs;
+    using std::sqrt;
+    RealType result(0);
+    for (size_t ii = 0; ii < nn; ++ii) {
+      const RealType value = abs(xx[ii]);
+      result += value * value;
+    }
+    return sqrt(result);
+  } // ... nrm2(...)
+
+  static ScalarType sum(const size_t nn, const ScalarType* xx)
+  {
+    ScalarType result(0);
+    for (size_t ii = 0; ii < nn; ++ii)
+      result += xx[ii];
+    return result;
+  }
+
+  /**
+   * \brief The first index at which the maximum absolute value is attained and that value, (0, 0) for empty vectors.
+   * \note  NaN entries are skipped, as in VectorInterface::amax().
+   */
+  static std::pair<size_t, RealType> iamax(const size_t nn, const ScalarType* xx)
+  {
+    using std::abs;
+    auto result = std::make_pair(size_t(0), RealType(0));
+    for (size_t ii = 0; ii < nn; ++ii) {
+      const RealType value = abs(xx[ii]);
+      if (value > result.second) {
+        result.first = ii;
+        result.second = value;
+      }
+    }
+    return result;
+  } // ... iamax(...)
+
+  //! The maximum absolute value, 0 for empty vectors and NaN if any entry is NaN.
+  static RealType sup_norm(const size_t nn, const ScalarType* xx)
+  {
+    using std::abs;
+    RealType result(0);
+    for (size_t ii = 0; ii < nn; ++ii) {
+      const RealType value = abs(xx[ii]);
+      if (std::isnan(value))
+        return value;
+      if (value > result)
+        result = value;
+    }
+    return result;
+  } // ... sup_norm(...)
+
+  /**
+   * \brief Computes the mr x nr block acc = sum_pp aa_pp * bb_pp^T (stored row major), where aa and bb are packed
+   *        panels holding kc consecutive columns of mr entries and rows of nr entries, respectively.
+   * \sa    CommonDenseGemm
+   */
+  static void gemm_micro_kernel(const size_t kc, const ScalarType* aa, const ScalarType* bb, ScalarType* acc)
+  {
+    static const constexpr size_t mr = common_dense_gemm_mr;
+    static const constexpr size_t nr = common_dense_gemm_nr;
+    ScalarType block[mr][nr];
+    for (size_t ii = 0; ii < mr; ++ii)
+      for (size_t jj = 0; jj < nr; ++jj)
+        block[ii][jj] = ScalarType(0);
+    for (size_t pp = 0; pp < kc; ++pp, aa += mr, bb += nr)
+      for (size_t ii = 0; ii < mr; ++ii)
+        for (size_t jj = 0; jj < nr; ++jj)
+          block[ii][jj] += aa[ii] * bb[jj];
+    for (size_t ii = 0; ii < mr; ++ii)
+      for (size_t jj = 0; jj < nr; ++jj)
+        acc[ii * nr + jj] = block[ii][jj];
+  } // ... gemm_micro_kernel(...)
+}; // struct PortableCommonDenseKernels
+
+
+#if DUNE_XT_LA_COMMON_KERNELS_X86
+namespace Avx2Kernels {
+
+
+DUNE_XT_LA_TARGET_AVX2 inline double horizontal_sum(const __m256d vv)
+{
+  const __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(vv), _mm256_extractf128_pd(vv, 1));
+  return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+DUNE_XT_LA_TARGET_AVX2 inline double horizontal_max(const __m256d vv)
+{
+  const __m128d pair = _mm_max_pd(_mm256_castpd256_pd128(vv), _mm256_extractf128_pd(vv, 1));
+  return _mm_cvtsd_f64(_mm_max_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+DUNE_XT_LA_TARGET_AVX2 inline __m256d abs(const __m256d vv)
+{
+  return _mm256_andnot_pd(_mm256_set1_pd(-0.), vv);
+}
+
+DUNE_XT_LA_TARGET_AVX2 inline void scal(const size_t nn, const double alpha, double* xx)
+{
+  const __m256d aa = _mm256_set1_pd(alpha);
+  size_t ii = 0;
+  for (; ii + 4 <= nn; ii += 4)
+    _mm256_storeu_pd(xx + ii, _mm256_mul_pd(aa, _mm256_loadu_pd(xx + ii)));
+  for (; ii < nn; ++ii)
+    xx[ii] *= alpha;
+}
+
+DUNE_XT_LA_TARGET_AVX2 inline void axpy(const size_t nn, const double alpha, const double* xx, double* yy)
+{
+  const __m256d aa = _mm256_set1_pd(alpha);
+  size_t ii = 0;
+  for (; ii + 4 <= nn; ii += 4)
+    _mm256_storeu_pd(yy + ii, _mm256_fmadd_pd(aa, _mm256_loadu_pd(xx + ii), _mm256_loadu_pd(yy + ii)));
+  for (; ii < nn; ++ii)
+    yy[ii] += alpha * xx[ii];
+}
+
+DUNE_XT_LA_TARGET_AVX2 inline double dot(const size_t nn, const double* xx, const double* yy)
+{
+  // two independent accumulators to hide the latency of the fma
+  __m256d acc0 = _mm256_setzero_pd();
+  __m256d acc1 = _mm256_setzero_pd();
+  size_t ii = 0;
+  for (; ii + 8 <= nn; ii += 8) {
+    acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(xx + ii), _mm256_loadu_pd(yy + ii), acc0);
+    acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(xx + ii + 4), _mm256_loadu_pd(yy + ii + 4), acc1);
+  }
+  for (; ii + 4 <= nn; ii += 4)
+    acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(xx + ii), _mm256_loadu_pd(yy + ii), acc0);
+  double result = horizontal_sum(_mm256_add_pd(acc0, acc1));
+  for (; ii < nn; ++ii)
+    result += xx[ii] * yy[ii];
+  return result;
+} // ... dot(...)
+
+DUNE_XT_LA_TARGET_AVX2 inline double asum(const size_t nn, const double* xx)
+{
+  __m256d acc0 = _mm256_setzero_pd();
+  __m256d acc1 = _mm256_setzero_pd();
+  size_t ii = 0;
+  for (; ii + 8 <= nn; ii += 8) {
+    acc0 = _mm256_add_pd(abs(_mm256_loadu_pd(xx + ii)), acc0);
+    acc1 = _mm256_add_pd(abs(_mm256_loadu_pd(xx + ii + 4)), acc1);
+  }
+  for (; ii + 4 <= nn; ii += 4)
+    acc0 = _mm256_add_pd(abs(_mm256_loadu_pd(xx + ii)), acc0);
+  double result = horizontal_sum(_mm256_add_pd(acc0, acc1));
+  for (; ii < nn; ++ii)
+    result += std::abs(xx[ii]);
+  return result;
+} // ... asum(...)
+
+DUNE_XT_LA_TARGET_AVX2 inline double sum(const size_t nn, const double* xx)
+{
+  __m256d acc0 = _mm256_setzero_pd();
+  __m256d acc1 = _mm256_setzero_pd();
+  size_t ii = 0;
+  for (; ii + 8 <= nn; ii += 8) {
+    acc0 = _mm256_add_pd(_mm256_loadu_pd(xx + ii), acc0);
+    acc1 = _mm256_add_pd(_mm256_loadu_pd(xx + ii + 4), acc1);
+  }
+  for (; ii + 4 <= nn; ii += 4)
+    acc0 = _mm256_add_pd(_mm256_loadu_pd(xx + ii), acc0);
+  double result = horizontal_sum(_mm256_add_pd(acc0, acc1));
+  for (; ii < nn; ++ii)
+    result += xx[ii];
+  return result;
+} // ... sum(...)
+
+/// \note Returns NaN if any entry is NaN, which _mm256_max_pd alone would skip (it returns its second argument then).
+// the maximum absolute value of the entries which are not NaN (vmaxpd returns its second operand if one is NaN),
+// has_nan tells if there are any others
+DUNE_XT_LA_TARGET_AVX2 inline double amax(const size_t nn, const double* xx, bool& has_nan)
+{
+  __m256d acc = _mm256_setzero_pd();
+  __m256d nans = _mm256_setzero_pd();
+  size_t ii = 0;
+  for (; ii + 4 <= nn; ii += 4) {
+    const __m256d values = _mm256_loadu_pd(xx + ii);
+    nans = _mm256_or_pd(_mm256_cmp_pd(values, values, _CMP_UNORD_Q), nans);
+    acc = _mm256_max_pd(abs(values), acc);
+  }
+  has_nan = _mm256_movemask_pd(nans) != 0;
+  double result = horizontal_max(acc);
+  for (; ii < nn; ++ii) {
+    if (std::isnan(xx[ii]))
+      has_nan = true;
+    else if (std::abs(xx[ii]) > result)
+      result = std::abs(xx[ii]);
+  }
+  return result;
+} // ... amax(...)
+
+
+// keeps the 4 x 8 block in eight registers, see PortableCommonDenseKernels::gemm_micro_kernel()
+DUNE_XT_LA_TARGET_AVX2 inline void gemm_micro_kernel(const size_t kc, const double* aa, const double* bb, double* acc)
+{
+  static_assert(common_dense_gemm_mr == 4 && common_dense_gemm_nr == 8, "");
+  __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+  __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+  __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+  __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+  for (size_t pp = 0; pp < kc; ++pp, aa += 4, bb += 8) {
+    const __m256d b0 = _mm256_loadu_pd(bb);
+    const __m256d b1 = _mm256_loadu_pd(bb + 4);
+    __m256d ai = _mm256_broadcast_sd(aa);
+    c00 = _mm256_fmadd_pd(ai, b0, c00);
+    c01 = _mm256_fmadd_pd(ai, b1, c01);
+    ai = _mm256_broadcast_sd(aa + 1);
+    c10 = _mm256_fmadd_pd(ai, b0, c10);
+    c11 = _mm256_fmadd_pd(ai, b1, c11);
+    ai = _mm256_broadcast_sd(aa + 2);
+    c20 = _mm256_fmadd_pd(ai, b0, c20);
+    c21 = _mm256_fmadd_pd(ai, b1, c21);
+    ai = _mm256_broadcast_sd(aa + 3);
+    c30 = _mm256_fmadd_pd(ai, b0, c30);
+    c31 = _mm256_fmadd_pd(ai, b1, c31);
+  }
+  _mm256_storeu_pd(acc, c00);
+  _mm256_storeu_pd(acc + 4, c01);
+  _mm256_storeu_pd(acc + 8, c10);
+  _mm256_storeu_pd(acc + 12, c11);
+  _mm256_storeu_pd(acc + 16, c20);
+  _mm256_storeu_pd(acc + 20, c21);
+  _mm256_storeu_pd(acc + 24, c30);
+  _mm256_storeu_pd(acc + 28, c31);
+} // ... gemm_micro_kernel(...)
+
+
+} // namespace Avx2Kernels
+namespace Avx512Kernels {
+
+
+DUNE_XT_LA_TARGET_AVX512 inline __mmask8 tail_mask(const size_t rest)
+{
+  return static_cast<__mmask8>((1u << rest) - 1u);
+}
+
+// _mm512_reduce_add_pd and _mm512_max_pd trigger -Wuninitialized in some gcc versions, so we avoid them
+DUNE_XT_LA_TARGET_AVX512 inline double horizontal_sum(const __m512d vv)
+{
+  alignas(64) double lanes[8];
+  _mm512_store_pd(lanes, vv);
+  return ((lanes[0] + lanes[4]) + (lanes[1] + lanes[5])) + ((lanes[2] + lanes[6]) + (lanes[3] + lanes[7]));
+}
+
+DUNE_XT_LA_TARGET_AVX512 inline double horizontal_max(const __m512d vv)
+{
+  alignas(64) double lanes[8];
+  _mm512_store_pd(lanes, vv);
+  double result = lanes[0];
+  for (size_t ii = 1; ii < 8; ++ii)
+    result = (lanes[ii] > result) ? lanes[ii] : result;
+  return result;
+}
+
+DUNE_XT_LA_TARGET_AVX512 inline __m512d max(const __m512d aa, const __m512d bb)
+{
+  return _mm512_maskz_max_pd(static_cast<__mmask8>(0xFF), aa, bb);
+}
+
+DUNE_XT_LA_TARGET_AVX512 inline void scal(const size_t nn, const double alpha, double* xx)
+{
+  const __m512d aa = _mm512_set1_pd(alpha);
+  size_t ii = 0;
+  for (; ii + 8 <= nn; ii += 8)
+    _mm512_storeu_pd(xx + ii, _mm512_mul_pd(aa, _mm512_loadu_pd(xx + ii)));
+  if (ii < nn) {
+    const auto mask = tail_mask(nn - ii);
+    _mm512_mask_storeu_pd(xx + ii, mask, _mm512_mul_pd(aa, _mm512_maskz_loadu_pd(mask, xx + ii)));
+  }
+} // ... scal(...)
+
+DUNE_XT_LA_TARGET_AVX512 inline void axpy(const size_t nn, const double alpha, const double* xx, double* yy)
+{
+  const __m512d aa = _mm512_set1_pd(alpha);
+  size_t ii = 0;
+  for (; ii + 8 <= nn; ii += 8)
+    _mm512_storeu_pd(yy + ii, _mm512_fmadd_pd(aa, _mm512_loadu_pd(xx + ii), _mm512_loadu_pd(yy + ii)));
+  if (ii < nn) {
+    const auto mask = tail_mask(nn - ii);
+    _mm512_mask_storeu_pd(
+        yy + ii,
+        mask,
+        _mm512_fmadd_pd(aa, _mm512_maskz_loadu_pd(mask, xx + ii), _mm512_maskz_loadu_pd(mask, yy + ii)));
+  }
+} // ... axpy(...)
+
+DUNE_XT_LA_TARGET_AVX512 inline double dot(const size_t nn, const double* xx, const double* yy)
+{
+  __m512d acc0 = _mm512_setzero_pd();
+  __m512d acc1 = _mm512_setzero_pd();
+  size_t ii = 0;
+  for (; ii + 16 <= nn; ii += 16) {
+    acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(xx + ii), _mm512_loadu_pd(yy + ii), acc0);
+    acc1 = _mm512_fmadd_pd(_mm512_loadu_pd(xx + ii + 8), _mm512_loadu_pd(yy + ii + 8), acc1);
+  }
+  for (; ii + 8 <= nn; ii += 8)
+    acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(xx + ii), _mm512_loadu_pd(yy + ii), acc0);
+  if (ii < nn) {
+    const auto mask = tail_mask(nn - ii);
+    acc1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, xx + ii), _mm512_maskz_loadu_pd(mask, yy + ii), acc1);
+  }
+  return horizontal_sum(_mm512_add_pd(acc0, acc1));
+} // ... dot(...)
+
+DUNE_XT_LA_TARGET_AVX512 inline double asum(const size_t nn, const double* xx)
+{
+  __m512d acc0 = _mm512_setzero_pd();
+  __m512d acc1 = _mm512_setzero_pd();
+  size_t ii = 0;
+  for (; ii + 16 <= nn; ii += 16) {
+    acc0 = _mm512_add_pd(_mm512_abs_pd(_mm512_loadu_pd(xx + ii)), acc0);
+    acc1 = _mm512_add_pd(_mm512_abs_pd(_mm512_loadu_pd(xx + ii + 8)), acc1);
+  }
+  for (; ii + 8 <= nn; ii += 8)
+    acc0 = _mm512_add_pd(_mm512_abs_pd(_mm512_loadu_pd(xx + ii)), acc0);
+  if (ii < nn)
+    acc1 = _mm512_add_pd(_mm512_abs_pd(_mm512_maskz_loadu_pd(tail_mask(nn - ii), xx + ii)), acc1);
+  return horizontal_sum(_mm512_add_pd(acc0, acc1));
+} // ... asum(...)
+
+DUNE_XT_LA_TARGET_AVX512 inline double sum(const size_t nn, const double* xx)
+{
+  __m512d acc0 = _mm512_setzero_pd();
+  __m512d acc1 = _mm512_setzero_pd();
+  size_t ii = 0;
+  for (; ii + 16 <= nn; ii += 16) {
+    acc0 = _mm512_add_pd(_mm512_loadu_pd(xx + ii), acc0);
+    acc1 = _mm512_add_pd(_mm512_loadu_pd(xx + ii + 8), acc1);
+  }
+  for (; ii + 8 <= nn; ii += 8)
+    acc0 = _mm512_add_pd(_mm512_loadu_pd(xx + ii), acc0);
+  if (ii < nn)
+    acc1 = _mm512_add_pd(_mm512_maskz_loadu_pd(tail_mask(nn - ii), xx + ii), acc1);
+  return horizontal_sum(_mm512_add_pd(acc0, acc1));
+} // ... sum(...)
+
+/// \note Returns NaN if any entry is NaN, which vmaxpd alone would skip (it returns its second argument then).
+//! \sa Avx2Kernels::amax
+DUNE_XT_LA_TARGET_AVX512 inline double amax(const size_t nn, const double* xx, bool& has_nan)
+{
+  __m512d acc = _mm512_setzero_pd();
+  __mmask8 nans = 0;
+  size_t ii = 0;
+  for (; ii + 8 <= nn; ii += 8) {
+    const __m512d values = _mm512_loadu_pd(xx + ii);
+    nans = static_cast<__mmask8>(nans | _mm512_cmp_pd_mask(values, values, _CMP_UNORD_Q));
+    acc = max(_mm512_abs_pd(values), acc);
+  }
+  if (ii < nn) {
+    const __m512d values = _mm512_maskz_loadu_pd(tail_mask(nn - ii), xx + ii);
+    nans = static_cast<__mmask8>(nans | _mm512_cmp_pd_mask(values, values, _CMP_UNORD_Q));
+    acc = max(_mm512_abs_pd(values), acc);
+  }
+  has_nan = nans != 0;
+  return horizontal_max(acc);
+} // ... amax(...)
+
+
+} // namespace Avx512Kernels
+#endif // DUNE_XT_LA_COMMON_KERNELS_X86
+
+
+/**
+ * \brief BLAS-1 kernels on contiguous memory (and the micro kernel of CommonDenseGemm), as used by CommonDenseVector
+ *        and CommonDenseMatrix.
+ *
+ * Only double is vectorized explicitly, all other scalar types use the portable loops.
+ */
+template <class ScalarType>
+struct CommonDenseKernels : public PortableCommonDenseKernels<ScalarType>
+{};
+
+
+/**
+ * \brief Dispatches to the AVX-512 or AVX2 kernels at runtime, depending on simd_instruction_set().
+ */
+template <>
+struct CommonDenseKernels<double>
+{
+  using RealType = double;
+
+private:
+  using Portable = PortableCommonDenseKernels<double>;
+
+public:
+  static void scal(const size_t nn, const double& alpha, double* xx)
+  {
+#if DUNE_XT_LA_COMMON_KERNELS_X86
+    switch (simd_instruction_set()) {
+      case SimdInstructionSet::avx512:
+        return Avx512Kernels::scal(nn, alpha, xx);
+      case SimdInstructionSet::avx2:
+        return Avx2Kernels::scal(nn, alpha, xx);
+      default:
+        break;
+    }
+#endif
+    Portable::scal(nn, alpha, xx);
+  } // ... scal(...)
+
+  static void axpy(const size_t nn, const double& alpha, const double* xx, double* yy)
+  {
+#if DUNE_XT_LA_COMMON_KERNELS_X86
+    switch (simd_instruction_set()) {
+      case SimdInstructionSet::avx512:
+        return Avx512Kernels::axpy(nn, alpha, xx, yy);
+      case SimdInstructionSet::avx2:
+        return Avx2Kernels::axpy(nn, alpha, xx, yy);
+      default:
+        break;
+    }
+#endif
+    Portable::axpy(nn, alpha, xx, yy);
+  } // ... axpy(...)
+
+  static double dot(const size_t nn, const double* xx, const double* yy)
+  {
+#if DUNE_XT_LA_COMMON_KERNELS_X86
+    switch (simd_instruction_set()) {
+      case SimdInstructionSet::avx512:
+        return Avx512Kernels::dot(nn, xx, yy);
+      case SimdInstructionSet::avx2:
+        return Avx2Kernels::dot(nn, xx, yy);
+      default:
+        break;
+    }
+#endif
+    return Portable::dot(nn, xx, yy);
+  } // ... dot(...)
+
+  static double asum(const size_t nn, const double* xx)
+  {
+#if DUNE_XT_LA_COMMON_KERNELS_X86
+    switch (simd_instruction_set()) {
+      case SimdInstructionSet::avx512:
+        return Avx512Kernels::asum(nn, xx);
+      case SimdInstructionSet::avx2:
+        return Avx2Kernels::asum(nn, xx);
+      default:
+        break;
+    }
+#endif
+    return Portable::asum(nn, xx);
+  } // ... asum(...)
+
+  static double nrm2(const size_t nn, const double* xx)
+  {
+    return std::sqrt(dot(nn, xx, xx));
+  }
+
+  static double sum(const size_t nn, const double* xx)
+  {
+#if DUNE_XT_LA_COMMON_KERNELS_X86
+    switch (simd_instruction_set()) {
+      case SimdInstructionSet::avx512:
+        return Avx512Kernels::sum(nn, xx);
+      case SimdInstructionSet::avx2:
+        return Avx2Kernels::sum(nn, xx);
+      default:
+        break;
+    }
+#endif
+    return Portable::sum(nn, xx);
+  } // ... sum(...)
+
+  static std::pair<size_t, double> iamax(const size_t nn, const double* xx)
+  {
+#if DUNE_XT_LA_COMMON_KERNELS_X86
+    bool has_nan = false;
+    double max_value = 0.;
+    switch (simd_instruction_set()) {
+      case SimdInstructionSet::avx512:
+        max_value = Avx512Kernels::amax(nn, xx, has_nan);
+        break;
+      case SimdInstructionSet::avx2:
+        max_value = Avx2Kernels::amax(nn, xx, has_nan);
+        break;
+      default:
+        return Portable::iamax(nn, xx);
+    }
+    // the vectorized reduction only yields the value, the (first) index is found in a second sweep which stops early
+    if (max_value > 0.)
+      for (size_t ii = 0; ii < nn; ++ii)
+        if (std::abs(xx[ii]) == max_value)
+          return std::make_pair(ii, max_value);
+    return std::make_pair(size_t(0), 0.);
+#else
+    return Portable::iamax(nn, xx);
+#endif
+  } // ... iamax(...)
+
+  static double sup_norm(const size_t nn, const double* xx)
+  {
+#if DUNE_XT_LA_COMMON_KERNELS_X86
+    bool has_nan = false;
+    double max_value = 0.;
+    switch (simd_instruction_set()) {
+      case SimdInstructionSet::avx512:
+        max_value = Avx512Kernels::amax(nn, xx, has_nan);
+        break;
+      case SimdInstructionSet::avx2:
+        max_value = Avx2Kernels::amax(nn, xx, has_nan);
+        break;
+      default:
+        return Portable::sup_norm(nn, xx);
+    }
+    return has_nan ? std::numeric_limits<double>::quiet_NaN() : max_value;
+#else
+    return Portable::sup_norm(nn, xx);
+#endif
+  } // ... sup_norm(...)
+
+  //! \note Uses the AVX2 kernel also on AVX-512 cpus, the 4 x 8 block is too small to benefit from wider registers.
+  static void gemm_micro_kernel(const size_t kc, const double* aa, const double* bb, double* acc)
+  {
+#if DUNE_XT_LA_COMMON_KERNELS_X86
+    if (simd_instruction_set() != SimdInstructionSet::portable)
+      return Avx2Kernels::gemm_micro_kernel(kc, aa, bb, acc);
+#endif
+    Portable::gemm_micro_kernel(kc, aa, bb, acc);
+  }
+}; // struct CommonDenseKernels<double>
+
+
+} // namespace internal
+} // namespace LA
+} // namespace XT
+} // namespace Dune
+
+#if DUNE_XT_LA_COMMON_KERNELS_X86
+#undef DUNE_XT_LA_TARGET_AVX2
+#undef DUNE_XT_LA_TARGET_AVX512
+#endif
+
+#endif // DUNE_XT_LA_CONTAINER_COMMON_KERNELS_HH
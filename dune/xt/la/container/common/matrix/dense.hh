@@ -12,10 +12,12 @@
 #ifndef DUNE_XT_LA_CONTAINER_COMMON_MATRIX_DENSE_HH
 #define DUNE_XT_LA_CONTAINER_COMMON_MATRIX_DENSE_HH
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <mutex>
 #include <numeric>
+#include <type_traits>
 #include <vector>
 
 #include <boost/align/aligned_allocator.hpp>
@@ -27,6 +29,8 @@
 #include <dune/xt/common/float_cmp.hh>
 #include <dune/xt/common/vector.hh>
 
+#include <dune/xt/la/container/common/gemm.hh>
+#include <dune/xt/la/container/common/kernels.hh>
 #include <dune/xt/la/container/matrix-interface.hh>
 #include <dune/xt/la/container/pattern.hh>
 #include <dune/xt/la/container/vector-view.hh>
@@ -39,7 +43,7 @@ namespace LA {
 template <class ScalarImp, Common::StorageLayout storage_layout>
 class CommonDenseMatrix;
 
-template <class ScalarImp>
+template <class ScalarImp, class IndexImp>
 class CommonSparseVector;
 
 
@@ -175,6 +179,15 @@ public:
 
 private:
   using MutexesType = typename Traits::MutexesType;
+  using Kernels = internal::CommonDenseKernels<ScalarType>;
+
+  // the kernels may only be used if both vectors provide contiguous storage of our ScalarType
+  template <class V1, class V2>
+  using KernelsApplicable =
+      std::integral_constant<bool,
+                             V1::is_contiguous && V2::is_contiguous
+                                 && std::is_same<std::decay_t<typename V1::ScalarType>, ScalarType>::value
+                                 && std::is_same<std::decay_t<typename V2::ScalarType>, ScalarType>::value>;
 
 public:
   explicit CommonDenseMatrix(const size_t rr = 0,
@@ -194,6 +207,16 @@ public:
     , mutexes_(std::make_unique<MutexesType>(num_mutexes))
   {}
 
+  /// This constructors ignores the given pattern and initializes the matrix with 0.
+  template <class PatternIndexType>
+  CommonDenseMatrix(const size_t rr,
+                    const size_t cc,
+                    const SparsityPatternCompressed<PatternIndexType>& /*pattern*/,
+                    const size_t num_mutexes = 1)
+    : backend_(std::make_unique<BackendType>(rr, cc, ScalarType(0)))
+    , mutexes_(std::make_unique<MutexesType>(num_mutexes))
+  {}
+
   CommonDenseMatrix(const ThisType& other)
     : backend_(std::make_unique<BackendType>(*other.backend_))
     , mutexes_(std::make_unique<MutexesType>(other.mutexes_->size()))
@@ -303,8 +326,7 @@ public:
   void scal(const ScalarType& alpha)
   {
     const internal::VectorLockGuard DUNE_UNUSED(guard)(*mutexes_);
-    for (auto& entry : backend_->entries_)
-      entry *= alpha;
+    Kernels::scal(backend_->entries_.size(), alpha, backend_->entries_.data());
   }
 
   template <class OtherMatrixType>
@@ -322,8 +344,7 @@ public:
 private:
   void axpy_impl(const ScalarType& alpha, const ThisType& xx)
   {
-    for (size_t ii = 0; ii < backend_->entries_.size(); ++ii)
-      backend_->entries_[ii] += alpha * xx.backend_->entries_[ii];
+    Kernels::axpy(backend_->entries_.size(), alpha, xx.backend_->entries_.data(), backend_->entries_.data());
   }
 
   template <class OtherMatrixType>
@@ -362,21 +383,7 @@ public:
     using V2 = typename Common::VectorAbstraction<SecondVectorType>;
     static_assert(V1::is_vector && V2::is_vector, "");
     assert(xx.size() == cols() && yy.size() == rows());
-    if (storage_layout == Common::StorageLayout::dense_row_major && V1::is_contiguous) {
-      for (size_t rr = 0; rr < rows(); ++rr)
-        V2::set_entry(
-            yy,
-            rr,
-            std::inner_product(&get_entry_ref(rr, 0.), &get_entry_ref(rr + 1, 0.), V1::data(xx), ScalarType(0.)));
-    } else {
-      assert(xx.size() == cols() && yy.size() == rows());
-      yy *= ScalarType(0.);
-      for (size_t rr = 0; rr < rows(); ++rr) {
-        V2::set_entry(yy, rr, 0.);
-        for (size_t cc = 0; cc < cols(); ++cc)
-          V2::add_to_entry(yy, rr, get_entry(rr, cc) * V1::get_entry(xx, cc));
-      }
-    }
+    mv_impl(xx, yy, KernelsApplicable<V1, V2>());
   }
 
   template <class FirstVectorType, class SecondVectorType>
@@ -386,15 +393,11 @@ public:
     using V2 = typename Common::VectorAbstraction<SecondVectorType>;
     static_assert(V1::is_vector && V2::is_vector, "");
     assert(xx.size() == rows() && yy.size() == cols());
-    yy *= ScalarType(0.);
-    for (size_t cc = 0; cc < cols(); ++cc) {
-      V2::set_entry(yy, cc, 0.);
-      for (size_t rr = 0; rr < rows(); ++rr)
-        V2::add_to_entry(yy, cc, get_entry(cc, rr) * V1::get_entry(xx, rr));
-    }
+    mtv_impl(xx, yy, KernelsApplicable<V1, V2>());
   }
 
-  void mtv(const CommonSparseVector<ScalarType>& xx, CommonSparseVector<ScalarType>& yy) const
+  template <class IndexType>
+  void mtv(const CommonSparseVector<ScalarType, IndexType>& xx, CommonSparseVector<ScalarType, IndexType>& yy) const
   {
     yy.clear();
     const auto& vec_entries = xx.entries();
@@ -515,21 +518,37 @@ public:
   using InterfaceType::operator-;
   using InterfaceType::operator+=;
   using InterfaceType::operator-=;
+  using InterfaceType::operator*;
 
+  /// \note Uses the cache blocked (and, for large matrices, parallel) product of internal::CommonDenseGemm.
+  virtual ThisType operator*(const ThisType& other) const override final
+  {
+    if (other.rows() != cols())
+      DUNE_THROW(XT::Common::Exceptions::shapes_do_not_match, "Dimensions of matrices to be multiplied do not match!");
+    return multiply_dense(other);
+  }
+
+  /// \note Uses the cache blocked (and, for large matrices, parallel) product of internal::CommonDenseGemm.
+  template <class MM>
+  ThisType operator*(const MatrixInterface<MM, ScalarType>& other) const
+  {
+    if (other.rows() != cols())
+      DUNE_THROW(XT::Common::Exceptions::shapes_do_not_match, "Dimensions of matrices to be multiplied do not match!");
+    return multiply_dense(other.as_imp());
+  }
+
+  /// \brief Replaces this by this * other, see operator*.
   template <class OtherMatrixType>
   void rightmultiply(const OtherMatrixType& other)
   {
     using M = typename Common::MatrixAbstraction<OtherMatrixType>;
     static_assert(M::is_matrix, "");
-    BackendType new_backend(rows(), M::cols(other), ScalarType(0.));
     if (M::rows(other) != cols())
       DUNE_THROW(Dune::XT::Common::Exceptions::shapes_do_not_match,
                  "For rightmultiply, the number of columns of this has to match the number of rows of other!");
-    for (size_t rr = 0; rr < rows(); ++rr)
-      for (size_t cc = 0; cc < cols(); ++cc)
-        for (size_t kk = 0; kk < cols(); ++kk)
-          new_backend->get_entry_ref(rr, cc) += get_entry(rr, kk) * M::get_entry(other, kk, cc);
-    *backend_ = new_backend;
+    auto product = multiply_dense(other);
+    const internal::VectorLockGuard DUNE_UNUSED(guard)(*mutexes_);
+    std::swap(backend_, product.backend_);
   }
 
   virtual ThisType pruned(const typename Common::FloatCmp::DefaultEpsilon<ScalarType>::Type eps =
@@ -559,6 +578,131 @@ public:
   }
 
 private:
+  static size_t row_stride(const Common::StorageLayout layout, const size_t /*num_rows*/, const size_t num_cols)
+  {
+    return layout == Common::StorageLayout::dense_row_major ? num_cols : 1;
+  }
+
+  static size_t col_stride(const Common::StorageLayout layout, const size_t num_rows, const size_t /*num_cols*/)
+  {
+    return layout == Common::StorageLayout::dense_row_major ? 1 : num_rows;
+  }
+
+  template <Common::StorageLayout other_layout>
+  ThisType multiply_dense(const CommonDenseMatrix<ScalarType, other_layout>& other) const
+  {
+    using Gemm = internal::CommonDenseGemm<ScalarType>;
+    ThisType ret(rows(), other.cols(), ScalarType(0));
+    Gemm::apply(rows(),
+                other.cols(),
+                cols(),
+                data(),
+                row_stride(storage_layout, rows(), cols()),
+                col_stride(storage_layout, rows(), cols()),
+                other.data(),
+                row_stride(other_layout, other.rows(), other.cols()),
+                col_stride(other_layout, other.rows(), other.cols()),
+                ret.data(),
+                row_stride(storage_layout, ret.rows(), ret.cols()),
+                col_stride(storage_layout, ret.rows(), ret.cols()),
+                Gemm::num_threads(rows(), other.cols(), cols()));
+    return ret;
+  } // ... multiply_dense(...)
+
+  // copies other into a dense matrix first, which is cheap compared to the product
+  template <class OtherMatrixType>
+  ThisType multiply_dense(const OtherMatrixType& other) const
+  {
+    using M = typename Common::MatrixAbstraction<OtherMatrixType>;
+    CommonDenseMatrix<ScalarType, Common::StorageLayout::dense_row_major> other_dense(M::rows(other), M::cols(other));
+    for (size_t rr = 0; rr < M::rows(other); ++rr)
+      for (size_t cc = 0; cc < M::cols(other); ++cc)
+        other_dense.set_entry(rr, cc, M::get_entry(other, rr, cc));
+    return multiply_dense(other_dense);
+  }
+
+  // yy[rr] = <row rr, xx> for row major storage, yy += xx[cc] * column cc for column major storage
+  template <class FirstVectorType, class SecondVectorType>
+  void mv_impl(const FirstVectorType& xx, SecondVectorType& yy, std::true_type /*kernels_applicable*/) const
+  {
+    using V1 = typename Common::VectorAbstraction<FirstVectorType>;
+    using V2 = typename Common::VectorAbstraction<SecondVectorType>;
+    if (rows() == 0)
+      return;
+    ScalarType* yy_data = V2::data(yy);
+    if (cols() == 0) {
+      std::fill_n(yy_data, rows(), ScalarType(0));
+      return;
+    }
+    const ScalarType* xx_data = V1::data(xx);
+    if (storage_layout == Common::StorageLayout::dense_row_major) {
+      for (size_t rr = 0; rr < rows(); ++rr)
+        yy_data[rr] = Kernels::dot(cols(), data() + rr * cols(), xx_data);
+    } else {
+      std::fill_n(yy_data, rows(), ScalarType(0));
+      for (size_t cc = 0; cc < cols(); ++cc)
+        Kernels::axpy(rows(), xx_data[cc], data() + cc * rows(), yy_data);
+    }
+  } // ... mv_impl(...)
+
+  template <class FirstVectorType, class SecondVectorType>
+  void mv_impl(const FirstVectorType& xx, SecondVectorType& yy, std::false_type /*kernels_applicable*/) const
+  {
+    using V1 = typename Common::VectorAbstraction<FirstVectorType>;
+    using V2 = typename Common::VectorAbstraction<SecondVectorType>;
+    if (storage_layout == Common::StorageLayout::dense_row_major && V1::is_contiguous) {
+      for (size_t rr = 0; rr < rows(); ++rr)
+        V2::set_entry(
+            yy,
+            rr,
+            std::inner_product(&get_entry_ref(rr, 0.), &get_entry_ref(rr + 1, 0.), V1::data(xx), ScalarType(0.)));
+    } else {
+      yy *= ScalarType(0.);
+      for (size_t rr = 0; rr < rows(); ++rr) {
+        V2::set_entry(yy, rr, 0.);
+        for (size_t cc = 0; cc < cols(); ++cc)
+          V2::add_to_entry(yy, rr, get_entry(rr, cc) * V1::get_entry(xx, cc));
+      }
+    }
+  } // ... mv_impl(...)
+
+  // yy += xx[rr] * row rr for row major storage, yy[cc] = <column cc, xx> for column major storage
+  template <class FirstVectorType, class SecondVectorType>
+  void mtv_impl(const FirstVectorType& xx, SecondVectorType& yy, std::true_type /*kernels_applicable*/) const
+  {
+    using V1 = typename Common::VectorAbstraction<FirstVectorType>;
+    using V2 = typename Common::VectorAbstraction<SecondVectorType>;
+    if (cols() == 0)
+      return;
+    ScalarType* yy_data = V2::data(yy);
+    if (rows() == 0) {
+      std::fill_n(yy_data, cols(), ScalarType(0));
+      return;
+    }
+    const ScalarType* xx_data = V1::data(xx);
+    if (storage_layout == Common::StorageLayout::dense_row_major) {
+      std::fill_n(yy_data, cols(), ScalarType(0));
+      for (size_t rr = 0; rr < rows(); ++rr)
+        Kernels::axpy(cols(), xx_data[rr], data() + rr * cols(), yy_data);
+    } else {
+      for (size_t cc = 0; cc < cols(); ++cc)
+        yy_data[cc] = Kernels::dot(rows(), data() + cc * rows(), xx_data);
+    }
+  } // ... mtv_impl(...)
+
+  template <class FirstVectorType, class SecondVectorType>
+  void mtv_impl(const FirstVectorType& xx, SecondVectorType& yy, std::false_type /*kernels_applicable*/) const
+  {
+    using V1 = typename Common::VectorAbstraction<FirstVectorType>;
+    using V2 = typename Common::VectorAbstraction<SecondVectorType>;
+    yy *= ScalarType(0.);
+    for (size_t cc = 0; cc < cols(); ++cc) {
+      V2::set_entry(yy, cc, 0.);
+      for (size_t rr = 0; rr < rows(); ++rr)
+        V2::add_to_entry(yy, cc, get_entry(rr, cc) * V1::get_entry(xx, rr));
+    }
+  } // ... mtv_impl(...)
+
   std::unique_ptr<BackendType> backend_;
   std::unique_ptr<MutexesType> mutexes_;
 }; // class CommonDenseMatrix
@@ -14,11 +14,24 @@
 #ifndef DUNE_XT_LA_CONTAINER_COMMON_MATRIX_SPARSE_HH
 #define DUNE_XT_LA_CONTAINER_COMMON_MATRIX_SPARSE_HH
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+#if HAVE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 #include <dune/xt/common/matrix.hh>
+#include <dune/xt/common/parallel/threadmanager.hh>
 
 #include <dune/xt/la/container/interfaces.hh>
 #include <dune/xt/la/container/pattern.hh>
 
+#include "../spgemm.hh"
 #include "../vector/sparse.hh"
 #include "dense.hh"
 
@@ -28,7 +41,7 @@ namespace LA {
 
 
 // forwards
-template <class ScalarImp, Common::StorageLayout layout>
+template <class ScalarImp, Common::StorageLayout layout, class IndexImp>
 class CommonSparseMatrix;
 
 // forwards
@@ -39,17 +52,37 @@ class CommonSparseOrDenseMatrix;
 namespace internal {
 
 
-template <class ScalarImp, Common::StorageLayout layout>
+//! Default number of non-zeros from which on CommonSparseMatrix<..., csr> uses the parallel mv() and mtv().
+static const constexpr size_t common_sparse_parallel_threshold = 100000;
+
+
+//! Throws if the dimensions or the number of non-zeros of a CommonSparseMatrix do not fit into its index type.
+template <class IndexType>
+void check_common_sparse_index_range(const size_t rows, const size_t cols, const size_t non_zeros)
+{
+  const size_t max_index = std::numeric_limits<IndexType>::max();
+  if (rows > max_index || cols > max_index || non_zeros > max_index)
+    DUNE_THROW(Common::Exceptions::index_out_of_range,
+               "A matrix with " << rows << " rows, " << cols << " columns and " << non_zeros
+                                << " non-zeros can not be indexed by the chosen index type (max " << max_index
+                                << ")!");
+}
+
+
+template <class ScalarImp, Common::StorageLayout layout, class IndexImp>
 struct CommonSparseMatrixTraits
   : public MatrixTraitsBase<ScalarImp,
-                            CommonSparseMatrix<ScalarImp, layout>,
+                            CommonSparseMatrix<ScalarImp, layout, IndexImp>,
                             void,
                             Backends::common_sparse,
                             Backends::common_dense,
                             true>
 {
+  static_assert(std::is_integral<IndexImp>::value && std::is_unsigned<IndexImp>::value,
+                "The index type has to be an unsigned integer!");
   using EntriesVectorType = std::vector<ScalarImp>;
-  using IndexVectorType = std::vector<size_t>;
+  using IndexType = IndexImp;
+  using IndexVectorType = std::vector<IndexImp>;
   using EpsType = typename Common::FloatCmp::DefaultEpsilon<ScalarImp>::Type;
 };
 
@@ -74,12 +107,16 @@ struct CommonSparseOrDenseMatrixTraits
 
 /**
  * \brief A sparse matrix implementation of the MatrixInterface with row major memory layout.
+ *
+ * The row pointers and column indices are stored as IndexImp. Using uint32_t halves the memory traffic of the indices
+ * in mv(), mtv() and get_entry() for matrices with less than 2^32 rows, columns and non-zeros.
  */
-template <class ScalarImp = double, Common::StorageLayout layout = Common::StorageLayout::csr>
-class CommonSparseMatrix : public MatrixInterface<internal::CommonSparseMatrixTraits<ScalarImp, layout>, ScalarImp>
+template <class ScalarImp = double, Common::StorageLayout layout = Common::StorageLayout::csr, class IndexImp = size_t>
+class CommonSparseMatrix
+  : public MatrixInterface<internal::CommonSparseMatrixTraits<ScalarImp, layout, IndexImp>, ScalarImp>
 {
   using ThisType = CommonSparseMatrix;
-  using InterfaceType = MatrixInterface<internal::CommonSparseMatrixTraits<ScalarImp, layout>, ScalarImp>;
+  using InterfaceType = MatrixInterface<internal::CommonSparseMatrixTraits<ScalarImp, layout, IndexImp>, ScalarImp>;
 
 public:
   using typename InterfaceType::RealType;
@@ -87,6 +124,7 @@ public:
   using typename InterfaceType::Traits;
   using EntriesVectorType = typename Traits::EntriesVectorType;
   using EpsType = typename Traits::EpsType;
+  using IndexType = typename Traits::IndexType;
   using IndexVectorType = typename Traits::IndexVectorType;
 
 private:
@@ -130,6 +168,53 @@ public:
         } // kk
         entries_->resize(column_indices_->size());
       } // row
+      internal::check_common_sparse_index_range<IndexType>(num_rows_, num_cols_, column_indices_->size());
+    }
+  } // CommonSparseMatrix(rr, cc, patt, num_mutexes)
+
+  /**
+   * \brief Creates a sparse matrix with the given compressed pattern, whose arrays are adopted without copying.
+   */
+  CommonSparseMatrix(const size_t rr,
+                     const size_t cc,
+                     SparsityPatternCompressed<IndexType>&& patt,
+                     const size_t num_mutexes = 1,
+                     const EpsType eps = Common::FloatCmp::DefaultEpsilon<ScalarType>::value() / 1000.)
+    : num_rows_(rr)
+    , num_cols_(cc)
+    , entries_(std::make_shared<EntriesVectorType>())
+    , row_pointers_(std::make_shared<IndexVectorType>(num_rows_ + 1, 0))
+    , column_indices_(std::make_shared<IndexVectorType>())
+    , mutexes_(std::make_unique<MutexesType>(num_mutexes))
+    , eps_(eps)
+  {
+    if (num_rows_ > 0 && num_cols_ > 0) {
+      check_pattern(patt);
+      patt.release(*row_pointers_, *column_indices_);
+      entries_->resize(column_indices_->size());
+    }
+  } // CommonSparseMatrix(rr, cc, patt, num_mutexes)
+
+  template <class PatternIndexType>
+  CommonSparseMatrix(const size_t rr,
+                     const size_t cc,
+                     const SparsityPatternCompressed<PatternIndexType>& patt,
+                     const size_t num_mutexes = 1,
+                     const EpsType eps = Common::FloatCmp::DefaultEpsilon<ScalarType>::value() / 1000.)
+    : num_rows_(rr)
+    , num_cols_(cc)
+    , entries_(std::make_shared<EntriesVectorType>())
+    , row_pointers_(std::make_shared<IndexVectorType>(num_rows_ + 1, 0))
+    , column_indices_(std::make_shared<IndexVectorType>())
+    , mutexes_(std::make_unique<MutexesType>(num_mutexes))
+    , eps_(eps)
+  {
+    if (num_rows_ > 0 && num_cols_ > 0) {
+      check_pattern(patt);
+      internal::check_common_sparse_index_range<IndexType>(num_rows_, num_cols_, patt.non_zeros());
+      row_pointers_->assign(patt.row_offsets().begin(), patt.row_offsets().end());
+      column_indices_->assign(patt.column_indices().begin(), patt.column_indices().end());
+      entries_->resize(column_indices_->size());
     }
   } // CommonSparseMatrix(rr, cc, patt, num_mutexes)
 
@@ -147,6 +232,7 @@ public:
     , eps_(eps)
   {
     if (!is_zero(value, eps)) {
+      internal::check_common_sparse_index_range<IndexType>(num_rows_, num_cols_, num_rows_ * num_cols_);
       IndexVectorType row_column_indices(num_cols_);
       for (size_t col = 0; col < num_cols_; ++col)
         row_column_indices[col] = col;
@@ -165,6 +251,7 @@ public:
     , column_indices_(std::make_shared<IndexVectorType>(*other.column_indices_))
     , mutexes_(std::make_unique<MutexesType>(other.mutexes_->size()))
     , eps_(other.eps_)
+    , parallel_threshold_(other.parallel_threshold_)
   {}
 
   template <class OtherMatrixType>
@@ -196,6 +283,7 @@ public:
       } // cc
     } // rr
     (*row_pointers_)[num_rows_] = column_indices_->size();
+    internal::check_common_sparse_index_range<IndexType>(num_rows_, num_cols_, column_indices_->size());
   } // CommonSparseMatrix(...)
 
   template <class OtherMatrixType>
@@ -227,6 +315,7 @@ public:
       *row_pointers_ = *other.row_pointers_;
       *column_indices_ = *other.column_indices_;
       mutexes_ = std::make_unique<MutexesType>(other.mutexes_->size());
+      parallel_threshold_ = other.parallel_threshold_;
     }
     return *this;
   }
@@ -308,39 +397,100 @@ public:
     return num_cols_;
   }
 
-  //! Matrix-Vector multiplication for arbitrary vectors that support operator[]
+  /**
+   * \brief Matrix-Vector multiplication for arbitrary vectors that support operator[]
+   * \note  Runs in parallel for large matrices, see parallel_threshold().
+   */
   template <class XX, class YY>
   inline std::enable_if_t<XT::Common::VectorAbstraction<XX>::is_vector && XT::Common::VectorAbstraction<YY>::is_vector,
                           void>
   mv(const XX& xx, YY& yy) const
   {
-    std::fill(yy.begin(), yy.end(), ScalarType(0));
     const auto& entries = *entries_;
     const auto& row_pointers = *row_pointers_;
     const auto& column_indices = *column_indices_;
-    for (size_t rr = 0; rr < num_rows_; ++rr) {
-      auto& yy_rr = yy[rr];
-      const size_t end = row_pointers[rr + 1];
-      for (size_t kk = row_pointers[rr]; kk < end; ++kk)
-        yy_rr += entries[kk] * xx[column_indices[kk]];
-    }
-  }
+    const auto mv_rows = [&](const size_t first_row, const size_t past_last_row) {
+      for (size_t rr = first_row; rr < past_last_row; ++rr) {
+        ScalarType yy_rr(0);
+        const size_t end = row_pointers[rr + 1];
+        for (size_t kk = row_pointers[rr]; kk < end; ++kk)
+          yy_rr += entries[kk] * xx[column_indices[kk]];
+        yy[rr] = yy_rr;
+      }
+    };
+    const auto num_parts = num_parallel_parts();
+    if (num_parts > 1) {
+      const auto first_rows = balanced_row_partition(num_parts);
+      for_each_part(num_parts, [&](const size_t pp) { mv_rows(first_rows[pp], first_rows[pp + 1]); });
+    } else
+      mv_rows(0, num_rows_);
+  } // ... mv(...)
 
-  //! TransposedMatrix-Vector multiplication for arbitrary vectors that support operator[]
+  /**
+   * \brief TransposedMatrix-Vector multiplication for arbitrary vectors that support operator[]
+   * \note  Runs in parallel for large matrices, see parallel_threshold(). To avoid write conflicts, each thread
+   *        accumulates its rows into a vector of its own, which are summed up afterwards. These partial results are
+   *        kept in between calls to avoid allocations, calls running at the same time use temporary ones instead.
+   */
   template <class XX, class YY>
   inline std::enable_if_t<XT::Common::VectorAbstraction<XX>::is_vector && XT::Common::VectorAbstraction<YY>::is_vector,
                           void>
   mtv(const XX& xx, YY& yy) const
   {
-    std::fill(yy.begin(), yy.end(), ScalarType(0));
     const auto& entries = *entries_;
     const auto& row_pointers = *row_pointers_;
     const auto& column_indices = *column_indices_;
-    for (size_t rr = 0; rr < num_rows_; ++rr) {
-      const size_t end = row_pointers[rr + 1];
-      for (size_t kk = row_pointers[rr]; kk < end; ++kk)
-        yy[column_indices[kk]] += entries[kk] * xx[rr];
+    const auto num_parts = num_parallel_parts();
+    if (num_parts > 1) {
+      const auto first_rows = balanced_row_partition(num_parts);
+      std::unique_lock<std::mutex> scratch_lock(mtv_scratch_mutex_, std::try_to_lock);
+      std::vector<ScalarType> temporary;
+      auto& partial_results = scratch_lock.owns_lock() ? mtv_scratch_ : temporary;
+      partial_results.resize(num_parts * num_cols_);
+      for_each_part(num_parts, [&](const size_t pp) {
+        const auto partial_result = partial_results.begin() + pp * num_cols_;
+        std::fill(partial_result, partial_result + num_cols_, ScalarType(0));
+        for (size_t rr = first_rows[pp]; rr < first_rows[pp + 1]; ++rr) {
+          const size_t end = row_pointers[rr + 1];
+          for (size_t kk = row_pointers[rr]; kk < end; ++kk)
+            partial_result[column_indices[kk]] += entries[kk] * xx[rr];
+        }
+      });
+      // sum up the partial results, splitting the columns evenly
+      for_each_part(num_parts, [&](const size_t pp) {
+        const size_t past_last_col = (pp + 1) * num_cols_ / num_parts;
+        for (size_t cc = pp * num_cols_ / num_parts; cc < past_last_col; ++cc) {
+          ScalarType yy_cc(0);
+          for (size_t qq = 0; qq < num_parts; ++qq)
+            yy_cc += partial_results[qq * num_cols_ + cc];
+          yy[cc] = yy_cc;
+        }
+      });
+    } else {
+      std::fill(yy.begin(), yy.end(), ScalarType(0));
+      for (size_t rr = 0; rr < num_rows_; ++rr) {
+        const size_t end = row_pointers[rr + 1];
+        for (size_t kk = row_pointers[rr]; kk < end; ++kk)
+          yy[column_indices[kk]] += entries[kk] * xx[rr];
+      }
     }
+  } // ... mtv(...)
+
+  /**
+   * \brief Number of non-zeros from which on mv() and mtv() run in parallel.
+   *
+   * The work is split into as many parts as there are threads available in the thread manager of dune-xt-common,
+   * balanced by the number of non-zeros (not rows) per part. Requires TBB, otherwise everything is serial.
+   */
+  size_t parallel_threshold() const
+  {
+    return parallel_threshold_;
+  }
+
+  //! Set to std::numeric_limits<size_t>::max() to always use the serial mv() and mtv().
+  void set_parallel_threshold(const size_t num_nonzeros)
+  {
+    parallel_threshold_ = num_nonzeros;
   }
 
   inline void add_to_entry(const size_t rr, const size_t cc, const ScalarType& value)
@@ -349,6 +499,17 @@ public:
     entries_->operator[](get_entry_index(rr, cc)) += value;
   }
 
+  /**
+   * \brief Variant of add_to_entry() which adds atomically instead of locking.
+   *
+   * Allows to assemble from several threads into a matrix with a fixed pattern without any lock traffic (construct
+   * the matrix with num_mutexes = 0 in that case). Must not be used at the same time as add_to_entry() or set_entry().
+   */
+  inline void atomic_add_to_entry(const size_t rr, const size_t cc, const ScalarType& value)
+  {
+    internal::atomic_add(entries_->operator[](get_entry_index(rr, cc)), value);
+  }
+
   inline ScalarType get_entry(const size_t rr, const size_t cc) const
   {
     const size_t index = get_entry_index(rr, cc, false);
@@ -464,8 +625,42 @@ public:
     column_indices_ = new_column_indices;
   } // void rightmultiply(...)
 
+  /**
+   * \brief Replaces this by this * other, using the sparse matrix-matrix product (see internal::CommonSparseSpgemm).
+   * \note  As in the generic rightmultiply(), entries of the product which are numerically zero are removed.
+   */
+  void rightmultiply(const ThisType& other)
+  {
+    if (other.rows() != num_cols_)
+      DUNE_THROW(XT::Common::Exceptions::shapes_do_not_match, "Dimensions of matrices to be multiplied do not match!");
+    auto new_entries = std::make_shared<EntriesVectorType>();
+    auto new_row_pointers = std::make_shared<IndexVectorType>();
+    auto new_column_indices = std::make_shared<IndexVectorType>();
+    spgemm(other, *new_row_pointers, *new_column_indices, *new_entries);
+    internal::CommonSparseSpgemm<ScalarType, IndexType>::remove_zeros(
+        num_rows_, *new_row_pointers, *new_column_indices, *new_entries, eps_ / num_cols_);
+    num_cols_ = other.cols();
+    entries_ = new_entries;
+    row_pointers_ = new_row_pointers;
+    column_indices_ = new_column_indices;
+  } // void rightmultiply(...)
+
+  /**
+   * \brief Sparse matrix-matrix product (see internal::CommonSparseSpgemm), runs in parallel for large products.
+   * \note  The pattern of the result is the pattern of the product, no entries are removed.
+   */
+  virtual ThisType operator*(const ThisType& other) const override final
+  {
+    if (other.rows() != num_cols_)
+      DUNE_THROW(XT::Common::Exceptions::shapes_do_not_match, "Dimensions of matrices to be multiplied do not match!");
+    ThisType ret(num_rows_, other.cols(), ScalarType(0), 1, eps_);
+    spgemm(other, *ret.row_pointers_, *ret.column_indices_, *ret.entries_);
+    return ret;
+  }
+
   using InterfaceType::operator+;
   using InterfaceType::operator-;
+  using InterfaceType::operator*;
   using InterfaceType::operator+=;
   using InterfaceType::operator-=;
 
@@ -479,22 +674,22 @@ public:
     return entries_->data();
   }
 
-  size_t* outer_index_ptr()
+  IndexType* outer_index_ptr()
   {
     return row_pointers_->data();
   }
 
-  const size_t* outer_index_ptr() const
+  const IndexType* outer_index_ptr() const
   {
     return row_pointers_->data();
   }
 
-  size_t* inner_index_ptr()
+  IndexType* inner_index_ptr()
   {
     return column_indices_->data();
   }
 
-  const size_t* inner_index_ptr() const
+  const IndexType* inner_index_ptr() const
   {
     return column_indices_->data();
   }
@@ -519,6 +714,20 @@ private:
     return size_t(-1);
   }
 
+  template <class PatternIndexType>
+  void check_pattern(const SparsityPatternCompressed<PatternIndexType>& patt) const
+  {
+    if (patt.size() != num_rows_)
+      DUNE_THROW(XT::Common::Exceptions::shapes_do_not_match,
+                 "The size of the pattern (" << patt.size() << ") does not match the number of rows of this ("
+                                             << num_rows_ << ")!");
+    for (const auto& col : patt.column_indices())
+      if (size_t(col) >= num_cols_)
+        DUNE_THROW(XT::Common::Exceptions::shapes_do_not_match,
+                   "The pattern contains column " << col << ", which does not match the number of columns of this ("
+                                                  << num_cols_ << ")!");
+  } // ... check_pattern(...)
+
   bool is_zero(const ScalarType val, const ScalarType eps) const
   {
     const auto factor = (num_cols_ == 0 ? 1. : ScalarType(num_cols_));
@@ -526,24 +735,91 @@ private:
     return XT::Common::FloatCmp::eq(val, ScalarType(0.), 0., tol);
   }
 
+  //! Computes the compressed row arrays of this * other.
+  void spgemm(const ThisType& other,
+              IndexVectorType& row_pointers,
+              IndexVectorType& column_indices,
+              EntriesVectorType& entries) const
+  {
+    using Spgemm = internal::CommonSparseSpgemm<ScalarType, IndexType>;
+    const size_t threads = Spgemm::num_threads(Spgemm::multiply_adds(
+        num_rows_, row_pointers_->data(), column_indices_->data(), other.row_pointers_->data()));
+    Spgemm::apply(num_rows_,
+                  other.num_cols_,
+                  row_pointers_->data(),
+                  column_indices_->data(),
+                  entries_->data(),
+                  other.row_pointers_->data(),
+                  other.column_indices_->data(),
+                  other.entries_->data(),
+                  row_pointers,
+                  column_indices,
+                  entries,
+                  threads);
+  } // ... spgemm(...)
+
+  size_t num_parallel_parts() const
+  {
+#if HAVE_TBB
+    if (entries_->size() < parallel_threshold_)
+      return 1;
+    return std::max(size_t(1), std::min(size_t(Common::threadManager().max_threads()), num_rows_));
+#else
+    return 1;
+#endif
+  }
+
+  //! Returns the first row of each part (and num_rows_ as last entry), such that all parts have about as many nonzeros.
+  std::vector<size_t> balanced_row_partition(const size_t num_parts) const
+  {
+    const auto& row_pointers = *row_pointers_;
+    const size_t num_nonzeros = row_pointers[num_rows_];
+    std::vector<size_t> first_rows(num_parts + 1, num_rows_);
+    first_rows[0] = 0;
+    for (size_t pp = 1; pp < num_parts; ++pp)
+      first_rows[pp] = std::distance(
+          row_pointers.begin(),
+          std::lower_bound(row_pointers.begin(), row_pointers.begin() + num_rows_, pp * num_nonzeros / num_parts));
+    return first_rows;
+  }
+
+  template <class FunctorType>
+  static void for_each_part(const size_t num_parts, const FunctorType& functor)
+  {
+#if HAVE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_parts, 1), [&](const tbb::blocked_range<size_t>& range) {
+      for (size_t pp = range.begin(); pp != range.end(); ++pp)
+        functor(pp);
+    });
+#else
+    for (size_t pp = 0; pp < num_parts; ++pp)
+      functor(pp);
+#endif
+  }
+
   size_t num_rows_, num_cols_;
   std::shared_ptr<EntriesVectorType> entries_;
   std::shared_ptr<IndexVectorType> row_pointers_;
   std::shared_ptr<IndexVectorType> column_indices_;
   std::unique_ptr<MutexesType> mutexes_;
   EpsType eps_;
+  size_t parallel_threshold_ = internal::common_sparse_parallel_threshold;
+  // the partial results of the parallel mtv(), one block of num_cols_ entries per part
+  mutable std::mutex mtv_scratch_mutex_;
+  mutable std::vector<ScalarType> mtv_scratch_;
 }; // class CommonSparseMatrix
 
 /**
  * \brief A sparse matrix implementation of the MatrixInterface with column major memory layout.
  */
-template <class ScalarImp>
-class CommonSparseMatrix<ScalarImp, Common::StorageLayout::csc>
-  : public MatrixInterface<internal::CommonSparseMatrixTraits<ScalarImp, Common::StorageLayout::csc>, ScalarImp>
+template <class ScalarImp, class IndexImp>
+class CommonSparseMatrix<ScalarImp, Common::StorageLayout::csc, IndexImp>
+  : public MatrixInterface<internal::CommonSparseMatrixTraits<ScalarImp, Common::StorageLayout::csc, IndexImp>,
+                           ScalarImp>
 {
   using ThisType = CommonSparseMatrix;
   using InterfaceType =
-      MatrixInterface<internal::CommonSparseMatrixTraits<ScalarImp, Common::StorageLayout::csc>, ScalarImp>;
+      MatrixInterface<internal::CommonSparseMatrixTraits<ScalarImp, Common::StorageLayout::csc, IndexImp>, ScalarImp>;
 
 public:
   using typename InterfaceType::RealType;
@@ -551,6 +827,7 @@ public:
   using typename InterfaceType::Traits;
   using EntriesVectorType = typename Traits::EntriesVectorType;
   using EpsType = typename Traits::EpsType;
+  using IndexType = typename Traits::IndexType;
   using IndexVectorType = typename Traits::IndexVectorType;
 
 private:
@@ -587,6 +864,50 @@ public:
         (*column_pointers_)[col + 1] = row_indices_->size();
       } // col
       entries_->resize(row_indices_->size());
+      internal::check_common_sparse_index_range<IndexType>(num_rows_, num_cols_, row_indices_->size());
+    }
+  } // CommonSparseMatrix(rr, cc, patt, num_mutexes)
+
+  /**
+   * \brief Creates a sparse matrix with the given compressed (row) pattern.
+   */
+  template <class PatternIndexType>
+  CommonSparseMatrix(const size_t rr,
+                     const size_t cc,
+                     const SparsityPatternCompressed<PatternIndexType>& patt,
+                     const size_t num_mutexes = 1,
+                     const EpsType eps = Common::FloatCmp::DefaultEpsilon<ScalarType>::value() / 1000.)
+    : num_rows_(rr)
+    , num_cols_(cc)
+    , entries_(std::make_shared<EntriesVectorType>())
+    , column_pointers_(std::make_shared<IndexVectorType>(num_cols_ + 1, 0))
+    , row_indices_(std::make_shared<IndexVectorType>())
+    , mutexes_(std::make_unique<MutexesType>(num_mutexes))
+    , eps_(eps)
+  {
+    if (num_rows_ > 0 && num_cols_ > 0) {
+      if (patt.size() != num_rows_)
+        DUNE_THROW(XT::Common::Exceptions::shapes_do_not_match,
+                   "The size of the pattern (" << patt.size() << ") does not match the number of rows of this ("
+                                               << num_rows_ << ")!");
+      internal::check_common_sparse_index_range<IndexType>(num_rows_, num_cols_, patt.non_zeros());
+      auto& column_pointers = *column_pointers_;
+      // count the entries per column, then sort the rows into the columns (which keeps each column sorted)
+      for (const auto& col : patt.column_indices()) {
+        if (size_t(col) >= num_cols_)
+          DUNE_THROW(XT::Common::Exceptions::shapes_do_not_match,
+                     "The pattern contains column " << col << ", which does not match the number of columns of this ("
+                                                    << num_cols_ << ")!");
+        ++column_pointers[col + 1];
+      }
+      for (size_t col = 0; col < num_cols_; ++col)
+        column_pointers[col + 1] += column_pointers[col];
+      row_indices_->resize(patt.non_zeros());
+      IndexVectorType next_index(column_pointers.begin(), column_pointers.end() - 1);
+      for (size_t row = 0; row < num_rows_; ++row)
+        for (auto it = patt.inner_begin(row); it != patt.inner_end(row); ++it)
+          (*row_indices_)[next_index[*it]++] = row;
+      entries_->resize(row_indices_->size());
     }
   } // CommonSparseMatrix(rr, cc, patt, num_mutexes)
 
@@ -604,6 +925,7 @@ public:
     , eps_(eps)
   {
     if (!is_zero(value, eps)) {
+      internal::check_common_sparse_index_range<IndexType>(num_rows_, num_cols_, num_rows_ * num_cols_);
       IndexVectorType column_row_indices(num_rows_);
       for (size_t row = 0; row < num_rows_; ++row)
         column_row_indices[row] = row;
@@ -664,6 +986,7 @@ public:
       } // rr
       (*column_pointers_)[cc + 1] = index;
     } // cc
+    internal::check_common_sparse_index_range<IndexType>(num_rows_, num_cols_, row_indices_->size());
   } // CommonSparseMatrix(...)
 
   template <class OtherMatrixType>
@@ -787,8 +1110,8 @@ public:
 
   //! Matrix-Vector multiplication for arbitrary vectors that support operator[]
   template <class XX, class YY>
-  inline std::enable_if_t<!std::is_base_of<CommonSparseVector<ScalarType>, XX>::value
-                              && !std::is_base_of<CommonSparseVector<ScalarType>, YY>::value
+  inline std::enable_if_t<!internal::is_common_sparse_vector<XX>::value
+                              && !internal::is_common_sparse_vector<YY>::value
                               && XT::Common::VectorAbstraction<XX>::is_vector
                               && XT::Common::VectorAbstraction<YY>::is_vector,
                           void>
@@ -805,7 +1128,9 @@ public:
     }
   }
 
-  void mv(const CommonSparseVector<ScalarType>& xx, CommonSparseVector<ScalarType>& yy) const
+  template <class VectorIndexType>
+  void mv(const CommonSparseVector<ScalarType, VectorIndexType>& xx,
+          CommonSparseVector<ScalarType, VectorIndexType>& yy) const
   {
     yy.clear();
     const auto& entries = *entries_;
@@ -829,8 +1154,8 @@ public:
 
   //! TransposedMatrix-Vector multiplication for arbitrary vectors that support operator[]
   template <class XX, class YY>
-  inline std::enable_if_t<!std::is_base_of<CommonSparseVector<ScalarType>, XX>::value
-                              && !std::is_base_of<CommonSparseVector<ScalarType>, YY>::value
+  inline std::enable_if_t<!internal::is_common_sparse_vector<XX>::value
+                              && !internal::is_common_sparse_vector<YY>::value
                               && XT::Common::VectorAbstraction<XX>::is_vector
                               && XT::Common::VectorAbstraction<YY>::is_vector,
                           void>
@@ -847,7 +1172,9 @@ public:
     }
   }
 
-  void mtv(const CommonSparseVector<ScalarType>& xx, CommonSparseVector<ScalarType>& yy) const
+  template <class VectorIndexType>
+  void mtv(const CommonSparseVector<ScalarType, VectorIndexType>& xx,
+           CommonSparseVector<ScalarType, VectorIndexType>& yy) const
   {
     yy.clear();
     const auto& entries = *entries_;
@@ -869,6 +1196,17 @@ public:
     entries_->operator[](get_entry_index(rr, cc)) += value;
   }
 
+  /**
+   * \brief Variant of add_to_entry() which adds atomically instead of locking.
+   *
+   * Allows to assemble from several threads into a matrix with a fixed pattern without any lock traffic (construct
+   * the matrix with num_mutexes = 0 in that case). Must not be used at the same time as add_to_entry() or set_entry().
+   */
+  inline void atomic_add_to_entry(const size_t rr, const size_t cc, const ScalarType& value)
+  {
+    internal::atomic_add(entries_->operator[](get_entry_index(rr, cc)), value);
+  }
+
   inline ScalarType get_entry(const size_t rr, const size_t cc) const
   {
     const size_t index = get_entry_index(rr, cc, false);
@@ -988,42 +1326,42 @@ public:
     *row_indices_ = new_row_indices;
   } // void rightmultiply(...)
 
+  /**
+   * \brief Replaces this by this * other, using the sparse matrix-matrix product (see internal::CommonSparseSpgemm).
+   * \note  As in the generic rightmultiply(), entries of the product which are numerically zero are removed.
+   */
   void rightmultiply(const ThisType& other)
   {
-    thread_local EntriesVectorType new_entries;
-    thread_local IndexVectorType new_column_pointers(num_cols_ + 1, 0);
-    thread_local IndexVectorType new_row_indices;
-    new_entries.clear();
-    new_row_indices.clear();
-    const auto& other_entries = *other.entries_;
-    const auto& other_column_pointers = *other.column_pointers_;
-    const auto& other_row_indices = *other.row_indices_;
-    thread_local std::vector<ScalarType> dense_column(num_rows_, 0.);
-    dense_column.resize(num_rows_);
-    for (size_t cc = 0; cc < other.cols(); ++cc) {
-      std::fill(dense_column.begin(), dense_column.end(), 0.);
-      size_t other_col_end = other_column_pointers[cc + 1];
-      for (size_t kk = other_column_pointers[cc]; kk < other_col_end; ++kk) {
-        size_t col = other_row_indices[kk];
-        size_t col_end = (*column_pointers_)[col + 1];
-        for (size_t ll = (*column_pointers_)[col]; ll < col_end; ++ll)
-          dense_column[(*row_indices_)[ll]] += (*entries_)[ll] * other_entries[kk];
-      } // kk
-      for (size_t rr = 0; rr < num_rows_; ++rr) {
-        if (XT::Common::FloatCmp::ne(dense_column[rr], ScalarType(0.), 0., eps_ / num_cols_)) {
-          new_entries.push_back(dense_column[rr]);
-          new_row_indices.push_back(rr);
-        }
-      } // ii
-      new_column_pointers[cc + 1] = new_row_indices.size();
-    } // cc
-    *entries_ = new_entries;
-    *column_pointers_ = new_column_pointers;
-    *row_indices_ = new_row_indices;
+    if (other.rows() != num_cols_)
+      DUNE_THROW(XT::Common::Exceptions::shapes_do_not_match, "Dimensions of matrices to be multiplied do not match!");
+    auto new_entries = std::make_shared<EntriesVectorType>();
+    auto new_column_pointers = std::make_shared<IndexVectorType>();
+    auto new_row_indices = std::make_shared<IndexVectorType>();
+    spgemm(other, *new_column_pointers, *new_row_indices, *new_entries);
+    internal::CommonSparseSpgemm<ScalarType, IndexType>::remove_zeros(
+        other.cols(), *new_column_pointers, *new_row_indices, *new_entries, eps_ / num_cols_);
+    num_cols_ = other.cols();
+    entries_ = new_entries;
+    column_pointers_ = new_column_pointers;
+    row_indices_ = new_row_indices;
   } // void rightmultiply(...)
 
+  /**
+   * \brief Sparse matrix-matrix product (see internal::CommonSparseSpgemm), runs in parallel for large products.
+   * \note  The pattern of the result is the pattern of the product, no entries are removed.
+   */
+  virtual ThisType operator*(const ThisType& other) const override final
+  {
+    if (other.rows() != num_cols_)
+      DUNE_THROW(XT::Common::Exceptions::shapes_do_not_match, "Dimensions of matrices to be multiplied do not match!");
+    ThisType ret(num_rows_, other.cols(), ScalarType(0), 1, eps_);
+    spgemm(other, *ret.column_pointers_, *ret.row_indices_, *ret.entries_);
+    return ret;
+  }
+
   using InterfaceType::operator+;
   using InterfaceType::operator-;
+  using InterfaceType::operator*;
   using InterfaceType::operator+=;
   using InterfaceType::operator-=;
 
@@ -1037,22 +1375,22 @@ public:
     return entries_->data();
   }
 
-  size_t* outer_index_ptr()
+  IndexType* outer_index_ptr()
   {
     return column_pointers_->data();
   }
 
-  const size_t* outer_index_ptr() const
+  const IndexType* outer_index_ptr() const
   {
     return column_pointers_->data();
   }
 
-  size_t* inner_index_ptr()
+  IndexType* inner_index_ptr()
   {
     return row_indices_->data();
   }
 
-  const size_t* inner_index_ptr() const
+  const IndexType* inner_index_ptr() const
   {
     return row_indices_->data();
   }
@@ -1084,6 +1422,29 @@ private:
     return XT::Common::FloatCmp::eq(val, ScalarType(0.), 0., tol);
   }
 
+  //! Computes the compressed column arrays of this * other, which are the compressed row arrays of other^T * this^T.
+  void spgemm(const ThisType& other,
+              IndexVectorType& column_pointers,
+              IndexVectorType& row_indices,
+              EntriesVectorType& entries) const
+  {
+    using Spgemm = internal::CommonSparseSpgemm<ScalarType, IndexType>;
+    const size_t threads = Spgemm::num_threads(Spgemm::multiply_adds(
+        other.num_cols_, other.column_pointers_->data(), other.row_indices_->data(), column_pointers_->data()));
+    Spgemm::apply(other.num_cols_,
+                  num_rows_,
+                  other.column_pointers_->data(),
+                  other.row_indices_->data(),
+                  other.entries_->data(),
+                  column_pointers_->data(),
+                  row_indices_->data(),
+                  entries_->data(),
+                  column_pointers,
+                  row_indices,
+                  entries,
+                  threads);
+  } // ... spgemm(...)
+
   size_t num_rows_, num_cols_;
   std::shared_ptr<EntriesVectorType> entries_;
   std::shared_ptr<IndexVectorType> column_pointers_;
@@ -1139,6 +1500,26 @@ public:
     }
   } // CommonSparseOrDenseMatrix(rr, cc, patt, num_mutexes)
 
+  template <class PatternIndexType>
+  CommonSparseOrDenseMatrix(const size_t rr,
+                            const size_t cc,
+                            const SparsityPatternCompressed<PatternIndexType>& patt,
+                            const size_t num_mutexes = 1,
+                            EpsType eps = Common::FloatCmp::DefaultEpsilon<ScalarType>::value() / 1000.)
+    : num_rows_(rr)
+    , num_cols_(cc)
+  {
+    const double density = double(patt.non_zeros()) / double(rr * cc);
+    sparse_ = density < sparse_limit;
+    if (sparse_) {
+      sparse_matrix_ = SparseMatrixType(rr, cc, patt, num_mutexes, eps);
+      dense_matrix_ = DenseMatrixType(0, 0, patt, num_mutexes);
+    } else {
+      sparse_matrix_ = SparseMatrixType(0, 0, patt, num_mutexes, eps);
+      dense_matrix_ = DenseMatrixType(rr, cc, patt, num_mutexes);
+    }
+  } // CommonSparseOrDenseMatrix(rr, cc, patt, num_mutexes)
+
   CommonSparseOrDenseMatrix(const size_t rr = 0,
                             const size_t cc = 0,
                             const ScalarType& value = ScalarType(0),
@@ -1454,11 +1835,11 @@ private:
   DenseMatrixType dense_matrix_;
 }; // class CommonSparseOrDenseMatrix<...>
 
-template <class ScalarType = double>
-using CommonSparseMatrixCsr = CommonSparseMatrix<ScalarType, Common::StorageLayout::csr>;
+template <class ScalarType = double, class IndexType = size_t>
+using CommonSparseMatrixCsr = CommonSparseMatrix<ScalarType, Common::StorageLayout::csr, IndexType>;
 
-template <class ScalarType = double>
-using CommonSparseMatrixCsc = CommonSparseMatrix<ScalarType, Common::StorageLayout::csc>;
+template <class ScalarType = double, class IndexType = size_t>
+using CommonSparseMatrixCsc = CommonSparseMatrix<ScalarType, Common::StorageLayout::csc, IndexType>;
 
 template <class ScalarType = double>
 using CommonSparseOrDenseMatrixCsr =
@@ -1473,26 +1854,26 @@ using CommonSparseOrDenseMatrixCsc =
 namespace Common {
 
 
-template <class T>
-struct MatrixAbstraction<LA::CommonSparseMatrixCsr<T>>
-  : public LA::internal::MatrixAbstractionBase<LA::CommonSparseMatrixCsr<T>>
+template <class T, class I>
+struct MatrixAbstraction<LA::CommonSparseMatrixCsr<T, I>>
+  : public LA::internal::MatrixAbstractionBase<LA::CommonSparseMatrixCsr<T, I>>
 {
-  using BaseType = LA::internal::MatrixAbstractionBase<LA::CommonSparseMatrixCsr<T>>;
+  using BaseType = LA::internal::MatrixAbstractionBase<LA::CommonSparseMatrixCsr<T, I>>;
 
   template <size_t rows = BaseType::static_rows, size_t cols = BaseType::static_cols, class FieldType = T>
-  using MatrixTypeTemplate = LA::CommonSparseMatrixCsr<FieldType>;
+  using MatrixTypeTemplate = LA::CommonSparseMatrixCsr<FieldType, I>;
 
   static const constexpr Common::StorageLayout storage_layout = Common::StorageLayout::csr;
 };
 
-template <class T>
-struct MatrixAbstraction<LA::CommonSparseMatrixCsc<T>>
-  : public LA::internal::MatrixAbstractionBase<LA::CommonSparseMatrixCsc<T>>
+template <class T, class I>
+struct MatrixAbstraction<LA::CommonSparseMatrixCsc<T, I>>
+  : public LA::internal::MatrixAbstractionBase<LA::CommonSparseMatrixCsc<T, I>>
 {
-  using BaseType = LA::internal::MatrixAbstractionBase<LA::CommonSparseMatrixCsc<T>>;
+  using BaseType = LA::internal::MatrixAbstractionBase<LA::CommonSparseMatrixCsc<T, I>>;
 
   template <size_t rows = BaseType::static_rows, size_t cols = BaseType::static_cols, class FieldType = T>
-  using MatrixTypeTemplate = LA::CommonSparseMatrixCsc<FieldType>;
+  using MatrixTypeTemplate = LA::CommonSparseMatrixCsc<FieldType, I>;
 
   static const constexpr Common::StorageLayout storage_layout = Common::StorageLayout::csc;
 };
@@ -1525,6 +1906,8 @@ struct MatrixAbstraction<LA::CommonSparseOrDenseMatrix<DenseMatrixImp, SparseMat
 
 extern template class Dune::XT::LA::CommonSparseMatrix<double, Dune::XT::Common::StorageLayout::csr>;
 extern template class Dune::XT::LA::CommonSparseMatrix<double, Dune::XT::Common::StorageLayout::csc>;
+extern template class Dune::XT::LA::CommonSparseMatrix<double, Dune::XT::Common::StorageLayout::csr, uint32_t>;
+extern template class Dune::XT::LA::CommonSparseMatrix<double, Dune::XT::Common::StorageLayout::csc, uint32_t>;
 
 
 #endif // DUNE_XT_WITH_PYTHON_BINDINGS
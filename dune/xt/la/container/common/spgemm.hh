@@ -0,0 +1,245 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_LA_CONTAINER_COMMON_SPGEMM_HH
+#define DUNE_XT_LA_CONTAINER_COMMON_SPGEMM_HH
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <vector>
+
+#if HAVE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+#include <dune/common/unused.hh>
+
+#include <dune/xt/common/exceptions.hh>
+#include <dune/xt/common/float_cmp.hh>
+#include <dune/xt/common/parallel/threadmanager.hh>
+
+namespace Dune {
+namespace XT {
+namespace LA {
+namespace internal {
+
+
+//! Default number of multiply-adds from which on CommonSparseSpgemm runs in parallel.
+static const constexpr size_t common_sparse_spgemm_parallel_threshold = 100000;
+
+
+/**
+ * \brief Sparse matrix-matrix product C = A * B of matrices in compressed row storage (Gustavson's algorithm).
+ *
+ * The product is computed in two passes over the rows of A: the symbolic pass counts the non-zeros of each row of C
+ * (marking the columns already seen in a dense marker array), which allows to allocate C exactly, and the numeric
+ * pass accumulates each row of C in a dense accumulator, collecting the touched columns directly in the row of C.
+ * The columns of each row of C are sorted, the structural non-zeros of the product are kept (even if they cancel out
+ * numerically, see remove_zeros()).
+ *
+ * Compressed column storage is covered by the same code: the compressed column arrays of a matrix are the compressed
+ * row arrays of its transposed, and (A * B)^T = B^T * A^T.
+ *
+ * For large products, the rows of A are split into parts with about the same number of multiply-adds, which are
+ * processed in parallel (requires TBB), see num_threads().
+ *
+ * The row pointers and column indices of all matrices are of type IndexType, apply() throws if the number of
+ * non-zeros of C does not fit into it.
+ */
+template <class ScalarType, class IndexType = size_t>
+class CommonSparseSpgemm
+{
+  using SizeVectorType = std::vector<size_t>;
+
+public:
+  using EntriesVectorType = std::vector<ScalarType>;
+  using IndexVectorType = std::vector<IndexType>;
+
+  //! The number of multiply-adds needed to compute A * B (for A with mm rows), which is a bound for nnz(C).
+  static size_t multiply_adds(const size_t mm,
+                              const IndexType* a_row_pointers,
+                              const IndexType* a_column_indices,
+                              const IndexType* b_row_pointers)
+  {
+    size_t ret = 0;
+    for (size_t kk = a_row_pointers[0]; kk < a_row_pointers[mm]; ++kk)
+      ret += b_row_pointers[a_column_indices[kk] + 1] - b_row_pointers[a_column_indices[kk]];
+    return ret;
+  }
+
+  //! The number of threads apply() uses by default, 1 for small products or without TBB.
+  static size_t num_threads(const size_t num_multiply_adds,
+                            const size_t threshold = common_sparse_spgemm_parallel_threshold)
+  {
+#if HAVE_TBB
+    if (num_multiply_adds < threshold)
+      return 1;
+    return std::max(size_t(1), size_t(Common::threadManager().max_threads()));
+#else
+    DUNE_UNUSED_PARAMETER(num_multiply_adds);
+    DUNE_UNUSED_PARAMETER(threshold);
+    return 1;
+#endif
+  } // ... num_threads(...)
+
+  /**
+   * \brief Computes C = A * B for A with mm rows and B with nn columns.
+   *
+   * The previous contents of c_row_pointers, c_column_indices and c_entries are discarded.
+   */
+  static void apply(const size_t mm,
+                    const size_t nn,
+                    const IndexType* a_row_pointers,
+                    const IndexType* a_column_indices,
+                    const ScalarType* a_entries,
+                    const IndexType* b_row_pointers,
+                    const IndexType* b_column_indices,
+                    const ScalarType* b_entries,
+                    IndexVectorType& c_row_pointers,
+                    IndexVectorType& c_column_indices,
+                    EntriesVectorType& c_entries,
+                    const size_t threads)
+  {
+    const auto first_rows = balanced_row_partition(mm, a_row_pointers, a_column_indices, b_row_pointers, threads);
+    const size_t num_parts = first_rows.size() - 1;
+    // symbolic pass, store the number of non-zeros of row rr in c_row_pointers[rr + 1]
+    c_row_pointers.assign(mm + 1, 0);
+    for_each_part(num_parts, [&](const size_t pp) {
+      SizeVectorType marker(nn, size_t(-1));
+      for (size_t rr = first_rows[pp]; rr < first_rows[pp + 1]; ++rr) {
+        size_t row_nnz = 0;
+        for (size_t kk = a_row_pointers[rr]; kk < a_row_pointers[rr + 1]; ++kk) {
+          const size_t row_of_b = a_column_indices[kk];
+          for (size_t ll = b_row_pointers[row_of_b]; ll < b_row_pointers[row_of_b + 1]; ++ll) {
+            const size_t col = b_column_indices[ll];
+            if (marker[col] != rr) {
+              marker[col] = rr;
+              ++row_nnz;
+            }
+          }
+        }
+        c_row_pointers[rr + 1] = static_cast<IndexType>(row_nnz);
+      }
+    });
+    size_t nnz = 0;
+    for (size_t rr = 0; rr < mm; ++rr) {
+      nnz += c_row_pointers[rr + 1];
+      c_row_pointers[rr + 1] = static_cast<IndexType>(nnz);
+    }
+    if (nnz > size_t(std::numeric_limits<IndexType>::max()))
+      DUNE_THROW(Common::Exceptions::index_out_of_range,
+                 "The product has " << nnz << " non-zeros, which can not be indexed by the chosen index type!");
+    c_column_indices.resize(nnz);
+    c_entries.resize(nnz);
+    // numeric pass
+    for_each_part(num_parts, [&](const size_t pp) {
+      SizeVectorType marker(nn, size_t(-1));
+      EntriesVectorType accumulator(nn);
+      for (size_t rr = first_rows[pp]; rr < first_rows[pp + 1]; ++rr) {
+        const size_t row_begin = c_row_pointers[rr];
+        size_t row_end = row_begin;
+        for (size_t kk = a_row_pointers[rr]; kk < a_row_pointers[rr + 1]; ++kk) {
+          const size_t row_of_b = a_column_indices[kk];
+          const ScalarType a_entry = a_entries[kk];
+          for (size_t ll = b_row_pointers[row_of_b]; ll < b_row_pointers[row_of_b + 1]; ++ll) {
+            const size_t col = b_column_indices[ll];
+            if (marker[col] != rr) {
+              marker[col] = rr;
+              accumulator[col] = a_entry * b_entries[ll];
+              c_column_indices[row_end++] = static_cast<IndexType>(col);
+            } else
+              accumulator[col] += a_entry * b_entries[ll];
+          }
+        }
+        assert(row_end == c_row_pointers[rr + 1]);
+        std::sort(c_column_indices.begin() + row_begin, c_column_indices.begin() + row_end);
+        for (size_t kk = row_begin; kk < row_end; ++kk)
+          c_entries[kk] = accumulator[c_column_indices[kk]];
+      }
+    });
+  } // ... apply(...)
+
+  /**
+   * \brief Removes all entries whose absolute value is not larger than tolerance from compressed row (or column)
+   *        arrays with mm rows (or columns).
+   */
+  static void remove_zeros(const size_t mm,
+                           IndexVectorType& row_pointers,
+                           IndexVectorType& column_indices,
+                           EntriesVectorType& entries,
+                           const typename Common::FloatCmp::DefaultEpsilon<ScalarType>::Type tolerance)
+  {
+    size_t index = 0;
+    size_t row_begin = 0;
+    for (size_t rr = 0; rr < mm; ++rr) {
+      const size_t row_end = row_pointers[rr + 1];
+      for (size_t kk = row_begin; kk < row_end; ++kk) {
+        if (Common::FloatCmp::ne(entries[kk], ScalarType(0), 0., tolerance)) {
+          column_indices[index] = column_indices[kk];
+          entries[index] = entries[kk];
+          ++index;
+        }
+      }
+      row_begin = row_end;
+      row_pointers[rr + 1] = static_cast<IndexType>(index);
+    }
+    column_indices.resize(index);
+    entries.resize(index);
+  } // ... remove_zeros(...)
+
+private:
+  //! Returns the first row of each part (and mm as last entry), such that all parts have about as much work.
+  static SizeVectorType balanced_row_partition(const size_t mm,
+                                               const IndexType* a_row_pointers,
+                                               const IndexType* a_column_indices,
+                                               const IndexType* b_row_pointers,
+                                               const size_t threads)
+  {
+    const size_t num_parts = std::max(size_t(1), std::min(threads, mm));
+    SizeVectorType first_rows(num_parts + 1, mm);
+    first_rows[0] = 0;
+    if (num_parts == 1)
+      return first_rows;
+    SizeVectorType work(mm + 1, 0);
+    for (size_t rr = 0; rr < mm; ++rr) {
+      // count each row of A as one unit of work, to also balance rows which do not contribute
+      work[rr + 1] = work[rr] + 1;
+      for (size_t kk = a_row_pointers[rr]; kk < a_row_pointers[rr + 1]; ++kk)
+        work[rr + 1] += b_row_pointers[a_column_indices[kk] + 1] - b_row_pointers[a_column_indices[kk]];
+    }
+    for (size_t pp = 1; pp < num_parts; ++pp)
+      first_rows[pp] =
+          std::distance(work.begin(), std::lower_bound(work.begin(), work.begin() + mm, pp * work[mm] / num_parts));
+    return first_rows;
+  } // ... balanced_row_partition(...)
+
+  template <class FunctorType>
+  static void for_each_part(const size_t num_parts, const FunctorType& functor)
+  {
+#if HAVE_TBB
+    if (num_parts > 1) {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, num_parts, 1), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t pp = range.begin(); pp != range.end(); ++pp)
+          functor(pp);
+      });
+      return;
+    }
+#endif
+    for (size_t pp = 0; pp < num_parts; ++pp)
+      functor(pp);
+  } // ... for_each_part(...)
+}; // class CommonSparseSpgemm
+
+
+} // namespace internal
+} // namespace LA
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_LA_CONTAINER_COMMON_SPGEMM_HH
@@ -26,6 +26,7 @@
 
 #include <dune/xt/common/exceptions.hh>
 
+#include <dune/xt/la/container/common/kernels.hh>
 #include <dune/xt/la/container/vector-interface.hh>
 
 namespace Dune {
@@ -79,6 +80,7 @@ public:
 
 private:
   using MutexesType = typename Traits::MutexesType;
+  using Kernels = internal::CommonDenseKernels<ScalarType>;
 
 public:
   explicit CommonDenseVector(const size_t ss = 0, const ScalarType& value = ScalarType(), const size_t num_mutexes = 1)
@@ -196,7 +198,7 @@ public:
   void scal(const ScalarType& alpha)
   {
     const internal::VectorLockGuard DUNE_UNUSED(guard)(*mutexes_);
-    backend() *= alpha;
+    Kernels::scal(size(), alpha, entries());
   }
 
   void axpy(const ScalarType& alpha, const ThisType& xx)
@@ -205,8 +207,7 @@ public:
       DUNE_THROW(Common::Exceptions::shapes_do_not_match,
                  "The size of x (" << xx.size() << ") does not match the size of this (" << size() << ")!");
     const internal::VectorLockGuard DUNE_UNUSED(guard)(*mutexes_);
-    for (size_t ii = 0; ii < backend().size(); ++ii)
-      backend()[ii] += alpha * xx.backend()[ii];
+    Kernels::axpy(size(), alpha, xx.entries(), entries());
   } // ... axpy(...)
 
   bool has_equal_shape(const ThisType& other) const
@@ -278,22 +279,36 @@ public:
     if (other.size() != size())
       DUNE_THROW(Common::Exceptions::shapes_do_not_match,
                  "The size of other (" << other.size() << ") does not match the size of this (" << size() << ")!");
-    return backend() * other.backend();
+    return Kernels::dot(size(), entries(), other.entries());
   } // ... dot(...)
 
+  //! \note Returns 0 for empty vectors, as the other reductions.
+  virtual ScalarType mean() const override final
+  {
+    if (size() == 0)
+      return ScalarType(0);
+    return Kernels::sum(size(), entries()) / ScalarType(size());
+  }
+
+  virtual std::pair<size_t, RealType> amax() const override final
+  {
+    return Kernels::iamax(size(), entries());
+  }
+
   virtual RealType l1_norm() const override final
   {
-    return backend().one_norm();
+    return Kernels::asum(size(), entries());
   }
 
   virtual RealType l2_norm() const override final
   {
-    return backend().two_norm();
+    return Kernels::nrm2(size(), entries());
   }
 
+  //! \note In contrast to amax(), NaN entries propagate, so that the post checks of the solvers detect them.
   virtual RealType sup_norm() const override final
   {
-    return backend().infinity_norm();
+    return Kernels::sup_norm(size(), entries());
   }
 
   virtual void iadd(const ThisType& other) override final
@@ -325,6 +340,17 @@ public:
 private:
   friend class VectorInterface<internal::CommonDenseVectorTraits<ScalarType>, ScalarType>;
 
+  // contiguous storage for the kernels, in contrast to data() also valid for empty vectors
+  ScalarType* entries()
+  {
+    return size() > 0 ? &(backend()[0]) : nullptr;
+  }
+
+  const ScalarType* entries() const
+  {
+    return size() > 0 ? &(backend()[0]) : nullptr;
+  }
+
   std::shared_ptr<BackendType> backend_;
   std::unique_ptr<MutexesType> mutexes_;
 }; // class CommonDenseVector
@@ -12,6 +12,7 @@
 #define DUNE_XT_LA_CONTAINER_COMMON_VECTOR_SPARSE_HH
 
 #include <cmath>
+#include <cstdint>
 #include <initializer_list>
 #include <memory>
 #include <type_traits>
@@ -35,24 +36,27 @@ namespace LA {
 
 
 // forwards
-template <class ScalarImp>
+template <class ScalarImp, class IndexImp>
 class CommonSparseVector;
 
 
 namespace internal {
 
 
-template <class ScalarImp>
+template <class ScalarImp, class IndexImp>
 struct CommonSparseVectorTraits
   : VectorTraitsBase<ScalarImp,
-                     CommonSparseVector<ScalarImp>,
+                     CommonSparseVector<ScalarImp, IndexImp>,
                      void,
                      Backends::common_dense,
                      Backends::common_dense,
                      Backends::common_sparse>
 {
+  static_assert(std::is_integral<IndexImp>::value && std::is_unsigned<IndexImp>::value,
+                "The index type has to be an unsigned integer!");
   using EntriesVectorType = std::vector<ScalarImp>;
-  using IndicesVectorType = std::vector<size_t>;
+  using IndexType = IndexImp;
+  using IndicesVectorType = std::vector<IndexImp>;
 };
 
 
@@ -61,17 +65,21 @@ struct CommonSparseVectorTraits
 
 /**
  *  \brief A sparse vector implementation of VectorInterface
+ *
+ *  The indices of the non-zero entries are stored as IndexImp, use uint32_t to halve the memory traffic of the indices
+ *  for vectors with less than 2^32 entries.
  */
-template <class ScalarImp = double>
-class CommonSparseVector : public VectorInterface<internal::CommonSparseVectorTraits<ScalarImp>, ScalarImp>
+template <class ScalarImp = double, class IndexImp = size_t>
+class CommonSparseVector : public VectorInterface<internal::CommonSparseVectorTraits<ScalarImp, IndexImp>, ScalarImp>
 {
   using ThisType = CommonSparseVector;
-  using InterfaceType = VectorInterface<internal::CommonSparseVectorTraits<ScalarImp>, ScalarImp>;
+  using InterfaceType = VectorInterface<internal::CommonSparseVectorTraits<ScalarImp, IndexImp>, ScalarImp>;
 
 public:
   using typename InterfaceType::RealType;
   using typename InterfaceType::ScalarType;
   using typename InterfaceType::Traits;
+  using IndexType = typename Traits::IndexType;
   using IndicesVectorType = typename Traits::IndicesVectorType;
   using EntriesVectorType = typename Traits::EntriesVectorType;
   // needed to fix gcc compilation error due to ambiguous lookup of derived type
@@ -473,7 +481,7 @@ public:
   using InterfaceType::operator*;
 
 private:
-  friend class VectorInterface<internal::CommonSparseVectorTraits<ScalarType>, ScalarType>;
+  friend class VectorInterface<internal::CommonSparseVectorTraits<ScalarType, IndexType>, ScalarType>;
 
   size_t size_;
   std::shared_ptr<EntriesVectorType> entries_;
@@ -482,13 +490,26 @@ private:
 }; // class CommonSparseVector
 
 
+namespace internal {
+
+
+template <class T>
+struct is_common_sparse_vector : public std::false_type
+{};
+
+template <class S, class I>
+struct is_common_sparse_vector<CommonSparseVector<S, I>> : public std::true_type
+{};
+
+
+} // namespace internal
 } // namespace LA
 namespace Common {
 
 
-template <class T>
-struct VectorAbstraction<LA::CommonSparseVector<T>>
-  : public LA::internal::VectorAbstractionBase<LA::CommonSparseVector<T>>
+template <class T, class I>
+struct VectorAbstraction<LA::CommonSparseVector<T, I>>
+  : public LA::internal::VectorAbstractionBase<LA::CommonSparseVector<T, I>>
 {
   static const bool is_contiguous = false;
 };
@@ -498,9 +519,9 @@ struct VectorAbstraction<LA::CommonSparseVector<T>>
 } // namespace XT
 
 
-template <class ScalarType, int size>
+template <class ScalarType, int size, class IndexType>
 FieldVector<ScalarType, size>& operator+=(FieldVector<ScalarType, size>& lhs,
-                                          const XT::LA::CommonSparseVector<ScalarType>& rhs)
+                                          const XT::LA::CommonSparseVector<ScalarType, IndexType>& rhs)
 {
   const auto& indices = rhs.indices();
   const auto& entries = rhs.entries();
@@ -518,6 +539,7 @@ FieldVector<ScalarType, size>& operator+=(FieldVector<ScalarType, size>& lhs,
 
 
 extern template class Dune::XT::LA::CommonSparseVector<double>;
+extern template class Dune::XT::LA::CommonSparseVector<double, uint32_t>;
 
 
 #endif // DUNE_XT_WITH_PYTHON_BINDINGS
@@ -13,6 +13,7 @@
 #define DUNE_XT_LA_CONTAINER_CONTAINER_INTERFACE_HH
 
 #include <cmath>
+#include <complex>
 #include <limits>
 #include <type_traits>
 
@@ -70,6 +71,34 @@ struct LockGuard
 }; // LockGuard
 
 
+/**
+ * \brief Adds value to target by a compare-and-swap loop, which is lock-free for float and double.
+ *
+ * Concurrent calls for the same target are safe, as long as target is not accessed otherwise at the same time.
+ */
+template <class T>
+void atomic_add(T& target, const T& value)
+{
+  static_assert(std::is_arithmetic<T>::value, "Only implemented for arithmetic types and std::complex of those!");
+  T expected;
+  __atomic_load(&target, &expected, __ATOMIC_RELAXED);
+  T desired = expected + value;
+  // expected is updated to the current value of target on failure
+  while (!__atomic_compare_exchange(&target, &expected, &desired, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    desired = expected + value;
+} // ... atomic_add(...)
+
+//! The real and imaginary parts are updated separately, which yields the correct sum once all additions are done.
+template <class T>
+void atomic_add(std::complex<T>& target, const std::complex<T>& value)
+{
+  // std::complex<T> is guaranteed to have the layout of T[2]
+  T* parts = reinterpret_cast<T*>(&target);
+  atomic_add(parts[0], value.real());
+  atomic_add(parts[1], value.imag());
+}
+
+
 } // namespace internal
 
 
@@ -241,7 +241,9 @@ private:
  *  \brief  A dense vector implementation of VectorInterface using the eigen backend which wrappes a raw array.
  */
 template <class ScalarImp = double>
-class EigenMappedDenseVector : public EigenBaseVector<internal::EigenMappedDenseVectorTraits<ScalarImp>, ScalarImp>
+class EigenMappedDenseVector
+  : public EigenBaseVector<internal::EigenMappedDenseVectorTraits<ScalarImp>, ScalarImp>
+  , public ProvidesDataAccess<internal::EigenMappedDenseVectorTraits<ScalarImp>>
 {
   using ThisType = EigenMappedDenseVector;
   using InterfaceType = VectorInterface<internal::EigenMappedDenseVectorTraits<ScalarImp>, ScalarImp>;
@@ -253,6 +255,7 @@ public:
   using typename InterfaceType::ScalarType;
   using Traits = typename InterfaceType::Traits;
   using BackendType = typename Traits::BackendType;
+  using typename ProvidesDataAccess<Traits>::DataType;
   // needed to fix gcc compilation error due to ambiguous lookup of derived type
   using derived_type = typename Traits::derived_type;
 
@@ -271,13 +274,15 @@ public:
 
   /**
    *  \brief  This constructor allows to create an instance of this type just like any other vector.
+   *  \note   This and all other constructors which do not wrap a given array allocate memory, which is freed when the
+   *          last vector sharing it (see copy()) is destroyed.
    */
   explicit EigenMappedDenseVector(const size_t ss = 0,
                                   const ScalarType value = ScalarType(0),
                                   const size_t num_mutexes = 1)
     : BaseType(num_mutexes)
   {
-    backend_ = std::make_shared<BackendType>(new ScalarType[ss], Common::numeric_cast<EIGEN_size_t>(ss));
+    backend_ = create_owning_backend(ss);
     backend_->setOnes();
     backend_->operator*=(value);
   }
@@ -285,8 +290,7 @@ public:
   explicit EigenMappedDenseVector(const std::vector<ScalarType>& other, const size_t num_mutexes = 1)
     : BaseType(num_mutexes)
   {
-    backend_ =
-        std::make_shared<BackendType>(new ScalarType[other.size()], Common::numeric_cast<EIGEN_size_t>(other.size()));
+    backend_ = create_owning_backend(other.size());
     for (size_t ii = 0; ii < other.size(); ++ii)
       (*backend_)[ii] = other[ii];
   }
@@ -294,8 +298,7 @@ public:
   explicit EigenMappedDenseVector(const std::initializer_list<ScalarType>& other, const size_t num_mutexes = 1)
     : BaseType(num_mutexes)
   {
-    backend_ =
-        std::make_shared<BackendType>(new ScalarType[other.size()], Common::numeric_cast<EIGEN_size_t>(other.size()));
+    backend_ = create_owning_backend(other.size());
     size_t ii = 0;
     for (auto element : other)
       (*backend_)[ii++] = element;
@@ -304,8 +307,7 @@ public:
   EigenMappedDenseVector(const ThisType& other)
     : BaseType(other)
   {
-    backend_ =
-        std::make_shared<BackendType>(new ScalarType[other.size()], Common::numeric_cast<EIGEN_size_t>(other.size()));
+    backend_ = create_owning_backend(other.size());
     backend_->operator=(other.backend());
   }
 
@@ -315,8 +317,7 @@ public:
                                   const size_t num_mutexes = 1)
     : BaseType(num_mutexes)
   {
-    backend_ =
-        std::make_shared<BackendType>(new ScalarType[other.size()], Common::numeric_cast<EIGEN_size_t>(other.size()));
+    backend_ = create_owning_backend(other.size());
     backend_->operator=(other);
   }
 
@@ -345,7 +346,7 @@ public:
 
   ThisType& operator=(const BackendType& other)
   {
-    backend_ = std::make_shared<BackendType>(new ScalarType[other.size()], other.size());
+    backend_ = create_owning_backend(other.size());
     backend_->operator=(other);
     return *this;
   }
@@ -356,6 +357,22 @@ public:
       DUNE_THROW(XT::Common::Exceptions::you_are_using_this_wrong, "This does not make sense for mapped memory!");
   }
 
+  /// \name Required by ProvidesDataAccess.
+  /// \{
+
+  //! The wrapped array (if constructed from one).
+  DataType* data()
+  {
+    return backend().data();
+  }
+
+  size_t data_size() const
+  {
+    return this->size();
+  }
+
+  /// \}
+
   using InterfaceType::add;
   using InterfaceType::sub;
   using InterfaceType::operator+;
@@ -364,6 +381,21 @@ public:
   using BaseType::backend;
 
 private:
+  /**
+   * \brief Creates a backend which maps newly allocated memory, the memory is freed together with the backend (i.e.
+   *        when the last vector sharing it is destroyed).
+   */
+  static std::shared_ptr<BackendType> create_owning_backend(const size_t ss)
+  {
+    auto data = std::make_unique<ScalarType[]>(ss);
+    auto map = std::make_unique<BackendType>(data.get(), Common::numeric_cast<EIGEN_size_t>(ss));
+    data.release(); // <- from now on owned by map, the deleter is also called if creating the shared_ptr throws
+    return std::shared_ptr<BackendType>(map.release(), [](BackendType* ptr) {
+      delete[] ptr->data();
+      delete ptr;
+    });
+  } // ... create_owning_backend(...)
+
   using BaseType::backend_;
 
   friend class VectorInterface<internal::EigenMappedDenseVectorTraits<ScalarType>, ScalarType>;
@@ -419,6 +451,15 @@ public:
     backend_->setZero();
   }
 
+  /// This constructors ignores the given pattern and initializes the matrix with 0.
+  template <class PatternIndexType>
+  EigenDenseMatrix(const size_t rr,
+                   const size_t cc,
+                   const SparsityPatternCompressed<PatternIndexType>& /*pattern*/,
+                   const size_t num_mutexes = 1)
+    : EigenDenseMatrix(rr, cc, SparsityPatternDefault(), num_mutexes)
+  {}
+
   EigenDenseMatrix(const ThisType& other)
     : backend_(std::make_shared<BackendType>(*other.backend_))
     , mutexes_(std::make_unique<MutexesType>(other.mutexes_->size()))
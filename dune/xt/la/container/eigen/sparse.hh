@@ -13,6 +13,7 @@
 #ifndef DUNE_XT_LA_CONTAINER_EIGEN_SPARSE_HH
 #define DUNE_XT_LA_CONTAINER_EIGEN_SPARSE_HH
 
+#include <algorithm>
 #include <memory>
 #include <type_traits>
 #include <vector>
@@ -137,6 +138,44 @@ public:
     }
   } // EigenRowMajorSparseMatrix(...)
 
+  /**
+   * \brief Creates a sparse matrix with the given compressed pattern, which is inserted directly into the compressed
+   *        storage of the backend.
+   */
+  template <class PatternIndexType>
+  EigenRowMajorSparseMatrix(const size_t rr,
+                            const size_t cc,
+                            const SparsityPatternCompressed<PatternIndexType>& pattern_in,
+                            const size_t num_mutexes = 1)
+    : backend_(
+          std::make_shared<BackendType>(Common::numeric_cast<EIGEN_size_t>(rr), Common::numeric_cast<EIGEN_size_t>(cc)))
+    , mutexes_(std::make_unique<MutexesType>(num_mutexes))
+  {
+    if (rr > 0 && cc > 0) {
+      if (pattern_in.size() != rr)
+        DUNE_THROW(Common::Exceptions::shapes_do_not_match,
+                   "The size of the pattern (" << pattern_in.size() << ") does not match the number of rows of this ("
+                                               << rr << ")!");
+      std::vector<EIGEN_size_t> row_sizes(rr);
+      for (size_t row = 0; row < rr; ++row)
+        row_sizes[row] = std::max(EIGEN_size_t(1), static_cast<EIGEN_size_t>(pattern_in.inner_size(row)));
+      backend_->reserve(row_sizes);
+      for (size_t row = 0; row < rr; ++row) {
+        for (auto it = pattern_in.inner_begin(row); it != pattern_in.inner_end(row); ++it) {
+          if (size_t(*it) >= cc)
+            DUNE_THROW(Common::Exceptions::shapes_do_not_match,
+                       "The size of row " << row << " of the pattern does not match the number of columns of this ("
+                                          << cc << ")!");
+          backend_->insert(static_cast<EIGEN_size_t>(row), static_cast<EIGEN_size_t>(*it));
+        }
+        // create entry (as in the constructor above)
+        if (pattern_in.inner_size(row) == 0)
+          backend_->insert(static_cast<EIGEN_size_t>(row), 0);
+      }
+      backend_->makeCompressed();
+    }
+  } // EigenRowMajorSparseMatrix(...)
+
   explicit EigenRowMajorSparseMatrix(const size_t rr = 0, const size_t cc = 0, const size_t num_mutexes = 1)
     : backend_(
           std::make_shared<BackendType>(Common::numeric_cast<EIGEN_size_t>(rr), Common::numeric_cast<EIGEN_size_t>(cc)))
@@ -453,6 +492,17 @@ public:
     return ThisType(*backend_, true, eps);
   }
 
+  /**
+   * \brief Sparse matrix-matrix product, uses the (two pass) sparse product of Eigen instead of the entry-wise product
+   *        of the MatrixInterface.
+   */
+  virtual ThisType operator*(const ThisType& other) const override final
+  {
+    if (other.rows() != cols())
+      DUNE_THROW(XT::Common::Exceptions::shapes_do_not_match, "Dimensions of matrices to be multiplied do not match!");
+    return ThisType(std::make_shared<BackendType>(backend() * other.backend()));
+  }
+
   /// \}
 
   ScalarType* entries()
@@ -493,6 +543,7 @@ public:
 
   using InterfaceType::operator+;
   using InterfaceType::operator-;
+  using InterfaceType::operator*;
   using InterfaceType::operator+=;
   using InterfaceType::operator-=;
 
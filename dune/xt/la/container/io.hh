@@ -12,13 +12,44 @@
 #ifndef DUNE_XT_LA_CONTAINER_IO_HH
 #define DUNE_XT_LA_CONTAINER_IO_HH
 
+#include <algorithm>
+#include <cctype>
+#include <complex>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <iomanip>
+#include <limits>
+#include <numeric>
+#include <string>
 #include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DUNE_XT_LA_CONTAINER_IO_USE_MMAP 1
+#else
+#define DUNE_XT_LA_CONTAINER_IO_USE_MMAP 0
+#endif
+
+#if HAVE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+#include <dune/common/unused.hh>
 
 #include <dune/xt/common/exceptions.hh>
+#include <dune/xt/common/parallel/threadmanager.hh>
 #include <dune/xt/common/string.hh>
+#include <dune/xt/common/type_traits.hh>
 
 #include "matrix-interface.hh"
+#include "pattern.hh"
 #include "vector-interface.hh"
 
 namespace Dune {
@@ -26,21 +57,889 @@ namespace XT {
 namespace LA {
 
 
+// forwards
+template <class ScalarImp, Common::StorageLayout layout, class IndexImp>
+class CommonSparseMatrix;
+
+
+namespace internal {
+
+
+static const constexpr uint32_t binary_container_format_version = 1;
+static const constexpr char binary_matrix_magic[] = "DXTLACSR";
+static const constexpr char binary_vector_magic[] = "DXTLAVEC";
+
+
+/**
+ * \brief Header of the binary format of to_file() and from_file() (mode "binary").
+ *
+ * A matrix is stored in compressed row storage: the header is followed by rows + 1 row pointers and non_zeros column
+ * indices (of index_size bytes each) and, starting at the next multiple of 16 bytes, by the non_zeros values. A vector
+ * is stored as its values only (rows = non_zeros = size, cols = 1). All numbers are stored in the byte order of the
+ * machine which wrote the file.
+ */
+struct BinaryContainerHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t scalar_size;
+  uint32_t scalar_is_complex;
+  uint32_t index_size;
+  uint64_t rows;
+  uint64_t cols;
+  uint64_t non_zeros;
+
+  template <class ScalarType>
+  static BinaryContainerHeader
+  create(const char* mgc, const size_t rr, const size_t cc, const size_t nnz, const size_t idx_size)
+  {
+    BinaryContainerHeader header;
+    std::memcpy(header.magic, mgc, 8);
+    header.version = binary_container_format_version;
+    header.scalar_size = sizeof(ScalarType);
+    header.scalar_is_complex = Common::is_complex<ScalarType>::value;
+    header.index_size = static_cast<uint32_t>(idx_size);
+    header.rows = rr;
+    header.cols = cc;
+    header.non_zeros = nnz;
+    return header;
+  }
+
+  //! The offset of the first value in the file.
+  size_t values_offset() const
+  {
+    const size_t indices_end = sizeof(BinaryContainerHeader) + index_size * (rows + 1 + non_zeros);
+    return (index_size == 0) ? sizeof(BinaryContainerHeader) : ((indices_end + 15) / 16) * 16;
+  }
+
+  template <class ScalarType>
+  void check(const char* mgc, const std::string& filename, const size_t file_size) const
+  {
+    if (file_size < sizeof(BinaryContainerHeader) || std::memcmp(magic, mgc, 8) != 0)
+      DUNE_THROW(IOError, "'" << filename << "' is not a binary file written by to_file() for this kind of container!");
+    if (version != binary_container_format_version)
+      DUNE_THROW(IOError,
+                 "'" << filename << "' has version " << version << ", expected " << binary_container_format_version
+                     << "!");
+    if (scalar_size != sizeof(ScalarType) || bool(scalar_is_complex) != Common::is_complex<ScalarType>::value)
+      DUNE_THROW(IOError, "The scalar type stored in '" << filename << "' does not match the one of the container!");
+    const bool is_vector = std::memcmp(mgc, binary_vector_magic, 8) == 0;
+    if (is_vector ? (index_size != 0) : (index_size != 4 && index_size != 8))
+      DUNE_THROW(IOError, "'" << filename << "' has an unsupported index size (" << index_size << ")!");
+    if (is_vector && (rows != non_zeros || cols != 1))
+      DUNE_THROW(IOError, "'" << filename << "' contains a vector of inconsistent size!");
+    // each row pointer and each value takes at least one byte, which bounds the numbers (and prevents the offsets
+    // below from overflowing)
+    if (rows >= file_size || non_zeros >= file_size || file_size < values_offset() + non_zeros * scalar_size)
+      DUNE_THROW(IOError, "'" << filename << "' is truncated!");
+  } // ... check(...)
+}; // struct BinaryContainerHeader
+
+
+/**
+ * \brief Read-only view of the contents of a file, memory mapped where available (read into memory otherwise).
+ */
+class ReadOnlyFileMapping
+{
+public:
+  explicit ReadOnlyFileMapping(const std::string& filename)
+  {
+#if DUNE_XT_LA_CONTAINER_IO_USE_MMAP
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+      DUNE_THROW(IOError, "Could not open '" << filename << "' for reading!");
+    struct stat file_status;
+    if (::fstat(fd, &file_status) != 0) {
+      ::close(fd);
+      DUNE_THROW(IOError, "Could not determine the size of '" << filename << "'!");
+    }
+    size_ = static_cast<size_t>(file_status.st_size);
+    if (size_ > 0) {
+      mapping_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      ::close(fd);
+      if (mapping_ == MAP_FAILED) {
+        mapping_ = nullptr;
+        DUNE_THROW(IOError, "Could not map '" << filename << "' into memory!");
+      }
+      ::posix_madvise(mapping_, size_, POSIX_MADV_SEQUENTIAL);
+      data_ = static_cast<const char*>(mapping_);
+    } else
+      ::close(fd);
+#else // DUNE_XT_LA_CONTAINER_IO_USE_MMAP
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+      DUNE_THROW(IOError, "Could not open '" << filename << "' for reading!");
+    buffer_.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(buffer_.data(), buffer_.size());
+    size_ = buffer_.size();
+    data_ = buffer_.data();
+#endif // DUNE_XT_LA_CONTAINER_IO_USE_MMAP
+  } // ReadOnlyFileMapping(...)
+
+  ReadOnlyFileMapping(const ReadOnlyFileMapping&) = delete;
+  ReadOnlyFileMapping& operator=(const ReadOnlyFileMapping&) = delete;
+
+  ~ReadOnlyFileMapping()
+  {
+#if DUNE_XT_LA_CONTAINER_IO_USE_MMAP
+    if (mapping_ != nullptr)
+      ::munmap(mapping_, size_);
+#endif
+  }
+
+  const char* data() const
+  {
+    return data_;
+  }
+
+  size_t size() const
+  {
+    return size_;
+  }
+
+private:
+  size_t size_ = 0;
+  const char* data_ = nullptr;
+#if DUNE_XT_LA_CONTAINER_IO_USE_MMAP
+  void* mapping_ = nullptr;
+#else
+  std::vector<char> buffer_;
+#endif
+}; // class ReadOnlyFileMapping
+
+
+template <class ScalarType>
+BinaryContainerHeader
+read_binary_header(const ReadOnlyFileMapping& file, const char* magic, const std::string& filename)
+{
+  BinaryContainerHeader header = {};
+  if (file.size() >= sizeof(header))
+    std::memcpy(&header, file.data(), sizeof(header));
+  header.template check<ScalarType>(magic, filename, file.size());
+  return header;
+}
+
+
+//! Copies count indices of size index_size (4 or 8) from source, converting them to IndexType if required.
+template <class IndexType>
+void copy_binary_indices(const char* source,
+                         const size_t index_size,
+                         const size_t count,
+                         std::vector<IndexType>& target)
+{
+  target.resize(count);
+  if (index_size == sizeof(IndexType)) {
+    std::memcpy(target.data(), source, count * sizeof(IndexType));
+    return;
+  }
+  for (size_t ii = 0; ii < count; ++ii) {
+    uint64_t index;
+    if (index_size == 4) {
+      uint32_t index_32;
+      std::memcpy(&index_32, source + 4 * ii, 4);
+      index = index_32;
+    } else
+      std::memcpy(&index, source + 8 * ii, 8);
+    if (index > uint64_t(std::numeric_limits<IndexType>::max()))
+      DUNE_THROW(IOError, "The index " << index << " does not fit into the index type of the matrix!");
+    target[ii] = static_cast<IndexType>(index);
+  }
+} // ... copy_binary_indices(...)
+
+
+/**
+ * \brief Reads the row pointers and column indices of a matrix, extended by empty rows up to the given number of rows.
+ *
+ * The file need not have been written by to_file(), so the arrays are checked in one pass before they are used: the
+ * row pointers have to be non-decreasing from 0 to non_zeros and the column indices of each row sorted, unique and
+ * smaller than cols (in particular, there are no entries if cols is 0).
+ */
+template <class IndexType>
+void read_binary_pattern(const ReadOnlyFileMapping& file,
+                         const BinaryContainerHeader& header,
+                         const size_t rows,
+                         std::vector<IndexType>& row_pointers,
+                         std::vector<IndexType>& column_indices)
+{
+  const char* indices = file.data() + sizeof(BinaryContainerHeader);
+  copy_binary_indices(indices, header.index_size, header.rows + 1, row_pointers);
+  copy_binary_indices(
+      indices + header.index_size * (header.rows + 1), header.index_size, header.non_zeros, column_indices);
+  if (size_t(row_pointers.front()) != 0 || size_t(row_pointers.back()) != header.non_zeros)
+    DUNE_THROW(IOError, "The row pointers do not match the number of non-zeros!");
+  for (size_t ii = 0; ii < header.rows; ++ii) {
+    const size_t row_begin = row_pointers[ii];
+    const size_t row_end = row_pointers[ii + 1];
+    if (row_begin > row_end || row_end > header.non_zeros)
+      DUNE_THROW(IOError, "The row pointers are not non-decreasing in row " << ii << "!");
+    for (size_t kk = row_begin; kk < row_end; ++kk)
+      if (size_t(column_indices[kk]) >= header.cols || (kk > row_begin && column_indices[kk - 1] >= column_indices[kk]))
+        DUNE_THROW(IOError,
+                   "The column indices of row " << ii << " are not sorted, not unique or not smaller than the number "
+                                                << "of columns (" << header.cols << ")!");
+  }
+  row_pointers.resize(rows + 1, row_pointers.back());
+} // ... read_binary_pattern(...)
+
+
+template <class IndexType, class ScalarType>
+void write_binary_matrix(const std::string& filename,
+                         const size_t rows,
+                         const size_t cols,
+                         const IndexType* row_pointers,
+                         const IndexType* column_indices,
+                         const ScalarType* values)
+{
+  std::ofstream file(filename, std::ios::binary);
+  if (!file.is_open())
+    DUNE_THROW(IOError, "Could not open '" << filename << "' for writing!");
+  const size_t nnz = row_pointers[rows];
+  const auto header =
+      BinaryContainerHeader::create<ScalarType>(binary_matrix_magic, rows, cols, nnz, sizeof(IndexType));
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(row_pointers), (rows + 1) * sizeof(IndexType));
+  file.write(reinterpret_cast<const char*>(column_indices), nnz * sizeof(IndexType));
+  const char padding[16] = {};
+  file.write(padding, header.values_offset() - sizeof(header) - (rows + 1 + nnz) * sizeof(IndexType));
+  file.write(reinterpret_cast<const char*>(values), nnz * sizeof(ScalarType));
+  if (!file.good())
+    DUNE_THROW(IOError, "Could not write '" << filename << "'!");
+} // ... write_binary_matrix(...)
+
+
+//! Writes and reads arbitrary matrices in the binary format, entry by entry.
+template <class MatrixType>
+struct BinaryMatrixIo
+{
+  using ScalarType = typename MatrixType::ScalarType;
+
+  static void write(const MatrixType& matrix, const std::string& filename)
+  {
+    const SparsityPatternCompressed<size_t> pattern(matrix.pattern());
+    const auto& row_pointers = pattern.row_offsets();
+    const auto& column_indices = pattern.column_indices();
+    std::vector<ScalarType> values(pattern.non_zeros());
+    for (size_t ii = 0; ii < pattern.size(); ++ii)
+      for (size_t kk = row_pointers[ii]; kk < row_pointers[ii + 1]; ++kk)
+        values[kk] = matrix.get_entry(ii, column_indices[kk]);
+    write_binary_matrix(filename,
+                        pattern.size(),
+                        matrix.cols(),
+                        row_pointers.data(),
+                        column_indices.data(),
+                        values.data());
+  } // ... write(...)
+
+  static MatrixType read(const ReadOnlyFileMapping& file,
+                         const BinaryContainerHeader& header,
+                         const size_t rows,
+                         const size_t cols)
+  {
+    std::vector<size_t> row_pointers, column_indices;
+    read_binary_pattern(file, header, rows, row_pointers, column_indices);
+    const SparsityPatternCompressed<size_t> pattern(std::move(row_pointers), std::move(column_indices));
+    MatrixType matrix(rows, cols, pattern);
+    const char* values = file.data() + header.values_offset();
+    ScalarType value;
+    for (size_t ii = 0; ii < header.rows; ++ii)
+      for (size_t kk = pattern.row_offsets()[ii]; kk < pattern.row_offsets()[ii + 1]; ++kk) {
+        std::memcpy(&value, values + kk * sizeof(ScalarType), sizeof(ScalarType));
+        matrix.set_entry(ii, pattern.column_indices()[kk], value);
+      }
+    return matrix;
+  } // ... read(...)
+}; // struct BinaryMatrixIo
+
+
+//! Writes the arrays of a CommonSparseMatrix in compressed row storage directly and adopts the arrays when reading.
+template <class S, class I>
+struct BinaryMatrixIo<CommonSparseMatrix<S, Common::StorageLayout::csr, I>>
+{
+  using MatrixType = CommonSparseMatrix<S, Common::StorageLayout::csr, I>;
+
+  static void write(const MatrixType& matrix, const std::string& filename)
+  {
+    write_binary_matrix(filename,
+                        matrix.rows(),
+                        matrix.cols(),
+                        matrix.outer_index_ptr(),
+                        matrix.inner_index_ptr(),
+                        matrix.entries());
+  }
+
+  static MatrixType read(const ReadOnlyFileMapping& file,
+                         const BinaryContainerHeader& header,
+                         const size_t rows,
+                         const size_t cols)
+  {
+    std::vector<I> row_pointers, column_indices;
+    read_binary_pattern(file, header, rows, row_pointers, column_indices);
+    MatrixType matrix(rows, cols, SparsityPatternCompressed<I>(std::move(row_pointers), std::move(column_indices)));
+    // if there are entries, rows and cols are positive (see read_binary_pattern()), so the matrix has adopted them
+    if (header.non_zeros > 0)
+      std::memcpy(matrix.entries(), file.data() + header.values_offset(), header.non_zeros * sizeof(S));
+    return matrix;
+  }
+}; // struct BinaryMatrixIo<CommonSparseMatrix<..., csr, ...>>
+
+
+//! Default size of a Matrix Market file (in bytes) from which on its entries are parsed in parallel.
+static const constexpr size_t matrix_market_parallel_threshold = 1 << 20;
+
+
+template <class FunctorType>
+void for_each_io_chunk(const size_t num_chunks, const FunctorType& functor)
+{
+#if HAVE_TBB
+  if (num_chunks > 1) {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_chunks, 1), [&](const tbb::blocked_range<size_t>& range) {
+      for (size_t pp = range.begin(); pp != range.end(); ++pp)
+        functor(pp);
+    });
+    return;
+  }
+#endif
+  for (size_t pp = 0; pp < num_chunks; ++pp)
+    functor(pp);
+} // ... for_each_io_chunk(...)
+
+
+template <class ScalarType>
+struct MatrixMarketEntry
+{
+  size_t row;
+  size_t col;
+  ScalarType value;
+};
+
+
+template <class ScalarType, bool is_complex = Common::is_complex<ScalarType>::value>
+struct MatrixMarketScalar
+{
+  static ScalarType create(const double real, const double /*imag*/)
+  {
+    return ScalarType(real);
+  }
+
+  static ScalarType conj(const ScalarType& value)
+  {
+    return value;
+  }
+
+  static void write(std::ostream& out, const ScalarType& value)
+  {
+    out << value;
+  }
+}; // struct MatrixMarketScalar<..., false>
+
+template <class ScalarType>
+struct MatrixMarketScalar<ScalarType, true>
+{
+  static ScalarType create(const double real, const double imag)
+  {
+    return ScalarType(real, imag);
+  }
+
+  static ScalarType conj(const ScalarType& value)
+  {
+    return std::conj(value);
+  }
+
+  static void write(std::ostream& out, const ScalarType& value)
+  {
+    out << value.real() << " " << value.imag();
+  }
+}; // struct MatrixMarketScalar<..., true>
+
+
+/**
+ * \brief Reads the header of a Matrix Market file (http://math.nist.gov/MatrixMarket/formats.html) and parses its
+ *        entries.
+ *
+ * Coordinate files are split into num_threads() byte ranges (at line ends), which are parsed in parallel (requires
+ * TBB), array files are parsed serially. The entries of symmetric, skew-symmetric and hermitian files are mirrored.
+ */
+template <class ScalarType>
+class MatrixMarketReader
+{
+  enum class Field
+  {
+    real,
+    integer,
+    complex,
+    pattern
+  };
+
+  enum class Symmetry
+  {
+    general,
+    symmetric,
+    skew_symmetric,
+    hermitian
+  };
+
+public:
+  using EntryType = MatrixMarketEntry<ScalarType>;
+  using EntryChunksType = std::vector<std::vector<EntryType>>;
+
+  explicit MatrixMarketReader(const std::string& filename)
+    : filename_(filename)
+    , file_(filename)
+  {
+    const char* pos = file_.data();
+    const char* const end = file_.data() + file_.size();
+    const auto banner = tokenize_line(pos, end);
+    if (banner.size() != 5 || banner[0] != "%%matrixmarket" || banner[1] != "matrix")
+      DUNE_THROW(IOError, "'" << filename_ << "' does not start with '%%MatrixMarket matrix'!");
+    if (banner[2] == "coordinate")
+      coordinate_ = true;
+    else if (banner[2] == "array")
+      coordinate_ = false;
+    else
+      DUNE_THROW(IOError, "Unknown Matrix Market format '" << banner[2] << "' in '" << filename_ << "'!");
+    if (banner[3] == "real")
+      field_ = Field::real;
+    else if (banner[3] == "integer")
+      field_ = Field::integer;
+    else if (banner[3] == "complex")
+      field_ = Field::complex;
+    else if (banner[3] == "pattern" && coordinate_)
+      field_ = Field::pattern;
+    else
+      DUNE_THROW(IOError, "Unsupported Matrix Market field '" << banner[3] << "' in '" << filename_ << "'!");
+    if (field_ == Field::complex && !Common::is_complex<ScalarType>::value)
+      DUNE_THROW(IOError, "'" << filename_ << "' contains complex values, which do not fit into the container!");
+    if (banner[4] == "general")
+      symmetry_ = Symmetry::general;
+    else if (banner[4] == "symmetric")
+      symmetry_ = Symmetry::symmetric;
+    else if (banner[4] == "skew-symmetric")
+      symmetry_ = Symmetry::skew_symmetric;
+    else if (banner[4] == "hermitian")
+      symmetry_ = Symmetry::hermitian;
+    else
+      DUNE_THROW(IOError, "Unknown Matrix Market symmetry '" << banner[4] << "' in '" << filename_ << "'!");
+    std::vector<std::string> sizes;
+    while (pos != end && sizes.empty()) {
+      if (*pos == '%')
+        pos = line_end(pos, end);
+      else
+        sizes = tokenize_line(pos, end);
+    }
+    if (sizes.size() != (coordinate_ ? 3 : 2))
+      DUNE_THROW(IOError, "'" << filename_ << "' does not contain a valid size line!");
+    rows_ = parse_index(sizes[0].data(), sizes[0].data() + sizes[0].size());
+    cols_ = parse_index(sizes[1].data(), sizes[1].data() + sizes[1].size());
+    num_entries_ = coordinate_ ? parse_index(sizes[2].data(), sizes[2].data() + sizes[2].size()) : 0;
+    if (symmetry_ != Symmetry::general && rows_ != cols_)
+      DUNE_THROW(IOError, "'" << filename_ << "' is " << banner[4] << " but not square!");
+    body_begin_ = pos;
+  } // MatrixMarketReader(...)
+
+  size_t rows() const
+  {
+    return rows_;
+  }
+
+  size_t cols() const
+  {
+    return cols_;
+  }
+
+  //! The number of threads entries() uses by default, 1 for small files or without TBB.
+  size_t num_threads(const size_t threshold = matrix_market_parallel_threshold) const
+  {
+#if HAVE_TBB
+    if (!coordinate_ || file_.size() < threshold)
+      return 1;
+    return std::max(size_t(1), size_t(Common::threadManager().max_threads()));
+#else
+    DUNE_UNUSED_PARAMETER(threshold);
+    return 1;
+#endif
+  } // ... num_threads(...)
+
+  //! The entries of the matrix (with 0-based indices), in one chunk per thread.
+  EntryChunksType entries(const size_t threads) const
+  {
+    const char* const end = file_.data() + file_.size();
+    if (!coordinate_) {
+      EntryChunksType chunks(1);
+      parse_array(body_begin_, end, chunks[0]);
+      return chunks;
+    }
+    const size_t num_chunks = std::max(size_t(1), threads);
+    std::vector<const char*> chunk_begins(num_chunks + 1, end);
+    chunk_begins[0] = body_begin_;
+    const size_t body_size = end - body_begin_;
+    for (size_t pp = 1; pp < num_chunks; ++pp)
+      chunk_begins[pp] = line_end(std::max(chunk_begins[pp - 1], body_begin_ + pp * body_size / num_chunks), end);
+    EntryChunksType chunks(num_chunks);
+    std::vector<size_t> num_entries(num_chunks, 0);
+    for_each_io_chunk(num_chunks, [&](const size_t pp) {
+      num_entries[pp] = parse_coordinates(chunk_begins[pp], chunk_begins[pp + 1], chunks[pp]);
+    });
+    if (std::accumulate(num_entries.begin(), num_entries.end(), size_t(0)) != num_entries_)
+      DUNE_THROW(IOError, "'" << filename_ << "' does not contain " << num_entries_ << " entries!");
+    return chunks;
+  } // ... entries(...)
+
+private:
+  // returns the position after the next line break (or end)
+  static const char* line_end(const char* pos, const char* end)
+  {
+    const void* line_break = std::memchr(pos, '\n', end - pos);
+    return (line_break == nullptr) ? end : static_cast<const char*>(line_break) + 1;
+  }
+
+  static bool is_blank(const char cc)
+  {
+    return cc == ' ' || cc == '\t' || cc == '\r' || cc == '\n';
+  }
+
+  // returns the lower case tokens of the line starting at pos and moves pos to the next line
+  static std::vector<std::string> tokenize_line(const char*& pos, const char* end)
+  {
+    const char* const next_line = line_end(pos, end);
+    std::vector<std::string> tokens;
+    while (pos != next_line) {
+      while (pos != next_line && is_blank(*pos))
+        ++pos;
+      const char* const token_begin = pos;
+      while (pos != next_line && !is_blank(*pos))
+        ++pos;
+      if (pos != token_begin) {
+        tokens.emplace_back(token_begin, pos);
+        for (auto& cc : tokens.back())
+          cc = static_cast<char>(std::tolower(static_cast<unsigned char>(cc)));
+      }
+    }
+    return tokens;
+  } // ... tokenize_line(...)
+
+  // moves [token_begin, pos) to the next token before end, skipping blanks and comment lines
+  static bool next_token(const char*& token_begin, const char*& pos, const char* end)
+  {
+    while (pos != end && (is_blank(*pos) || *pos == '%')) {
+      if (*pos == '%')
+        pos = line_end(pos, end);
+      else
+        ++pos;
+    }
+    token_begin = pos;
+    while (pos != end && !is_blank(*pos))
+      ++pos;
+    return pos != token_begin;
+  } // ... next_token(...)
+
+  size_t parse_index(const char* begin, const char* end) const
+  {
+    if (begin == end)
+      DUNE_THROW(IOError, "Encountered an empty index in '" << filename_ << "'!");
+    size_t ret = 0;
+    for (const char* pos = begin; pos != end; ++pos) {
+      if (*pos < '0' || *pos > '9')
+        DUNE_THROW(IOError,
+                   "Encountered an invalid index '" << std::string(begin, end) << "' in '" << filename_ << "'!");
+      ret = 10 * ret + size_t(*pos - '0');
+    }
+    return ret;
+  } // ... parse_index(...)
+
+  double parse_real(const char* begin, const char* end) const
+  {
+    // the mapped file is not null terminated, strtod requires a copy of the token
+    char buffer[64];
+    const size_t length = end - begin;
+    if (length == 0 || length >= sizeof(buffer))
+      DUNE_THROW(IOError, "Encountered an invalid value '" << std::string(begin, end) << "' in '" << filename_ << "'!");
+    std::memcpy(buffer, begin, length);
+    buffer[length] = '\0';
+    char* parsed_end = nullptr;
+    const double ret = std::strtod(buffer, &parsed_end);
+    if (parsed_end != buffer + length)
+      DUNE_THROW(IOError, "Encountered an invalid value '" << std::string(begin, end) << "' in '" << filename_ << "'!");
+    return ret;
+  } // ... parse_real(...)
+
+  ScalarType parse_value(const char*& pos, const char* end) const
+  {
+    if (field_ == Field::pattern)
+      return ScalarType(1);
+    const char* token_begin = pos;
+    if (!next_token(token_begin, pos, end))
+      DUNE_THROW(IOError, "'" << filename_ << "' ends within an entry!");
+    const double real = parse_real(token_begin, pos);
+    double imag = 0.;
+    if (field_ == Field::complex) {
+      if (!next_token(token_begin, pos, end))
+        DUNE_THROW(IOError, "'" << filename_ << "' ends within an entry!");
+      imag = parse_real(token_begin, pos);
+    }
+    return MatrixMarketScalar<ScalarType>::create(real, imag);
+  } // ... parse_value(...)
+
+  void add_entry(const size_t ii, const size_t jj, const ScalarType& value, std::vector<EntryType>& entries) const
+  {
+    entries.push_back({ii, jj, value});
+    if (ii == jj || symmetry_ == Symmetry::general)
+      return;
+    if (symmetry_ == Symmetry::symmetric)
+      entries.push_back({jj, ii, value});
+    else if (symmetry_ == Symmetry::skew_symmetric)
+      entries.push_back({jj, ii, ScalarType(-value)});
+    else
+      entries.push_back({jj, ii, MatrixMarketScalar<ScalarType>::conj(value)});
+  } // ... add_entry(...)
+
+  // returns the number of entries in the file (without the mirrored ones)
+  size_t parse_coordinates(const char* pos, const char* end, std::vector<EntryType>& entries) const
+  {
+    // guess the number of entries from the length of the first line
+    const char* const first_line_end = line_end(pos, end);
+    if (first_line_end > pos)
+      entries.reserve((symmetry_ == Symmetry::general ? 1 : 2) * ((end - pos) / (first_line_end - pos) + 1));
+    size_t num_entries = 0;
+    const char* token_begin = pos;
+    while (next_token(token_begin, pos, end)) {
+      const size_t ii = parse_index(token_begin, pos);
+      if (!next_token(token_begin, pos, end))
+        DUNE_THROW(IOError, "'" << filename_ << "' ends within an entry!");
+      const size_t jj = parse_index(token_begin, pos);
+      if (ii == 0 || ii > rows_ || jj == 0 || jj > cols_)
+        DUNE_THROW(IOError,
+                   "The entry (" << ii << ", " << jj << ") in '" << filename_ << "' does not fit into a " << rows_
+                                 << "x" << cols_ << " matrix!");
+      add_entry(ii - 1, jj - 1, parse_value(pos, end), entries);
+      ++num_entries;
+    }
+    return num_entries;
+  } // ... parse_coordinates(...)
+
+  // the entries are stored column by column, only the lower triangular part of symmetric matrices
+  void parse_array(const char* pos, const char* end, std::vector<EntryType>& entries) const
+  {
+    entries.reserve(rows_ * cols_);
+    for (size_t jj = 0; jj < cols_; ++jj) {
+      size_t first_row = 0;
+      if (symmetry_ == Symmetry::skew_symmetric)
+        first_row = jj + 1;
+      else if (symmetry_ != Symmetry::general)
+        first_row = jj;
+      for (size_t ii = first_row; ii < rows_; ++ii)
+        add_entry(ii, jj, parse_value(pos, end), entries);
+    }
+    const char* token_begin = pos;
+    if (next_token(token_begin, pos, end))
+      DUNE_THROW(IOError, "'" << filename_ << "' contains more entries than expected!");
+  } // ... parse_array(...)
+
+  const std::string filename_;
+  const ReadOnlyFileMapping file_;
+  bool coordinate_;
+  Field field_;
+  Symmetry symmetry_;
+  size_t rows_;
+  size_t cols_;
+  size_t num_entries_;
+  const char* body_begin_;
+}; // class MatrixMarketReader
+
+
+/**
+ * \brief Sorts entries into compressed row arrays (with rows rows), the values of duplicate entries are summed up.
+ *
+ * The entries are distributed to their rows by a counting sort, the rows are then sorted in parallel by column
+ * (requires TBB, one part of the rows per thread) and merged.
+ */
+template <class IndexType, class ScalarType>
+void entries_to_compressed_rows(const size_t rows,
+                                const std::vector<std::vector<MatrixMarketEntry<ScalarType>>>& chunks,
+                                const size_t threads,
+                                std::vector<IndexType>& row_pointers,
+                                std::vector<IndexType>& column_indices,
+                                std::vector<ScalarType>& values)
+{
+  std::vector<size_t> offsets(rows + 1, 0);
+  for (const auto& chunk : chunks)
+    for (const auto& entry : chunk)
+      ++offsets[entry.row + 1];
+  for (size_t ii = 0; ii < rows; ++ii)
+    offsets[ii + 1] += offsets[ii];
+  if (offsets[rows] > size_t(std::numeric_limits<IndexType>::max()))
+    DUNE_THROW(IOError, "The matrix has too many entries for the index type of the container!");
+  std::vector<std::pair<size_t, ScalarType>> row_entries(offsets[rows]);
+  std::vector<size_t> next_position(offsets.begin(), offsets.end() - 1);
+  for (const auto& chunk : chunks)
+    for (const auto& entry : chunk)
+      row_entries[next_position[entry.row]++] = std::make_pair(entry.col, entry.value);
+  const size_t num_parts = std::max(size_t(1), std::min(threads, rows));
+  for_each_io_chunk(num_parts, [&](const size_t pp) {
+    for (size_t ii = pp * rows / num_parts; ii < (pp + 1) * rows / num_parts; ++ii)
+      std::sort(row_entries.begin() + offsets[ii],
+                row_entries.begin() + offsets[ii + 1],
+                [](const std::pair<size_t, ScalarType>& lhs, const std::pair<size_t, ScalarType>& rhs) {
+                  return lhs.first < rhs.first;
+                });
+  });
+  row_pointers.assign(rows + 1, 0);
+  column_indices.clear();
+  column_indices.reserve(row_entries.size());
+  values.clear();
+  values.reserve(row_entries.size());
+  for (size_t ii = 0; ii < rows; ++ii) {
+    for (size_t kk = offsets[ii]; kk < offsets[ii + 1]; ++kk) {
+      if (kk > offsets[ii] && row_entries[kk].first == row_entries[kk - 1].first)
+        values.back() += row_entries[kk].second;
+      else {
+        column_indices.push_back(static_cast<IndexType>(row_entries[kk].first));
+        values.push_back(row_entries[kk].second);
+      }
+    }
+    row_pointers[ii + 1] = static_cast<IndexType>(column_indices.size());
+  }
+} // ... entries_to_compressed_rows(...)
+
+
+//! Creates arbitrary matrices from compressed row arrays, entry by entry.
+template <class MatrixType>
+struct CompressedRowsToMatrix
+{
+  using IndexType = size_t;
+  using ScalarType = typename MatrixType::ScalarType;
+
+  static MatrixType create(const size_t rows,
+                           const size_t cols,
+                           std::vector<IndexType>&& row_pointers,
+                           std::vector<IndexType>&& column_indices,
+                           const ScalarType* values)
+  {
+    const SparsityPatternCompressed<IndexType> pattern(std::move(row_pointers), std::move(column_indices));
+    MatrixType matrix(rows, cols, pattern);
+    for (size_t ii = 0; ii < pattern.size(); ++ii)
+      for (size_t kk = pattern.row_offsets()[ii]; kk < pattern.row_offsets()[ii + 1]; ++kk)
+        matrix.set_entry(ii, pattern.column_indices()[kk], values[kk]);
+    return matrix;
+  }
+}; // struct CompressedRowsToMatrix
+
+
+//! Adopts the arrays for a CommonSparseMatrix in compressed row storage.
+template <class S, class I>
+struct CompressedRowsToMatrix<CommonSparseMatrix<S, Common::StorageLayout::csr, I>>
+{
+  using IndexType = I;
+  using MatrixType = CommonSparseMatrix<S, Common::StorageLayout::csr, I>;
+
+  static MatrixType create(const size_t rows,
+                           const size_t cols,
+                           std::vector<IndexType>&& row_pointers,
+                           std::vector<IndexType>&& column_indices,
+                           const S* values)
+  {
+    MatrixType matrix(rows, cols, SparsityPatternCompressed<I>(std::move(row_pointers), std::move(column_indices)));
+    std::copy(values, values + matrix.non_zeros(), matrix.entries());
+    return matrix;
+  }
+}; // struct CompressedRowsToMatrix<CommonSparseMatrix<..., csr, ...>>
+
+
+template <class MatrixType>
+MatrixType read_matrix_market(const std::string& filename, const ssize_t min_rows, const ssize_t min_cols)
+{
+  using IndexType = typename CompressedRowsToMatrix<MatrixType>::IndexType;
+  using ScalarType = typename MatrixType::ScalarType;
+  const MatrixMarketReader<ScalarType> reader(filename);
+  const size_t threads = reader.num_threads();
+  const size_t rows = std::max(min_rows, ssize_t(reader.rows()));
+  const size_t cols = std::max(min_cols, ssize_t(reader.cols()));
+  std::vector<IndexType> row_pointers, column_indices;
+  std::vector<ScalarType> values;
+  entries_to_compressed_rows(rows, reader.entries(threads), threads, row_pointers, column_indices, values);
+  return CompressedRowsToMatrix<MatrixType>::create(
+      rows, cols, std::move(row_pointers), std::move(column_indices), values.data());
+} // ... read_matrix_market(...)
+
+
+/**
+ * \brief Writes a matrix in the Matrix Market coordinate format (or in the array format, if requested).
+ *
+ * Symmetric matrices are detected and written as such, i.e. only their lower triangular part.
+ */
+template <class MatrixType>
+void write_matrix_market(const MatrixType& matrix, const std::string& filename, const bool array)
+{
+  using ScalarType = typename MatrixType::ScalarType;
+  const SparsityPatternCompressed<size_t> pattern(matrix.pattern());
+  const auto& row_pointers = pattern.row_offsets();
+  const auto& column_indices = pattern.column_indices();
+  bool symmetric = (matrix.rows() == matrix.cols());
+  for (size_t ii = 0; ii < pattern.size() && symmetric; ++ii)
+    for (size_t kk = row_pointers[ii]; kk < row_pointers[ii + 1] && symmetric; ++kk) {
+      const size_t jj = column_indices[kk];
+      symmetric = (jj == ii) || (pattern.contains(jj, ii) && matrix.get_entry(ii, jj) == matrix.get_entry(jj, ii));
+    }
+  std::ofstream file(filename);
+  if (!file.is_open())
+    DUNE_THROW(IOError, "Could not open '" << filename << "' for writing!");
+  file << "%%MatrixMarket matrix " << (array ? "array " : "coordinate ")
+       << (Common::is_complex<ScalarType>::value ? "complex " : "real ") << (symmetric ? "symmetric" : "general")
+       << "\n";
+  file << std::scientific << std::setprecision(std::numeric_limits<double>::max_digits10 - 1);
+  if (array) {
+    file << matrix.rows() << " " << matrix.cols() << "\n";
+    for (size_t jj = 0; jj < matrix.cols(); ++jj)
+      for (size_t ii = symmetric ? jj : 0; ii < matrix.rows(); ++ii) {
+        MatrixMarketScalar<ScalarType>::write(file, matrix.get_entry(ii, jj));
+        file << "\n";
+      }
+  } else {
+    size_t num_entries = 0;
+    for (size_t ii = 0; ii < pattern.size(); ++ii)
+      for (size_t kk = row_pointers[ii]; kk < row_pointers[ii + 1]; ++kk)
+        num_entries += (!symmetric || column_indices[kk] <= ii);
+    file << matrix.rows() << " " << matrix.cols() << " " << num_entries << "\n";
+    for (size_t ii = 0; ii < pattern.size(); ++ii)
+      for (size_t kk = row_pointers[ii]; kk < row_pointers[ii + 1]; ++kk)
+        if (!symmetric || column_indices[kk] <= ii) {
+          file << ii + 1 << " " << column_indices[kk] + 1 << " ";
+          MatrixMarketScalar<ScalarType>::write(file, matrix.get_entry(ii, column_indices[kk]));
+          file << "\n";
+        }
+  }
+  if (!file.good())
+    DUNE_THROW(IOError, "Could not write '" << filename << "'!");
+} // ... write_matrix_market(...)
+
+
+} // namespace internal
+
+
 template <class M>
 void to_file(const MatrixInterface<M>& matrix, const std::string& filename, const std::string& mode = "ascii")
 {
   if (filename.empty())
     DUNE_THROW(Common::Exceptions::wrong_input_given, "'filename' must not be empty!");
+  if (mode == "binary") {
+    internal::BinaryMatrixIo<M>::write(matrix.as_imp(), filename);
+    return;
+  }
+  if (mode == "matrix-market" || mode == "matrix-market-array") {
+    internal::write_matrix_market(matrix.as_imp(), filename, mode == "matrix-market-array");
+    return;
+  }
   if (mode != "ascii")
-    DUNE_THROW(NotImplemented, "Currently, only 'ascii' is implemented!");
+    DUNE_THROW(NotImplemented,
+               "Currently, only 'ascii', 'binary', 'matrix-market' and 'matrix-market-array' are implemented!");
   std::ofstream file(filename);
   if (!file.is_open())
     DUNE_THROW(IOError, "Could not open '" << filename << "' for writing!");
+  file << std::scientific << std::setprecision(15);
   const auto pattern = matrix.pattern();
   for (size_t ii = 0; ii < pattern.size(); ++ii)
     for (const auto& jj : pattern.inner(ii))
-      file << ii << " " << jj << " " << std::scientific << std::setprecision(15) << matrix.get_entry(ii, jj)
-           << std::endl;
+      file << ii << " " << jj << " " << matrix.get_entry(ii, jj) << "\n";
 } // ... to_file(...)
 
 
@@ -49,13 +948,45 @@ void to_file(const VectorInterface<V>& vector, const std::string& filename, cons
 {
   if (filename.empty())
     DUNE_THROW(Common::Exceptions::wrong_input_given, "'filename' must not be empty!");
+  typedef typename V::ScalarType R;
+  if (mode == "binary") {
+    std::vector<R> values(vector.size());
+    for (size_t ii = 0; ii < vector.size(); ++ii)
+      values[ii] = vector[ii];
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open())
+      DUNE_THROW(IOError, "Could not open '" << filename << "' for writing!");
+    const auto header = internal::BinaryContainerHeader::create<R>(
+        internal::binary_vector_magic, vector.size(), 1, vector.size(), 0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(R));
+    if (!file.good())
+      DUNE_THROW(IOError, "Could not write '" << filename << "'!");
+    return;
+  }
+  if (mode == "matrix-market") {
+    std::ofstream file(filename);
+    if (!file.is_open())
+      DUNE_THROW(IOError, "Could not open '" << filename << "' for writing!");
+    file << "%%MatrixMarket matrix array " << (Common::is_complex<R>::value ? "complex" : "real") << " general\n"
+         << vector.size() << " 1\n";
+    file << std::scientific << std::setprecision(std::numeric_limits<double>::max_digits10 - 1);
+    for (size_t ii = 0; ii < vector.size(); ++ii) {
+      internal::MatrixMarketScalar<R>::write(file, vector[ii]);
+      file << "\n";
+    }
+    if (!file.good())
+      DUNE_THROW(IOError, "Could not write '" << filename << "'!");
+    return;
+  }
   if (mode != "ascii")
-    DUNE_THROW(NotImplemented, "Currently, only 'ascii' is implemented!");
+    DUNE_THROW(NotImplemented, "Currently, only 'ascii', 'binary' and 'matrix-market' are implemented!");
   std::ofstream file(filename);
   if (!file.is_open())
     DUNE_THROW(IOError, "Could not open '" << filename << "' for writing!");
+  file << std::scientific << std::setprecision(15);
   for (size_t ii = 0; ii < vector.size(); ++ii)
-    file << ii << " " << std::scientific << std::setprecision(15) << vector[ii] << std::endl;
+    file << ii << " " << vector[ii] << "\n";
 } // ... to_file(...)
 
 
@@ -67,14 +998,23 @@ typename std::enable_if<is_matrix<M>::value, M>::type from_file(const std::strin
 {
   if (filename.empty())
     DUNE_THROW(Common::Exceptions::wrong_input_given, "Given filename must not be empty!");
+  typedef typename M::ScalarType R;
+  if (mode == "binary") {
+    const internal::ReadOnlyFileMapping mapping(filename);
+    const auto header = internal::read_binary_header<R>(mapping, internal::binary_matrix_magic, filename);
+    const size_t matrix_rows = std::max(min_rows, ssize_t(header.rows));
+    const size_t matrix_cols = std::max(min_cols, ssize_t(header.cols));
+    return internal::BinaryMatrixIo<M>::read(mapping, header, matrix_rows, matrix_cols);
+  }
+  if (mode == "matrix-market" || mode == "matrix-market-array")
+    return internal::read_matrix_market<M>(filename, min_rows, min_cols);
   if (mode != "ascii")
-    DUNE_THROW(NotImplemented, "Currently, only 'ascii' is implemented!");
+    DUNE_THROW(NotImplemented,
+               "Currently, only 'ascii', 'binary', 'matrix-market' and 'matrix-market-array' are implemented!");
   std::ifstream file(filename);
   if (!file.is_open())
     DUNE_THROW(IOError, "Could not open '" << filename << "' for reading!");
-  typedef typename M::ScalarType R;
   std::vector<std::tuple<size_t, size_t, R>> values;
-  std::set<size_t> rows;
   size_t max_row = 0;
   size_t max_col = 0;
   std::string line;
@@ -87,22 +1027,24 @@ typename std::enable_if<is_matrix<M>::value, M>::type from_file(const std::strin
     auto ii = Common::from_string<size_t>(words[0]);
     auto jj = Common::from_string<size_t>(words[1]);
     auto value = Common::from_string<R>(words[2]);
-    rows.insert(ii);
     max_row = std::max(max_row, ii);
     max_col = std::max(max_col, jj);
     values.emplace_back(std::tuple<size_t, size_t, R>(ii, jj, value));
   }
-  if (rows.size() == 0)
+  if (values.size() == 0)
     DUNE_THROW(IOError, "Given file '" << filename << "' must not be empty!");
   const size_t matrix_rows = std::max(min_rows, ssize_t(max_row) + 1);
   const size_t matrix_cols = std::max(min_cols, ssize_t(max_col) + 1);
-  SparsityPatternDefault pattern(matrix_rows);
-  for (const auto& element : values)
-    pattern.insert(std::get<0>(element), std::get<1>(element));
+  SparsityPatternBuilder pattern_builder(matrix_rows);
+  std::vector<bool> row_has_entries(matrix_rows, false);
+  for (const auto& element : values) {
+    pattern_builder.insert(std::get<0>(element), std::get<1>(element));
+    row_has_entries[std::get<0>(element)] = true;
+  }
   for (size_t ii = 0; ii < matrix_rows; ++ii)
-    if (rows.count(ii) == 0)
-      pattern.insert(ii, 0); // <- ensure at least one entry in each row
-  pattern.sort();
+    if (!row_has_entries[ii])
+      pattern_builder.insert(ii, 0); // <- ensure at least one entry in each row
+  const auto pattern = pattern_builder.finalize();
   M matrix(matrix_rows, matrix_cols, pattern);
   for (const auto& element : values)
     matrix.set_entry(std::get<0>(element), std::get<1>(element), std::get<2>(element));
@@ -116,12 +1058,34 @@ from_file(const std::string& filename, const ssize_t min_size = -1, const std::s
 {
   if (filename.empty())
     DUNE_THROW(Common::Exceptions::wrong_input_given, "Given filename must not be empty!");
+  typedef typename V::ScalarType R;
+  if (mode == "binary") {
+    const internal::ReadOnlyFileMapping mapping(filename);
+    const auto header = internal::read_binary_header<R>(mapping, internal::binary_vector_magic, filename);
+    V vector(std::max(min_size, ssize_t(header.non_zeros)), R(0));
+    const char* values = mapping.data() + header.values_offset();
+    R value;
+    for (size_t ii = 0; ii < header.non_zeros; ++ii) {
+      std::memcpy(&value, values + ii * sizeof(R), sizeof(R));
+      vector[ii] = value;
+    }
+    return vector;
+  }
+  if (mode == "matrix-market") {
+    const internal::MatrixMarketReader<R> reader(filename);
+    if (reader.cols() != 1 && reader.rows() != 1)
+      DUNE_THROW(IOError, "'" << filename << "' contains a " << reader.rows() << "x" << reader.cols() << " matrix!");
+    V vector(std::max(min_size, ssize_t(reader.rows() * reader.cols())), R(0));
+    for (const auto& chunk : reader.entries(reader.num_threads()))
+      for (const auto& entry : chunk)
+        vector[entry.row + entry.col] = entry.value;
+    return vector;
+  }
   if (mode != "ascii")
-    DUNE_THROW(NotImplemented, "Currently, only 'ascii' is implemented!");
+    DUNE_THROW(NotImplemented, "Currently, only 'ascii', 'binary' and 'matrix-market' are implemented!");
   std::ifstream file(filename);
   if (!file.is_open())
     DUNE_THROW(IOError, "Could not open '" << filename << "' for reading!");
-  typedef typename V::ScalarType R;
   std::vector<std::tuple<size_t, R>> values;
   size_t max_size = 0;
   std::string line;
@@ -27,6 +27,7 @@
 
 #include <dune/istl/bvector.hh>
 #include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/matrixmatrix.hh>
 
 #include <dune/xt/common/float_cmp.hh>
 #include <dune/xt/common/math.hh>
@@ -406,6 +407,21 @@ public:
     backend_->operator*=(ScalarType(0));
   } // ... IstlRowMajorSparseMatrix(...)
 
+  template <class PatternIndexType>
+  IstlRowMajorSparseMatrix(const size_t rr,
+                           const size_t cc,
+                           const SparsityPatternCompressed<PatternIndexType>& patt,
+                           const size_t num_mutexes = 1)
+    : mutexes_(std::make_unique<MutexesType>(num_mutexes))
+  {
+    if (patt.size() != rr)
+      DUNE_THROW(Common::Exceptions::shapes_do_not_match,
+                 "The size of the pattern (" << patt.size() << ") does not match the number of rows of this (" << rr
+                                             << ")!");
+    build_sparse_matrix(rr, cc, patt);
+    backend_->operator*=(ScalarType(0));
+  } // ... IstlRowMajorSparseMatrix(...)
+
   explicit IstlRowMajorSparseMatrix(const size_t rr = 0, const size_t cc = 0, const size_t num_mutexes = 1)
     : backend_(new BackendType(rr, cc, BackendType::row_wise))
     , mutexes_(std::make_unique<MutexesType>(num_mutexes))
@@ -592,6 +608,13 @@ public:
     backend()[ii][jj][0][0] += value;
   }
 
+  //! \sa CommonSparseMatrix::atomic_add_to_entry()
+  void atomic_add_to_entry(const size_t ii, const size_t jj, const ScalarType& value)
+  {
+    assert(these_are_valid_indices(ii, jj));
+    internal::atomic_add(backend()[ii][jj][0][0], value);
+  }
+
   void set_entry(const size_t ii, const size_t jj, const ScalarType& value)
   {
     assert(these_are_valid_indices(ii, jj));
@@ -706,10 +729,24 @@ public:
     return ThisType(*backend_, true, eps);
   }
 
+  /**
+   * \brief Sparse matrix-matrix product, uses Dune::matMultMat from dune-istl (which sets up the pattern of the
+   *        product once) instead of the entry-wise product of the MatrixInterface.
+   */
+  virtual ThisType operator*(const ThisType& other) const override final
+  {
+    if (other.rows() != cols())
+      DUNE_THROW(Common::Exceptions::shapes_do_not_match, "Dimensions of matrices to be multiplied do not match!");
+    auto product = std::make_shared<BackendType>();
+    Dune::matMultMat(*product, backend(), other.backend());
+    return ThisType(product);
+  }
+
   /// \}
 
   using InterfaceType::operator+;
   using InterfaceType::operator-;
+  using InterfaceType::operator*;
   using InterfaceType::operator+=;
   using InterfaceType::operator-=;
 
@@ -726,6 +763,20 @@ private:
     backend_->endindices();
   } // ... build_sparse_matrix(...)
 
+  template <class PatternIndexType>
+  void build_sparse_matrix(const size_t rr, const size_t cc, const SparsityPatternCompressed<PatternIndexType>& patt)
+  {
+    for (const auto& col : patt.column_indices())
+      if (size_t(col) >= cc)
+        DUNE_THROW(Common::Exceptions::shapes_do_not_match,
+                   "The pattern contains column " << col << ", which does not match the number of columns of this ("
+                                                  << cc << ")!");
+    backend_ = std::make_shared<BackendType>(rr, cc, patt.non_zeros(), BackendType::row_wise);
+    for (auto row = backend_->createbegin(); row != backend_->createend(); ++row)
+      for (auto it = patt.inner_begin(row.index()); it != patt.inner_end(row.index()); ++it)
+        row.insert(*it);
+  } // ... build_sparse_matrix(...)
+
   SparsityPatternDefault
   pruned_pattern_from_backend(const BackendType& mat,
                               const typename Common::FloatCmp::DefaultEpsilon<ScalarType>::Type eps =
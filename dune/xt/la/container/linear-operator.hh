@@ -0,0 +1,452 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_LA_CONTAINER_LINEAR_OPERATOR_HH
+#define DUNE_XT_LA_CONTAINER_LINEAR_OPERATOR_HH
+
+#include <memory>
+#include <vector>
+
+#include <dune/xt/common/exceptions.hh>
+
+#include <dune/xt/la/type_traits.hh>
+
+#include "matrix-interface.hh"
+
+namespace Dune {
+namespace XT {
+namespace LA {
+
+
+/**
+ * \brief Interface for linear operators which are only applied, but never assembled, e.g. compositions of matrices
+ *        (see BlockOperator, LinearCombinationOperator and TransposedOperator).
+ *
+ * Operators may be solved for with the iterative solvers of Solver<LinearOperatorInterface<...>>.
+ * \note The operators use temporaries allocated on construction, so an operator must not be applied concurrently.
+ */
+template <class VectorImp>
+class LinearOperatorInterface
+{
+public:
+  using VectorType = VectorImp;
+  using ScalarType = typename VectorType::ScalarType;
+
+  virtual ~LinearOperatorInterface() = default;
+
+  virtual size_t rows() const = 0;
+
+  virtual size_t cols() const = 0;
+
+  //! Computes yy = A xx.
+  virtual void mv(const VectorType& xx, VectorType& yy) const = 0;
+
+  //! Computes yy = A^T xx.
+  virtual void mtv(const VectorType& xx, VectorType& yy) const = 0;
+}; // class LinearOperatorInterface
+
+
+//! Models a matrix as a LinearOperatorInterface, keeps a reference to the matrix.
+template <class MatrixImp, class VectorImp = vector_t<MatrixImp>>
+class MatrixOperator : public LinearOperatorInterface<VectorImp>
+{
+  static_assert(is_matrix<MatrixImp>::value, "");
+  using BaseType = LinearOperatorInterface<VectorImp>;
+
+public:
+  using MatrixType = MatrixImp;
+  using typename BaseType::VectorType;
+
+  MatrixOperator(const MatrixType& matrix)
+    : matrix_(matrix)
+  {}
+
+  size_t rows() const override final
+  {
+    return matrix_.rows();
+  }
+
+  size_t cols() const override final
+  {
+    return matrix_.cols();
+  }
+
+  void mv(const VectorType& xx, VectorType& yy) const override final
+  {
+    matrix_.mv(xx, yy);
+  }
+
+  void mtv(const VectorType& xx, VectorType& yy) const override final
+  {
+    matrix_.mtv(xx, yy);
+  }
+
+  const MatrixType& matrix() const
+  {
+    return matrix_;
+  }
+
+private:
+  const MatrixType& matrix_;
+}; // class MatrixOperator
+
+
+namespace internal {
+
+
+/**
+ * \brief Keeps references to the operators composed by BlockOperator, LinearCombinationOperator and
+ *        TransposedOperator.
+ *
+ * Matrices are wrapped into MatrixOperators, which are owned by this class.
+ */
+template <class VectorType>
+class LinearOperatorReferences
+{
+public:
+  using OperatorType = LinearOperatorInterface<VectorType>;
+
+  const OperatorType& reference(const OperatorType& op)
+  {
+    return op;
+  }
+
+  template <class T, class S>
+  const OperatorType& reference(const MatrixInterface<T, S>& matrix)
+  {
+    using MatrixType = typename MatrixInterface<T, S>::derived_type;
+    wrapped_matrices_.emplace_back(std::make_unique<MatrixOperator<MatrixType, VectorType>>(matrix.as_imp()));
+    return *wrapped_matrices_.back();
+  }
+
+private:
+  std::vector<std::unique_ptr<OperatorType>> wrapped_matrices_;
+}; // class LinearOperatorReferences
+
+
+template <class VectorType>
+void check_operator_sizes(const size_t rows, const size_t cols, const VectorType& xx, const VectorType& yy)
+{
+  if (xx.size() != cols || yy.size() != rows)
+    DUNE_THROW(Common::Exceptions::shapes_do_not_match,
+               "A " << rows << "x" << cols << " operator can not be applied to a vector of size " << xx.size()
+                    << " with a result of size " << yy.size() << "!");
+}
+
+
+} // namespace internal
+
+
+/**
+ * \brief The transpose of the given operator or matrix, i.e. mv() and mtv() are interchanged.
+ *
+ * Keeps a reference to the given operator or matrix.
+ */
+template <class VectorImp>
+class TransposedOperator : public LinearOperatorInterface<VectorImp>
+{
+  using BaseType = LinearOperatorInterface<VectorImp>;
+
+public:
+  using typename BaseType::VectorType;
+
+  template <class OperatorOrMatrixType>
+  TransposedOperator(const OperatorOrMatrixType& op)
+    : op_(references_.reference(op))
+  {}
+
+  size_t rows() const override final
+  {
+    return op_.cols();
+  }
+
+  size_t cols() const override final
+  {
+    return op_.rows();
+  }
+
+  void mv(const VectorType& xx, VectorType& yy) const override final
+  {
+    op_.mtv(xx, yy);
+  }
+
+  void mtv(const VectorType& xx, VectorType& yy) const override final
+  {
+    op_.mv(xx, yy);
+  }
+
+private:
+  internal::LinearOperatorReferences<VectorType> references_;
+  const BaseType& op_;
+}; // class TransposedOperator
+
+
+/**
+ * \brief The linear combination sum_k coefficient_k A_k of the given operators or matrices, e.g. M + dt A.
+ *
+ * Keeps references to the given operators and matrices. The coefficients may be changed after construction (e.g. in
+ * each time step, see set_coefficient()). Applying the operator requires one temporary, which is allocated once.
+ */
+template <class VectorImp>
+class LinearCombinationOperator : public LinearOperatorInterface<VectorImp>
+{
+  using BaseType = LinearOperatorInterface<VectorImp>;
+
+public:
+  using typename BaseType::VectorType;
+  using typename BaseType::ScalarType;
+
+  LinearCombinationOperator(const size_t num_rows, const size_t num_cols)
+    : rows_(num_rows)
+    , cols_(num_cols)
+    , range_tmp_(num_rows, 0.)
+    , source_tmp_(num_cols, 0.)
+  {}
+
+  //! Adds coefficient * op to the linear combination, returns the index of the summand.
+  template <class OperatorOrMatrixType>
+  size_t add(const OperatorOrMatrixType& op, const ScalarType& coefficient = ScalarType(1))
+  {
+    const auto& op_reference = references_.reference(op);
+    if (op_reference.rows() != rows_ || op_reference.cols() != cols_)
+      DUNE_THROW(Common::Exceptions::shapes_do_not_match,
+                 "Can not add a " << op_reference.rows() << "x" << op_reference.cols() << " operator to a " << rows_
+                                  << "x" << cols_ << " linear combination!");
+    ops_.push_back(&op_reference);
+    coefficients_.push_back(coefficient);
+    return ops_.size() - 1;
+  } // ... add(...)
+
+  size_t num_summands() const
+  {
+    return ops_.size();
+  }
+
+  const ScalarType& coefficient(const size_t kk) const
+  {
+    check_index(kk);
+    return coefficients_[kk];
+  }
+
+  void set_coefficient(const size_t kk, const ScalarType& coefficient)
+  {
+    check_index(kk);
+    coefficients_[kk] = coefficient;
+  }
+
+  size_t rows() const override final
+  {
+    return rows_;
+  }
+
+  size_t cols() const override final
+  {
+    return cols_;
+  }
+
+  void mv(const VectorType& xx, VectorType& yy) const override final
+  {
+    internal::check_operator_sizes(rows_, cols_, xx, yy);
+    apply(xx, yy, range_tmp_, /*transposed=*/false);
+  }
+
+  void mtv(const VectorType& xx, VectorType& yy) const override final
+  {
+    internal::check_operator_sizes(cols_, rows_, xx, yy);
+    apply(xx, yy, source_tmp_, /*transposed=*/true);
+  }
+
+private:
+  void check_index(const size_t kk) const
+  {
+    if (kk >= ops_.size())
+      DUNE_THROW(Common::Exceptions::index_out_of_range,
+                 "kk = " << kk << " is not smaller than num_summands() = " << ops_.size() << "!");
+  }
+
+  // the first summand is computed in yy directly, all others in tmp
+  void apply(const VectorType& xx, VectorType& yy, VectorType& tmp, const bool transposed) const
+  {
+    if (ops_.empty()) {
+      yy.set_all(0.);
+      return;
+    }
+    for (size_t kk = 0; kk < ops_.size(); ++kk) {
+      auto& result = (kk == 0) ? yy : tmp;
+      if (transposed)
+        ops_[kk]->mtv(xx, result);
+      else
+        ops_[kk]->mv(xx, result);
+      if (kk == 0)
+        yy.scal(coefficients_[0]);
+      else
+        yy.axpy(coefficients_[kk], tmp);
+    }
+  } // ... apply(...)
+
+  const size_t rows_;
+  const size_t cols_;
+  internal::LinearOperatorReferences<VectorType> references_;
+  std::vector<const BaseType*> ops_;
+  std::vector<ScalarType> coefficients_;
+  mutable VectorType range_tmp_;
+  mutable VectorType source_tmp_;
+}; // class LinearCombinationOperator
+
+
+/**
+ * \brief An operator composed of blocks of operators or matrices, e.g. the saddle point operator [A B1; B2^T C].
+ *
+ * The sizes of the block rows and columns are given on construction, all blocks are zero unless set by set_block().
+ * Keeps references to the given operators and matrices. Applying the operator copies the blocks of the argument and the
+ * result to temporaries allocated once on construction, the blocks of each block row are summed up in place.
+ */
+template <class VectorImp>
+class BlockOperator : public LinearOperatorInterface<VectorImp>
+{
+  using BaseType = LinearOperatorInterface<VectorImp>;
+
+public:
+  using typename BaseType::VectorType;
+
+  BlockOperator(const std::vector<size_t>& row_sizes, const std::vector<size_t>& col_sizes)
+    : row_sizes_(row_sizes)
+    , col_sizes_(col_sizes)
+    , row_offsets_(offsets(row_sizes_))
+    , col_offsets_(offsets(col_sizes_))
+    , blocks_(row_sizes_.size() * col_sizes_.size(), nullptr)
+  {
+    for (const auto& size : row_sizes_) {
+      row_vectors_.emplace_back(size, 0.);
+      row_tmps_.emplace_back(size, 0.);
+    }
+    for (const auto& size : col_sizes_) {
+      col_vectors_.emplace_back(size, 0.);
+      col_tmps_.emplace_back(size, 0.);
+    }
+  } // BlockOperator(...)
+
+  size_t num_block_rows() const
+  {
+    return row_sizes_.size();
+  }
+
+  size_t num_block_cols() const
+  {
+    return col_sizes_.size();
+  }
+
+  //! Sets the block (ii, jj) to the given operator or matrix, which has to be row_sizes[ii] x col_sizes[jj].
+  template <class OperatorOrMatrixType>
+  void set_block(const size_t ii, const size_t jj, const OperatorOrMatrixType& op)
+  {
+    if (ii >= num_block_rows() || jj >= num_block_cols())
+      DUNE_THROW(Common::Exceptions::index_out_of_range,
+                 "There is no block (" << ii << ", " << jj << ") in a " << num_block_rows() << "x" << num_block_cols()
+                                       << " block operator!");
+    const auto& op_reference = references_.reference(op);
+    if (op_reference.rows() != row_sizes_[ii] || op_reference.cols() != col_sizes_[jj])
+      DUNE_THROW(Common::Exceptions::shapes_do_not_match,
+                 "The block (" << ii << ", " << jj << ") has to be " << row_sizes_[ii] << "x" << col_sizes_[jj]
+                               << ", the given one is " << op_reference.rows() << "x" << op_reference.cols() << "!");
+    blocks_[ii * num_block_cols() + jj] = &op_reference;
+  } // ... set_block(...)
+
+  size_t rows() const override final
+  {
+    return row_offsets_.back();
+  }
+
+  size_t cols() const override final
+  {
+    return col_offsets_.back();
+  }
+
+  void mv(const VectorType& xx, VectorType& yy) const override final
+  {
+    internal::check_operator_sizes(rows(), cols(), xx, yy);
+    split(xx, col_offsets_, col_vectors_);
+    for (size_t ii = 0; ii < num_block_rows(); ++ii) {
+      bool first = true;
+      for (size_t jj = 0; jj < num_block_cols(); ++jj) {
+        const auto* block = blocks_[ii * num_block_cols() + jj];
+        if (block) {
+          block->mv(col_vectors_[jj], first ? row_vectors_[ii] : row_tmps_[ii]);
+          if (!first)
+            row_vectors_[ii].axpy(1., row_tmps_[ii]);
+          first = false;
+        }
+      }
+      if (first)
+        row_vectors_[ii].set_all(0.);
+    }
+    join(row_vectors_, row_offsets_, yy);
+  } // ... mv(...)
+
+  void mtv(const VectorType& xx, VectorType& yy) const override final
+  {
+    internal::check_operator_sizes(cols(), rows(), xx, yy);
+    split(xx, row_offsets_, row_vectors_);
+    for (size_t jj = 0; jj < num_block_cols(); ++jj) {
+      bool first = true;
+      for (size_t ii = 0; ii < num_block_rows(); ++ii) {
+        const auto* block = blocks_[ii * num_block_cols() + jj];
+        if (block) {
+          block->mtv(row_vectors_[ii], first ? col_vectors_[jj] : col_tmps_[jj]);
+          if (!first)
+            col_vectors_[jj].axpy(1., col_tmps_[jj]);
+          first = false;
+        }
+      }
+      if (first)
+        col_vectors_[jj].set_all(0.);
+    }
+    join(col_vectors_, col_offsets_, yy);
+  } // ... mtv(...)
+
+private:
+  static std::vector<size_t> offsets(const std::vector<size_t>& sizes)
+  {
+    std::vector<size_t> ret(sizes.size() + 1, 0);
+    for (size_t kk = 0; kk < sizes.size(); ++kk)
+      ret[kk + 1] = ret[kk] + sizes[kk];
+    return ret;
+  }
+
+  static void split(const VectorType& vector, const std::vector<size_t>& offsets, std::vector<VectorType>& blocks)
+  {
+    for (size_t kk = 0; kk < blocks.size(); ++kk)
+      for (size_t ii = 0; ii < blocks[kk].size(); ++ii)
+        blocks[kk][ii] = vector[offsets[kk] + ii];
+  }
+
+  static void join(const std::vector<VectorType>& blocks, const std::vector<size_t>& offsets, VectorType& vector)
+  {
+    for (size_t kk = 0; kk < blocks.size(); ++kk)
+      for (size_t ii = 0; ii < blocks[kk].size(); ++ii)
+        vector[offsets[kk] + ii] = blocks[kk][ii];
+  }
+
+  const std::vector<size_t> row_sizes_;
+  const std::vector<size_t> col_sizes_;
+  const std::vector<size_t> row_offsets_;
+  const std::vector<size_t> col_offsets_;
+  internal::LinearOperatorReferences<VectorType> references_;
+  // the blocks in row major order, nullptr for zero blocks
+  std::vector<const BaseType*> blocks_;
+  mutable std::vector<VectorType> row_vectors_;
+  mutable std::vector<VectorType> row_tmps_;
+  mutable std::vector<VectorType> col_vectors_;
+  mutable std::vector<VectorType> col_tmps_;
+}; // class BlockOperator
+
+
+} // namespace LA
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_LA_CONTAINER_LINEAR_OPERATOR_HH
@@ -17,6 +17,7 @@
 #include <limits>
 #include <iostream>
 #include <type_traits>
+#include <vector>
 
 #include <dune/common/ftraits.hh>
 
@@ -378,12 +379,22 @@ protected:
     if (other.rows() != cols())
       DUNE_THROW(XT::Common::Exceptions::shapes_do_not_match, "Dimensions of matrices to be multiplied do not match!");
     const auto this_pattern = pattern();
-    const auto new_pattern = multiplication_pattern(this_pattern, other.pattern(), other.cols());
+    const auto other_pattern = other.pattern();
+    const auto new_pattern = multiplication_pattern(this_pattern, other_pattern, other.cols());
     derived_type yy(rows(), other.cols(), new_pattern);
-    for (size_t rr = 0; rr < rows(); ++rr)
-      for (auto&& cc : new_pattern.inner(rr))
-        for (auto&& kk : this_pattern.inner(rr))
-          yy.add_to_entry(rr, cc, get_entry(rr, kk) * other.get_entry(kk, cc));
+    // accumulate each row of the product in a dense row (Gustavson's algorithm)
+    std::vector<ScalarType> row(other.cols(), ScalarType(0));
+    for (size_t rr = 0; rr < rows(); ++rr) {
+      for (auto&& kk : this_pattern.inner(rr)) {
+        const auto this_entry = get_entry(rr, kk);
+        for (auto&& cc : other_pattern.inner(kk))
+          row[cc] += this_entry * other.get_entry(kk, cc);
+      }
+      for (auto&& cc : new_pattern.inner(rr)) {
+        yy.set_entry(rr, cc, row[cc]);
+        row[cc] = ScalarType(0);
+      }
+    }
     return yy;
   }
 
@@ -143,6 +143,32 @@ public:
     return past_last_col_ - first_col_;
   }
 
+  //! The viewed matrix, the view consists of its rows [first_row(), past_last_row()) and columns [first_col(), ...).
+  const Matrix& matrix() const
+  {
+    return matrix_;
+  }
+
+  size_t first_row() const
+  {
+    return first_row_;
+  }
+
+  size_t past_last_row() const
+  {
+    return past_last_row_;
+  }
+
+  size_t first_col() const
+  {
+    return first_col_;
+  }
+
+  size_t past_last_col() const
+  {
+    return past_last_col_;
+  }
+
   inline void scal(const ScalarType& /*alpha*/)
   {
     DUNE_THROW(XT::Common::Exceptions::you_are_using_this_wrong, "You cannot use non-const methods on ConstMatrixView");
@@ -352,6 +378,31 @@ public:
     return const_matrix_view_.cols();
   }
 
+  const Matrix& matrix() const
+  {
+    return matrix_;
+  }
+
+  size_t first_row() const
+  {
+    return const_matrix_view_.first_row();
+  }
+
+  size_t past_last_row() const
+  {
+    return const_matrix_view_.past_last_row();
+  }
+
+  size_t first_col() const
+  {
+    return const_matrix_view_.first_col();
+  }
+
+  size_t past_last_col() const
+  {
+    return const_matrix_view_.past_last_col();
+  }
+
   inline void scal(const ScalarType& alpha)
   {
     const auto& patt = const_matrix_view_.get_pattern();
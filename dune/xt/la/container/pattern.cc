@@ -13,6 +13,8 @@
 
 #include <cassert>
 #include <algorithm>
+#include <utility>
+#include <vector>
 
 #include "config.h"
 #include "pattern.hh"
@@ -79,16 +81,12 @@ bool SparsityPatternDefault::operator!=(const SparsityPatternDefault& other) con
 
 SparsityPatternDefault SparsityPatternDefault::operator+(const SparsityPatternDefault& other) const
 {
-  SparsityPatternDefault ret(std::max(this->size(), other.size()));
+  SparsityPatternBuilder builder(std::max(this->size(), other.size()));
   for (size_t rr = 0; rr < this->size(); ++rr)
-    for (const auto& cc : this->inner(rr))
-      ret.insert(rr, cc);
+    builder.insert(rr, this->inner(rr).begin(), this->inner(rr).end());
   for (size_t rr = 0; rr < other.size(); ++rr)
-    for (const auto& cc : other.inner(rr))
-      if (!ret.contains(rr, cc))
-        ret.insert(rr, cc);
-  ret.sort();
-  return ret;
+    builder.insert(rr, other.inner(rr).begin(), other.inner(rr).end());
+  return builder.finalize();
 }
 
 void SparsityPatternDefault::insert(const size_t outer_index, const size_t inner_index)
@@ -128,23 +126,66 @@ bool SparsityPatternDefault::contains(const SparsityPatternDefault& other) const
 
 SparsityPatternDefault SparsityPatternDefault::transposed(const size_t cols) const
 {
-  SparsityPatternDefault transposed_pattern(cols);
+  SparsityPatternBuilder transposed_pattern(cols);
   for (size_t rr = 0; rr < size(); ++rr)
     for (const auto& cc : inner(rr))
       transposed_pattern.insert(cc, rr);
-  transposed_pattern.sort();
-  return transposed_pattern;
+  return transposed_pattern.finalize();
+}
+
+
+// ================================
+// ==== SparsityPatternBuilder ====
+// ================================
+SparsityPatternBuilder::SparsityPatternBuilder(const size_t _size)
+  : rows_(_size)
+  , compressed_sizes_(_size, 0)
+{}
+
+size_t SparsityPatternBuilder::size() const
+{
+  return rows_.size();
+}
+
+void SparsityPatternBuilder::insert(const size_t outer_index, const size_t inner_index)
+{
+  assert(outer_index < size() && "Wrong index requested!");
+  auto& row = rows_[outer_index];
+  row.push_back(inner_index);
+  if (row.size() >= 2 * compressed_sizes_[outer_index] + 16)
+    compress(outer_index);
+}
+
+SparsityPatternDefault SparsityPatternBuilder::finalize()
+{
+  SparsityPatternDefault ret(size());
+  for (size_t ii = 0; ii < size(); ++ii) {
+    compress(ii);
+    ret.inner(ii) = std::move(rows_[ii]);
+  }
+  rows_.clear();
+  compressed_sizes_.clear();
+  return ret;
+}
+
+void SparsityPatternBuilder::compress(const size_t outer_index)
+{
+  auto& row = rows_[outer_index];
+  if (!std::is_sorted(row.begin(), row.end()))
+    std::sort(row.begin(), row.end());
+  row.erase(std::unique(row.begin(), row.end()), row.end());
+  compressed_sizes_[outer_index] = row.size();
 }
 
 SparsityPatternDefault dense_pattern(const size_t rows, const size_t cols)
 {
-  SparsityPatternDefault ret(rows);
+  SparsityPatternBuilder ret(rows);
   std::vector<size_t> columns(cols);
   for (size_t ii = 0; ii < cols; ++ii)
     columns[ii] = ii;
-  for (auto& inner : ret)
-    inner = columns;
-  return ret;
+  for (size_t ii = 0; ii < rows; ++ii)
+    ret.insert(ii, columns.begin(), columns.end());
+  return ret.finalize();
 }
 
 SparsityPatternDefault tridiagonal_pattern(const size_t rows, const size_t cols)
@@ -183,17 +224,17 @@ SparsityPatternDefault multiplication_pattern(const SparsityPatternDefault& lhs_
                                               const size_t rhs_cols)
 {
   const size_t lhs_rows = lhs_pattern.size();
-  SparsityPatternDefault pattern(lhs_rows);
+  SparsityPatternBuilder pattern(lhs_rows);
+  // marker[jj] == ii iff column jj has already been added to row ii of the new pattern
+  std::vector<size_t> marker(rhs_cols, size_t(-1));
   for (size_t ii = 0; ii < lhs_rows; ++ii) // rows of new pattern
-    for (size_t jj = 0; jj < rhs_cols; ++jj) // cols of new pattern
-      for (const auto& index : lhs_pattern.inner(ii)) { // entries in lhs_pattern in current row
-        if (std::find(rhs_pattern.inner(index).begin(), rhs_pattern.inner(index).end(), jj)
-            != rhs_pattern.inner(index).end()) {
+    for (const auto& index : lhs_pattern.inner(ii)) // entries in lhs_pattern in current row
+      for (const auto& jj : rhs_pattern.inner(index)) // cols of new pattern
+        if (jj < rhs_cols && marker[jj] != ii) {
+          marker[jj] = ii;
           pattern.insert(ii, jj);
-          break;
         }
-      }
-  return pattern;
+  return pattern.finalize();
 }
 
 
@@ -13,9 +13,14 @@
 #ifndef DUNE_XT_LA_CONTAINER_PATTERN_HH
 #define DUNE_XT_LA_CONTAINER_PATTERN_HH
 
+#include <algorithm>
+#include <cassert>
 #include <cstddef>
+#include <iterator>
+#include <utility>
 #include <vector>
 
+#include <dune/xt/common/exceptions.hh>
 #include <dune/xt/common/type_traits.hh>
 
 namespace Dune {
@@ -55,6 +60,7 @@ public:
 
   SparsityPatternDefault operator+(const SparsityPatternDefault& other) const;
 
+  //! Searches the row for inner_index before appending it, use SparsityPatternBuilder to insert many entries.
   void insert(const size_t outer_index, const size_t inner_index);
 
   void sort(const size_t outer_index);
@@ -71,6 +77,217 @@ private:
   BaseType vector_of_vectors_;
 }; // class SparsityPatternDefault
 
+
+/**
+ * \brief Bulk construction of a SparsityPatternDefault (or of compressed row arrays).
+ *
+ * In contrast to SparsityPatternDefault::insert(), insert() does not search the row for the inner index but only
+ * appends it. Duplicates are removed by sorting the row whenever it has grown to twice its size since the last time
+ * (which bounds the memory needed for duplicates) and in finalize(). Different rows may be inserted to concurrently.
+ */
+class SparsityPatternBuilder
+{
+public:
+  explicit SparsityPatternBuilder(const size_t _size = 0);
+
+  size_t size() const;
+
+  void insert(const size_t outer_index, const size_t inner_index);
+
+  template <class InputIteratorType>
+  void insert(const size_t outer_index, InputIteratorType first, InputIteratorType last)
+  {
+    assert(outer_index < size() && "Wrong index requested!");
+    auto& row = rows_[outer_index];
+    row.insert(row.end(), first, last);
+    if (row.size() >= 2 * compressed_sizes_[outer_index] + 16)
+      compress(outer_index);
+  }
+
+  //! Sorts each row and removes all duplicates, leaves this builder empty.
+  SparsityPatternDefault finalize();
+
+  /**
+   * \brief Sorts each row and removes all duplicates, and stores the result in compressed row storage, leaves this
+   *        builder empty.
+   *
+   * outer_index_ptr has size() + 1 entries, the inner indices of row ii are
+   * inner_indices[outer_index_ptr[ii]], ..., inner_indices[outer_index_ptr[ii + 1] - 1].
+   */
+  template <class IndexType>
+  void finalize(std::vector<IndexType>& outer_index_ptr, std::vector<IndexType>& inner_indices)
+  {
+    outer_index_ptr.assign(size() + 1, 0);
+    for (size_t ii = 0; ii < size(); ++ii) {
+      compress(ii);
+      outer_index_ptr[ii + 1] = static_cast<IndexType>(outer_index_ptr[ii] + rows_[ii].size());
+    }
+    inner_indices.resize(outer_index_ptr[size()]);
+    for (size_t ii = 0; ii < size(); ++ii) {
+      std::copy(rows_[ii].begin(), rows_[ii].end(), inner_indices.begin() + outer_index_ptr[ii]);
+      std::vector<size_t>().swap(rows_[ii]); // <- frees the memory of the row
+    }
+    rows_.clear();
+    compressed_sizes_.clear();
+  } // ... finalize(...)
+
+private:
+  void compress(const size_t outer_index);
+
+  std::vector<std::vector<size_t>> rows_;
+  std::vector<size_t> compressed_sizes_;
+}; // class SparsityPatternBuilder
+
+
+/**
+ * \brief Sparsity pattern in compressed row storage: row offsets and one contiguous array of column indices.
+ *
+ * In contrast to SparsityPatternDefault, which needs one heap allocation per row, this is the layout the sparse
+ * matrices use internally. All matrices accept it in place of a SparsityPatternDefault, and CommonSparseMatrix adopts
+ * the arrays of a pattern with its own index type passed as an rvalue without copying them. Using a 32-bit IndexImp
+ * halves the memory needed for the indices (as long as the number of non-zeros fits).
+ *
+ * The column indices of each row are sorted and unique.
+ */
+template <class IndexImp = size_t>
+class SparsityPatternCompressed
+{
+public:
+  using IndexType = IndexImp;
+  using IndexVectorType = std::vector<IndexType>;
+
+  //! Creates a pattern with _size empty rows.
+  explicit SparsityPatternCompressed(const size_t _size = 0)
+    : row_offsets_(_size + 1, 0)
+  {}
+
+  /**
+   * \brief Takes the given arrays, the column indices of each row have to be sorted and unique.
+   *
+   * The arrays are checked in one pass (also in release builds, since they are usually read from somewhere), the
+   * number of columns is checked by the matrices.
+   */
+  SparsityPatternCompressed(IndexVectorType row_offsets, IndexVectorType column_indices)
+    : row_offsets_(std::move(row_offsets))
+    , column_indices_(std::move(column_indices))
+  {
+    if (row_offsets_.empty() || row_offsets_.front() != 0 || size_t(row_offsets_.back()) != column_indices_.size())
+      DUNE_THROW(Common::Exceptions::wrong_input_given,
+                 "The row offsets have to start with 0 and end with the number of column indices ("
+                     << column_indices_.size() << ")!");
+    for (size_t ii = 0; ii < size(); ++ii) {
+      if (row_offsets_[ii] > row_offsets_[ii + 1] || size_t(row_offsets_[ii + 1]) > column_indices_.size())
+        DUNE_THROW(Common::Exceptions::wrong_input_given,
+                   "The row offsets have to be non-decreasing, which is not the case for row " << ii << "!");
+      for (size_t kk = size_t(row_offsets_[ii]) + 1; kk < size_t(row_offsets_[ii + 1]); ++kk)
+        if (column_indices_[kk - 1] >= column_indices_[kk])
+          DUNE_THROW(Common::Exceptions::wrong_input_given,
+                     "The column indices of row " << ii << " are not sorted or not unique!");
+    }
+  } // SparsityPatternCompressed(...)
+
+  //! Converts the given pattern, sorting its rows and removing duplicates.
+  explicit SparsityPatternCompressed(const SparsityPatternDefault& pattern)
+    : row_offsets_(pattern.size() + 1, 0)
+  {
+    size_t non_zeros = 0;
+    for (size_t ii = 0; ii < pattern.size(); ++ii)
+      non_zeros += pattern.inner(ii).size();
+    column_indices_.resize(non_zeros);
+    // the rows are compacted in place, row ii starts where the unique entries of row ii - 1 end
+    auto row_begin = column_indices_.begin();
+    for (size_t ii = 0; ii < pattern.size(); ++ii) {
+      const auto row_end = std::copy(pattern.inner(ii).begin(), pattern.inner(ii).end(), row_begin);
+      std::sort(row_begin, row_end);
+      row_begin = std::unique(row_begin, row_end);
+      row_offsets_[ii + 1] = static_cast<IndexType>(std::distance(column_indices_.begin(), row_begin));
+    }
+    column_indices_.resize(row_offsets_.back());
+  } // SparsityPatternCompressed(...)
+
+  //! Finalizes the given builder.
+  explicit SparsityPatternCompressed(SparsityPatternBuilder&& builder)
+  {
+    builder.finalize(row_offsets_, column_indices_);
+  }
+
+  //! The number of rows.
+  size_t size() const
+  {
+    return row_offsets_.size() - 1;
+  }
+
+  size_t non_zeros() const
+  {
+    return column_indices_.size();
+  }
+
+  size_t inner_size(const size_t ii) const
+  {
+    assert(ii < size() && "Wrong index requested!");
+    return row_offsets_[ii + 1] - row_offsets_[ii];
+  }
+
+  const IndexType* inner_begin(const size_t ii) const
+  {
+    assert(ii < size() && "Wrong index requested!");
+    return column_indices_.data() + row_offsets_[ii];
+  }
+
+  const IndexType* inner_end(const size_t ii) const
+  {
+    assert(ii < size() && "Wrong index requested!");
+    return column_indices_.data() + row_offsets_[ii + 1];
+  }
+
+  bool contains(const size_t outer_index, const size_t inner_index) const
+  {
+    return std::binary_search(inner_begin(outer_index), inner_end(outer_index), IndexType(inner_index));
+  }
+
+  const IndexVectorType& row_offsets() const
+  {
+    return row_offsets_;
+  }
+
+  const IndexVectorType& column_indices() const
+  {
+    return column_indices_;
+  }
+
+  //! Moves the arrays of this pattern into the given vectors, leaves this pattern without rows.
+  void release(IndexVectorType& row_offsets, IndexVectorType& column_indices)
+  {
+    row_offsets = std::move(row_offsets_);
+    column_indices = std::move(column_indices_);
+    row_offsets_.assign(1, 0);
+    column_indices_.clear();
+  }
+
+  SparsityPatternDefault uncompressed() const
+  {
+    SparsityPatternDefault ret(size());
+    for (size_t ii = 0; ii < size(); ++ii)
+      ret.inner(ii).assign(inner_begin(ii), inner_end(ii));
+    return ret;
+  }
+
+  bool operator==(const SparsityPatternCompressed& other) const
+  {
+    return row_offsets_ == other.row_offsets_ && column_indices_ == other.column_indices_;
+  }
+
+  bool operator!=(const SparsityPatternCompressed& other) const
+  {
+    return !(*this == other);
+  }
+
+private:
+  IndexVectorType row_offsets_;
+  IndexVectorType column_indices_;
+}; // class SparsityPatternCompressed
+
+
 SparsityPatternDefault dense_pattern(const size_t rows, const size_t cols);
 
 SparsityPatternDefault tridiagonal_pattern(const size_t rows, const size_t cols);
@@ -12,6 +12,7 @@
 #ifndef DUNE_XT_LA_SOLVER_HH
 #define DUNE_XT_LA_SOLVER_HH
 
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -21,6 +22,8 @@
 
 #include <dune/xt/la/exceptions.hh>
 #include <dune/xt/la/type_traits.hh>
+#include <dune/xt/la/container/vector-array/list.hh>
+#include <dune/xt/la/solver/statistics.hh>
 
 namespace Dune {
 namespace XT {
@@ -46,9 +49,145 @@ public:
                                 << ss.str());
     }
   }
+
+  /**
+   * \brief Checks the vectors given to a solve with multiple right hand sides.
+   *
+   * If solution is empty, it is filled with a zero vector of the size of the right hand sides for each of them.
+   */
+  template <class V>
+  static void check_given(const ListVectorArray<V>& rhs, ListVectorArray<V>& solution)
+  {
+    if (solution.dim() != rhs.dim())
+      DUNE_THROW(Common::Exceptions::shapes_do_not_match,
+                 "solution.dim() = " << solution.dim() << "\n   rhs.dim() = " << rhs.dim());
+    if (solution.length() == 0) {
+      solution.reserve(rhs.length());
+      for (size_t ii = 0; ii < rhs.length(); ++ii)
+        solution.append(V(rhs.dim(), 0.));
+    }
+    if (solution.length() != rhs.length())
+      DUNE_THROW(Common::Exceptions::shapes_do_not_match,
+                 "solution.length() = " << solution.length() << "\n   rhs.length() = " << rhs.length());
+  } // ... check_given(...)
+
+  /**
+   * \brief Checks if the given options and those given to prepare() agree in all given keys, i.e. if the setup
+   *        computed in prepare() may be reused.
+   *
+   * Missing keys are taken from default_opts, the values are compared as strings (so '1e-4' and '0.0001' differ,
+   * which only leads to an unnecessary setup).
+   */
+  static bool setup_options_agree(const Common::Configuration& opts,
+                                  const Common::Configuration& prepared_opts,
+                                  const Common::Configuration& default_opts,
+                                  const std::vector<std::string>& setup_keys)
+  {
+    for (const auto& key : setup_keys) {
+      const std::string default_value = default_opts.has_key(key) ? default_opts.get<std::string>(key) : "";
+      if (opts.get(key, default_value) != prepared_opts.get(key, default_value))
+        return false;
+    }
+    return true;
+  } // ... setup_options_agree(...)
 };
 
 
+// calls solver.prepare(opts) for the solvers with a setup to reuse (see e.g. Solver::prepare()), a no-op otherwise
+template <class SolverType>
+auto prepare_if_possible(SolverType& solver, const Common::Configuration& opts, int)
+    -> decltype(solver.prepare(opts), void())
+{
+  solver.prepare(opts);
+}
+
+template <class SolverType>
+void prepare_if_possible(SolverType& /*solver*/, const Common::Configuration& /*opts*/, long)
+{}
+
+// calls solver.update() for the solvers with a setup to reuse (see e.g. Solver::update()), a no-op otherwise
+template <class SolverType>
+auto update_if_possible(SolverType& solver, int) -> decltype(solver.update(), void())
+{
+  solver.update();
+}
+
+template <class SolverType>
+void update_if_possible(SolverType& /*solver*/, long)
+{}
+
+
+//! A mutex to be kept by solvers without preventing their copy or move, each copy gets a mutex of its own.
+class SolverMutex : public std::mutex
+{
+public:
+  SolverMutex() = default;
+
+  SolverMutex(const SolverMutex& /*other*/)
+    : std::mutex()
+  {}
+
+  SolverMutex& operator=(const SolverMutex& /*other*/)
+  {
+    return *this;
+  }
+}; // class SolverMutex
+
+
+/**
+ * \brief A scratch vector kept by a solver, to avoid allocations in each call to apply().
+ *
+ * Since the const apply() of a solver may be called concurrently, each call accesses the vector via Access: the first
+ * call gets the kept vector, calls running at the same time get a temporary one instead. Copies of a solver do not
+ * share (or copy) the scratch vector.
+ */
+template <class V>
+class ScratchVector
+{
+public:
+  class Access
+  {
+  public:
+    explicit Access(const ScratchVector& scratch)
+      : lock_(scratch.mutex_, std::try_to_lock)
+      , temporary_()
+      , vector_(lock_.owns_lock() ? scratch.vector_ : temporary_)
+    {}
+
+    Access(const Access&) = delete;
+    Access& operator=(const Access&) = delete;
+
+    V& operator*()
+    {
+      return vector_;
+    }
+
+    V* operator->()
+    {
+      return &vector_;
+    }
+
+  private:
+    std::unique_lock<std::mutex> lock_;
+    V temporary_;
+    V& vector_;
+  }; // class Access
+
+  ScratchVector() = default;
+
+  ScratchVector(const ScratchVector& /*other*/) {}
+
+  ScratchVector& operator=(const ScratchVector& /*other*/)
+  {
+    return *this;
+  }
+
+private:
+  mutable std::mutex mutex_;
+  mutable V vector_;
+}; // class ScratchVector
+
+
 } // namespace internal
 
 
@@ -137,6 +276,32 @@ public:
                "Please include the correct header for your matrix implementation '"
                    << Common::Typename<MatrixType>::value() << "'!");
   }
+
+  /**
+   *  Solves for several right hand sides at once (each specialization also provides the overloads with a type or
+   *  with options), reusing the factorization (or preconditioner) of the matrix where possible. If solution is
+   *  empty, it is filled with one vector for each right hand side.
+   */
+  template <class V>
+  void apply(const ListVectorArray<V>& /*rhs*/, ListVectorArray<V>& /*solution*/) const
+  {
+    DUNE_THROW(NotImplemented,
+               "This is the unspecialized version of LA::Solver< ... >. "
+               "Please include the correct header for your matrix implementation '"
+                   << Common::Typename<MatrixType>::value() << "'!");
+  }
+
+  /**
+   *  The timings, iterations and residuals of the last finished call to apply() (provided by the specializations for
+   *  the common, eigen and istl matrices), returned by value since each call collects its own statistics.
+   */
+  SolverStatistics statistics() const
+  {
+    DUNE_THROW(NotImplemented,
+               "This is the unspecialized version of LA::Solver< ... >. "
+               "Please include the correct header for your matrix implementation '"
+                   << Common::Typename<MatrixType>::value() << "'!");
+  }
 }; // class Solver
 
 
@@ -193,6 +358,7 @@ solve(const MatrixInterface<M, S>& A,
 #include "solver/dense.hh"
 #include "solver/eigen.hh"
 #include "solver/istl.hh"
+#include "solver/linear-operator.hh"
 #include "solver/view.hh"
 
 #endif // DUNE_XT_LA_SOLVER_HH
@@ -19,6 +19,8 @@
 #include <sstream>
 #include <cmath>
 
+#include <dune/common/timer.hh>
+
 #include <dune/xt/common/configuration.hh>
 
 #include <dune/xt/la/algorithms/qr.hh>
@@ -91,45 +93,126 @@ public:
 
   void apply(const CommonDenseVector<S>& rhs, CommonDenseVector<S>& solution, const Common::Configuration& opts) const
   {
-    if (!opts.has_key("type"))
-      DUNE_THROW(Common::Exceptions::configuration_error,
-                 "Given options (see below) need to have at least the key 'type' set!\n\n"
+    const auto type = check_type(opts);
+    const Common::Configuration default_opts = options(type);
+    SolverStatisticsStorage::Recorder statistics(statistics_, type);
+    // solve
+    try {
+      Timer timer;
+      auto QR = matrix_;
+      std::vector<S> tau(QR.cols());
+      std::vector<int> permutations(QR.cols());
+      qr(QR, tau, permutations);
+      statistics->setup_time = timer.elapsed();
+      timer.reset();
+      solve_qr_factorized(QR, tau, permutations, solution, rhs);
+      statistics->solve_time = timer.elapsed();
+      statistics->iterations = 1;
+    } catch (FMatrixError&) {
+      DUNE_THROW(Exceptions::linear_solver_failed_bc_data_did_not_fulfill_requirements,
+                 "The dune-common backend reported 'FMatrixError'!\n"
+                     << "Those were the given options:\n\n"
                      << opts);
-    const auto type = opts.get<std::string>("type");
-    internal::SolverUtils::check_given(type, types());
+    }
+    post_check(rhs, solution, opts, default_opts, *statistics);
+  } // ... apply(...)
+
+  void apply(const ListVectorArray<CommonDenseVector<S>>& rhs, ListVectorArray<CommonDenseVector<S>>& solution) const
+  {
+    apply(rhs, solution, types()[0]);
+  }
+
+  void apply(const ListVectorArray<CommonDenseVector<S>>& rhs,
+             ListVectorArray<CommonDenseVector<S>>& solution,
+             const std::string& type) const
+  {
+    apply(rhs, solution, options(type));
+  }
+
+  //! \note The QR decomposition of the matrix is computed once for all right hand sides.
+  void apply(const ListVectorArray<CommonDenseVector<S>>& rhs,
+             ListVectorArray<CommonDenseVector<S>>& solution,
+             const Common::Configuration& opts) const
+  {
+    const auto type = check_type(opts);
     const Common::Configuration default_opts = options(type);
+    internal::SolverUtils::check_given(rhs, solution);
+    SolverStatisticsStorage::Recorder statistics(statistics_, type);
     // solve
     try {
+      Timer timer;
       auto QR = matrix_;
-      solve_by_qr_decomposition(QR, solution, rhs);
+      std::vector<S> tau(QR.cols());
+      std::vector<int> permutations(QR.cols());
+      qr(QR, tau, permutations);
+      statistics->setup_time = timer.elapsed();
+      timer.reset();
+      CommonDenseVector<S> work(QR.cols(), 0.);
+      for (size_t jj = 0; jj < rhs.length(); ++jj)
+        solve_qr_factorized(QR, tau, permutations, solution[jj].vector(), rhs[jj].vector(), &work);
+      statistics->solve_time = timer.elapsed();
+      statistics->iterations = rhs.length();
     } catch (FMatrixError&) {
       DUNE_THROW(Exceptions::linear_solver_failed_bc_data_did_not_fulfill_requirements,
                  "The dune-common backend reported 'FMatrixError'!\n"
                      << "Those were the given options:\n\n"
                      << opts);
     }
-    // check
+    for (size_t jj = 0; jj < rhs.length(); ++jj)
+      post_check(rhs[jj].vector(), solution[jj].vector(), opts, default_opts, *statistics);
+  } // ... apply(...)
+
+  //! \sa SolverStatistics
+  SolverStatistics statistics() const
+  {
+    return statistics_.get();
+  }
+
+private:
+  static std::string check_type(const Common::Configuration& opts)
+  {
+    if (!opts.has_key("type"))
+      DUNE_THROW(Common::Exceptions::configuration_error,
+                 "Given options (see below) need to have at least the key 'type' set!\n\n"
+                     << opts);
+    const auto type = opts.get<std::string>("type");
+    internal::SolverUtils::check_given(type, types());
+    return type;
+  } // ... check_type(...)
+
+  void post_check(const CommonDenseVector<S>& rhs,
+                  const CommonDenseVector<S>& solution,
+                  const Common::Configuration& opts,
+                  const Common::Configuration& default_opts,
+                  SolverStatistics& statistics) const
+  {
     const R post_check_solves_system_threshold =
         opts.get("post_check_solves_system", default_opts.get<R>("post_check_solves_system"));
     if (post_check_solves_system_threshold > 0) {
-      auto tmp = rhs.copy();
-      matrix_.mv(solution, tmp);
-      tmp -= rhs;
-      const R sup_norm = tmp.sup_norm();
+      Timer timer;
+      // the residual is kept to avoid allocations
+      typename internal::ScratchVector<CommonDenseVector<S>>::Access residual(residual_);
+      if (residual->size() != rhs.size())
+        *residual = CommonDenseVector<S>(rhs.size(), 0.);
+      matrix_.mv(solution, *residual);
+      *residual -= rhs;
+      const R sup_norm = residual->sup_norm();
+      statistics.post_check_time += timer.elapsed();
       if (sup_norm > post_check_solves_system_threshold || Common::isnan(sup_norm) || Common::isinf(sup_norm))
         DUNE_THROW(Exceptions::linear_solver_failed_bc_the_solution_does_not_solve_the_system,
                    "The computed solution does not solve the system (although the dune-common backend "
                        << "reported no error) and you requested checking (see options below)! "
                        << "If you want to disable this check, set 'post_check_solves_system = 0' in the options."
                        << "\n\n"
-                       << "  (A * x - b).sup_norm() = " << tmp.sup_norm() << "\n\n"
+                       << "  (A * x - b).sup_norm() = " << sup_norm << "\n\n"
                        << "Those were the given options:\n\n"
                        << opts);
     }
-  } // ... apply(...)
+  } // ... post_check(...)
 
-private:
   const MatrixType& matrix_;
+  SolverStatisticsStorage statistics_;
+  internal::ScratchVector<CommonDenseVector<S>> residual_;
 }; // class Solver< CommonDenseMatrix< ... > >
 
 
@@ -106,7 +106,54 @@ public:
     // solve
     auto writable_copy_of_matrix_ = matrix_;
     solve_by_qr_decomposition(writable_copy_of_matrix_, solution, rhs);
-    // check
+    post_check(rhs, solution, opts, default_opts);
+  } // ... apply(...)
+
+  template <class VectorType>
+  void apply(const ListVectorArray<VectorType>& rhs, ListVectorArray<VectorType>& solution) const
+  {
+    apply(rhs, solution, types()[0]);
+  }
+
+  template <class VectorType>
+  void
+  apply(const ListVectorArray<VectorType>& rhs, ListVectorArray<VectorType>& solution, const std::string& type) const
+  {
+    apply(rhs, solution, options(type));
+  }
+
+  //! \note The QR decomposition of the matrix is computed once for all right hand sides.
+  template <class VectorType>
+  std::enable_if_t<XT::Common::is_vector<VectorType>::value, void> apply(const ListVectorArray<VectorType>& rhs,
+                                                                         ListVectorArray<VectorType>& solution,
+                                                                         const Common::Configuration& opts) const
+  {
+    if (!opts.has_key("type"))
+      DUNE_THROW(Common::Exceptions::configuration_error,
+                 "Given options (see below) need to have at least the key 'type' set!\n\n"
+                     << opts);
+    const auto type = opts.get<std::string>("type");
+    internal::SolverUtils::check_given(type, types());
+    const Common::Configuration default_opts = options(type);
+    internal::SolverUtils::check_given(rhs, solution);
+    // solve
+    auto writable_copy_of_matrix_ = matrix_;
+    std::vector<typename M::ScalarType> tau(M::cols(matrix_));
+    std::vector<int> permutations(M::cols(matrix_));
+    qr(writable_copy_of_matrix_, tau, permutations);
+    for (size_t jj = 0; jj < rhs.length(); ++jj) {
+      solve_qr_factorized(writable_copy_of_matrix_, tau, permutations, solution[jj].vector(), rhs[jj].vector());
+      post_check(rhs[jj].vector(), solution[jj].vector(), opts, default_opts);
+    }
+  } // ... apply(...)
+
+private:
+  template <class VectorType>
+  void post_check(const VectorType& rhs,
+                  const VectorType& solution,
+                  const Common::Configuration& opts,
+                  const Common::Configuration& default_opts) const
+  {
     const auto post_check_solves_system_threshold =
         opts.get("post_check_solves_system", default_opts.get<double>("post_check_solves_system"));
     if (post_check_solves_system_threshold > 0) {
@@ -123,9 +170,8 @@ public:
                        << "Those were the given options:\n\n"
                        << opts);
     }
-  } // ... apply(...)
+  } // ... post_check(...)
 
-private:
   const MatrixType& matrix_;
 }; // class Solver<...>
 
@@ -19,6 +19,8 @@
 #include <sstream>
 #include <cmath>
 #include <complex>
+#include <memory>
+#include <mutex>
 
 #if HAVE_EIGEN
 #  include <dune/xt/common/disable_warnings.hh>
@@ -39,6 +41,8 @@
 #  include <dune/xt/common/reenable_warnings.hh>
 #endif // HAVE_EIGEN
 
+#include <dune/common/timer.hh>
+
 #include <dune/xt/common/exceptions.hh>
 #include <dune/xt/common/configuration.hh>
 #include <dune/xt/la/container/eigen.hh>
@@ -122,6 +126,72 @@ public:
   template <class T1, class T2>
   void
   apply(const EigenBaseVector<T1, S>& rhs, EigenBaseVector<T2, S>& solution, const Common::Configuration& opts) const
+  {
+    const auto type = check_type(opts);
+    const Common::Configuration default_opts = options(type);
+    SolverStatisticsStorage::Recorder statistics(statistics_, type);
+    check_matrix(type, opts, default_opts);
+    const bool check_for_inf_nan = opts.get("check_for_inf_nan", default_opts.get<bool>("check_for_inf_nan"));
+    if (check_for_inf_nan)
+      check_rhs(rhs, opts);
+    solve(type, rhs.backend(), solution.backend(), *statistics);
+    statistics->iterations = 1;
+    if (check_for_inf_nan)
+      check_solution(rhs, solution, opts);
+    post_check(rhs, solution, opts, default_opts, *statistics);
+  } // ... apply(...)
+
+  template <class V>
+  void apply(const ListVectorArray<V>& rhs, ListVectorArray<V>& solution) const
+  {
+    apply(rhs, solution, types()[0]);
+  }
+
+  template <class V>
+  void apply(const ListVectorArray<V>& rhs, ListVectorArray<V>& solution, const std::string& type) const
+  {
+    apply(rhs, solution, options(type));
+  }
+
+  /**
+   * \note The decomposition of the matrix is computed once for all right hand sides, which are copied into a dense
+   *       block for that purpose.
+   */
+  template <class V>
+  void apply(const ListVectorArray<V>& rhs, ListVectorArray<V>& solution, const Common::Configuration& opts) const
+  {
+    const auto type = check_type(opts);
+    const Common::Configuration default_opts = options(type);
+    internal::SolverUtils::check_given(rhs, solution);
+    SolverStatisticsStorage::Recorder statistics(statistics_, type);
+    check_matrix(type, opts, default_opts);
+    const bool check_for_inf_nan = opts.get("check_for_inf_nan", default_opts.get<bool>("check_for_inf_nan"));
+    typedef ::Eigen::Matrix<S, ::Eigen::Dynamic, ::Eigen::Dynamic> BlockType;
+    BlockType rhs_block(matrix_.rows(), rhs.length());
+    for (size_t jj = 0; jj < rhs.length(); ++jj) {
+      if (check_for_inf_nan)
+        check_rhs(rhs[jj].vector(), opts);
+      rhs_block.col(jj) = rhs[jj].vector().backend();
+    }
+    BlockType solution_block(matrix_.cols(), rhs.length());
+    solve(type, rhs_block, solution_block, *statistics);
+    statistics->iterations = rhs.length();
+    for (size_t jj = 0; jj < rhs.length(); ++jj) {
+      solution[jj].vector().backend() = solution_block.col(jj);
+      if (check_for_inf_nan)
+        check_solution(rhs[jj].vector(), solution[jj].vector(), opts);
+      post_check(rhs[jj].vector(), solution[jj].vector(), opts, default_opts, *statistics);
+    }
+  } // ... apply(...)
+
+  //! \sa SolverStatistics
+  SolverStatistics statistics() const
+  {
+    return statistics_.get();
+  }
+
+private:
+  static std::string check_type(const Common::Configuration& opts)
   {
     if (!opts.has_key("type"))
       DUNE_THROW(Common::Exceptions::configuration_error,
@@ -129,7 +199,13 @@ public:
                      << opts);
     const auto type = opts.get<std::string>("type");
     internal::SolverUtils::check_given(type, types());
-    const Common::Configuration default_opts = options(type);
+    return type;
+  } // ... check_type(...)
+
+  void check_matrix(const std::string& type,
+                    const Common::Configuration& opts,
+                    const Common::Configuration& default_opts) const
+  {
     // check for inf or nan
     const bool check_for_inf_nan = opts.get("check_for_inf_nan", default_opts.get<bool>("check_for_inf_nan"));
     if (check_for_inf_nan) {
@@ -142,25 +218,12 @@ public:
                 << "If you want to disable this check, set 'check_for_inf_nan = 0' in the options.\n\n"
                 << "Those were the given options:\n\n"
                 << opts;
-            if (rhs.size() <= internal::max_size_to_print)
+            if (matrix_.rows() <= internal::max_size_to_print)
               msg << "\nThis was the given matrix:\n\n" << matrix_ << "\n";
             DUNE_THROW(Exceptions::linear_solver_failed_bc_data_did_not_fulfill_requirements, msg.str());
           }
         }
       }
-      for (size_t ii = 0; ii < rhs.size(); ++ii) {
-        const S val = rhs.get_entry(ii);
-        if (Common::isnan(val) || Common::isinf(val)) {
-          std::stringstream msg;
-          msg << "Given rhs contains inf or nan and you requested checking (see options below)!\n"
-              << "If you want to disable this check, set 'check_for_inf_nan = 0' in the options.\n\n"
-              << "Those were the given options:\n\n"
-              << opts;
-          if (rhs.size() <= internal::max_size_to_print)
-            msg << "\nThis was the given right hand side:\n\n" << rhs << "\n";
-          DUNE_THROW(Exceptions::linear_solver_failed_bc_data_did_not_fulfill_requirements, msg.str());
-        }
-      }
     }
     // check for symmetry (if solver needs it)
     if (type == "ldlt" || type == "llt") {
@@ -176,62 +239,120 @@ public:
               << "  (A - A').sup_norm() = " << error << "\n\n"
               << "Those were the given options:\n\n"
               << opts;
-          if (rhs.size() <= internal::max_size_to_print)
+          if (matrix_.rows() <= internal::max_size_to_print)
             msg << "\nThis was the given matrix A:\n\n" << matrix_ << "\n";
           DUNE_THROW(Exceptions::linear_solver_failed_bc_data_did_not_fulfill_requirements, msg.str());
         }
       }
     }
-    // solve
+  } // ... check_matrix(...)
+
+  template <class T1>
+  static void check_rhs(const EigenBaseVector<T1, S>& rhs, const Common::Configuration& opts)
+  {
+    for (size_t ii = 0; ii < rhs.size(); ++ii) {
+      const S val = rhs.get_entry(ii);
+      if (Common::isnan(val) || Common::isinf(val)) {
+        std::stringstream msg;
+        msg << "Given rhs contains inf or nan and you requested checking (see options below)!\n"
+            << "If you want to disable this check, set 'check_for_inf_nan = 0' in the options.\n\n"
+            << "Those were the given options:\n\n"
+            << opts;
+        if (rhs.size() <= internal::max_size_to_print)
+          msg << "\nThis was the given right hand side:\n\n" << rhs << "\n";
+        DUNE_THROW(Exceptions::linear_solver_failed_bc_data_did_not_fulfill_requirements, msg.str());
+      }
+    }
+  } // ... check_rhs(...)
+
+  template <class RhsType, class SolutionType>
+  void
+  solve(const std::string& type, const RhsType& rhs, SolutionType& solution, SolverStatistics& statistics) const
+  {
+    const auto& matrix = matrix_.backend();
     if (type == "qr.colpivhouseholder") {
-      solution.backend() = matrix_.backend().colPivHouseholderQr().solve(rhs.backend());
+      factorize_and_solve([&]() { return matrix.colPivHouseholderQr(); }, rhs, solution, statistics);
     } else if (type == "qr.fullpivhouseholder")
-      solution.backend() = matrix_.backend().fullPivHouseholderQr().solve(rhs.backend());
+      factorize_and_solve([&]() { return matrix.fullPivHouseholderQr(); }, rhs, solution, statistics);
     else if (type == "qr.householder")
-      solution.backend() = matrix_.backend().householderQr().solve(rhs.backend());
+      factorize_and_solve([&]() { return matrix.householderQr(); }, rhs, solution, statistics);
     else if (type == "lu.fullpiv")
-      solution.backend() = matrix_.backend().fullPivLu().solve(rhs.backend());
+      factorize_and_solve([&]() { return matrix.fullPivLu(); }, rhs, solution, statistics);
     else if (type == "llt")
-      solution.backend() = matrix_.backend().llt().solve(rhs.backend());
+      factorize_and_solve([&]() { return matrix.llt(); }, rhs, solution, statistics);
     else if (type == "ldlt")
-      solution.backend() = matrix_.backend().ldlt().solve(rhs.backend());
+      factorize_and_solve([&]() { return matrix.ldlt(); }, rhs, solution, statistics);
     else if (type == "lu.partialpiv")
-      solution.backend() = matrix_.backend().partialPivLu().solve(rhs.backend());
+      factorize_and_solve([&]() { return matrix.partialPivLu(); }, rhs, solution, statistics);
     else
       DUNE_THROW(Common::Exceptions::internal_error,
                  "Given type '" << type << "' is not supported, although it was reported by types()!");
-    // check
-    if (check_for_inf_nan)
-      for (size_t ii = 0; ii < solution.size(); ++ii) {
-        const S val = solution.get_entry(ii);
-        if (Common::isnan(val) || Common::isinf(val)) {
-          std::stringstream msg;
-          msg << "The computed solution contains inf or nan and you requested checking (see options "
-              << "below)!\n"
-              << "If you want to disable this check, set 'check_for_inf_nan = 0' in the options.\n\n"
-              << "Those were the given options:\n\n"
-              << opts;
-          if (rhs.size() <= internal::max_size_to_print)
-            msg << "\nThis was the given matrix A:\n\n"
-                << matrix_ << "\nThis was the given right hand side b:\n\n"
-                << rhs << "\nThis is the computed solution:\n\n"
-                << solution << "\n";
-          DUNE_THROW(Exceptions::linear_solver_failed_bc_data_did_not_fulfill_requirements, msg.str());
-        }
+  } // ... solve(...)
+
+  //! Times the decomposition (given by factorize) and the solve separately.
+  template <class FactorizationType, class RhsType, class SolutionType>
+  void factorize_and_solve(const FactorizationType& factorize,
+                           const RhsType& rhs,
+                           SolutionType& solution,
+                           SolverStatistics& statistics) const
+  {
+    Timer timer;
+    const auto decomposition = factorize();
+    statistics.setup_time = timer.elapsed();
+    timer.reset();
+    solution = decomposition.solve(rhs);
+    statistics.solve_time = timer.elapsed();
+  } // ... factorize_and_solve(...)
+
+  template <class T1, class T2>
+  void check_solution(const EigenBaseVector<T1, S>& rhs,
+                      const EigenBaseVector<T2, S>& solution,
+                      const Common::Configuration& opts) const
+  {
+    for (size_t ii = 0; ii < solution.size(); ++ii) {
+      const S val = solution.get_entry(ii);
+      if (Common::isnan(val) || Common::isinf(val)) {
+        std::stringstream msg;
+        msg << "The computed solution contains inf or nan and you requested checking (see options "
+            << "below)!\n"
+            << "If you want to disable this check, set 'check_for_inf_nan = 0' in the options.\n\n"
+            << "Those were the given options:\n\n"
+            << opts;
+        if (rhs.size() <= internal::max_size_to_print)
+          msg << "\nThis was the given matrix A:\n\n"
+              << matrix_ << "\nThis was the given right hand side b:\n\n"
+              << rhs << "\nThis is the computed solution:\n\n"
+              << solution << "\n";
+        DUNE_THROW(Exceptions::linear_solver_failed_bc_data_did_not_fulfill_requirements, msg.str());
       }
+    }
+  } // ... check_solution(...)
+
+  template <class T1, class T2>
+  void post_check(const EigenBaseVector<T1, S>& rhs,
+                  const EigenBaseVector<T2, S>& solution,
+                  const Common::Configuration& opts,
+                  const Common::Configuration& default_opts,
+                  SolverStatistics& statistics) const
+  {
     const R post_check_solves_system_threshold =
         opts.get("post_check_solves_system", default_opts.get<R>("post_check_solves_system"));
     if (post_check_solves_system_threshold > 0) {
-      auto tmp = rhs.copy();
-      tmp.backend() = matrix_.backend() * solution.backend() - rhs.backend();
-      const R sup_norm = tmp.sup_norm();
+      Timer timer;
+      // the residual is kept to avoid allocations, resize() does nothing if the size did not change
+      typename internal::ScratchVector<ResidualType>::Access residual(residual_);
+      residual->resize(matrix_.rows());
+      residual->noalias() = matrix_.backend() * solution.backend();
+      *residual -= rhs.backend();
+      const R sup_norm = residual->template lpNorm<::Eigen::Infinity>();
+      statistics.post_check_time += timer.elapsed();
       if (sup_norm > post_check_solves_system_threshold || Common::isnan(sup_norm) || Common::isinf(sup_norm)) {
         std::stringstream msg;
         msg << "The computed solution does not solve the system (although the eigen backend reported "
             << "'Success') and you requested checking (see options below)!\n"
             << "If you want to disable this check, set 'post_check_solves_system = 0' in the options."
             << "\n\n"
-            << "  (A * x - b).sup_norm() = " << tmp.sup_norm() << "\n\n"
+            << "  (A * x - b).sup_norm() = " << sup_norm << "\n\n"
             << "Those were the given options:\n\n"
             << opts;
         if (rhs.size() <= internal::max_size_to_print)
@@ -242,10 +363,13 @@ public:
         DUNE_THROW(Exceptions::linear_solver_failed_bc_the_solution_does_not_solve_the_system, msg.str());
       }
     }
-  } // ... apply(...)
+  } // ... post_check(...)
+
+  typedef ::Eigen::Matrix<S, ::Eigen::Dynamic, 1> ResidualType;
 
-private:
   const MatrixType& matrix_;
+  SolverStatisticsStorage statistics_;
+  internal::ScratchVector<ResidualType> residual_;
 }; // class Solver
 
 
@@ -296,7 +420,9 @@ public:
     // default config
     Common::Configuration default_options({"type", "post_check_solves_system", "check_for_inf_nan"},
                                           {tp.c_str(), "1e-5", "1"});
-    Common::Configuration iterative_options({"max_iter", "precision"}, {"10000", "1e-10"});
+    // 'post_check_reuses_residual' skips computing the residual if the one estimated by the solver is small enough
+    Common::Configuration iterative_options({"max_iter", "precision", "post_check_reuses_residual"},
+                                            {"10000", "1e-10", "0"});
     iterative_options += default_options;
     // direct solvers
     if (tp == "lu.sparse" || tp == "qr.sparse" || tp == "lu.umfpack" || tp == "spqr" || tp == "llt.cholmodsupernodal"
@@ -318,16 +444,181 @@ public:
 };
 
 
+namespace internal {
+
+
+/**
+ * \brief Interface for the reusable state (factorization or preconditioner) of the sparse eigen solvers.
+ *
+ * Allows Solver<EigenRowMajorSparseMatrix<...>> to keep the result of analyze_pattern() and factorize() alive in
+ * between several calls to solve().
+ */
+template <class S>
+class EigenSparseSolverStorageInterface
+{
+public:
+  using MatrixType = typename EigenRowMajorSparseMatrix<S>::BackendType;
+  using VectorType = ::Eigen::Matrix<S, ::Eigen::Dynamic, 1>;
+
+  virtual ~EigenSparseSolverStorageInterface() = default;
+
+  virtual void analyze_pattern(const MatrixType& matrix) = 0;
+
+  virtual void factorize(const MatrixType& matrix) = 0;
+
+  virtual ::Eigen::ComputationInfo info() const = 0;
+
+  virtual void solve(const ::Eigen::Ref<const VectorType>& rhs, ::Eigen::Ref<VectorType> solution) const = 0;
+
+  //! The number of iterations of the last solve(), 1 for direct solvers.
+  virtual size_t iterations() const = 0;
+
+  //! The relative residual of the last solve() as estimated by the iterative solvers, negative for direct solvers.
+  virtual double error() const = 0;
+}; // class EigenSparseSolverStorageInterface
+
+
+/**
+ * \note Works on a column major copy of the matrix, as required by the sparse direct solvers of eigen.
+ */
+template <class S, class SolverImp>
+class EigenSparseDirectSolverStorage : public EigenSparseSolverStorageInterface<S>
+{
+  using BaseType = EigenSparseSolverStorageInterface<S>;
+  using ColMajorMatrixType = ::Eigen::SparseMatrix<S, ::Eigen::ColMajor>;
+
+public:
+  using typename BaseType::MatrixType;
+  using typename BaseType::VectorType;
+
+  EigenSparseDirectSolverStorage()
+    : colmajor_copy_is_current_(false)
+  {}
+
+  SolverImp& solver()
+  {
+    return solver_;
+  }
+
+  void analyze_pattern(const MatrixType& matrix) override final
+  {
+    copy(matrix);
+    solver_.analyzePattern(colmajor_copy_);
+    colmajor_copy_is_current_ = true;
+  }
+
+  void factorize(const MatrixType& matrix) override final
+  {
+    if (!colmajor_copy_is_current_)
+      copy(matrix);
+    solver_.factorize(colmajor_copy_);
+    colmajor_copy_is_current_ = false;
+  }
+
+  ::Eigen::ComputationInfo info() const override final
+  {
+    return solver_.info();
+  }
+
+  void solve(const ::Eigen::Ref<const VectorType>& rhs, ::Eigen::Ref<VectorType> solution) const override final
+  {
+    solution = solver_.solve(rhs);
+  }
+
+  size_t iterations() const override final
+  {
+    return 1;
+  }
+
+  double error() const override final
+  {
+    return -1.;
+  }
+
+private:
+  void copy(const MatrixType& matrix)
+  {
+    colmajor_copy_ = matrix;
+    colmajor_copy_.makeCompressed();
+  }
+
+  ColMajorMatrixType colmajor_copy_;
+  bool colmajor_copy_is_current_;
+  SolverImp solver_;
+}; // class EigenSparseDirectSolverStorage
+
+
+/**
+ * \note The iterative solvers of eigen keep a reference to the given matrix, which thus has to outlive this storage.
+ */
+template <class S, class SolverImp>
+class EigenSparseIterativeSolverStorage : public EigenSparseSolverStorageInterface<S>
+{
+  using BaseType = EigenSparseSolverStorageInterface<S>;
+
+public:
+  using typename BaseType::MatrixType;
+  using typename BaseType::VectorType;
+
+  SolverImp& solver()
+  {
+    return solver_;
+  }
+
+  void analyze_pattern(const MatrixType& matrix) override final
+  {
+    solver_.analyzePattern(matrix);
+  }
+
+  void factorize(const MatrixType& matrix) override final
+  {
+    solver_.factorize(matrix);
+  }
+
+  ::Eigen::ComputationInfo info() const override final
+  {
+    return solver_.info();
+  }
+
+  void solve(const ::Eigen::Ref<const VectorType>& rhs, ::Eigen::Ref<VectorType> solution) const override final
+  {
+    solution = solver_.solve(rhs);
+  }
+
+  size_t iterations() const override final
+  {
+    return static_cast<size_t>(solver_.iterations());
+  }
+
+  double error() const override final
+  {
+    return static_cast<double>(solver_.error());
+  }
+
+private:
+  SolverImp solver_;
+}; // class EigenSparseIterativeSolverStorage
+
+
+} // namespace internal
+
+
 /**
  *  \note lu.sparse will copy the matrix to column major
  *  \note qr.sparse will copy the matrix to column major
  *  \note ldlt.simplicial will copy the matrix to column major
  *  \note llt.simplicial will copy the matrix to column major
+ *  \note Call prepare() to compute the factorization (or preconditioner) once and reuse it in all subsequent calls to
+ *        apply() with the same type, e.g. for many right hand sides and a fixed matrix. Since changes to the matrix
+ *        are not detected, call update() (or invalidate()) after modifying the matrix. If the options given to apply()
+ *        differ from those given to prepare() in a way that affects the setup (e.g. the drop tolerance of
+ *        bicgstab.ilut), a temporary setup is computed instead.
  */
 template <class S, class CommunicatorType>
 class Solver<EigenRowMajorSparseMatrix<S>, CommunicatorType> : protected internal::SolverUtils
 {
   typedef ::Eigen::SparseMatrix<S, ::Eigen::ColMajor> ColMajorBackendType;
+  typedef internal::EigenSparseSolverStorageInterface<S> StorageType;
 
 public:
   typedef EigenRowMajorSparseMatrix<S> MatrixType;
@@ -345,6 +636,8 @@ public:
     : matrix_(matrix)
   {}
 
+  Solver(Solver&& source) = default;
+
   static std::vector<std::string> types()
   {
     return SolverOptions<MatrixType, CommunicatorType>::types();
@@ -355,6 +648,71 @@ public:
     return SolverOptions<MatrixType, CommunicatorType>::options(type);
   } // ... options(...)
 
+  void prepare()
+  {
+    prepare(types()[0]);
+  }
+
+  void prepare(const std::string& type)
+  {
+    prepare(options(type));
+  }
+
+  /**
+   * \brief Checks the matrix and computes the factorization (or preconditioner) of the given type, which is then
+   *        reused by all subsequent calls to apply() with the same type.
+   */
+  void prepare(const Common::Configuration& opts)
+  {
+    const auto type = check_type(opts);
+    const Common::Configuration default_opts = options(type);
+    SolverStatisticsStorage::Recorder statistics(statistics_, type);
+    storage_ = factorize(type, opts, default_opts, *statistics);
+    prepared_type_ = type;
+    prepared_opts_ = opts;
+    store_pattern();
+  } // ... prepare(...)
+
+  /**
+   * \brief Recomputes the factorization (or preconditioner) computed in prepare() after the entries of the matrix
+   *        have changed.
+   *
+   * If the sparsity pattern of the matrix is the same as in prepare(), only the numerical factorization is recomputed
+   * and the result of the symbolic analysis (i.e. the fill-reducing ordering and the elimination tree) is reused.
+   * Otherwise, this falls back to prepare() with the same options.
+   */
+  void update()
+  {
+    if (!prepared())
+      DUNE_THROW(Common::Exceptions::you_are_using_this_wrong, "Call prepare() before calling update()!");
+    if (pattern_changed()) {
+      prepare(prepared_opts_);
+      return;
+    }
+    const Common::Configuration default_opts = options(prepared_type_);
+    check_matrix(prepared_type_, prepared_opts_, default_opts);
+    SolverStatisticsStorage::Recorder statistics(statistics_, prepared_type_);
+    Timer timer;
+    storage_->factorize(matrix_.backend());
+    statistics->setup_time = timer.elapsed();
+    handle_info(storage_->info(), prepared_opts_);
+  } // ... update(...)
+
+  //! Drops the factorization (or preconditioner) computed in prepare().
+  void invalidate()
+  {
+    storage_ = nullptr;
+    prepared_type_.clear();
+    prepared_opts_ = Common::Configuration();
+    prepared_row_ends_.clear();
+    prepared_column_indices_.clear();
+  }
+
+  bool prepared() const
+  {
+    return storage_ != nullptr;
+  }
+
   template <class T1, class T2>
   void apply(const EigenBaseVector<T1, S>& rhs, EigenBaseVector<T2, S>& solution) const
   {
@@ -370,6 +728,217 @@ public:
   template <class T1, class T2>
   void
   apply(const EigenBaseVector<T1, S>& rhs, EigenBaseVector<T2, S>& solution, const Common::Configuration& opts) const
+  {
+    const auto type = check_type(opts);
+    const Common::Configuration default_opts = options(type);
+    SolverStatisticsStorage::Recorder statistics(statistics_, type);
+    if (reuses_setup(type, opts, default_opts)) {
+      statistics->setup_reused = true;
+      std::lock_guard<std::mutex> guard(storage_mutex_);
+      solve(*storage_, rhs, solution, opts, default_opts, *statistics);
+    } else
+      solve(*factorize(type, opts, default_opts, *statistics), rhs, solution, opts, default_opts, *statistics);
+  } // ... apply(...)
+
+  template <class V>
+  void apply(const ListVectorArray<V>& rhs, ListVectorArray<V>& solution) const
+  {
+    apply(rhs, solution, types()[0]);
+  }
+
+  template <class V>
+  void apply(const ListVectorArray<V>& rhs, ListVectorArray<V>& solution, const std::string& type) const
+  {
+    apply(rhs, solution, options(type));
+  }
+
+  //! \note The factorization (or preconditioner) is computed once for all right hand sides, if not prepared already.
+  template <class V>
+  void apply(const ListVectorArray<V>& rhs, ListVectorArray<V>& solution, const Common::Configuration& opts) const
+  {
+    const auto type = check_type(opts);
+    const Common::Configuration default_opts = options(type);
+    internal::SolverUtils::check_given(rhs, solution);
+    SolverStatisticsStorage::Recorder statistics(statistics_, type);
+    std::unique_ptr<StorageType> storage;
+    if (!reuses_setup(type, opts, default_opts))
+      storage = factorize(type, opts, default_opts, *statistics);
+    else
+      statistics->setup_reused = true;
+    const StorageType& actual_storage = storage ? *storage : *storage_;
+    std::unique_lock<std::mutex> guard(storage_mutex_, std::defer_lock);
+    if (!storage)
+      guard.lock();
+    for (size_t jj = 0; jj < rhs.length(); ++jj)
+      solve(actual_storage, rhs[jj].vector(), solution[jj].vector(), opts, default_opts, *statistics);
+  } // ... apply(...)
+
+  /**
+   * \sa SolverStatistics
+   * \note The iterative solvers of eigen do not provide a residual history, only the final relative residual is
+   *       available as reduction.
+   */
+  SolverStatistics statistics() const
+  {
+    return statistics_.get();
+  }
+
+private:
+  /**
+   * \brief Checks if the setup computed in prepare() may be used, i.e. if it was computed for the given type and for
+   *        the same options, as far as they affect the setup (the iterative solvers of eigen also keep max_iter and
+   *        precision).
+   */
+  bool reuses_setup(const std::string& type,
+                    const Common::Configuration& opts,
+                    const Common::Configuration& default_opts) const
+  {
+    return prepared() && type == prepared_type_
+           && internal::SolverUtils::setup_options_agree(
+                  opts,
+                  prepared_opts_,
+                  default_opts,
+                  {"max_iter", "precision", "preconditioner.drop_tol", "preconditioner.fill_factor"});
+  }
+
+  //! Stores the positions of the entries of the backend, to detect changes of the sparsity pattern in update().
+  void store_pattern()
+  {
+    typedef typename MatrixType::BackendType::InnerIterator InnerIterator;
+    const auto& matrix = matrix_.backend();
+    prepared_row_ends_.resize(matrix.outerSize());
+    prepared_column_indices_.clear();
+    prepared_column_indices_.reserve(matrix.nonZeros());
+    for (EIGEN_size_t ii = 0; ii < matrix.outerSize(); ++ii) {
+      for (InnerIterator it(matrix, ii); it; ++it)
+        prepared_column_indices_.push_back(it.index());
+      prepared_row_ends_[ii] = prepared_column_indices_.size();
+    }
+  } // ... store_pattern(...)
+
+  //! Compares the positions of the entries of the backend with those stored in prepare(), without temporaries.
+  bool pattern_changed() const
+  {
+    typedef typename MatrixType::BackendType::InnerIterator InnerIterator;
+    const auto& matrix = matrix_.backend();
+    if (size_t(matrix.outerSize()) != prepared_row_ends_.size()
+        || size_t(matrix.nonZeros()) != prepared_column_indices_.size())
+      return true;
+    size_t kk = 0;
+    for (EIGEN_size_t ii = 0; ii < matrix.outerSize(); ++ii) {
+      for (InnerIterator it(matrix, ii); it; ++it, ++kk)
+        if (kk >= prepared_row_ends_[ii] || prepared_column_indices_[kk] != EIGEN_size_t(it.index()))
+          return true;
+      if (kk != prepared_row_ends_[ii])
+        return true;
+    }
+    return false;
+  } // ... pattern_changed(...)
+
+  //! Checks the matrix and computes a temporary factorization (or preconditioner).
+  std::unique_ptr<StorageType> factorize(const std::string& type,
+                                         const Common::Configuration& opts,
+                                         const Common::Configuration& default_opts,
+                                         SolverStatistics& statistics) const
+  {
+    check_matrix(type, opts, default_opts);
+    Timer timer;
+    auto storage = create_storage(type, opts, default_opts);
+    storage->analyze_pattern(matrix_.backend());
+    storage->factorize(matrix_.backend());
+    statistics.setup_time += timer.elapsed();
+    handle_info(storage->info(), opts);
+    return storage;
+  } // ... factorize(...)
+
+  template <class T1, class T2>
+  void solve(const StorageType& storage,
+             const EigenBaseVector<T1, S>& rhs,
+             EigenBaseVector<T2, S>& solution,
+             const Common::Configuration& opts,
+             const Common::Configuration& default_opts,
+             SolverStatistics& statistics) const
+  {
+    // check for inf or nan
+    const bool check_for_inf_nan = opts.get("check_for_inf_nan", default_opts.get<bool>("check_for_inf_nan"));
+    if (check_for_inf_nan) {
+      for (size_t ii = 0; ii < rhs.size(); ++ii) {
+        const S val = rhs.get_entry(ii);
+        if (Common::isnan(val) || Common::isinf(val))
+          DUNE_THROW(Exceptions::linear_solver_failed_bc_data_did_not_fulfill_requirements,
+                     "Given rhs contains inf or nan and you requested checking (see options below)!\n"
+                         << "If you want to disable this check, set 'check_for_inf_nan = 0' in the options.\n\n"
+                         << "Those were the given options:\n\n"
+                         << opts);
+      }
+    }
+    // solve
+    Timer timer;
+    storage.solve(rhs.backend(), solution.backend());
+    statistics.solve_time += timer.elapsed();
+    statistics.iterations += storage.iterations();
+    statistics.reduction = std::max(statistics.reduction, storage.error());
+    handle_info(storage.info(), opts);
+    // check
+    if (check_for_inf_nan)
+      for (size_t ii = 0; ii < solution.size(); ++ii) {
+        const S& val = solution.get_entry(ii);
+        if (Common::isnan(val) || Common::isinf(val))
+          DUNE_THROW(Exceptions::linear_solver_failed_bc_data_did_not_fulfill_requirements,
+                     "The computed solution contains inf or nan and you requested checking (see options "
+                         << "below)!\n"
+                         << "If you want to disable this check, set 'check_for_inf_nan = 0' in the options.\n\n"
+                         << "Those were the given options:\n\n"
+                         << opts);
+      }
+    const R post_check_solves_system_threshold =
+        opts.get("post_check_solves_system", default_opts.get<R>("post_check_solves_system"));
+    if (post_check_solves_system_threshold > 0) {
+      timer.reset();
+      // the relative residual estimated by the iterative solvers is measured in the 2-norm, which bounds the sup-norm
+      const bool reuse_residual =
+          opts.get("post_check_reuses_residual", default_opts.get("post_check_reuses_residual", false));
+      if (reuse_residual && storage.error() >= 0
+          && storage.error() * rhs.backend().norm() <= post_check_solves_system_threshold) {
+        statistics.post_check_time += timer.elapsed();
+        return;
+      }
+      const R sup_norm = residual_sup_norm(rhs, solution);
+      statistics.post_check_time += timer.elapsed();
+      if (sup_norm > post_check_solves_system_threshold || Common::isnan(sup_norm) || Common::isinf(sup_norm))
+        DUNE_THROW(Exceptions::linear_solver_failed_bc_the_solution_does_not_solve_the_system,
+                   "The computed solution does not solve the system (although the eigen backend reported "
+                       << "'Success') and you requested checking (see options below)!\n"
+                       << "If you want to disable this check, set 'post_check_solves_system = 0' in the options."
+                       << "\n\n"
+                       << "  (A * x - b).sup_norm() = " << sup_norm << "\n\n"
+                       << "Those were the given options:\n\n"
+                       << opts);
+    }
+  } // ... solve(...)
+
+  //! Computes (A * x - b).sup_norm() in one pass over the rows of A, without temporaries.
+  template <class T1, class T2>
+  R residual_sup_norm(const EigenBaseVector<T1, S>& rhs, const EigenBaseVector<T2, S>& solution) const
+  {
+    typedef typename MatrixType::BackendType::InnerIterator InnerIterator;
+    const auto& matrix = matrix_.backend();
+    const auto& bb = rhs.backend();
+    const auto& xx = solution.backend();
+    R ret = 0;
+    for (EIGEN_size_t ii = 0; ii < matrix.outerSize(); ++ii) {
+      S value = -bb(ii);
+      for (InnerIterator it(matrix, ii); it; ++it)
+        value += it.value() * xx(it.index());
+      const R abs_value = std::abs(value);
+      if (Common::isnan(abs_value))
+        return abs_value;
+      ret = std::max(ret, abs_value);
+    }
+    return ret;
+  } // ... residual_sup_norm(...)
+
+  static std::string check_type(const Common::Configuration& opts)
   {
     if (!opts.has_key("type"))
       DUNE_THROW(Common::Exceptions::configuration_error,
@@ -377,7 +946,13 @@ public:
                      << opts);
     const auto type = opts.get<std::string>("type");
     internal::SolverUtils::check_given(type, types());
-    const Common::Configuration default_opts = options(type);
+    return type;
+  } // ... check_type(...)
+
+  void check_matrix(const std::string& type,
+                    const Common::Configuration& opts,
+                    const Common::Configuration& default_opts) const
+  {
     // check for inf or nan
     const bool check_for_inf_nan = opts.get("check_for_inf_nan", default_opts.get<bool>("check_for_inf_nan"));
     if (check_for_inf_nan) {
@@ -394,15 +969,6 @@ public:
                            << opts);
         }
       }
-      for (size_t ii = 0; ii < rhs.size(); ++ii) {
-        const S val = rhs.get_entry(ii);
-        if (Common::isnan(val) || Common::isinf(val))
-          DUNE_THROW(Exceptions::linear_solver_failed_bc_data_did_not_fulfill_requirements,
-                     "Given rhs contains inf or nan and you requested checking (see options below)!\n"
-                         << "If you want to disable this check, set 'check_for_inf_nan = 0' in the options.\n\n"
-                         << "Those were the given options:\n\n"
-                         << opts);
-      }
     }
     // check for symmetry (if solver needs it)
     if (type.substr(0, 3) == "cg." || type == "ldlt.simplicial" || type == "llt.simplicial") {
@@ -425,144 +991,91 @@ public:
         }
       }
     }
-    ::Eigen::ComputationInfo info;
+  } // ... check_matrix(...)
+
+  template <class SolverType>
+  static std::unique_ptr<StorageType> create_iterative_storage(const Common::Configuration& opts,
+                                                               const Common::Configuration& default_opts)
+  {
+    auto storage = std::make_unique<internal::EigenSparseIterativeSolverStorage<S, SolverType>>();
+    storage->solver().setMaxIterations(opts.get("max_iter", default_opts.get<int>("max_iter")));
+    storage->solver().setTolerance(opts.get("precision", default_opts.get<R>("precision")));
+    return std::move(storage);
+  }
+
+  static std::unique_ptr<StorageType> create_storage(const std::string& type,
+                                                     const Common::Configuration& opts,
+                                                     const Common::Configuration& default_opts)
+  {
+    typedef typename MatrixType::BackendType RowMajorBackendType;
     if (type == "cg.diagonal.lower") {
-      typedef ::Eigen::
-          ConjugateGradient<typename MatrixType::BackendType, ::Eigen::Lower, ::Eigen::DiagonalPreconditioner<S>>
-              SolverType;
-      SolverType solver(matrix_.backend());
-      solver.setMaxIterations(opts.get("max_iter", default_opts.get<int>("max_iter")));
-      solver.setTolerance(opts.get("precision", default_opts.get<R>("precision")));
-      solution.backend() = solver.solve(rhs.backend());
-      info = solver.info();
+      return create_iterative_storage<
+          ::Eigen::ConjugateGradient<RowMajorBackendType, ::Eigen::Lower, ::Eigen::DiagonalPreconditioner<S>>>(
+          opts, default_opts);
     } else if (type == "cg.diagonal.upper") {
-      typedef ::Eigen::
-          ConjugateGradient<typename MatrixType::BackendType, ::Eigen::Upper, ::Eigen::DiagonalPreconditioner<S>>
-              SolverType;
-      SolverType solver(matrix_.backend());
-      solver.setMaxIterations(opts.get("max_iter", default_opts.get<int>("max_iter")));
-      solver.setTolerance(opts.get("precision", default_opts.get<R>("precision")));
-      solution.backend() = solver.solve(rhs.backend());
-      info = solver.info();
+      return create_iterative_storage<
+          ::Eigen::ConjugateGradient<RowMajorBackendType, ::Eigen::Upper, ::Eigen::DiagonalPreconditioner<S>>>(
+          opts, default_opts);
     } else if (type == "cg.identity.lower") {
-      typedef ::Eigen::
-          ConjugateGradient<typename MatrixType::BackendType, ::Eigen::Lower, ::Eigen::IdentityPreconditioner>
-              SolverType;
-      SolverType solver(matrix_.backend());
-      solver.setMaxIterations(opts.get("max_iter", default_opts.get<int>("max_iter")));
-      solver.setTolerance(opts.get("precision", default_opts.get<R>("precision")));
-      solution.backend() = solver.solve(rhs.backend());
-      info = solver.info();
+      return create_iterative_storage<
+          ::Eigen::ConjugateGradient<RowMajorBackendType, ::Eigen::Lower, ::Eigen::IdentityPreconditioner>>(
+          opts, default_opts);
     } else if (type == "cg.identity.upper") {
-      typedef ::Eigen::
-          ConjugateGradient<typename MatrixType::BackendType, ::Eigen::Lower, ::Eigen::IdentityPreconditioner>
-              SolverType;
-      SolverType solver(matrix_.backend());
-      solver.setMaxIterations(opts.get("max_iter", default_opts.get<int>("max_iter")));
-      solver.setTolerance(opts.get("precision", default_opts.get<R>("precision")));
-      solution.backend() = solver.solve(rhs.backend());
-      info = solver.info();
+      return create_iterative_storage<
+          ::Eigen::ConjugateGradient<RowMajorBackendType, ::Eigen::Upper, ::Eigen::IdentityPreconditioner>>(
+          opts, default_opts);
     } else if (type == "bicgstab.ilut") {
-      typedef ::Eigen::BiCGSTAB<typename MatrixType::BackendType, ::Eigen::IncompleteLUT<S>> SolverType;
-      SolverType solver(matrix_.backend());
-      solver.setMaxIterations(opts.get("max_iter", default_opts.get<int>("max_iter")));
-      solver.setTolerance(opts.get("precision", default_opts.get<R>("precision")));
-      solver.preconditioner().setDroptol(
+      typedef ::Eigen::BiCGSTAB<RowMajorBackendType, ::Eigen::IncompleteLUT<S>> SolverType;
+      auto storage = std::make_unique<internal::EigenSparseIterativeSolverStorage<S, SolverType>>();
+      storage->solver().setMaxIterations(opts.get("max_iter", default_opts.get<int>("max_iter")));
+      storage->solver().setTolerance(opts.get("precision", default_opts.get<R>("precision")));
+      storage->solver().preconditioner().setDroptol(
           opts.get("preconditioner.drop_tol", default_opts.get<R>("preconditioner.drop_tol")));
-      solver.preconditioner().setFillfactor(
+      storage->solver().preconditioner().setFillfactor(
           opts.get("preconditioner.fill_factor", default_opts.get<int>("preconditioner.fill_factor")));
-      solution.backend() = solver.solve(rhs.backend());
-      info = solver.info();
+      return std::move(storage);
     } else if (type == "bicgstab.diagonal") {
-      typedef ::Eigen::BiCGSTAB<typename MatrixType::BackendType, ::Eigen::DiagonalPreconditioner<S>> SolverType;
-      SolverType solver(matrix_.backend());
-      solver.setMaxIterations(opts.get("max_iter", default_opts.get<int>("max_iter")));
-      solver.setTolerance(opts.get("precision", default_opts.get<R>("precision")));
-      solution.backend() = solver.solve(rhs.backend());
-      info = solver.info();
+      return create_iterative_storage<::Eigen::BiCGSTAB<RowMajorBackendType, ::Eigen::DiagonalPreconditioner<S>>>(
+          opts, default_opts);
     } else if (type == "bicgstab.identity") {
-      typedef ::Eigen::BiCGSTAB<typename MatrixType::BackendType, ::Eigen::IdentityPreconditioner> SolverType;
-      SolverType solver(matrix_.backend());
-      solver.setMaxIterations(opts.get("max_iter", default_opts.get<int>("max_iter")));
-      solver.setTolerance(opts.get("precision", default_opts.get<R>("precision")));
-      solution.backend() = solver.solve(rhs.backend());
-      info = solver.info();
+      return create_iterative_storage<::Eigen::BiCGSTAB<RowMajorBackendType, ::Eigen::IdentityPreconditioner>>(
+          opts, default_opts);
     } else if (type == "lu.sparse") {
-      ColMajorBackendType colmajor_copy(matrix_.backend());
-      colmajor_copy.makeCompressed();
       typedef ::Eigen::SparseLU<ColMajorBackendType> SolverType;
-      SolverType solver;
-      solver.analyzePattern(colmajor_copy);
-      solver.factorize(colmajor_copy);
-      solution.backend() = solver.solve(rhs.backend());
-      info = solver.info();
+      return std::make_unique<internal::EigenSparseDirectSolverStorage<S, SolverType>>();
     } else if (type == "qr.sparse") {
-      ColMajorBackendType colmajor_copy(matrix_.backend());
-      colmajor_copy.makeCompressed();
       typedef ::Eigen::SparseQR<ColMajorBackendType, ::Eigen::COLAMDOrdering<int>> SolverType;
-      SolverType solver;
-      solver.analyzePattern(colmajor_copy);
-      solver.factorize(colmajor_copy);
-      solution.backend() = solver.solve(rhs.backend());
-      info = solver.info();
+      return std::make_unique<internal::EigenSparseDirectSolverStorage<S, SolverType>>();
     } else if (type == "ldlt.simplicial") {
-      ColMajorBackendType colmajor_copy(matrix_.backend());
-      colmajor_copy.makeCompressed();
       typedef ::Eigen::SimplicialLDLT<ColMajorBackendType> SolverType;
-      SolverType solver;
-      solver.analyzePattern(colmajor_copy);
-      solver.factorize(colmajor_copy);
-      solution.backend() = solver.solve(rhs.backend());
-      info = solver.info();
+      return std::make_unique<internal::EigenSparseDirectSolverStorage<S, SolverType>>();
     } else if (type == "llt.simplicial") {
-      ColMajorBackendType colmajor_copy(matrix_.backend());
-      colmajor_copy.makeCompressed();
       typedef ::Eigen::SimplicialLLT<ColMajorBackendType> SolverType;
-      SolverType solver;
-      solver.analyzePattern(colmajor_copy);
-      solver.factorize(colmajor_copy);
-      solution.backend() = solver.solve(rhs.backend());
-      info = solver.info();
+      return std::make_unique<internal::EigenSparseDirectSolverStorage<S, SolverType>>();
       //#if HAVE_UMFPACK
       //    } else if (type == "lu.umfpack") {
-      //      typedef ::Eigen::UmfPackLU< typename MatrixType::BackendType > SolverType;
-      //      SolverType solver;
-      //      solver.analyzePattern(matrix_.backend());
-      //      solver.factorize(matrix_.backend());
-      //      solution.backend() = solver.solve(rhs.backend());
-      //      info = solver.info();
+      //      return std::make_unique<internal::EigenSparseDirectSolverStorage<
+      //          S, ::Eigen::UmfPackLU<ColMajorBackendType>>>();
       //#endif // HAVE_UMFPACK
       //    } else if (type == "spqr") {
-      //      ColMajorBackendType colmajor_copy(matrix_.backend());
-      //      colmajor_copy.makeCompressed();
-      //      typedef ::Eigen::SPQR< ColMajorBackendType > SolverType;
-      //      SolverType solver;
-      //      solver.analyzePattern(colmajor_copy);
-      //      solver.factorize(colmajor_copy);
-      //      solution.backend() = solver.solve(rhs.backend());
-      //      if (solver.info() != ::Eigen::Success)
-      //        return solver.info();
+      //      return std::make_unique<internal::EigenSparseDirectSolverStorage<
+      //          S, ::Eigen::SPQR<ColMajorBackendType>>>();
       //    } else if (type == "cholmodsupernodalllt") {
-      //      typedef ::Eigen::CholmodSupernodalLLT< typename MatrixType::BackendType > SolverType;
-      //      SolverType solver;
-      //      solver.analyzePattern(matrix_.backend());
-      //      solver.factorize(matrix_.backend());
-      //      solution.backend() = solver.solve(rhs.backend());
-      //      if (solver.info() != ::Eigen::Success)
-      //        return solver.info();
+      //      return std::make_unique<internal::EigenSparseDirectSolverStorage<
+      //          S, ::Eigen::CholmodSupernodalLLT<ColMajorBackendType>>>();
       //#if HAVE_SUPERLU
       //    } else if (type == "superlu") {
-      //      typedef ::Eigen::SuperLU< typename MatrixType::BackendType > SolverType;
-      //      SolverType solver;
-      //      solver.analyzePattern(matrix_.backend());
-      //      solver.factorize(matrix_.backend());
-      //      solution.backend() = solver.solve(rhs.backend());
-      //      info = solver.info();
+      //      return std::make_unique<internal::EigenSparseDirectSolverStorage<
+      //          S, ::Eigen::SuperLU<ColMajorBackendType>>>();
       //#endif // HAVE_SUPERLU
     } else
       DUNE_THROW(Common::Exceptions::internal_error,
                  "Given type '" << type << "' is not supported, although it was reported by types()!");
-    // handle eigens info
+    return nullptr;
+  } // ... create_storage(...)
+
+  static void handle_info(const ::Eigen::ComputationInfo& info, const Common::Configuration& opts)
+  {
     if (info != ::Eigen::Success) {
       if (info == ::Eigen::NumericalIssue)
         DUNE_THROW(Exceptions::linear_solver_failed_bc_data_did_not_fulfill_requirements,
@@ -590,38 +1103,18 @@ public:
                    "The eigen backend reported an unknown status!\n"
                        << "Please report this to the dune-xt developers!");
     }
-    // check
-    if (check_for_inf_nan)
-      for (size_t ii = 0; ii < solution.size(); ++ii) {
-        const S& val = solution.get_entry(ii);
-        if (Common::isnan(val) || Common::isinf(val))
-          DUNE_THROW(Exceptions::linear_solver_failed_bc_data_did_not_fulfill_requirements,
-                     "The computed solution contains inf or nan and you requested checking (see options "
-                         << "below)!\n"
-                         << "If you want to disable this check, set 'check_for_inf_nan = 0' in the options.\n\n"
-                         << "Those were the given options:\n\n"
-                         << opts);
-      }
-    const R post_check_solves_system_threshold =
-        opts.get("post_check_solves_system", default_opts.get<R>("post_check_solves_system"));
-    if (post_check_solves_system_threshold > 0) {
-      auto tmp = rhs.copy();
-      tmp.backend() = matrix_.backend() * solution.backend() - rhs.backend();
-      const R sup_norm = tmp.sup_norm();
-      if (sup_norm > post_check_solves_system_threshold || Common::isnan(sup_norm) || Common::isinf(sup_norm))
-        DUNE_THROW(Exceptions::linear_solver_failed_bc_the_solution_does_not_solve_the_system,
-                   "The computed solution does not solve the system (although the eigen backend reported "
-                       << "'Success') and you requested checking (see options below)!\n"
-                       << "If you want to disable this check, set 'post_check_solves_system = 0' in the options."
-                       << "\n\n"
-                       << "  (A * x - b).sup_norm() = " << tmp.sup_norm() << "\n\n"
-                       << "Those were the given options:\n\n"
-                       << opts);
-    }
-  } // ... apply(...)
+  } // ... handle_info(...)
 
-private:
   const MatrixType& matrix_;
+  std::unique_ptr<StorageType> storage_;
+  // the const apply() may be called concurrently, but the iterative solvers of eigen keep the iterations and the error
+  // of the last solve, so the calls using the prepared setup are carried out one after the other
+  mutable internal::SolverMutex storage_mutex_;
+  std::string prepared_type_;
+  Common::Configuration prepared_opts_;
+  std::vector<size_t> prepared_row_ends_;
+  std::vector<EIGEN_size_t> prepared_column_indices_;
+  SolverStatisticsStorage statistics_;
 }; // class Solver
 
 
@@ -15,6 +15,13 @@
 
 #include <type_traits>
 #include <cmath>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#include <dune/common/timer.hh>
 
 #include <dune/istl/operators.hh>
 #include <dune/istl/preconditioners.hh>
@@ -23,6 +30,10 @@
 #include <dune/istl/umfpack.hh>
 #include <dune/istl/superlu.hh>
 
+#if HAVE_UMFPACK
+#include <umfpack.h>
+#endif
+
 #include <dune/xt/common/exceptions.hh>
 #include <dune/xt/common/configuration.hh>
 
@@ -30,6 +41,7 @@
 
 #include "istl/amg.hh"
 #include "istl/preconditioners.hh"
+#include "istl/scalarproducts.hh"
 #include "../solver.hh"
 
 namespace Dune {
@@ -97,6 +109,297 @@ struct IstlSolverTraits<S, SequentialCommunication>
 };
 
 
+/**
+ * \brief Interface for the reusable state (factorization or preconditioner) of the dune-istl solvers.
+ *
+ * Allows Solver<IstlRowMajorSparseMatrix<...>> to keep its setup alive in between several calls to apply().
+ */
+template <class S>
+class IstlSolverStorageInterface
+{
+public:
+  typedef typename IstlDenseVector<S>::BackendType IstlVectorType;
+  typedef typename IstlRowMajorSparseMatrix<S>::BackendType IstlMatrixType;
+
+  virtual ~IstlSolverStorageInterface() = default;
+
+  //! Recomputes the setup after the entries (but not the sparsity pattern) of the matrix have changed.
+  virtual void update() = 0;
+
+  /**
+   * \note The rhs may be modified.
+   * \note Iterative solvers append the norms of the residuals to residual_history, if not nullptr.
+   */
+  virtual void apply(IstlVectorType& rhs,
+                     IstlVectorType& solution,
+                     const Common::Configuration& opts,
+                     const Common::Configuration& default_opts,
+                     InverseOperatorResult& result,
+                     std::vector<double>* residual_history) = 0;
+}; // class IstlSolverStorageInterface
+
+
+/**
+ * \brief Keeps the AMG hierarchy of the bicgstab.amg.* types alive.
+ */
+template <class S, class CommunicatorType>
+class IstlAmgSolverStorage : public IstlSolverStorageInterface<S>
+{
+  typedef IstlSolverStorageInterface<S> BaseType;
+
+public:
+  using typename BaseType::IstlVectorType;
+
+  IstlAmgSolverStorage(const IstlRowMajorSparseMatrix<S>& matrix,
+                       const CommunicatorType& communicator,
+                       const Common::Configuration& opts,
+                       const Common::Configuration& default_opts,
+                       const std::string& smoother_type)
+    : applicator_(matrix, communicator)
+  {
+    applicator_.prepare(opts, default_opts, smoother_type);
+  }
+
+  void update() override final
+  {
+    applicator_.update();
+  }
+
+  void apply(IstlVectorType& rhs,
+             IstlVectorType& solution,
+             const Common::Configuration& opts,
+             const Common::Configuration& default_opts,
+             InverseOperatorResult& result,
+             std::vector<double>* residual_history) override final
+  {
+    result = applicator_.call_prepared(rhs, solution, opts, default_opts, residual_history);
+  }
+
+private:
+  AmgApplicator<S, CommunicatorType> applicator_;
+}; // class IstlAmgSolverStorage
+
+
+#if HAVE_UMFPACK
+
+
+/**
+ * \brief Uses the UMFPack wrapper of dune-istl.
+ * \note  Since the wrapper does not give access to the symbolic factorization, update() recomputes everything.
+ */
+template <class S>
+class IstlUmfpackSolverStorage : public IstlSolverStorageInterface<S>
+{
+  typedef IstlSolverStorageInterface<S> BaseType;
+
+public:
+  using typename BaseType::IstlMatrixType;
+  using typename BaseType::IstlVectorType;
+
+  IstlUmfpackSolverStorage(const IstlMatrixType& matrix, const int verbose)
+    : matrix_(matrix)
+    , solver_(matrix_, verbose)
+  {}
+
+  void update() override final
+  {
+    solver_.setMatrix(matrix_);
+  }
+
+  void apply(IstlVectorType& rhs,
+             IstlVectorType& solution,
+             const Common::Configuration& /*opts*/,
+             const Common::Configuration& /*default_opts*/,
+             InverseOperatorResult& result,
+             std::vector<double>* /*residual_history*/) override final
+  {
+    solver_.apply(solution, rhs, result);
+  }
+
+private:
+  const IstlMatrixType& matrix_;
+  UMFPack<IstlMatrixType> solver_;
+}; // class IstlUmfpackSolverStorage
+
+
+/**
+ * \brief Calls UMFPACK directly to keep the symbolic factorization alive, update() only recomputes the numerical one.
+ *
+ * The row major matrix is handed over as is, which UMFPACK interprets as the column major storage of its transpose.
+ * We thus solve the transposed system with respect to the factorization, which amounts to solving the original one.
+ */
+template <>
+class IstlUmfpackSolverStorage<double> : public IstlSolverStorageInterface<double>
+{
+  typedef IstlSolverStorageInterface<double> BaseType;
+
+public:
+  using typename BaseType::IstlMatrixType;
+  using typename BaseType::IstlVectorType;
+
+  IstlUmfpackSolverStorage(const IstlMatrixType& matrix, const int verbose)
+    : matrix_(matrix)
+    , verbose_(verbose)
+    , symbolic_(nullptr)
+    , numeric_(nullptr)
+  {
+    if (matrix_.N() != matrix_.M())
+      DUNE_THROW(Exceptions::linear_solver_failed_bc_data_did_not_fulfill_requirements,
+                 "UMFPACK requires a square matrix, the given one is " << matrix_.N() << "x" << matrix_.M() << "!");
+    if (matrix_.N() > size_t(std::numeric_limits<int>::max())
+        || matrix_.nonzeroes() > size_t(std::numeric_limits<int>::max()))
+      DUNE_THROW(Exceptions::linear_solver_failed_bc_data_did_not_fulfill_requirements,
+                 "The given matrix is too large for UMFPACK (with 32 bit indices)!");
+    umfpack_di_defaults(control_);
+    // copy the pattern
+    row_pointers_.resize(matrix_.N() + 1);
+    column_indices_.resize(matrix_.nonzeroes());
+    values_.resize(matrix_.nonzeroes());
+    int kk = 0;
+    for (auto row_it = matrix_.begin(); row_it != matrix_.end(); ++row_it) {
+      row_pointers_[row_it.index()] = kk;
+      for (auto col_it = row_it->begin(); col_it != row_it->end(); ++col_it)
+        column_indices_[kk++] = static_cast<int>(col_it.index());
+    }
+    row_pointers_[matrix_.N()] = kk;
+    copy_values();
+    double info[UMFPACK_INFO];
+    const int n = static_cast<int>(matrix_.N());
+    const int status = umfpack_di_symbolic(
+        n, n, row_pointers_.data(), column_indices_.data(), values_.data(), &symbolic_, control_, info);
+    check_status(status, "umfpack_di_symbolic");
+    factorize();
+  } // IstlUmfpackSolverStorage(...)
+
+  IstlUmfpackSolverStorage(const IstlUmfpackSolverStorage& other) = delete;
+
+  IstlUmfpackSolverStorage& operator=(const IstlUmfpackSolverStorage& other) = delete;
+
+  ~IstlUmfpackSolverStorage()
+  {
+    if (numeric_)
+      umfpack_di_free_numeric(&numeric_);
+    if (symbolic_)
+      umfpack_di_free_symbolic(&symbolic_);
+  }
+
+  void update() override final
+  {
+    copy_values();
+    factorize();
+  }
+
+  void apply(IstlVectorType& rhs,
+             IstlVectorType& solution,
+             const Common::Configuration& /*opts*/,
+             const Common::Configuration& /*default_opts*/,
+             InverseOperatorResult& result,
+             std::vector<double>* /*residual_history*/) override final
+  {
+    result.clear();
+    if (rhs.size() == 0) {
+      result.converged = true;
+      return;
+    }
+    double info[UMFPACK_INFO];
+    const int status = umfpack_di_solve(UMFPACK_At,
+                                        row_pointers_.data(),
+                                        column_indices_.data(),
+                                        values_.data(),
+                                        reinterpret_cast<double*>(&solution[0]),
+                                        reinterpret_cast<const double*>(&rhs[0]),
+                                        numeric_,
+                                        control_,
+                                        info);
+    check_status(status, "umfpack_di_solve");
+    result.iterations = 1;
+    result.converged = (status == UMFPACK_OK);
+  } // ... apply(...)
+
+private:
+  void copy_values()
+  {
+    size_t kk = 0;
+    for (auto row_it = matrix_.begin(); row_it != matrix_.end(); ++row_it)
+      for (auto col_it = row_it->begin(); col_it != row_it->end(); ++col_it)
+        values_[kk++] = (*col_it)[0][0];
+  }
+
+  void factorize()
+  {
+    if (numeric_)
+      umfpack_di_free_numeric(&numeric_);
+    double info[UMFPACK_INFO];
+    const int status = umfpack_di_numeric(
+        row_pointers_.data(), column_indices_.data(), values_.data(), symbolic_, &numeric_, control_, info);
+    check_status(status, "umfpack_di_numeric");
+    if (verbose_ > 0)
+      umfpack_di_report_info(control_, info);
+  }
+
+  static void check_status(const int status, const std::string& function)
+  {
+    if (status < 0)
+      DUNE_THROW(Exceptions::linear_solver_failed, "UMFPACK reported error " << status << " in " << function << "!");
+  }
+
+  const IstlMatrixType& matrix_;
+  const int verbose_;
+  double control_[UMFPACK_CONTROL];
+  void* symbolic_;
+  void* numeric_;
+  std::vector<int> row_pointers_;
+  std::vector<int> column_indices_;
+  std::vector<double> values_;
+}; // class IstlUmfpackSolverStorage<double>
+
+
+#endif // HAVE_UMFPACK
+#if HAVE_SUPERLU
+
+
+/**
+ * \note Since the SuperLU wrapper of dune-istl does not give access to the symbolic factorization, update()
+ *       recomputes everything.
+ */
+template <class S>
+class IstlSuperLUSolverStorage : public IstlSolverStorageInterface<S>
+{
+  typedef IstlSolverStorageInterface<S> BaseType;
+
+public:
+  using typename BaseType::IstlMatrixType;
+  using typename BaseType::IstlVectorType;
+
+  IstlSuperLUSolverStorage(const IstlMatrixType& matrix, const int verbose)
+    : matrix_(matrix)
+    , solver_(matrix_, verbose)
+  {}
+
+  void update() override final
+  {
+    solver_.setMatrix(matrix_);
+  }
+
+  void apply(IstlVectorType& rhs,
+             IstlVectorType& solution,
+             const Common::Configuration& /*opts*/,
+             const Common::Configuration& /*default_opts*/,
+             InverseOperatorResult& result,
+             std::vector<double>* /*residual_history*/) override final
+  {
+    solver_.apply(solution, rhs, result);
+  }
+
+private:
+  const IstlMatrixType& matrix_;
+  SuperLU<IstlMatrixType> solver_;
+}; // class IstlSuperLUSolverStorage
+
+
+#endif // HAVE_SUPERLU
+
+
 } // namespace internal
 
 
@@ -127,7 +430,9 @@ public:
     const std::string tp = !type.empty() ? type : types()[0];
     internal::SolverUtils::check_given(tp, types());
     Common::Configuration general_opts({"type", "post_check_solves_system", "verbose"}, {tp.c_str(), "1e-5", "0"});
-    Common::Configuration iterative_options({"max_iter", "precision"}, {"10000", "1e-10"});
+    // 'post_check_reuses_residual' skips computing the residual if the last one of the Krylov solver is small enough
+    Common::Configuration iterative_options({"max_iter", "precision", "post_check_reuses_residual"},
+                                            {"10000", "1e-10", "0"});
     iterative_options += general_opts;
     if (tp.substr(0, 13) == "bicgstab.amg." || tp == "bicgstab" || tp == "cg") {
       iterative_options.set("smoother.iterations", "1");
@@ -140,6 +445,8 @@ public:
       iterative_options.set("preconditioner.anisotropy_dim", "2"); // <- this should be the dimDomain of the problem!
       iterative_options.set("preconditioner.isotropy_dim", "2"); // <- this as well
       iterative_options.set("preconditioner.verbose", "0");
+      if (tp.substr(0, 13) == "bicgstab.amg.")
+        iterative_options.set("preconditioner.reuse_hierarchy", "0"); // <- only used in update(), see AmgApplicator
       return iterative_options;
     } else if (tp == "bicgstab.ilut" || tp == "bicgstab.ssor") {
       iterative_options.set("preconditioner.iterations", "2");
@@ -160,9 +467,18 @@ public:
 }; // class SolverOptions
 
 
+/**
+ * \note Call prepare() to compute the factorization once and reuse it in all subsequent calls to apply() with the same
+ *       type, e.g. for many right hand sides and a fixed matrix. Since changes to the matrix are not detected, call
+ *       update() (or invalidate()) after modifying the matrix. Only umfpack, superlu and bicgstab.amg.* (which keep the
+ *       AMG hierarchy) have a setup to reuse, prepare() has no effect for the other types. If the AMG options given to
+ *       apply() differ from those given to prepare(), a temporary hierarchy is built instead.
+ */
 template <class S, class CommunicatorType>
 class Solver<IstlRowMajorSparseMatrix<S>, CommunicatorType> : protected internal::SolverUtils
 {
+  typedef internal::IstlSolverStorageInterface<S> StorageType;
+
 public:
   typedef IstlRowMajorSparseMatrix<S> MatrixType;
   typedef typename MatrixType::RealType R;
@@ -189,6 +505,92 @@ public:
     return SolverOptions<MatrixType, CommunicatorType>::options(type);
   } // ... options(...)
 
+  void prepare()
+  {
+    prepare(types()[0]);
+  }
+
+  void prepare(const std::string& type)
+  {
+    prepare(options(type));
+  }
+
+  /**
+   * \brief Computes the setup (e.g., the factorization) of the given type, which is then reused by all subsequent
+   *        calls to apply() with the same type.
+   */
+  void prepare(const Common::Configuration& opts)
+  {
+    const auto type = check_type(opts);
+    const Common::Configuration default_opts = options(type);
+    SolverStatisticsStorage::Recorder statistics(statistics_, type);
+    try {
+      storage_ = create_storage(type, opts, default_opts, *statistics);
+    } catch (ISTLError& e) {
+      DUNE_THROW(Exceptions::linear_solver_failed,
+                 "The dune-istl backend reported: " << e.what() << "Those were the given options:\n\n"
+                                                    << opts);
+    }
+    prepared_type_ = type;
+    prepared_opts_ = opts;
+    store_pattern();
+  } // ... prepare(...)
+
+  /**
+   * \brief Recomputes the setup computed in prepare() after the entries of the matrix have changed.
+   *
+   * If the sparsity pattern of the matrix is the same as in prepare(), the symbolic factorization is reused where
+   * the backend allows it (umfpack with double), otherwise this falls back to prepare() with the same options. For
+   * bicgstab.amg.*, the AMG hierarchy is rebuilt, unless 'preconditioner.reuse_hierarchy' was set in prepare(), in
+   * which case the aggregates are kept and only the Galerkin products of the coarser levels are recomputed, see
+   * AmgApplicator::update().
+   */
+  void update()
+  {
+    if (!prepared())
+      DUNE_THROW(Common::Exceptions::you_are_using_this_wrong, "Call prepare() before calling update()!");
+    if (pattern_changed()) {
+      prepare(prepared_opts_);
+      return;
+    }
+    SolverStatisticsStorage::Recorder statistics(statistics_, prepared_type_);
+    if (storage_) {
+      try {
+        Timer timer;
+        storage_->update();
+        statistics->setup_time = timer.elapsed();
+      } catch (ISTLError& e) {
+        DUNE_THROW(Exceptions::linear_solver_failed,
+                   "The dune-istl backend reported: " << e.what() << "Those were the given options:\n\n"
+                                                      << prepared_opts_);
+      }
+    }
+  } // ... update(...)
+
+  //! Recomputes the setup from scratch, using the options given to prepare().
+  void recompute()
+  {
+    if (!prepared())
+      DUNE_THROW(Common::Exceptions::you_are_using_this_wrong, "Call prepare() before calling recompute()!");
+    const auto opts = prepared_opts_;
+    prepare(opts);
+  }
+
+  //! Drops the setup computed in prepare().
+  void invalidate()
+  {
+    storage_ = nullptr;
+    prepared_type_.clear();
+    prepared_opts_ = Common::Configuration();
+    prepared_row_ends_.clear();
+    prepared_column_indices_.clear();
+  }
+
+  bool prepared() const
+  {
+    return !prepared_type_.empty();
+  }
+
   void apply(const IstlDenseVector<S>& rhs, IstlDenseVector<S>& solution) const
   {
     apply(rhs, solution, types()[0]);
@@ -214,6 +616,168 @@ public:
    *  \note does a copy of the rhs
    */
   void apply(const IstlDenseVector<S>& rhs, IstlDenseVector<S>& solution, const Common::Configuration& opts) const
+  {
+    try {
+      const auto type = check_type(opts);
+      const Common::Configuration default_opts = options(type);
+      SolverStatisticsStorage::Recorder statistics(statistics_, type);
+      if (reuses_setup(type, opts, default_opts)) {
+        statistics->setup_reused = true;
+        const auto guard = lock_storage(storage_.get());
+        solve(storage_.get(), rhs, solution, type, opts, default_opts, *statistics);
+      } else
+        solve(create_storage(type, opts, default_opts, *statistics).get(),
+              rhs,
+              solution,
+              type,
+              opts,
+              default_opts,
+              *statistics);
+    } catch (ISTLError& e) {
+      DUNE_THROW(Exceptions::linear_solver_failed,
+                 "The dune-istl backend reported: " << e.what() << "Those were the given options:\n\n"
+                                                    << opts);
+    }
+  } // ... apply(...)
+
+  void apply(const ListVectorArray<IstlDenseVector<S>>& rhs, ListVectorArray<IstlDenseVector<S>>& solution) const
+  {
+    apply(rhs, solution, types()[0]);
+  }
+
+  void apply(const ListVectorArray<IstlDenseVector<S>>& rhs,
+             ListVectorArray<IstlDenseVector<S>>& solution,
+             const std::string& type) const
+  {
+    apply(rhs, solution, options(type));
+  }
+
+  /**
+   * \note The setup (see prepare()) is computed once for all right hand sides, if not prepared already. For the types
+   *       without a setup, the right hand sides are solved for one after the other.
+   */
+  void apply(const ListVectorArray<IstlDenseVector<S>>& rhs,
+             ListVectorArray<IstlDenseVector<S>>& solution,
+             const Common::Configuration& opts) const
+  {
+    try {
+      const auto type = check_type(opts);
+      const Common::Configuration default_opts = options(type);
+      internal::SolverUtils::check_given(rhs, solution);
+      SolverStatisticsStorage::Recorder statistics(statistics_, type);
+      std::unique_ptr<StorageType> storage;
+      StorageType* actual_storage = storage_.get();
+      if (!reuses_setup(type, opts, default_opts)) {
+        storage = create_storage(type, opts, default_opts, *statistics);
+        actual_storage = storage.get();
+      } else
+        statistics->setup_reused = true;
+      const auto guard = lock_storage(actual_storage);
+      for (size_t jj = 0; jj < rhs.length(); ++jj)
+        solve(actual_storage, rhs[jj].vector(), solution[jj].vector(), type, opts, default_opts, *statistics);
+    } catch (ISTLError& e) {
+      DUNE_THROW(Exceptions::linear_solver_failed,
+                 "The dune-istl backend reported: " << e.what() << "Those were the given options:\n\n"
+                                                    << opts);
+    }
+  } // ... apply(...)
+
+  /**
+   * \sa SolverStatistics
+   * \note For the types without a setup to reuse (see prepare()), the setup time is the time to compute the
+   *       preconditioner of bicgstab.ilut and bicgstab.ssor and zero otherwise.
+   * \note The residual history contains one norm per iteration for cg and two norms per iteration (one for each half
+   *       step) for bicgstab.*, in addition to the initial residual. It is empty for umfpack and superlu.
+   */
+  SolverStatistics statistics() const
+  {
+    return statistics_.get();
+  }
+
+private:
+  static std::string check_type(const Common::Configuration& opts)
+  {
+    if (!opts.has_key("type"))
+      DUNE_THROW(Common::Exceptions::configuration_error,
+                 "Given options (see below) need to have at least the key 'type' set!\n\n"
+                     << opts);
+    const auto type = opts.get<std::string>("type");
+    internal::SolverUtils::check_given(type, types());
+    return type;
+  } // ... check_type(...)
+
+  //! Checks if the setup computed in prepare() was computed for the given type and the same setup options.
+  bool reuses_setup(const std::string& type,
+                    const Common::Configuration& opts,
+                    const Common::Configuration& default_opts) const
+  {
+    return storage_ && type == prepared_type_
+           && internal::SolverUtils::setup_options_agree(opts,
+                                                         prepared_opts_,
+                                                         default_opts,
+                                                         {"smoother.iterations",
+                                                          "smoother.relaxation_factor",
+                                                          "preconditioner.max_level",
+                                                          "preconditioner.coarse_target",
+                                                          "preconditioner.min_coarse_rate",
+                                                          "preconditioner.prolong_damp",
+                                                          "preconditioner.anisotropy_dim",
+                                                          "preconditioner.isotropy_dim"});
+  } // ... reuses_setup(...)
+
+  //! Stores the positions of the entries of the backend, to detect changes of the sparsity pattern in update().
+  void store_pattern()
+  {
+    const auto& matrix = matrix_.backend();
+    prepared_row_ends_.resize(matrix.N());
+    prepared_column_indices_.clear();
+    prepared_column_indices_.reserve(matrix.nonzeroes());
+    for (auto row_it = matrix.begin(); row_it != matrix.end(); ++row_it) {
+      for (auto col_it = row_it->begin(); col_it != row_it->end(); ++col_it)
+        prepared_column_indices_.push_back(col_it.index());
+      prepared_row_ends_[row_it.index()] = prepared_column_indices_.size();
+    }
+  } // ... store_pattern(...)
+
+  //! Compares the positions of the entries of the backend with those stored in prepare(), without temporaries.
+  bool pattern_changed() const
+  {
+    const auto& matrix = matrix_.backend();
+    if (matrix.N() != prepared_row_ends_.size() || matrix.nonzeroes() != prepared_column_indices_.size())
+      return true;
+    size_t kk = 0;
+    for (auto row_it = matrix.begin(); row_it != matrix.end(); ++row_it) {
+      const size_t row_end = prepared_row_ends_[row_it.index()];
+      for (auto col_it = row_it->begin(); col_it != row_it->end(); ++col_it, ++kk)
+        if (kk >= row_end || prepared_column_indices_[kk] != col_it.index())
+          return true;
+      if (kk != row_end)
+        return true;
+    }
+    return false;
+  } // ... pattern_changed(...)
+
+  /**
+   * \brief Locks the setup computed in prepare(), if it is the given storage.
+   *
+   * The const apply() may be called concurrently, but the prepared setup keeps work state (e.g., the AMG hierarchy), so
+   * the calls using it are carried out one after the other.
+   */
+  std::unique_lock<std::mutex> lock_storage(const StorageType* storage) const
+  {
+    if (storage != nullptr && storage == storage_.get())
+      return std::unique_lock<std::mutex>(storage_mutex_);
+    return std::unique_lock<std::mutex>();
+  } // ... lock_storage(...)
+
+  //! \note Uses the given storage if not nullptr.
+  void solve(StorageType* storage,
+             const IstlDenseVector<S>& rhs,
+             IstlDenseVector<S>& solution,
+             const std::string& type,
+             const Common::Configuration& opts,
+             const Common::Configuration& default_opts,
+             SolverStatistics& statistics) const
   {
     using Traits = internal::IstlSolverTraits<S, CommunicatorType>;
     using IstlVectorType = typename Traits::IstlVectorType;
@@ -222,133 +786,199 @@ public:
     using CgSolverType = CGSolver<IstlVectorType>;
 
     InverseOperatorResult solver_result;
-    auto scalar_product = Traits::make_scalarproduct(communicator_.access());
-
-    try {
-      if (!opts.has_key("type"))
-        DUNE_THROW(Common::Exceptions::configuration_error,
-                   "Given options (see below) need to have at least the key 'type' set!\n\n"
-                       << opts);
-      const auto type = opts.get<std::string>("type");
-      internal::SolverUtils::check_given(type, types());
-      const Common::Configuration default_opts = options(type);
-      IstlDenseVector<S> writable_rhs = rhs.copy();
-
-      if (type.substr(0, 13) == "bicgstab.amg.") {
-        solver_result = AmgApplicator<S, CommunicatorType>(matrix_, communicator_.access())
-                            .call(writable_rhs, solution, opts, default_opts, type.substr(13));
-      } else if (type == "bicgstab.ilut") {
-        auto matrix_operator = Traits::make_operator(matrix_.backend(), communicator_.access());
-        typedef SeqILUn<typename MatrixType::BackendType, IstlVectorType, IstlVectorType> SequentialPreconditionerType;
-        SequentialPreconditionerType seq_preconditioner(
-            matrix_.backend(),
-            opts.get("preconditioner.iterations", default_opts.get<int>("preconditioner.iterations")),
-            opts.get("preconditioner.relaxation_factor", default_opts.get<S>("preconditioner.relaxation_factor")));
-        auto preconditioner = Traits::make_preconditioner(seq_preconditioner, communicator_.access());
-        BiCgSolverType solver(matrix_operator,
-                              scalar_product,
-                              preconditioner,
-                              opts.get("precision", default_opts.get<R>("precision")),
-                              opts.get("max_iter", default_opts.get<int>("max_iter")),
-                              verbosity(opts, default_opts));
-        solver.apply(solution.backend(), writable_rhs.backend(), solver_result);
-      } else if (type == "bicgstab.ssor") {
-        auto matrix_operator = Traits::make_operator(matrix_.backend(), communicator_.access());
-        typedef SeqSSOR<typename MatrixType::BackendType, IstlVectorType, IstlVectorType> SequentialPreconditionerType;
-        SequentialPreconditionerType seq_preconditioner(
-            matrix_.backend(),
-            opts.get("preconditioner.iterations", default_opts.get<int>("preconditioner.iterations")),
-            opts.get("preconditioner.relaxation_factor", default_opts.get<S>("preconditioner.relaxation_factor")));
-        auto preconditioner = Traits::make_preconditioner(seq_preconditioner, communicator_.access());
-        BiCgSolverType solver(matrix_operator,
-                              scalar_product,
-                              preconditioner,
-                              opts.get("precision", default_opts.get<S>("precision")),
-                              opts.get("max_iter", default_opts.get<int>("max_iter")),
-                              verbosity(opts, default_opts));
-        solver.apply(solution.backend(), writable_rhs.backend(), solver_result);
-      } else if (type == "bicgstab") {
-        auto matrix_operator = Traits::make_operator(matrix_.backend(), communicator_.access());
-        const auto cat = matrix_operator.category();
-        typedef IdentityPreconditioner<MatrixOperatorType> SequentialPreconditioner;
-        SequentialPreconditioner seq_preconditioner(cat);
-        auto preconditioner = Traits::make_preconditioner(seq_preconditioner, communicator_.access());
-        // define the BiCGStab as the actual solver
-        BiCgSolverType solver(matrix_operator,
-                              scalar_product,
-                              preconditioner,
-                              opts.get("precision", default_opts.get<S>("precision")),
-                              opts.get("max_iter", default_opts.get<int>("max_iter")),
-                              verbosity(opts, default_opts));
-        solver.apply(solution.backend(), writable_rhs.backend(), solver_result);
-      } else if (type == "cg") {
-        auto matrix_operator = Traits::make_operator(matrix_.backend(), communicator_.access());
-        const auto cat = matrix_operator.category();
-        typedef IdentityPreconditioner<MatrixOperatorType> SequentialPreconditioner;
-        SequentialPreconditioner seq_preconditioner(cat);
-        auto preconditioner = Traits::make_preconditioner(seq_preconditioner, communicator_.access());
-        // define the CG as the actual solver
-        CgSolverType solver(matrix_operator,
+    auto backend_scalar_product = Traits::make_scalarproduct(communicator_.access());
+    statistics.residual_history.clear();
+    internal::RecordingScalarProduct<IstlVectorType> scalar_product(backend_scalar_product,
+                                                                    &statistics.residual_history);
+    // the dune-istl solvers overwrite the rhs, the copy is kept to avoid allocations in subsequent calls
+    typename internal::ScratchVector<IstlDenseVector<S>>::Access scratch(writable_rhs_);
+    auto& writable_rhs = *scratch;
+    writable_rhs.backend() = rhs.backend();
+
+    Timer timer;
+    if (storage) {
+      storage->apply(
+          writable_rhs.backend(), solution.backend(), opts, default_opts, solver_result, &statistics.residual_history);
+    } else if (type == "bicgstab.ilut") {
+      auto matrix_operator = Traits::make_operator(matrix_.backend(), communicator_.access());
+      typedef SeqILUn<typename MatrixType::BackendType, IstlVectorType, IstlVectorType> SequentialPreconditionerType;
+      SequentialPreconditionerType seq_preconditioner(
+          matrix_.backend(),
+          opts.get("preconditioner.iterations", default_opts.get<int>("preconditioner.iterations")),
+          opts.get("preconditioner.relaxation_factor", default_opts.get<S>("preconditioner.relaxation_factor")));
+      auto preconditioner = Traits::make_preconditioner(seq_preconditioner, communicator_.access());
+      statistics.setup_time += timer.elapsed();
+      timer.reset();
+      BiCgSolverType solver(matrix_operator,
+                            scalar_product,
+                            preconditioner,
+                            opts.get("precision", default_opts.get<R>("precision")),
+                            opts.get("max_iter", default_opts.get<int>("max_iter")),
+                            verbosity(opts, default_opts));
+      solver.apply(solution.backend(), writable_rhs.backend(), solver_result);
+    } else if (type == "bicgstab.ssor") {
+      auto matrix_operator = Traits::make_operator(matrix_.backend(), communicator_.access());
+      typedef SeqSSOR<typename MatrixType::BackendType, IstlVectorType, IstlVectorType> SequentialPreconditionerType;
+      SequentialPreconditionerType seq_preconditioner(
+          matrix_.backend(),
+          opts.get("preconditioner.iterations", default_opts.get<int>("preconditioner.iterations")),
+          opts.get("preconditioner.relaxation_factor", default_opts.get<S>("preconditioner.relaxation_factor")));
+      auto preconditioner = Traits::make_preconditioner(seq_preconditioner, communicator_.access());
+      statistics.setup_time += timer.elapsed();
+      timer.reset();
+      BiCgSolverType solver(matrix_operator,
                             scalar_product,
                             preconditioner,
                             opts.get("precision", default_opts.get<S>("precision")),
                             opts.get("max_iter", default_opts.get<int>("max_iter")),
-                            verbosity(opts, default_opts),
-                            false);
-        solver.apply(solution.backend(), writable_rhs.backend(), solver_result);
-#if HAVE_UMFPACK
-      } else if (type == "umfpack") {
-        UMFPack<typename MatrixType::BackendType> solver(matrix_.backend(),
-                                                         opts.get("verbose", default_opts.get<int>("verbose")));
-        solver.apply(solution.backend(), writable_rhs.backend(), solver_result);
-#endif // HAVE_UMFPACK
-#if HAVE_SUPERLU
-      } else if (type == "superlu") {
-        SuperLU<typename MatrixType::BackendType> solver(matrix_.backend(),
-                                                         opts.get("verbose", default_opts.get<int>("verbose")));
-
-        solver.apply(solution.backend(), writable_rhs.backend(), solver_result);
-#endif // HAVE_SUPERLU
-      } else
-        DUNE_THROW(Common::Exceptions::internal_error,
-                   "Given type '" << type << "' is not supported, although it was reported by types()!");
-      if (!solver_result.converged)
-        DUNE_THROW(Exceptions::linear_solver_failed_bc_it_did_not_converge,
-                   "The dune-istl backend reported 'InverseOperatorResult.converged == false'!\n"
+                            verbosity(opts, default_opts));
+      solver.apply(solution.backend(), writable_rhs.backend(), solver_result);
+    } else if (type == "bicgstab") {
+      auto matrix_operator = Traits::make_operator(matrix_.backend(), communicator_.access());
+      const auto cat = matrix_operator.category();
+      typedef IdentityPreconditioner<MatrixOperatorType> SequentialPreconditioner;
+      SequentialPreconditioner seq_preconditioner(cat);
+      auto preconditioner = Traits::make_preconditioner(seq_preconditioner, communicator_.access());
+      // define the BiCGStab as the actual solver
+      BiCgSolverType solver(matrix_operator,
+                            scalar_product,
+                            preconditioner,
+                            opts.get("precision", default_opts.get<S>("precision")),
+                            opts.get("max_iter", default_opts.get<int>("max_iter")),
+                            verbosity(opts, default_opts));
+      solver.apply(solution.backend(), writable_rhs.backend(), solver_result);
+    } else if (type == "cg") {
+      auto matrix_operator = Traits::make_operator(matrix_.backend(), communicator_.access());
+      const auto cat = matrix_operator.category();
+      typedef IdentityPreconditioner<MatrixOperatorType> SequentialPreconditioner;
+      SequentialPreconditioner seq_preconditioner(cat);
+      auto preconditioner = Traits::make_preconditioner(seq_preconditioner, communicator_.access());
+      // define the CG as the actual solver
+      CgSolverType solver(matrix_operator,
+                          scalar_product,
+                          preconditioner,
+                          opts.get("precision", default_opts.get<S>("precision")),
+                          opts.get("max_iter", default_opts.get<int>("max_iter")),
+                          verbosity(opts, default_opts),
+                          false);
+      solver.apply(solution.backend(), writable_rhs.backend(), solver_result);
+    } else
+      DUNE_THROW(Common::Exceptions::internal_error,
+                 "Given type '" << type << "' is not supported, although it was reported by types()!");
+    statistics.solve_time += timer.elapsed();
+    statistics.iterations += solver_result.iterations;
+    statistics.reduction = std::max(statistics.reduction, static_cast<double>(solver_result.reduction));
+    if (!solver_result.converged)
+      DUNE_THROW(Exceptions::linear_solver_failed_bc_it_did_not_converge,
+                 "The dune-istl backend reported 'InverseOperatorResult.converged == false'!\n"
+                     << "Those were the given options:\n\n"
+                     << opts);
+
+    // check
+    const R post_check_solves_system_threshold =
+        opts.get("post_check_solves_system", default_opts.get<R>("post_check_solves_system"));
+    if (post_check_solves_system_threshold > 0) {
+      timer.reset();
+      // the Krylov solvers compute the 2-norm of their residual last, which bounds the sup-norm
+      const bool reuse_residual =
+          opts.get("post_check_reuses_residual", default_opts.get("post_check_reuses_residual", false));
+      if (reuse_residual && !statistics.residual_history.empty()
+          && statistics.residual_history.back() <= post_check_solves_system_threshold) {
+        statistics.post_check_time += timer.elapsed();
+        return;
+      }
+      const R sup_norm =
+          residual_sup_norm(rhs, solution, writable_rhs, std::is_same<CommunicatorType, SequentialCommunication>());
+      statistics.post_check_time += timer.elapsed();
+      if (sup_norm > post_check_solves_system_threshold || Common::isnan(sup_norm) || Common::isinf(sup_norm))
+        DUNE_THROW(Exceptions::linear_solver_failed_bc_the_solution_does_not_solve_the_system,
+                   "The computed solution does not solve the system (although the dune-istl backend "
+                       << "reported no error) and you requested checking (see options below)!\n"
+                       << "If you want to disable this check, set 'post_check_solves_system = 0' in the options."
+                       << "\n\n"
+                       << "  (A * x - b).sup_norm() = " << sup_norm << "\n\n"
                        << "Those were the given options:\n\n"
                        << opts);
+    }
+  } // ... solve(...)
 
-      // check (use writable_rhs as tmp)
-      const R post_check_solves_system_threshold =
-          opts.get("post_check_solves_system", default_opts.get<R>("post_check_solves_system"));
-      if (post_check_solves_system_threshold > 0) {
-        matrix_.mv(solution, writable_rhs);
-        //! TODO the additional copy to make the original rhs consistent is only necessary in parallel setups
-        auto tmp_rhs = rhs;
-        communicator_.access().copyOwnerToAll(writable_rhs.backend(), writable_rhs.backend());
-        communicator_.access().copyOwnerToAll(tmp_rhs.backend(), tmp_rhs.backend());
-        writable_rhs -= tmp_rhs;
-        const R sup_norm = writable_rhs.sup_norm();
-        if (sup_norm > post_check_solves_system_threshold || Common::isnan(sup_norm) || Common::isinf(sup_norm))
-          DUNE_THROW(Exceptions::linear_solver_failed_bc_the_solution_does_not_solve_the_system,
-                     "The computed solution does not solve the system (although the dune-istl backend "
-                         << "reported no error) and you requested checking (see options below)!\n"
-                         << "If you want to disable this check, set 'post_check_solves_system = 0' in the options."
-                         << "\n\n"
-                         << "  (A * x - b).sup_norm() = " << sup_norm << "\n\n"
-                         << "Those were the given options:\n\n"
-                         << opts);
-      }
-    } catch (ISTLError& e) {
-      DUNE_THROW(Exceptions::linear_solver_failed,
-                 "The dune-istl backend reported: " << e.what() << "Those were the given options:\n\n"
-                                                    << opts);
+  //! Computes (A * x - b).sup_norm() in one pass over the rows of A, without temporaries.
+  R residual_sup_norm(const IstlDenseVector<S>& rhs,
+                      const IstlDenseVector<S>& solution,
+                      IstlDenseVector<S>& /*writable_rhs*/,
+                      std::true_type /*sequential*/) const
+  {
+    const auto& matrix = matrix_.backend();
+    const auto& bb = rhs.backend();
+    const auto& xx = solution.backend();
+    R ret = 0;
+    for (auto row_it = matrix.begin(); row_it != matrix.end(); ++row_it) {
+      S value = -bb[row_it.index()][0];
+      for (auto col_it = row_it->begin(); col_it != row_it->end(); ++col_it)
+        value += (*col_it)[0][0] * xx[col_it.index()][0];
+      const R abs_value = std::abs(value);
+      if (Common::isnan(abs_value))
+        return abs_value;
+      ret = std::max(ret, abs_value);
     }
-  } // ... apply(...)
+    return ret;
+  } // ... residual_sup_norm(..., std::true_type)
+
+  //! Uses the copy of the rhs as storage for the residual, which has to be made consistent.
+  R residual_sup_norm(const IstlDenseVector<S>& rhs,
+                      const IstlDenseVector<S>& solution,
+                      IstlDenseVector<S>& writable_rhs,
+                      std::false_type /*sequential*/) const
+  {
+    matrix_.mv(solution, writable_rhs);
+    writable_rhs -= rhs;
+    // copyOwnerToAll is linear, so this is the same as making A * x and b consistent separately
+    communicator_.access().copyOwnerToAll(writable_rhs.backend(), writable_rhs.backend());
+    return writable_rhs.sup_norm();
+  } // ... residual_sup_norm(..., std::false_type)
+
+  //! Returns nullptr for types which do not keep a setup, adds the time to the setup time of the given statistics.
+  std::unique_ptr<StorageType> create_storage(const std::string& type,
+                                              const Common::Configuration& opts,
+                                              const Common::Configuration& default_opts,
+                                              SolverStatistics& statistics) const
+  {
+    Timer timer;
+    auto storage = create_storage_without_timing(type, opts, default_opts);
+    statistics.setup_time += timer.elapsed();
+    return storage;
+  }
+
+  std::unique_ptr<StorageType> create_storage_without_timing(const std::string& type,
+                                                             const Common::Configuration& opts,
+                                                             const Common::Configuration& default_opts) const
+  {
+    if (type.substr(0, 13) == "bicgstab.amg.")
+      return std::make_unique<internal::IstlAmgSolverStorage<S, CommunicatorType>>(
+          matrix_, communicator_.access(), opts, default_opts, type.substr(13));
+#if HAVE_UMFPACK
+    if (type == "umfpack")
+      return std::make_unique<internal::IstlUmfpackSolverStorage<S>>(
+          matrix_.backend(), opts.get("verbose", default_opts.get<int>("verbose")));
+#endif
+#if HAVE_SUPERLU
+    if (type == "superlu")
+      return std::make_unique<internal::IstlSuperLUSolverStorage<S>>(
+          matrix_.backend(), opts.get("verbose", default_opts.get<int>("verbose")));
+#endif
+    return nullptr;
+  } // ... create_storage_without_timing(...)
 
-private:
   const MatrixType& matrix_;
   const Common::ConstStorageProvider<CommunicatorType> communicator_;
+  std::unique_ptr<StorageType> storage_;
+  mutable internal::SolverMutex storage_mutex_;
+  std::string prepared_type_;
+  Common::Configuration prepared_opts_;
+  std::vector<size_t> prepared_row_ends_;
+  std::vector<size_t> prepared_column_indices_;
+  SolverStatisticsStorage statistics_;
+  internal::ScratchVector<IstlDenseVector<S>> writable_rhs_;
 }; // class Solver
 
 } // namespace LA
@@ -15,6 +15,9 @@
 
 #include <type_traits>
 #include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include <dune/istl/operators.hh>
 #include <dune/istl/solvers.hh>
@@ -27,6 +30,7 @@
 #include <dune/xt/la/container/istl.hh>
 
 #include "preconditioners.hh"
+#include "scalarproducts.hh"
 
 namespace Dune {
 namespace XT {
@@ -34,6 +38,13 @@ namespace LA {
 
 
 //! the general, parallel case
+/**
+ * \brief Applies a BiCGStab solver, preconditioned by an AMG.
+ *
+ * call() builds the AMG hierarchy (the coarsening, the Galerkin products and the smoothers) for the given options and
+ * discards it afterwards. To reuse the hierarchy for several solves, build it once in prepare() and solve with
+ * call_prepared(). Since changes to the matrix are not detected, call update() or recompute() after modifying it.
+ */
 template <class S, class CommunicatorType>
 class AmgApplicator
 {
@@ -41,6 +52,18 @@ class AmgApplicator
   typedef typename MatrixType::RealType R;
   typedef typename MatrixType::BackendType IstlMatrixType;
   typedef typename IstlDenseVector<S>::BackendType IstlVectorType;
+  typedef OverlappingSchwarzOperator<IstlMatrixType, IstlVectorType, IstlVectorType, CommunicatorType>
+      MatrixOperatorType;
+  // ILU0 as the smoother for the AMG
+  typedef SeqILU0<IstlMatrixType, IstlVectorType, IstlVectorType, 1> SequentialSmootherType_ILU;
+  typedef BlockPreconditioner<IstlVectorType, IstlVectorType, CommunicatorType, SequentialSmootherType_ILU>
+      SmootherType_ILU;
+  typedef Amg::AMG<MatrixOperatorType, IstlVectorType, SmootherType_ILU, CommunicatorType> PreconditionerType_ILU;
+  // SSOR as the smoother for the amg
+  typedef SeqSSOR<IstlMatrixType, IstlVectorType, IstlVectorType, 1> SequentialSmootherType_SSOR;
+  typedef BlockPreconditioner<IstlVectorType, IstlVectorType, CommunicatorType, SequentialSmootherType_SSOR>
+      SmootherType_SSOR;
+  typedef Amg::AMG<MatrixOperatorType, IstlVectorType, SmootherType_SSOR, CommunicatorType> PreconditionerType_SSOR;
 
 public:
   AmgApplicator(const MatrixType& matrix, const CommunicatorType& comm)
@@ -48,41 +71,110 @@ public:
     , communicator_(comm)
   {}
 
+  bool prepared() const
+  {
+    return setup_ != nullptr;
+  }
+
+  //! Builds the AMG hierarchy and keeps it for call_prepared().
+  void prepare(const Common::Configuration& opts,
+               const Common::Configuration& default_opts,
+               const std::string& smoother_type)
+  {
+    setup_ = build(opts, default_opts, smoother_type);
+    smoother_type_ = smoother_type;
+    opts_ = opts;
+    default_opts_ = default_opts;
+  }
+
+  /**
+   * \brief Updates the hierarchy after the entries of the matrix have changed.
+   *
+   * If 'preconditioner.reuse_hierarchy' was set in prepare(), the aggregates and the smoothers are kept and only the
+   * Galerkin products of the coarser levels are recomputed. The ssor smoothers refer to the matrices of the hierarchy
+   * and thus use the new entries, while the ilu0 smoothers and the coarse solver keep the factorizations of the old
+   * ones. Since the BiCGStab always uses the current matrix, the solution is still correct, only the convergence may
+   * deteriorate. Otherwise, this is the same as recompute().
+   */
+  void update()
+  {
+    if (!prepared())
+      DUNE_THROW(Common::Exceptions::you_are_using_this_wrong, "Call prepare() before calling update()!");
+    if (opts_.get("preconditioner.reuse_hierarchy", default_opts_.get<bool>("preconditioner.reuse_hierarchy"))) {
+      if (setup_->ilu_preconditioner)
+        setup_->ilu_preconditioner->recalculateHierarchy();
+      else
+        setup_->ssor_preconditioner->recalculateHierarchy();
+    } else
+      recompute();
+  } // ... update(...)
+
+  //! Rebuilds the hierarchy from scratch, using the options given to prepare().
+  void recompute()
+  {
+    if (!prepared())
+      DUNE_THROW(Common::Exceptions::you_are_using_this_wrong, "Call prepare() before calling recompute()!");
+    setup_ = build(opts_, default_opts_, smoother_type_);
+  }
+
   InverseOperatorResult call(IstlDenseVector<S>& rhs,
                              IstlDenseVector<S>& solution,
                              const Common::Configuration& opts,
                              const Common::Configuration& default_opts,
-                             const std::string& smoother_type)
+                             const std::string& smoother_type,
+                             std::vector<double>* residual_history = nullptr)
   {
-    // define the matrix operator
+    return call(rhs.backend(), solution.backend(), opts, default_opts, smoother_type, residual_history);
+  }
 
-    typedef OverlappingSchwarzOperator<IstlMatrixType, IstlVectorType, IstlVectorType, CommunicatorType>
-        MatrixOperatorType;
-    MatrixOperatorType matrix_operator(matrix_.backend(), communicator_);
+  /**
+   * \brief Builds the AMG hierarchy for the given options, solves and discards the hierarchy.
+   * \note  If given, the residual norms computed by the BiCGStab are appended to residual_history.
+   */
+  InverseOperatorResult call(IstlVectorType& rhs,
+                             IstlVectorType& solution,
+                             const Common::Configuration& opts,
+                             const Common::Configuration& default_opts,
+                             const std::string& smoother_type,
+                             std::vector<double>* residual_history = nullptr)
+  {
+    const auto setup = build(opts, default_opts, smoother_type);
+    return solve(*setup, rhs, solution, opts, default_opts, residual_history);
+  }
 
-    // define the scalar product
-    OverlappingSchwarzScalarProduct<IstlVectorType, CommunicatorType> scalar_product(communicator_);
-
-    // ILU0 as the smoother for the AMG
-    typedef SeqILU0<IstlMatrixType, IstlVectorType, IstlVectorType, 1> SequentialSmootherType_ILU;
-    typedef BlockPreconditioner<IstlVectorType, IstlVectorType, CommunicatorType, SequentialSmootherType_ILU>
-        SmootherType_ILU;
-    typename Amg::SmootherTraits<SmootherType_ILU>::Arguments smoother_parameters_ILU;
-    smoother_parameters_ILU.iterations =
-        opts.get("smoother.iterations", default_opts.get<size_t>("smoother.iterations"));
-    smoother_parameters_ILU.relaxationFactor =
-        opts.get("smoother.relaxation_factor", default_opts.get<S>("smoother.relaxation_factor"));
-    // SSOR as the smoother for the amg
-    typedef SeqSSOR<IstlMatrixType, IstlVectorType, IstlVectorType, 1> SequentialSmootherType_SSOR;
-    typedef BlockPreconditioner<IstlVectorType, IstlVectorType, CommunicatorType, SequentialSmootherType_SSOR>
-        SmootherType_SSOR;
-    typename Amg::SmootherTraits<SmootherType_SSOR>::Arguments smoother_parameters_SSOR;
-    smoother_parameters_SSOR.iterations =
-        opts.get("smoother.iterations", default_opts.get<size_t>("smoother.iterations"));
-    smoother_parameters_SSOR.relaxationFactor =
-        opts.get("smoother.relaxation_factor", default_opts.get<S>("smoother.relaxation_factor"));
-
-    // define the AMG as the preconditioner for the BiCGStab solver
+  /**
+   * \brief Solves using the hierarchy built in prepare(), only the options of the BiCGStab are taken from opts.
+   * \note  If given, the residual norms computed by the BiCGStab are appended to residual_history.
+   */
+  InverseOperatorResult call_prepared(IstlVectorType& rhs,
+                                      IstlVectorType& solution,
+                                      const Common::Configuration& opts,
+                                      const Common::Configuration& default_opts,
+                                      std::vector<double>* residual_history = nullptr)
+  {
+    if (!prepared())
+      DUNE_THROW(Common::Exceptions::you_are_using_this_wrong, "Call prepare() before calling call_prepared()!");
+    return solve(*setup_, rhs, solution, opts, default_opts, residual_history);
+  }
+
+protected:
+  const MatrixType& matrix_;
+  const CommunicatorType& communicator_;
+
+private:
+  struct Setup
+  {
+    std::unique_ptr<MatrixOperatorType> matrix_operator;
+    std::unique_ptr<PreconditionerType_ILU> ilu_preconditioner;
+    std::unique_ptr<PreconditionerType_SSOR> ssor_preconditioner;
+  };
+
+  std::unique_ptr<Setup> build(const Common::Configuration& opts,
+                               const Common::Configuration& default_opts,
+                               const std::string& smoother_type) const
+  {
+    auto setup = std::make_unique<Setup>();
+    setup->matrix_operator = std::make_unique<MatrixOperatorType>(matrix_.backend(), communicator_);
     Amg::Parameters amg_parameters(
         opts.get("preconditioner.max_level", default_opts.get<size_t>("preconditioner.max_level")),
         opts.get("preconditioner.coarse_target", default_opts.get<size_t>("preconditioner.coarse_target")),
@@ -95,53 +187,66 @@ public:
     amg_parameters.setDebugLevel(opts.get("preconditioner.verbose", default_opts.get<int>("preconditioner.verbose")));
     Amg::CoarsenCriterion<Amg::UnSymmetricCriterion<IstlMatrixType, Amg::FirstDiagonal>> amg_criterion(amg_parameters);
     if (smoother_type == "ilu0") {
-      typedef Amg::AMG<MatrixOperatorType, IstlVectorType, SmootherType_ILU, CommunicatorType> PreconditionerType_ILU;
-      PreconditionerType_ILU preconditioner(matrix_operator, amg_criterion, smoother_parameters_ILU, communicator_);
-
-      // define the BiCGStab as the actual solver
-      BiCGSTABSolver<IstlVectorType> solver(
-          matrix_operator,
-          scalar_product,
-          preconditioner,
-          opts.get("precision", default_opts.get<S>("precision")),
-          opts.get("max_iter", default_opts.get<size_t>("max_iter")),
-#if HAVE_MPI
-          (communicator_.communicator().rank() == 0) ? opts.get("verbose", default_opts.get<int>("verbose")) : 0
-#else // HAVE_MPI
-          opts.get("verbose", default_opts.get<int>("verbose"))
-#endif
-      );
-
-      InverseOperatorResult stats;
-      solver.apply(solution.backend(), rhs.backend(), stats);
-      return stats;
+      typename Amg::SmootherTraits<SmootherType_ILU>::Arguments smoother_parameters;
+      smoother_parameters.iterations = opts.get("smoother.iterations", default_opts.get<size_t>("smoother.iterations"));
+      smoother_parameters.relaxationFactor =
+          opts.get("smoother.relaxation_factor", default_opts.get<S>("smoother.relaxation_factor"));
+      setup->ilu_preconditioner = std::make_unique<PreconditionerType_ILU>(
+          *setup->matrix_operator, amg_criterion, smoother_parameters, communicator_);
     } else if (smoother_type == "ssor") {
-      typedef Amg::AMG<MatrixOperatorType, IstlVectorType, SmootherType_SSOR, CommunicatorType> PreconditionerType_SSOR;
-      PreconditionerType_SSOR preconditioner(matrix_operator, amg_criterion, smoother_parameters_ILU, communicator_);
-
-      // define the BiCGStab as the actual solver
-      BiCGSTABSolver<IstlVectorType> solver(
-          matrix_operator,
-          scalar_product,
-          preconditioner,
-          opts.get("precision", default_opts.get<S>("precision")),
-          opts.get("max_iter", default_opts.get<size_t>("max_iter")),
+      typename Amg::SmootherTraits<SmootherType_SSOR>::Arguments smoother_parameters;
+      smoother_parameters.iterations = opts.get("smoother.iterations", default_opts.get<size_t>("smoother.iterations"));
+      smoother_parameters.relaxationFactor =
+          opts.get("smoother.relaxation_factor", default_opts.get<S>("smoother.relaxation_factor"));
+      setup->ssor_preconditioner = std::make_unique<PreconditionerType_SSOR>(
+          *setup->matrix_operator, amg_criterion, smoother_parameters, communicator_);
+    } else
+      DUNE_THROW(Common::Exceptions::wrong_input_given, "Unknown smoother requested: " << smoother_type);
+    return setup;
+  } // ... build(...)
+
+  InverseOperatorResult solve(Setup& setup,
+                              IstlVectorType& rhs,
+                              IstlVectorType& solution,
+                              const Common::Configuration& opts,
+                              const Common::Configuration& default_opts,
+                              std::vector<double>* residual_history) const
+  {
+    // define the scalar product
+    OverlappingSchwarzScalarProduct<IstlVectorType, CommunicatorType> parallel_scalar_product(communicator_);
+    internal::RecordingScalarProduct<IstlVectorType> scalar_product(parallel_scalar_product, residual_history);
+    const auto verbose =
 #if HAVE_MPI
-          (communicator_.communicator().rank() == 0) ? opts.get("verbose", default_opts.get<int>("verbose")) : 0
+        (communicator_.communicator().rank() == 0) ? opts.get("verbose", default_opts.get<int>("verbose")) : 0;
 #else // HAVE_MPI
-          opts.get("verbose", default_opts.get<int>("verbose"))
+        opts.get("verbose", default_opts.get<int>("verbose"));
 #endif
-      );
+    InverseOperatorResult stats;
+    // define the BiCGStab as the actual solver
+    if (setup.ilu_preconditioner) {
+      BiCGSTABSolver<IstlVectorType> solver(*setup.matrix_operator,
+                                            scalar_product,
+                                            *setup.ilu_preconditioner,
+                                            opts.get("precision", default_opts.get<S>("precision")),
+                                            opts.get("max_iter", default_opts.get<size_t>("max_iter")),
+                                            verbose);
+      solver.apply(solution, rhs, stats);
+    } else {
+      BiCGSTABSolver<IstlVectorType> solver(*setup.matrix_operator,
+                                            scalar_product,
+                                            *setup.ssor_preconditioner,
+                                            opts.get("precision", default_opts.get<S>("precision")),
+                                            opts.get("max_iter", default_opts.get<size_t>("max_iter")),
+                                            verbose);
+      solver.apply(solution, rhs, stats);
+    }
+    return stats;
+  } // ... solve(...)
 
-      InverseOperatorResult stats;
-      solver.apply(solution.backend(), rhs.backend(), stats);
-      return stats;
-    } else
-      DUNE_THROW(Common::Exceptions::wrong_input_given, "Unknown smoother requested: " << smoother_type);
-  } // ... call(...)
-protected:
-  const MatrixType& matrix_;
-  const CommunicatorType& communicator_;
+  std::unique_ptr<Setup> setup_;
+  std::string smoother_type_;
+  Common::Configuration opts_;
+  Common::Configuration default_opts_;
 };
 
 //! specialization for our faux type \ref SequentialCommunication
@@ -152,6 +257,11 @@ class AmgApplicator<S, SequentialCommunication>
   typedef typename MatrixType::RealType R;
   typedef typename MatrixType::BackendType IstlMatrixType;
   typedef typename IstlDenseVector<S>::BackendType IstlVectorType;
+  typedef MatrixAdapter<IstlMatrixType, IstlVectorType, IstlVectorType> MatrixOperatorType;
+  typedef SeqILU0<IstlMatrixType, IstlVectorType, IstlVectorType> SmootherType_ILU;
+  typedef Amg::AMG<MatrixOperatorType, IstlVectorType, SmootherType_ILU> PreconditionerType_ILU;
+  typedef SeqSSOR<IstlMatrixType, IstlVectorType, IstlVectorType> SmootherType_SSOR;
+  typedef Amg::AMG<MatrixOperatorType, IstlVectorType, SmootherType_SSOR> PreconditionerType_SSOR;
 
 public:
   AmgApplicator(const MatrixType& matrix, const SequentialCommunication& comm)
@@ -159,19 +269,102 @@ public:
     , communicator_(comm)
   {}
 
+  bool prepared() const
+  {
+    return setup_ != nullptr;
+  }
+
+  //! Builds the AMG hierarchy and keeps it for call_prepared().
+  void prepare(const Common::Configuration& opts,
+               const Common::Configuration& default_opts,
+               const std::string& smoother_type)
+  {
+    setup_ = build(opts, default_opts, smoother_type);
+    smoother_type_ = smoother_type;
+    opts_ = opts;
+    default_opts_ = default_opts;
+  }
+
+  //! \sa AmgApplicator::update()
+  void update()
+  {
+    if (!prepared())
+      DUNE_THROW(Common::Exceptions::you_are_using_this_wrong, "Call prepare() before calling update()!");
+    if (opts_.get("preconditioner.reuse_hierarchy", default_opts_.get<bool>("preconditioner.reuse_hierarchy"))) {
+      if (setup_->ilu_preconditioner)
+        setup_->ilu_preconditioner->recalculateHierarchy();
+      else
+        setup_->ssor_preconditioner->recalculateHierarchy();
+    } else
+      recompute();
+  } // ... update(...)
+
+  //! Rebuilds the hierarchy from scratch, using the options given to prepare().
+  void recompute()
+  {
+    if (!prepared())
+      DUNE_THROW(Common::Exceptions::you_are_using_this_wrong, "Call prepare() before calling recompute()!");
+    setup_ = build(opts_, default_opts_, smoother_type_);
+  }
+
   InverseOperatorResult call(IstlDenseVector<S>& rhs,
                              IstlDenseVector<S>& solution,
                              const Common::Configuration& opts,
                              const Common::Configuration& default_opts,
-                             const std::string& smoother_type)
+                             const std::string& smoother_type,
+                             std::vector<double>* residual_history = nullptr)
   {
-    typedef MatrixAdapter<IstlMatrixType, IstlVectorType, IstlVectorType> MatrixOperatorType;
-    MatrixOperatorType matrix_operator(matrix_.backend());
+    return call(rhs.backend(), solution.backend(), opts, default_opts, smoother_type, residual_history);
+  }
 
-    // define the scalar product
-    Dune::SeqScalarProduct<typename IstlDenseVector<S>::BackendType> scalar_product;
+  /**
+   * \brief Builds the AMG hierarchy for the given options, solves and discards the hierarchy.
+   * \note  If given, the residual norms computed by the BiCGStab are appended to residual_history.
+   */
+  InverseOperatorResult call(IstlVectorType& rhs,
+                             IstlVectorType& solution,
+                             const Common::Configuration& opts,
+                             const Common::Configuration& default_opts,
+                             const std::string& smoother_type,
+                             std::vector<double>* residual_history = nullptr)
+  {
+    const auto setup = build(opts, default_opts, smoother_type);
+    return solve(*setup, rhs, solution, opts, default_opts, residual_history);
+  }
+
+  /**
+   * \brief Solves using the hierarchy built in prepare(), only the options of the BiCGStab are taken from opts.
+   * \note  If given, the residual norms computed by the BiCGStab are appended to residual_history.
+   */
+  InverseOperatorResult call_prepared(IstlVectorType& rhs,
+                                      IstlVectorType& solution,
+                                      const Common::Configuration& opts,
+                                      const Common::Configuration& default_opts,
+                                      std::vector<double>* residual_history = nullptr)
+  {
+    if (!prepared())
+      DUNE_THROW(Common::Exceptions::you_are_using_this_wrong, "Call prepare() before calling call_prepared()!");
+    return solve(*setup_, rhs, solution, opts, default_opts, residual_history);
+  }
+
+protected:
+  const MatrixType& matrix_;
+  const SequentialCommunication& communicator_;
+
+private:
+  struct Setup
+  {
+    std::unique_ptr<MatrixOperatorType> matrix_operator;
+    std::unique_ptr<PreconditionerType_ILU> ilu_preconditioner;
+    std::unique_ptr<PreconditionerType_SSOR> ssor_preconditioner;
+  };
 
-    // define the AMG as the preconditioner for the BiCGStab solver
+  std::unique_ptr<Setup> build(const Common::Configuration& opts,
+                               const Common::Configuration& default_opts,
+                               const std::string& smoother_type) const
+  {
+    auto setup = std::make_unique<Setup>();
+    setup->matrix_operator = std::make_unique<MatrixOperatorType>(matrix_.backend());
     Amg::Parameters amg_parameters(
         opts.get("preconditioner.max_level", default_opts.get<int>("preconditioner.max_level")),
         opts.get("preconditioner.coarse_target", default_opts.get<int>("preconditioner.coarse_target")),
@@ -183,50 +376,61 @@ public:
         opts.get("preconditioner.anisotropy_dim", default_opts.get<size_t>("preconditioner.anisotropy_dim")));
     amg_parameters.setDebugLevel(opts.get("preconditioner.verbose", default_opts.get<int>("preconditioner.verbose")));
     Amg::CoarsenCriterion<Amg::UnSymmetricCriterion<IstlMatrixType, Amg::FirstDiagonal>> amg_criterion(amg_parameters);
-
-    InverseOperatorResult stats;
     if (smoother_type == "ilu0") {
-      typedef SeqILU0<IstlMatrixType, IstlVectorType, IstlVectorType> SmootherType;
-
-      typename Amg::SmootherTraits<SmootherType>::Arguments smoother_parameters;
+      typename Amg::SmootherTraits<SmootherType_ILU>::Arguments smoother_parameters;
       smoother_parameters.iterations = opts.get("smoother.iterations", default_opts.get<int>("smoother.iterations"));
       smoother_parameters.relaxationFactor =
           opts.get("smoother.relaxation_factor", default_opts.get<S>("smoother.relaxation_factor"));
-      typedef Amg::AMG<MatrixOperatorType, IstlVectorType, SmootherType> PreconditionerType;
-      PreconditionerType preconditioner(matrix_operator, amg_criterion, smoother_parameters);
-      // define the BiCGStab as the actual solver
-      BiCGSTABSolver<IstlVectorType> solver(matrix_operator,
-                                            scalar_product,
-                                            preconditioner,
-                                            opts.get("precision", default_opts.get<S>("precision")),
-                                            opts.get("max_iter", default_opts.get<int>("max_iter")),
-                                            opts.get("verbose", default_opts.get<int>("verbose")));
-      solver.apply(solution.backend(), rhs.backend(), stats);
+      setup->ilu_preconditioner = std::make_unique<PreconditionerType_ILU>(
+          *setup->matrix_operator, amg_criterion, smoother_parameters);
     } else if (smoother_type == "ssor") {
-      typedef SeqSSOR<IstlMatrixType, IstlVectorType, IstlVectorType> SmootherType;
-
-      typename Amg::SmootherTraits<SmootherType>::Arguments smoother_parameters;
+      typename Amg::SmootherTraits<SmootherType_SSOR>::Arguments smoother_parameters;
       smoother_parameters.iterations = opts.get("smoother.iterations", default_opts.get<int>("smoother.iterations"));
       smoother_parameters.relaxationFactor =
           opts.get("smoother.relaxation_factor", default_opts.get<S>("smoother.relaxation_factor"));
-      typedef Amg::AMG<MatrixOperatorType, IstlVectorType, SmootherType> PreconditionerType;
-      PreconditionerType preconditioner(matrix_operator, amg_criterion, smoother_parameters);
-      BiCGSTABSolver<IstlVectorType> solver(matrix_operator,
+      setup->ssor_preconditioner = std::make_unique<PreconditionerType_SSOR>(
+          *setup->matrix_operator, amg_criterion, smoother_parameters);
+    } else
+      DUNE_THROW(Common::Exceptions::wrong_input_given, "Unknown smoother requested: " << smoother_type);
+    return setup;
+  } // ... build(...)
+
+  InverseOperatorResult solve(Setup& setup,
+                              IstlVectorType& rhs,
+                              IstlVectorType& solution,
+                              const Common::Configuration& opts,
+                              const Common::Configuration& default_opts,
+                              std::vector<double>* residual_history) const
+  {
+    // define the scalar product
+    Dune::SeqScalarProduct<IstlVectorType> sequential_scalar_product;
+    internal::RecordingScalarProduct<IstlVectorType> scalar_product(sequential_scalar_product, residual_history);
+    InverseOperatorResult stats;
+    // define the BiCGStab as the actual solver
+    if (setup.ilu_preconditioner) {
+      BiCGSTABSolver<IstlVectorType> solver(*setup.matrix_operator,
                                             scalar_product,
-                                            preconditioner,
+                                            *setup.ilu_preconditioner,
                                             opts.get("precision", default_opts.get<S>("precision")),
                                             opts.get("max_iter", default_opts.get<int>("max_iter")),
                                             opts.get("verbose", default_opts.get<int>("verbose")));
-      solver.apply(solution.backend(), rhs.backend(), stats);
+      solver.apply(solution, rhs, stats);
     } else {
-      DUNE_THROW(Common::Exceptions::wrong_input_given, "Unknown smoother requested: " << smoother_type);
+      BiCGSTABSolver<IstlVectorType> solver(*setup.matrix_operator,
+                                            scalar_product,
+                                            *setup.ssor_preconditioner,
+                                            opts.get("precision", default_opts.get<S>("precision")),
+                                            opts.get("max_iter", default_opts.get<int>("max_iter")),
+                                            opts.get("verbose", default_opts.get<int>("verbose")));
+      solver.apply(solution, rhs, stats);
     }
     return stats;
-  } // ... call(...)
+  } // ... solve(...)
 
-protected:
-  const MatrixType& matrix_;
-  const SequentialCommunication& communicator_;
+  std::unique_ptr<Setup> setup_;
+  std::string smoother_type_;
+  Common::Configuration opts_;
+  Common::Configuration default_opts_;
 };
 
 
@@ -17,16 +17,21 @@
 
 #include <type_traits>
 #include <cmath>
+#include <memory>
+
+#include <dune/common/timer.hh>
 
 #include <dune/istl/operators.hh>
 #include <dune/istl/solvers.hh>
 
 #include <dune/xt/common/exceptions.hh>
 #include <dune/xt/common/configuration.hh>
+#include <dune/xt/la/container/block-matrix.hh>
 #include <dune/xt/la/container/istl.hh>
 #include <dune/xt/la/solver.hh>
 
 #include "preconditioners.hh"
+#include "saddlepointoperator.hh"
 #include "schurcomplement.hh"
 
 namespace Dune {
@@ -36,6 +41,24 @@ namespace LA {
 
 // Solver for saddle point system (A B1; B2^T C) (u; p) = (f; g) using the Schur complement, i.e., solve (B2^T A^{-1} B1
 // - C) p = B2^T A^{-1} f - g first and then u = A^{-1} (F - B1 p)
+//
+// The type "direct" assembles the (m + n) x (m + n) system matrix by copying the entries of the blocks from their
+// backends (see BlockMatrixAssembler) and solves it with the solver given by the sub options 'inner_solver'. Both are
+// computed in each call to apply(), unless prepare() was called, see prepare() and update().
+//
+// The Schur complement types prepare the solver for A once per call to apply(), so all inner solves of the outer cg
+// iteration reuse its setup. The outer cg iteration is preconditioned according to the option 'schur_preconditioner':
+// - "identity": no preconditioning
+// - "diagonal" or "lumped": solves with the approximation B2^T D^{-1} B1 - C, see approximate_schur_complement()
+// - "matrix": solves with the matrix given in the constructor, e.g. the pressure mass matrix for Stokes problems
+// The solver for the approximation can be configured by the sub options 'schur_preconditioner_solver'.
+//
+// The types minres.blockdiag, gmres.blocktriangular and uzawa.inexact solve the whole system iteratively, applying it
+// block by block (see SaddlePointOperator), preconditioned by the respective SaddlePointPreconditioner. These are
+// built from the solver for A given by the sub options 'inner_solver' and the Schur complement approximation given by
+// 'schur_preconditioner' as above. minres.blockdiag requires a symmetric system (i.e. B1 == B2 and C symmetric) and
+// symmetric positive definite approximations of A and S, uzawa.inexact requires 'relaxation_factor' to be small
+// enough, see SaddlePointPreconditioner. In contrast to "direct", no (m + n) x (m + n) matrix is assembled.
 template <class VectorType = IstlDenseVector<double>,
           class MatrixType = IstlRowMajorSparseMatrix<double>,
           class CommunicatorType = SequentialCommunication>
@@ -53,11 +76,26 @@ public:
     , B1_(B1)
     , B2_(B2)
     , C_(C)
+    , schur_preconditioner_matrix_(nullptr)
+  {}
+
+  //! \param S_approx Approximation of the Schur complement, used by the 'schur_preconditioner' "matrix" (n x n)
+  SaddlePointSolver(const Matrix& A, const Matrix& B1, const Matrix& B2, const Matrix& C, const Matrix& S_approx)
+    : A_(A)
+    , B1_(B1)
+    , B2_(B2)
+    , C_(C)
+    , schur_preconditioner_matrix_(&S_approx)
   {}
 
   static std::vector<std::string> types()
   {
-    std::vector<std::string> ret{"direct", "cg_cg_schurcomplement", "cg_direct_schurcomplement"};
+    std::vector<std::string> ret{"direct",
+                                 "cg_cg_schurcomplement",
+                                 "cg_direct_schurcomplement",
+                                 "minres.blockdiag",
+                                 "gmres.blocktriangular",
+                                 "uzawa.inexact"};
     return ret;
   } // ... types()
 
@@ -66,16 +104,84 @@ public:
     const std::string tp = !type.empty() ? type : types()[0];
     internal::SolverUtils::check_given(tp, types());
     Common::Configuration general_opts({"type", "post_check_solves_system", "verbose"}, {tp.c_str(), "1e-5", "0"});
-    Common::Configuration iterative_options({"max_iter", "precision"}, {"10000", "1e-10"});
+    // 'max_iter' and 'precision' (the reduction of the residual) are the parameters of the outer iteration
+    Common::Configuration iterative_options(
+        {"max_iter", "precision", "schur_preconditioner"}, {"10000", "1e-10", "identity"});
     iterative_options += general_opts;
     if (tp == "direct")
       return general_opts;
     else if (tp == "cg_direct_schurcomplement" || tp == "cg_cg_schurcomplement")
       return iterative_options;
-    else
-      return general_opts;
+    else {
+      iterative_options["schur_preconditioner"] = "diagonal";
+      if (tp == "gmres.blocktriangular")
+        iterative_options.set("restart", "100");
+      else if (tp == "uzawa.inexact")
+        iterative_options.set("relaxation_factor", "0.5"); // <- has to be small enough, see SaddlePointPreconditioner
+      return iterative_options;
+    }
   } // ... options(...)
 
+  void prepare()
+  {
+    prepare(types()[0]);
+  }
+
+  void prepare(const std::string& type)
+  {
+    prepare(options(type));
+  }
+
+  /**
+   * \brief Assembles the saddle point system matrix and prepares its solver (see Solver::prepare()) for "direct",
+   *        both are then reused by all subsequent calls to apply() with "direct".
+   *
+   * The blocks are kept by reference and have to outlive this solver. After their entries (but not their patterns)
+   * have changed, call update(), otherwise apply() keeps using the old entries.
+   * \note The other types have no setup to prepare, in which case this is a no-op.
+   */
+  void prepare(const Common::Configuration& opts)
+  {
+    const auto type = opts.get<std::string>("type");
+    internal::SolverUtils::check_given(type, types());
+    invalidate();
+    if (type != "direct")
+      return;
+    SolverStatisticsStorage::Recorder statistics(statistics_, type);
+    Timer timer;
+    system_assembler_ = create_system_assembler();
+    system_solver_ = std::make_unique<Solver<Matrix>>(system_assembler_->matrix());
+    internal::prepare_if_possible(*system_solver_,
+                                  opts.has_sub("inner_solver") ? opts.sub("inner_solver")
+                                                               : XT::LA::SolverOptions<Matrix>::options(),
+                                  0);
+    statistics->setup_time = timer.elapsed();
+  } // ... prepare(...)
+
+  //! Copies the entries of the blocks to the prepared system matrix and updates its solver, see Solver::update().
+  void update()
+  {
+    if (!prepared())
+      DUNE_THROW(Common::Exceptions::you_are_using_this_wrong, "Call prepare() before calling update()!");
+    SolverStatisticsStorage::Recorder statistics(statistics_, "direct");
+    Timer timer;
+    system_assembler_->update();
+    internal::update_if_possible(*system_solver_, 0);
+    statistics->setup_time = timer.elapsed();
+  } // ... update(...)
+
+  //! Drops the system matrix and the solver computed in prepare().
+  void invalidate()
+  {
+    system_solver_ = nullptr;
+    system_assembler_ = nullptr;
+  }
+
+  bool prepared() const
+  {
+    return system_solver_ != nullptr;
+  }
+
   void apply(const Vector& f, const Vector& g, Vector& u, Vector& p) const
   {
     apply(f, g, u, p, types()[0]);
@@ -95,65 +201,42 @@ public:
   void apply(const Vector& f, const Vector& g, Vector& u, Vector& p, const Common::Configuration& opts) const
   {
     const auto type = opts.get<std::string>("type");
+    internal::SolverUtils::check_given(type, types());
+    SolverStatisticsStorage::Recorder statistics(statistics_, type);
+    Timer timer;
     if (type == "direct") {
-      // copy matrices to saddle point system matrix
-      // create pattern first
-      const size_t m = f.size();
-      const size_t n = g.size();
-      XT::LA::SparsityPatternDefault system_matrix_pattern(m + n);
-      const auto pattern_A = A_.pattern();
-      const auto pattern_B1 = B1_.pattern();
-      const auto pattern_B2 = B2_.pattern();
-      const auto pattern_C = C_.pattern();
-      for (size_t ii = 0; ii < m; ++ii) {
-        for (const auto& jj : pattern_A.inner(ii))
-          system_matrix_pattern.insert(ii, jj);
-        for (const auto& jj : pattern_B1.inner(ii))
-          system_matrix_pattern.insert(ii, m + jj);
-        for (const auto& jj : pattern_B2.inner(ii))
-          system_matrix_pattern.insert(m + jj, ii);
-      } // ii
-      for (size_t ii = 0; ii < n; ++ii)
-        for (const auto& jj : pattern_C.inner(ii))
-          system_matrix_pattern.insert(m + ii, m + jj);
-      system_matrix_pattern.sort();
-
-      // now copy the matrices
-      Matrix system_matrix(m + n, m + n, system_matrix_pattern);
-      for (size_t ii = 0; ii < m; ++ii) {
-        for (const auto& jj : pattern_A.inner(ii))
-          system_matrix.set_entry(ii, jj, A_.get_entry(ii, jj));
-        for (const auto& jj : pattern_B1.inner(ii))
-          system_matrix.set_entry(ii, m + jj, B1_.get_entry(ii, jj));
-        for (const auto& jj : pattern_B2.inner(ii))
-          system_matrix.set_entry(m + jj, ii, B2_.get_entry(ii, jj));
-      } // ii
-      for (size_t ii = 0; ii < n; ++ii)
-        for (const auto& jj : pattern_C.inner(ii))
-          system_matrix.set_entry(m + ii, m + jj, C_.get_entry(ii, jj));
+      const size_t m = A_.rows();
+      const size_t n = C_.rows();
+      // assemble the saddle point system matrix, unless prepared
+      std::unique_ptr<BlockMatrixAssembler<Matrix>> assembler;
+      if (!prepared())
+        assembler = create_system_assembler();
+      else
+        statistics->setup_reused = true;
+      const Matrix& system_matrix = prepared() ? system_assembler_->matrix() : assembler->matrix();
 
       // also copy the rhs
       Vector system_vector(m + n, 0.), solution_vector(m + n, 0.);
-      for (size_t ii = 0; ii < m; ++ii)
-        system_vector[ii] = f[ii];
-      for (size_t ii = 0; ii < n; ++ii)
-        system_vector[m + ii] = g[ii];
+      internal::join_saddle_point_vector(f, g, system_vector);
 
       // solve the system by a direct solver
-      if (opts.has_sub("inner_solver"))
-        XT::LA::solve(system_matrix, system_vector, solution_vector, opts.sub("inner_solver"));
+      statistics->setup_time = timer.elapsed();
+      timer.reset();
+      const auto inner_solver_opts = opts.has_sub("inner_solver")
+                                         ? opts.sub("inner_solver")
+                                         : XT::LA::SolverOptions<Matrix>::options();
+      if (prepared())
+        system_solver_->apply(system_vector, solution_vector, inner_solver_opts);
       else
-        XT::LA::solve(system_matrix, system_vector, solution_vector);
+        XT::LA::solve(system_matrix, system_vector, solution_vector, inner_solver_opts);
 
       // copy to result vectors
-      for (size_t ii = 0; ii < m; ++ii)
-        u[ii] = solution_vector[ii];
-      for (size_t ii = 0; ii < n; ++ii)
-        p[ii] = solution_vector[m + ii];
+      internal::split_saddle_point_vector(solution_vector, u, p);
+      statistics->solve_time = timer.elapsed();
+      statistics->iterations = 1;
     } else if (type == "cg_direct_schurcomplement" || type == "cg_cg_schurcomplement") {
-      // calculate rhs B2^T A^{-1} f - g
-      auto Ainv_f = f;
-      auto rhs_p = g;
+      const Common::Configuration default_opts = options(type);
+      // the solver for A is prepared once and used for all inner solves
       SchurComplementOperator<Vector, Matrix, CommunicatorType> schur_complement_op(
           A_,
           B1_,
@@ -162,29 +245,169 @@ public:
           opts.has_sub("inner_solver") ? opts.sub("inner_solver")
                                        : XT::LA::SolverOptions<Matrix, CommunicatorType>::options(
                                              type == "cg_direct_schurcomplement" ? "" : "cg"));
-      schur_complement_op.A_inv().apply(f, Ainv_f);
+      std::unique_ptr<Matrix> schur_complement_approximation;
+      const auto prec = create_schur_preconditioner(opts, default_opts, schur_complement_approximation);
+      statistics->setup_time = timer.elapsed();
+      timer.reset();
+
+      // calculate rhs B2^T A^{-1} f - g
+      auto Ainv_f = f;
+      auto rhs_p = g;
+      schur_complement_op.solve_A(f, Ainv_f);
       B2_.mtv(Ainv_f, rhs_p);
       rhs_p -= g;
 
       // Solve S p = rhs
-      IdentityPreconditioner<SchurComplementOperator<Vector, Matrix, CommunicatorType>> prec(
-          SolverCategory::Category::sequential);
-      Dune::CGSolver<Vector> outer_solver(schur_complement_op, prec, 1e-10, 10000, 0, false);
+      Dune::CGSolver<Vector> outer_solver(schur_complement_op,
+                                          *prec,
+                                          opts.get("precision", default_opts.get<double>("precision")),
+                                          opts.get("max_iter", default_opts.get<int>("max_iter")),
+                                          verbosity(opts, default_opts),
+                                          false);
       InverseOperatorResult res;
       outer_solver.apply(p, rhs_p, res);
+      if (!res.converged)
+        DUNE_THROW(Exceptions::linear_solver_failed_bc_it_did_not_converge,
+                   "The outer cg iteration did not converge after " << res.iterations << " iterations (reduction "
+                                                                    << res.reduction
+                                                                    << "), those were the given options:\n\n"
+                                                                    << opts);
 
       // Now solve u = A^{-1}(f - B1 p)
       auto rhs_u = f;
       rhs_u -= B1_ * p;
-      schur_complement_op.A_inv().apply(rhs_u, u);
+      schur_complement_op.solve_A(rhs_u, u);
+      statistics->solve_time = timer.elapsed();
+      statistics->iterations = res.iterations;
+      statistics->reduction = res.reduction;
+    } else {
+      // the monolithic types
+      const Common::Configuration default_opts = options(type);
+      const size_t m = f.size();
+      const size_t n = g.size();
+      std::unique_ptr<Matrix> schur_complement_approximation;
+      const auto schur_prec = create_schur_preconditioner(opts, default_opts, schur_complement_approximation);
+      std::string preconditioner_type = "uzawa";
+      if (type == "minres.blockdiag")
+        preconditioner_type = "blockdiag";
+      else if (type == "gmres.blocktriangular")
+        preconditioner_type = "blocktriangular";
+      SaddlePointPreconditioner<Vector, Matrix, CommunicatorType> prec(
+          preconditioner_type,
+          A_,
+          B1_,
+          B2_,
+          *schur_prec,
+          opts.has_sub("inner_solver") ? opts.sub("inner_solver")
+                                       : XT::LA::SolverOptions<Matrix, CommunicatorType>::options(),
+          Field((type == "uzawa.inexact")
+                    ? opts.get("relaxation_factor", default_opts.get<double>("relaxation_factor"))
+                    : 1.));
+      SaddlePointOperator<Vector, Matrix> saddle_point_op(A_, B1_, B2_, C_);
+      statistics->setup_time = timer.elapsed();
+      timer.reset();
+
+      // the given u and p are the initial guess
+      Vector rhs(m + n), solution(m + n);
+      internal::join_saddle_point_vector(f, g, rhs);
+      internal::join_saddle_point_vector(u, p, solution);
+      const auto precision = opts.get("precision", default_opts.get<double>("precision"));
+      const auto max_iter = opts.get("max_iter", default_opts.get<int>("max_iter"));
+      InverseOperatorResult res;
+      if (type == "minres.blockdiag") {
+        Dune::MINRESSolver<Vector> outer_solver(
+            saddle_point_op, prec, precision, max_iter, verbosity(opts, default_opts));
+        outer_solver.apply(solution, rhs, res);
+      } else if (type == "gmres.blocktriangular") {
+        Dune::RestartedGMResSolver<Vector> outer_solver(saddle_point_op,
+                                                        prec,
+                                                        precision,
+                                                        opts.get("restart", default_opts.get<int>("restart")),
+                                                        max_iter,
+                                                        verbosity(opts, default_opts));
+        outer_solver.apply(solution, rhs, res);
+      } else {
+        // the stationary iteration x += P^{-1} (b - K x), with the Uzawa preconditioner P
+        Dune::LoopSolver<Vector> outer_solver(
+            saddle_point_op, prec, precision, max_iter, verbosity(opts, default_opts));
+        outer_solver.apply(solution, rhs, res);
+      }
+      if (!res.converged)
+        DUNE_THROW(Exceptions::linear_solver_failed_bc_it_did_not_converge,
+                   "The " << type << " iteration did not converge after " << res.iterations << " iterations (reduction "
+                          << res.reduction
+                          << "), those were the given options:\n\n"
+                          << opts);
+      internal::split_saddle_point_vector(solution, u, p);
+      statistics->solve_time = timer.elapsed();
+      statistics->iterations = res.iterations;
+      statistics->reduction = res.reduction;
     }
   } // ... apply(...)
 
+  /**
+   * \sa SolverStatistics
+   * \note For the iterative types, the setup is the preparation of the solver for A and of the preconditioners and the
+   *       iterations are the ones of the outer iteration.
+   */
+  SolverStatistics statistics() const
+  {
+    return statistics_.get();
+  }
+
 private:
+  std::unique_ptr<BlockMatrixAssembler<Matrix>> create_system_assembler() const
+  {
+    const size_t m = A_.rows();
+    const size_t n = C_.rows();
+    auto assembler = std::make_unique<BlockMatrixAssembler<Matrix>>(m + n, m + n);
+    assembler->add_block(0, 0, A_);
+    assembler->add_block(0, m, B1_);
+    assembler->add_block(m, 0, B2_, /*transposed=*/true);
+    assembler->add_block(m, m, C_);
+    assembler->assemble();
+    return assembler;
+  } // ... create_system_assembler(...)
+
+  // the approximation of the Schur complement is stored in schur_complement_approximation, if computed
+  std::unique_ptr<Dune::Preconditioner<Vector, Vector>>
+  create_schur_preconditioner(const Common::Configuration& opts,
+                              const Common::Configuration& default_opts,
+                              std::unique_ptr<Matrix>& schur_complement_approximation) const
+  {
+    using PreconditionerType = SchurComplementPreconditioner<Vector, Matrix, CommunicatorType>;
+    const auto type = opts.get("schur_preconditioner", default_opts.get<std::string>("schur_preconditioner"));
+    const auto solver_opts = opts.has_sub("schur_preconditioner_solver")
+                                 ? opts.sub("schur_preconditioner_solver")
+                                 : XT::LA::SolverOptions<Matrix, CommunicatorType>::options();
+    if (type == "identity")
+      return std::make_unique<IdentityPreconditioner<SchurComplementOperator<Vector, Matrix, CommunicatorType>>>(
+          SolverCategory::Category::sequential);
+    else if (type == "diagonal" || type == "lumped") {
+      schur_complement_approximation =
+          std::make_unique<Matrix>(approximate_schur_complement(A_, B1_, B2_, C_, type));
+      return std::make_unique<PreconditionerType>(*schur_complement_approximation, solver_opts);
+    } else if (type == "matrix") {
+      if (!schur_preconditioner_matrix_)
+        DUNE_THROW(Common::Exceptions::you_are_using_this_wrong,
+                   "The 'schur_preconditioner' \"matrix\" requires the approximation of the Schur complement to be "
+                   "given in the constructor!");
+      return std::make_unique<PreconditionerType>(*schur_preconditioner_matrix_, solver_opts);
+    } else
+      DUNE_THROW(Common::Exceptions::configuration_error,
+                 "'schur_preconditioner' has to be one of identity, diagonal, lumped or matrix, is '" << type << "'!");
+    return nullptr;
+  } // ... create_schur_preconditioner(...)
+
   const Matrix& A_;
   const Matrix& B1_;
   const Matrix& B2_;
   const Matrix& C_;
+  const Matrix* schur_preconditioner_matrix_;
+  SolverStatisticsStorage statistics_;
+  // the setup of "direct", see prepare()
+  std::unique_ptr<BlockMatrixAssembler<Matrix>> system_assembler_;
+  std::unique_ptr<Solver<Matrix>> system_solver_;
 };
 
 
@@ -0,0 +1,236 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_LA_SOLVER_ISTL_SADDLEPOINTOPERATOR_HH
+#define DUNE_XT_LA_SOLVER_ISTL_SADDLEPOINTOPERATOR_HH
+
+#include <string>
+#include <vector>
+
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioner.hh>
+
+#include <dune/xt/common/exceptions.hh>
+#include <dune/xt/common/configuration.hh>
+#include <dune/xt/la/container/istl.hh>
+#include <dune/xt/la/solver.hh>
+
+#include "schurcomplement.hh"
+
+namespace Dune {
+namespace XT {
+namespace LA {
+namespace internal {
+
+
+// copies the first u.size() entries of x to u and the remaining p.size() entries to p
+template <class VectorType>
+void split_saddle_point_vector(const VectorType& x, VectorType& u, VectorType& p)
+{
+  const size_t m = u.size();
+  for (size_t ii = 0; ii < m; ++ii)
+    u[ii] = x[ii];
+  for (size_t ii = 0; ii < p.size(); ++ii)
+    p[ii] = x[m + ii];
+}
+
+// the inverse of split_saddle_point_vector()
+template <class VectorType>
+void join_saddle_point_vector(const VectorType& u, const VectorType& p, VectorType& x)
+{
+  const size_t m = u.size();
+  for (size_t ii = 0; ii < m; ++ii)
+    x[ii] = u[ii];
+  for (size_t ii = 0; ii < p.size(); ++ii)
+    x[m + ii] = p[ii];
+}
+
+
+} // namespace internal
+
+
+// For a saddle point matrix (A B1; B2^T C) this applies the matrix to vectors (u; p) of size m + n, using the blocks
+// directly, i.e. without assembling the matrix
+template <class VectorType = IstlDenseVector<double>, class MatrixType = IstlRowMajorSparseMatrix<double>>
+class SaddlePointOperator : public Dune::LinearOperator<VectorType, VectorType>
+{
+public:
+  using Vector = VectorType;
+  using Matrix = MatrixType;
+  using Field = typename VectorType::ScalarType;
+
+  // Matrix dimensions are
+  // A: m x m, B1, B2: m x n, C: n x n
+  SaddlePointOperator(const Matrix& _A, const Matrix& _B1, const Matrix& _B2, const Matrix& _C)
+    : A_(_A)
+    , B1_(_B1)
+    , B2_(_B2)
+    , C_(_C)
+    , u_(_A.rows())
+    , p_(_C.rows())
+    , m_vec_1_(_A.rows())
+    , m_vec_2_(_A.rows())
+    , n_vec_1_(_C.rows())
+    , n_vec_2_(_C.rows())
+    , mn_vec_(_A.rows() + _C.rows())
+  {}
+
+  virtual void apply(const Vector& x, Vector& y) const override final
+  {
+    internal::split_saddle_point_vector(x, u_, p_);
+    // calculate A u + B1 p
+    A_.mv(u_, m_vec_1_);
+    B1_.mv(p_, m_vec_2_);
+    m_vec_1_ += m_vec_2_;
+    // calculate B2^T u + C p
+    B2_.mtv(u_, n_vec_1_);
+    C_.mv(p_, n_vec_2_);
+    n_vec_1_ += n_vec_2_;
+    internal::join_saddle_point_vector(m_vec_1_, n_vec_1_, y);
+  }
+
+  virtual void applyscaleadd(Field alpha, const Vector& x, Vector& y) const override final
+  {
+    apply(x, mn_vec_);
+    y.axpy(alpha, mn_vec_);
+  }
+
+  //! Category of the linear operator (see SolverCategory::Category)
+  virtual SolverCategory::Category category() const override final
+  {
+    return SolverCategory::Category::sequential;
+  }
+
+private:
+  const Matrix& A_;
+  const Matrix& B1_;
+  const Matrix& B2_;
+  const Matrix& C_;
+  // vectors to store intermediate results
+  mutable Vector u_;
+  mutable Vector p_;
+  mutable Vector m_vec_1_;
+  mutable Vector m_vec_2_;
+  mutable Vector n_vec_1_;
+  mutable Vector n_vec_2_;
+  mutable Vector mn_vec_;
+};
+
+
+/**
+ * \brief Block preconditioners for the saddle point matrix (A B1; B2^T C), acting on vectors (u; p) of size m + n.
+ *
+ * The preconditioners are built from a solver for A (prepared once, see Solver::prepare()) and a preconditioner for
+ * the Schur complement S = B2^T A^{-1} B1 - C (e.g. a SchurComplementPreconditioner), i.e. the application of an
+ * approximation of S^{-1}:
+ * - "blockdiag": (A 0; 0 S)^{-1}, which is symmetric positive definite (as required by minres) if A and the
+ *   approximation of S are;
+ * - "blocktriangular": (A B1; 0 -S)^{-1}, for which gmres converges in two iterations if all blocks are exact;
+ * - "uzawa": (A 0; B2^T -S / omega)^{-1}, within a stationary iteration this is the inexact Uzawa method, which
+ *   converges if the relaxation factor omega is smaller than 2 / lambda_max, where lambda_max is the largest
+ *   eigenvalue of the approximation of S^{-1} times S.
+ */
+template <class VectorType = IstlDenseVector<double>,
+          class MatrixType = IstlRowMajorSparseMatrix<double>,
+          class CommunicatorType = SequentialCommunication>
+class SaddlePointPreconditioner : public Dune::Preconditioner<VectorType, VectorType>
+{
+public:
+  using Vector = VectorType;
+  using Matrix = MatrixType;
+  using Field = typename VectorType::ScalarType;
+  using SolverType = Solver<Matrix, CommunicatorType>;
+  using SchurPreconditionerType = Dune::Preconditioner<Vector, Vector>;
+
+  static std::vector<std::string> types()
+  {
+    return {"blockdiag", "blocktriangular", "uzawa"};
+  }
+
+  //! \note Keeps a reference to the given Schur complement preconditioner.
+  SaddlePointPreconditioner(const std::string& type,
+                            const Matrix& A,
+                            const Matrix& B1,
+                            const Matrix& B2,
+                            SchurPreconditionerType& schur_preconditioner,
+                            const Common::Configuration& A_solver_opts = SolverOptions<Matrix>::options(),
+                            const Field relaxation_factor = Field(1))
+    : type_(type)
+    , A_inv_(make_solver(A))
+    , B1_(B1)
+    , B2_(B2)
+    , schur_preconditioner_(schur_preconditioner)
+    , A_solver_opts_(A_solver_opts)
+    , relaxation_factor_(relaxation_factor)
+    , d_u_(A.rows())
+    , d_p_(B1.cols())
+    , v_u_(A.rows())
+    , v_p_(B1.cols())
+    , m_vec_(A.rows())
+    , n_vec_(B1.cols())
+  {
+    internal::SolverUtils::check_given(type_, types());
+    internal::prepare_if_possible(A_inv_, A_solver_opts_, 0);
+  }
+
+  virtual void pre(Vector&, Vector&) override final {}
+
+  virtual void apply(Vector& v, const Vector& d) override final
+  {
+    internal::split_saddle_point_vector(d, d_u_, d_p_);
+    if (type_ == "blockdiag") {
+      A_inv_.apply(d_u_, v_u_, A_solver_opts_);
+      schur_preconditioner_.apply(v_p_, d_p_);
+    } else if (type_ == "blocktriangular") {
+      // v_p = -S^{-1} d_p, v_u = A^{-1} (d_u - B1 v_p)
+      schur_preconditioner_.apply(v_p_, d_p_);
+      v_p_ *= Field(-1);
+      B1_.mv(v_p_, m_vec_);
+      d_u_ -= m_vec_;
+      A_inv_.apply(d_u_, v_u_, A_solver_opts_);
+    } else {
+      // v_u = A^{-1} d_u, v_p = omega S^{-1} (B2^T v_u - d_p)
+      A_inv_.apply(d_u_, v_u_, A_solver_opts_);
+      B2_.mtv(v_u_, n_vec_);
+      n_vec_ -= d_p_;
+      schur_preconditioner_.apply(v_p_, n_vec_);
+      v_p_ *= relaxation_factor_;
+    }
+    internal::join_saddle_point_vector(v_u_, v_p_, v);
+  } // ... apply(...)
+
+  virtual void post(Vector&) override final {}
+
+  //! Category of the preconditioner (see SolverCategory::Category)
+  virtual SolverCategory::Category category() const override final
+  {
+    return SolverCategory::Category::sequential;
+  }
+
+private:
+  const std::string type_;
+  SolverType A_inv_;
+  const Matrix& B1_;
+  const Matrix& B2_;
+  SchurPreconditionerType& schur_preconditioner_;
+  const Common::Configuration A_solver_opts_;
+  const Field relaxation_factor_;
+  // vectors to store intermediate results
+  Vector d_u_;
+  Vector d_p_;
+  Vector v_u_;
+  Vector v_p_;
+  Vector m_vec_;
+  Vector n_vec_;
+};
+
+
+} // namespace LA
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_LA_SOLVER_ISTL_SADDLEPOINTOPERATOR_HH
@@ -0,0 +1,72 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_LA_SOLVER_ISTL_SCALARPRODUCTS_HH
+#define DUNE_XT_LA_SOLVER_ISTL_SCALARPRODUCTS_HH
+
+#include <vector>
+
+#include <dune/istl/scalarproducts.hh>
+#include <dune/istl/solvercategory.hh>
+
+namespace Dune {
+namespace XT {
+namespace LA {
+namespace internal {
+
+
+/**
+ * \brief Forwards to the given scalar product and appends each computed norm to norms (if not nullptr).
+ *
+ * The Krylov solvers of dune-istl compute the norm of the residual (and nothing else) via norm(), so this yields the
+ * residual history: the initial residual, followed by one entry per iteration for cg and two entries per iteration
+ * (one for each half step) for bicgstab.
+ */
+template <class X>
+class RecordingScalarProduct : public ScalarProduct<X>
+{
+  typedef ScalarProduct<X> BaseType;
+
+public:
+  using typename BaseType::field_type;
+  using typename BaseType::real_type;
+
+  RecordingScalarProduct(const BaseType& scalar_product, std::vector<double>* norms)
+    : scalar_product_(scalar_product)
+    , norms_(norms)
+  {}
+
+  field_type dot(const X& x, const X& y) const override final
+  {
+    return scalar_product_.dot(x, y);
+  }
+
+  real_type norm(const X& x) const override final
+  {
+    const auto ret = scalar_product_.norm(x);
+    if (norms_)
+      norms_->push_back(static_cast<double>(ret));
+    return ret;
+  }
+
+  SolverCategory::Category category() const override final
+  {
+    return scalar_product_.category();
+  }
+
+private:
+  const BaseType& scalar_product_;
+  std::vector<double>* norms_;
+}; // class RecordingScalarProduct
+
+
+} // namespace internal
+} // namespace LA
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_LA_SOLVER_ISTL_SCALARPRODUCTS_HH
@@ -10,7 +10,12 @@
 #ifndef DUNE_XT_LA_SOLVER_ISTL_SCHURCOMPLEMENT_HH
 #define DUNE_XT_LA_SOLVER_ISTL_SCHURCOMPLEMENT_HH
 
+#include <cmath>
+#include <string>
+#include <vector>
+
 #include <dune/istl/operators.hh>
+#include <dune/istl/preconditioner.hh>
 #include <dune/istl/solvers.hh>
 
 #include <dune/xt/common/exceptions.hh>
@@ -23,7 +28,9 @@ namespace XT {
 namespace LA {
 
 
-// For a saddle point matrix (A B1; B2^T C) this models the Schur complement (B2^T A^{-1} B1 - C)
+// For a saddle point matrix (A B1; B2^T C) this models the Schur complement (B2^T A^{-1} B1 - C). The solver for A is
+// prepared once with the given options (see Solver::prepare()), so all applications reuse its factorization or
+// preconditioner.
 template <class VectorType = IstlDenseVector<double>,
           class MatrixType = IstlRowMajorSparseMatrix<double>,
           class CommunicatorType = SequentialCommunication>
@@ -54,7 +61,9 @@ public:
     , m_vec_2_(_A.rows())
     , n_vec_1_(_C.rows())
     , n_vec_2_(_C.rows())
-  {}
+  {
+    internal::prepare_if_possible(A_inv_, solver_opts_, 0);
+  }
 
   SchurComplementOperator(const SchurComplementOperator& other)
     : A_(other.A_)
@@ -67,7 +76,9 @@ public:
     , m_vec_2_(other.m_vec_2_)
     , n_vec_1_(other.n_vec_1_)
     , n_vec_2_(other.n_vec_2_)
-  {}
+  {
+    internal::prepare_if_possible(A_inv_, solver_opts_, 0);
+  }
 
   /*! \brief apply operator to x:  \f$ y = S(x) \f$
         The input vector is consistent and the output must also be
@@ -81,7 +92,7 @@ public:
     B1_.mv(x, B1x);
     // calculate A^{-1} B1 x
     auto& AinvB1x = m_vec_2_;
-    A_inv_.apply(B1x, AinvB1x, solver_opts_);
+    solve_A(B1x, AinvB1x);
     // apply B2^T
     B2_.mtv(AinvB1x, y);
     // calculate Cx
@@ -109,6 +120,12 @@ public:
     return A_inv_;
   }
 
+  //! Solves A x = rhs with the prepared solver for A.
+  void solve_A(const Vector& rhs, Vector& x) const
+  {
+    A_inv_.apply(rhs, x, solver_opts_);
+  }
+
   const Matrix& A() const
   {
     return A_;
@@ -131,7 +148,7 @@ public:
 
 private:
   const Matrix& A_;
-  const SolverType A_inv_;
+  SolverType A_inv_;
   const Matrix& B1_;
   const Matrix& B2_;
   const Matrix& C_;
@@ -144,6 +161,112 @@ private:
 };
 
 
+/**
+ * \brief Returns the sparse approximation B2^T D^{-1} B1 - C of the Schur complement B2^T A^{-1} B1 - C, where D is
+ *        the diagonal of A (type "diagonal") or the diagonal matrix of the absolute row sums of A (type "lumped").
+ *
+ * Matrix dimensions are A: m x m, B1, B2: m x n, C: n x n, the result is n x n.
+ */
+template <class MatrixType>
+MatrixType approximate_schur_complement(const MatrixType& A,
+                                        const MatrixType& B1,
+                                        const MatrixType& B2,
+                                        const MatrixType& C,
+                                        const std::string& type = "diagonal")
+{
+  using Field = typename MatrixType::ScalarType;
+  if (type != "diagonal" && type != "lumped")
+    DUNE_THROW(Common::Exceptions::wrong_input_given,
+               "type has to be 'diagonal' or 'lumped', is '" << type << "'!");
+  const size_t m = A.rows();
+  const size_t n = C.rows();
+  const auto pattern_A = A.pattern();
+  const auto pattern_B1 = B1.pattern();
+  const auto pattern_B2 = B2.pattern();
+  const auto pattern_C = C.pattern();
+  // the entries of D^{-1}
+  std::vector<Field> inverse_diagonal(m);
+  for (size_t kk = 0; kk < m; ++kk) {
+    Field diagonal_entry(0);
+    if (type == "diagonal")
+      diagonal_entry = A.get_entry(kk, kk);
+    else
+      for (const auto& jj : pattern_A.inner(kk))
+        diagonal_entry += std::abs(A.get_entry(kk, jj));
+    if (diagonal_entry == Field(0))
+      DUNE_THROW(Common::Exceptions::wrong_input_given,
+                 "The " << (type == "diagonal" ? "diagonal entry" : "row sum") << " of A in row " << kk
+                        << " is zero, the Schur complement cannot be approximated!");
+    inverse_diagonal[kk] = Field(1) / diagonal_entry;
+  }
+  // (B2^T D^{-1} B1)_ij is the sum of B2_ki D^{-1}_kk B1_kj over all k
+  SparsityPatternBuilder pattern_builder(n);
+  for (size_t kk = 0; kk < m; ++kk)
+    for (const auto& ii : pattern_B2.inner(kk))
+      pattern_builder.insert(ii, pattern_B1.inner(kk).begin(), pattern_B1.inner(kk).end());
+  for (size_t ii = 0; ii < n; ++ii)
+    pattern_builder.insert(ii, pattern_C.inner(ii).begin(), pattern_C.inner(ii).end());
+  MatrixType ret(n, n, pattern_builder.finalize());
+  for (size_t ii = 0; ii < n; ++ii)
+    for (const auto& jj : pattern_C.inner(ii))
+      ret.set_entry(ii, jj, -C.get_entry(ii, jj));
+  for (size_t kk = 0; kk < m; ++kk)
+    for (const auto& ii : pattern_B2.inner(kk)) {
+      const Field scaled_B2_ki = B2.get_entry(kk, ii) * inverse_diagonal[kk];
+      for (const auto& jj : pattern_B1.inner(kk))
+        ret.add_to_entry(ii, jj, scaled_B2_ki * B1.get_entry(kk, jj));
+    }
+  return ret;
+} // ... approximate_schur_complement(...)
+
+
+/**
+ * \brief Preconditioner for the Schur complement B2^T A^{-1} B1 - C, which solves with a given approximation of it,
+ *        e.g. by approximate_schur_complement() or the pressure mass matrix for Stokes problems.
+ *
+ * The solver for the approximation is prepared once (see Solver::prepare()), so each application is a solve with the
+ * same factorization or preconditioner.
+ */
+template <class VectorType = IstlDenseVector<double>,
+          class MatrixType = IstlRowMajorSparseMatrix<double>,
+          class CommunicatorType = SequentialCommunication>
+class SchurComplementPreconditioner : public Dune::Preconditioner<VectorType, VectorType>
+{
+public:
+  using Vector = VectorType;
+  using Matrix = MatrixType;
+  using SolverType = Solver<Matrix, CommunicatorType>;
+
+  //! \note Keeps a reference to the given matrix.
+  SchurComplementPreconditioner(const Matrix& schur_complement_approximation,
+                                const Common::Configuration& solver_opts = SolverOptions<Matrix>::options())
+    : solver_(make_solver(schur_complement_approximation))
+    , solver_opts_(solver_opts)
+  {
+    internal::prepare_if_possible(solver_, solver_opts_, 0);
+  }
+
+  virtual void pre(Vector&, Vector&) override final {}
+
+  virtual void apply(Vector& v, const Vector& d) override final
+  {
+    solver_.apply(d, v, solver_opts_);
+  }
+
+  virtual void post(Vector&) override final {}
+
+  //! Category of the preconditioner (see SolverCategory::Category)
+  virtual SolverCategory::Category category() const override final
+  {
+    return SolverCategory::Category::sequential;
+  }
+
+private:
+  SolverType solver_;
+  const Common::Configuration solver_opts_;
+};
+
+
 } // namespace LA
 } // namespace XT
 } // namespace Dune
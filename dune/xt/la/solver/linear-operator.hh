@@ -0,0 +1,271 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_LA_SOLVER_LINEAR_OPERATOR_HH
+#define DUNE_XT_LA_SOLVER_LINEAR_OPERATOR_HH
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <dune/common/timer.hh>
+
+#include <dune/istl/operators.hh>
+#include <dune/istl/scalarproducts.hh>
+#include <dune/istl/solvers.hh>
+
+#include <dune/xt/common/configuration.hh>
+#include <dune/xt/common/exceptions.hh>
+#include <dune/xt/common/math.hh>
+
+#include <dune/xt/la/container/linear-operator.hh>
+
+#include "istl/preconditioners.hh"
+#include "istl/scalarproducts.hh"
+#include "../solver.hh"
+
+namespace Dune {
+namespace XT {
+namespace LA {
+namespace internal {
+
+
+// models a LinearOperatorInterface as a dune-istl LinearOperator, to be used with the Krylov solvers of dune-istl
+template <class VectorType>
+class IstlLinearOperatorAdapter : public Dune::LinearOperator<VectorType, VectorType>
+{
+  using BaseType = Dune::LinearOperator<VectorType, VectorType>;
+
+public:
+  using typename BaseType::field_type;
+
+  IstlLinearOperatorAdapter(const LinearOperatorInterface<VectorType>& op)
+    : op_(op)
+    , tmp_(op.rows(), 0.)
+  {}
+
+  virtual void apply(const VectorType& x, VectorType& y) const override final
+  {
+    op_.mv(x, y);
+  }
+
+  virtual void applyscaleadd(field_type alpha, const VectorType& x, VectorType& y) const override final
+  {
+    op_.mv(x, tmp_);
+    y.axpy(alpha, tmp_);
+  }
+
+  //! Category of the linear operator (see SolverCategory::Category)
+  virtual SolverCategory::Category category() const override final
+  {
+    return SolverCategory::Category::sequential;
+  }
+
+private:
+  const LinearOperatorInterface<VectorType>& op_;
+  mutable VectorType tmp_;
+}; // class IstlLinearOperatorAdapter
+
+
+} // namespace internal
+
+
+template <class VectorType, class CommunicatorType>
+class SolverOptions<LinearOperatorInterface<VectorType>, CommunicatorType> : protected internal::SolverUtils
+{
+public:
+  using MatrixType = LinearOperatorInterface<VectorType>;
+
+  static std::vector<std::string> types()
+  {
+    return {"cg", "bicgstab", "minres", "gmres"};
+  }
+
+  static Common::Configuration options(const std::string type = "")
+  {
+    const std::string tp = !type.empty() ? type : types()[0];
+    internal::SolverUtils::check_given(tp, types());
+    Common::Configuration general_opts({"type", "post_check_solves_system", "verbose"}, {tp.c_str(), "1e-5", "0"});
+    // 'post_check_reuses_residual' skips computing the residual if the last one of the Krylov solver is small enough
+    Common::Configuration iterative_options({"max_iter", "precision", "post_check_reuses_residual"},
+                                            {"10000", "1e-10", "0"});
+    iterative_options += general_opts;
+    if (tp == "gmres")
+      iterative_options.set("restart", "100");
+    return iterative_options;
+  } // ... options(...)
+}; // class SolverOptions<LinearOperatorInterface<...>>
+
+
+/**
+ * \brief Unpreconditioned Krylov solvers of dune-istl for operators which are only applied, e.g. a BlockOperator or a
+ *        LinearCombinationOperator, without assembling the operator.
+ *
+ * cg requires a symmetric positive definite operator, minres a symmetric one, bicgstab and gmres (restarted after
+ * 'restart' iterations) work for all invertible operators. Any operator derived from LinearOperatorInterface may be
+ * given (see also make_solver()), only sequential solves are supported.
+ */
+template <class VectorType, class CommunicatorType>
+class Solver<LinearOperatorInterface<VectorType>, CommunicatorType> : protected internal::SolverUtils
+{
+public:
+  using MatrixType = LinearOperatorInterface<VectorType>;
+  using S = typename VectorType::ScalarType;
+  using R = typename VectorType::RealType;
+
+  Solver(const MatrixType& op)
+    : op_(op)
+  {}
+
+  Solver(const MatrixType& op, const CommunicatorType& /*communicator*/)
+    : Solver(op)
+  {}
+
+  static std::vector<std::string> types()
+  {
+    return SolverOptions<MatrixType, CommunicatorType>::types();
+  }
+
+  static Common::Configuration options(const std::string type = "")
+  {
+    return SolverOptions<MatrixType, CommunicatorType>::options(type);
+  }
+
+  void apply(const VectorType& rhs, VectorType& solution) const
+  {
+    apply(rhs, solution, types()[0]);
+  }
+
+  void apply(const VectorType& rhs, VectorType& solution, const std::string& type) const
+  {
+    apply(rhs, solution, options(type));
+  }
+
+  int verbosity(const Common::Configuration& opts, const Common::Configuration& default_opts) const
+  {
+    return opts.get("verbose", default_opts.get<int>("verbose"));
+  }
+
+  //! \note The given solution is used as initial guess.
+  void apply(const VectorType& rhs, VectorType& solution, const Common::Configuration& opts) const
+  {
+    if (!opts.has_key("type"))
+      DUNE_THROW(Common::Exceptions::configuration_error,
+                 "Given options (see below) need to have at least the key 'type' set!\n\n"
+                     << opts);
+    const auto type = opts.get<std::string>("type");
+    internal::SolverUtils::check_given(type, types());
+    const Common::Configuration default_opts = options(type);
+    SolverStatisticsStorage::Recorder statistics(statistics_, type);
+    internal::IstlLinearOperatorAdapter<VectorType> op(op_);
+    IdentityPreconditioner<internal::IstlLinearOperatorAdapter<VectorType>> preconditioner(op.category());
+    SeqScalarProduct<VectorType> backend_scalar_product;
+    internal::RecordingScalarProduct<VectorType> scalar_product(backend_scalar_product,
+                                                                &statistics->residual_history);
+    // the dune-istl solvers overwrite the rhs
+    typename internal::ScratchVector<VectorType>::Access scratch(residual_);
+    auto& residual = *scratch;
+    residual = rhs;
+    const auto precision = opts.get("precision", default_opts.get<R>("precision"));
+    const auto max_iter = opts.get("max_iter", default_opts.get<int>("max_iter"));
+    InverseOperatorResult solver_result;
+    Timer timer;
+    if (type == "cg") {
+      CGSolver<VectorType> solver(
+          op, scalar_product, preconditioner, precision, max_iter, verbosity(opts, default_opts), false);
+      solver.apply(solution, residual, solver_result);
+    } else if (type == "bicgstab") {
+      BiCGSTABSolver<VectorType> solver(
+          op, scalar_product, preconditioner, precision, max_iter, verbosity(opts, default_opts));
+      solver.apply(solution, residual, solver_result);
+    } else if (type == "minres") {
+      MINRESSolver<VectorType> solver(
+          op, scalar_product, preconditioner, precision, max_iter, verbosity(opts, default_opts));
+      solver.apply(solution, residual, solver_result);
+    } else if (type == "gmres") {
+      RestartedGMResSolver<VectorType> solver(op,
+                                              scalar_product,
+                                              preconditioner,
+                                              precision,
+                                              opts.get("restart", default_opts.get<int>("restart")),
+                                              max_iter,
+                                              verbosity(opts, default_opts));
+      solver.apply(solution, residual, solver_result);
+    } else
+      DUNE_THROW(Common::Exceptions::internal_error,
+                 "Given type '" << type << "' is not supported, although it was reported by types()!");
+    statistics->solve_time = timer.elapsed();
+    statistics->iterations = solver_result.iterations;
+    statistics->reduction = static_cast<double>(solver_result.reduction);
+    if (!solver_result.converged)
+      DUNE_THROW(Exceptions::linear_solver_failed_bc_it_did_not_converge,
+                 "The dune-istl backend reported 'InverseOperatorResult.converged == false'!\n"
+                     << "Those were the given options:\n\n"
+                     << opts);
+
+    // check
+    const R post_check_solves_system_threshold =
+        opts.get("post_check_solves_system", default_opts.get<R>("post_check_solves_system"));
+    if (post_check_solves_system_threshold > 0) {
+      timer.reset();
+      // the Krylov solvers compute the 2-norm of their residual last, which bounds the sup-norm
+      const bool reuse_residual =
+          opts.get("post_check_reuses_residual", default_opts.get<bool>("post_check_reuses_residual"));
+      if (reuse_residual && !statistics->residual_history.empty()
+          && statistics->residual_history.back() <= post_check_solves_system_threshold) {
+        statistics->post_check_time = timer.elapsed();
+        return;
+      }
+      op_.mv(solution, residual);
+      residual -= rhs;
+      const R sup_norm = residual.sup_norm();
+      statistics->post_check_time = timer.elapsed();
+      if (sup_norm > post_check_solves_system_threshold || Common::isnan(sup_norm) || Common::isinf(sup_norm))
+        DUNE_THROW(Exceptions::linear_solver_failed_bc_the_solution_does_not_solve_the_system,
+                   "The computed solution does not solve the system (although the dune-istl backend "
+                       << "reported no error) and you requested checking (see options below)!\n"
+                       << "If you want to disable this check, set 'post_check_solves_system = 0' in the options."
+                       << "\n\n"
+                       << "  (A * x - b).sup_norm() = " << sup_norm << "\n\n"
+                       << "Those were the given options:\n\n"
+                       << opts);
+    }
+  } // ... apply(...)
+
+  //! \sa SolverStatistics
+  SolverStatistics statistics() const
+  {
+    return statistics_.get();
+  }
+
+private:
+  const MatrixType& op_;
+  // holds the rhs during the solve and the residual in the post check
+  internal::ScratchVector<VectorType> residual_;
+  SolverStatisticsStorage statistics_;
+}; // class Solver<LinearOperatorInterface<...>>
+
+
+template <class V>
+Solver<LinearOperatorInterface<V>> make_solver(const LinearOperatorInterface<V>& op)
+{
+  return Solver<LinearOperatorInterface<V>>(op);
+}
+
+
+template <class V, class... Args>
+void solve(const LinearOperatorInterface<V>& op, const V& b, V& x, Args&&... args)
+{
+  make_solver(op).apply(b, x, std::forward<Args>(args)...);
+}
+
+
+} // namespace LA
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_LA_SOLVER_LINEAR_OPERATOR_HH
@@ -0,0 +1,151 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#ifndef DUNE_XT_LA_SOLVER_STATISTICS_HH
+#define DUNE_XT_LA_SOLVER_STATISTICS_HH
+
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Dune {
+namespace XT {
+namespace LA {
+
+
+/**
+ * \brief Statistics of the last finished call to apply() (or prepare()) of a Solver, see Solver::statistics().
+ *
+ * All times are wall clock times in seconds. The setup is the computation of the factorization (direct solvers) or of
+ * the preconditioner (iterative solvers), its time is zero if the setup computed in prepare() was reused.
+ *
+ * For solves with several right hand sides, the times and iterations are summed up, the reduction is the largest one
+ * and the residual history is the one of the last right hand side.
+ */
+struct SolverStatistics
+{
+  //! the type of the solver, see Solver::types()
+  std::string type;
+  //! whether the setup computed in prepare() was used
+  bool setup_reused = false;
+  double setup_time = 0.;
+  //! the time for the triangular solves (direct solvers) or the Krylov iterations (iterative solvers)
+  double solve_time = 0.;
+  //! the time spent in 'post_check_solves_system', zero if disabled
+  double post_check_time = 0.;
+  //! the number of iterations of iterative solvers, 1 for direct solvers
+  size_t iterations = 0;
+  //! the reduction of the residual norm reported by the backend, negative if unknown
+  double reduction = -1.;
+  //! the residual norms of the iterates as computed by the backend, empty if not available (see the solvers)
+  std::vector<double> residual_history;
+
+  double total_time() const
+  {
+    return setup_time + solve_time + post_check_time;
+  }
+
+  void clear()
+  {
+    *this = SolverStatistics();
+  }
+}; // struct SolverStatistics
+
+
+/**
+ * \brief Keeps the statistics of the last finished call of a solver.
+ *
+ * Each call collects its own statistics (see Recorder), which are only stored here, guarded by a mutex, when the call
+ * returns. Thus, concurrent calls of the const apply() of one solver do not interfere (statistics() then returns the
+ * statistics of the call which finished last).
+ */
+class SolverStatisticsStorage
+{
+public:
+  //! Collects the statistics of one call and stores them when destroyed (i.e. also if the call throws).
+  class Recorder
+  {
+  public:
+    Recorder(const SolverStatisticsStorage& storage, const std::string& type)
+      : storage_(storage)
+    {
+      statistics_.type = type;
+    }
+
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+
+    ~Recorder()
+    {
+      storage_.set(std::move(statistics_));
+    }
+
+    SolverStatistics& operator*()
+    {
+      return statistics_;
+    }
+
+    SolverStatistics* operator->()
+    {
+      return &statistics_;
+    }
+
+  private:
+    const SolverStatisticsStorage& storage_;
+    SolverStatistics statistics_;
+  }; // class Recorder
+
+  SolverStatisticsStorage() = default;
+
+  SolverStatisticsStorage(const SolverStatisticsStorage& other)
+    : statistics_(other.get())
+  {}
+
+  SolverStatisticsStorage& operator=(const SolverStatisticsStorage& other)
+  {
+    if (this != &other)
+      set(other.get());
+    return *this;
+  }
+
+  SolverStatistics get() const
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return statistics_;
+  }
+
+  void set(SolverStatistics statistics) const
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    statistics_ = std::move(statistics);
+  }
+
+private:
+  mutable std::mutex mutex_;
+  mutable SolverStatistics statistics_;
+}; // class SolverStatisticsStorage
+
+
+//! Prints the statistics in one line (without the residual history), e.g. for log files.
+inline std::ostream& operator<<(std::ostream& out, const SolverStatistics& statistics)
+{
+  out << "type: " << statistics.type << ", setup: " << (statistics.setup_reused ? "reused" : "computed") << " ("
+      << statistics.setup_time << "s), solve: " << statistics.solve_time
+      << "s, post check: " << statistics.post_check_time << "s, iterations: " << statistics.iterations;
+  if (statistics.reduction >= 0)
+    out << ", reduction: " << statistics.reduction;
+  return out;
+} // ... operator<<(...)
+
+
+} // namespace LA
+} // namespace XT
+} // namespace Dune
+
+#endif // DUNE_XT_LA_SOLVER_STATISTICS_HH
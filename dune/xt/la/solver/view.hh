@@ -10,23 +10,107 @@
 #ifndef DUNE_XT_LA_SOLVER_VIEW_HH
 #define DUNE_XT_LA_SOLVER_VIEW_HH
 
+#include <memory>
 #include <string>
+#include <type_traits>
 #include <vector>
-#include <algorithm>
-#include <sstream>
-#include <cmath>
 
 #include <dune/xt/common/configuration.hh>
 
-#include <dune/xt/la/algorithms/qr.hh>
+#include <dune/xt/la/container/block-matrix.hh>
+#include <dune/xt/la/container/linear-operator.hh>
 #include <dune/xt/la/container/matrix-view.hh>
 #include <dune/xt/la/container/vector-view.hh>
 
+#include "linear-operator.hh"
 #include "../solver.hh"
 
 namespace Dune {
 namespace XT {
 namespace LA {
+namespace internal {
+
+
+// applies the viewed block of a matrix (and its transpose) without copying it
+template <class MatrixImp, class VectorType>
+class MatrixViewOperator : public LinearOperatorInterface<VectorType>
+{
+  using AccessType = SparseEntryAccess<MatrixImp>;
+  using ScalarType = typename MatrixImp::ScalarType;
+
+public:
+  MatrixViewOperator(const MatrixView<MatrixImp>& matrix_view)
+    : matrix_view_(matrix_view)
+  {}
+
+  size_t rows() const override final
+  {
+    return matrix_view_.rows();
+  }
+
+  size_t cols() const override final
+  {
+    return matrix_view_.cols();
+  }
+
+  void mv(const VectorType& xx, VectorType& yy) const override final
+  {
+    check_operator_sizes(rows(), cols(), xx, yy);
+    mv(xx, yy, std::integral_constant<bool, AccessType::backend_access>());
+  }
+
+  void mtv(const VectorType& xx, VectorType& yy) const override final
+  {
+    check_operator_sizes(cols(), rows(), xx, yy);
+    mtv(xx, yy, std::integral_constant<bool, AccessType::backend_access>());
+  }
+
+private:
+  void mv(const VectorType& xx, VectorType& yy, std::true_type /*backend_access*/) const
+  {
+    const size_t first_row = matrix_view_.first_row();
+    const size_t first_col = matrix_view_.first_col();
+    yy.set_all(ScalarType(0));
+    AccessType::for_each_in_block(matrix_view_.matrix(),
+                                  first_row,
+                                  matrix_view_.past_last_row(),
+                                  first_col,
+                                  matrix_view_.past_last_col(),
+                                  [&](const size_t ii, const size_t jj, const ScalarType& value) {
+                                    yy[ii - first_row] += value * xx[jj - first_col];
+                                  });
+  } // ... mv(...)
+
+  void mv(const VectorType& xx, VectorType& yy, std::false_type /*backend_access*/) const
+  {
+    matrix_view_.mv(xx, yy);
+  }
+
+  void mtv(const VectorType& xx, VectorType& yy, std::true_type /*backend_access*/) const
+  {
+    const size_t first_row = matrix_view_.first_row();
+    const size_t first_col = matrix_view_.first_col();
+    yy.set_all(ScalarType(0));
+    AccessType::for_each_in_block(matrix_view_.matrix(),
+                                  first_row,
+                                  matrix_view_.past_last_row(),
+                                  first_col,
+                                  matrix_view_.past_last_col(),
+                                  [&](const size_t ii, const size_t jj, const ScalarType& value) {
+                                    yy[jj - first_col] += value * xx[ii - first_row];
+                                  });
+  } // ... mtv(...)
+
+  void mtv(const VectorType& xx, VectorType& yy, std::false_type /*backend_access*/) const
+  {
+    matrix_view_.mtv(xx, yy);
+  }
+
+  const MatrixView<MatrixImp>& matrix_view_;
+}; // class MatrixViewOperator
+
+
+} // namespace internal
 
 
 template <class MatrixImp, class CommunicatorType>
@@ -47,6 +131,20 @@ public:
 }; // class SolverOptions<MatrixView<...>>
 
 
+/**
+ * \brief Solves with the viewed block of a matrix, offering the same types as Solver<MatrixImp>.
+ *
+ * Like the other solvers, apply() uses the current entries of the underlying matrix, unless prepare() was called:
+ *
+ * - The unpreconditioned Krylov types of dune-istl ('cg' and 'bicgstab') have no setup. They are carried out matrix
+ *   free by Solver<LinearOperatorInterface<...>>, applying the viewed block directly from the storage of the
+ *   underlying matrix.
+ * - For all other types (in particular all types of Eigen, which differ from the dune-istl ones, e.g. in the
+ *   definition of 'precision'), the block is extracted in one pass over the storage of the underlying matrix and
+ *   solved with by Solver<MatrixImp>. After prepare(), the extracted block and the setup of Solver<MatrixImp> are kept
+ *   for all subsequent calls to apply() with the prepared type, call update() after changing the entries of the
+ *   underlying matrix.
+ */
 template <class MatrixImp, class CommunicatorType>
 class Solver<MatrixView<MatrixImp>, CommunicatorType> : protected internal::SolverUtils
 {
@@ -57,14 +155,7 @@ public:
 
   Solver(const MatrixType& matrix_view)
     : matrix_view_(matrix_view)
-    , matrix_(matrix_view_.rows(), matrix_view_.cols(), matrix_view_.pattern())
-    , actual_solver_(matrix_)
-  {
-    const auto pattern = matrix_view_.pattern();
-    for (size_t ii = 0; ii < matrix_view_.rows(); ++ii)
-      for (const auto& jj : pattern.inner(ii))
-        matrix_.set_entry(ii, jj, matrix_view_.get_entry(ii, jj));
-  }
+  {}
 
   Solver(const MatrixType& matrix, const CommunicatorType& /*communicator*/)
     : Solver(matrix)
@@ -80,6 +171,57 @@ public:
     return SolverOptions<MatrixType, CommunicatorType>::options(type);
   } // ... options(...)
 
+  void prepare()
+  {
+    prepare(types()[0]);
+  }
+
+  void prepare(const std::string& type)
+  {
+    prepare(options(type));
+  }
+
+  /**
+   * \brief Extracts the viewed block and prepares Solver<MatrixImp> for it (see Solver::prepare()), both are then
+   *        reused by all subsequent calls to apply() with the same type.
+   * \note The matrix free types have no setup to prepare, they always use the current entries.
+   */
+  void prepare(const Common::Configuration& opts)
+  {
+    const auto type = check_type(opts);
+    invalidate();
+    prepared_type_ = type;
+    if (!matrix_free_type_of(type).empty())
+      return;
+    extractor_ = create_extractor();
+    actual_solver_ = std::make_unique<ActualSolver>(extractor_->matrix());
+    internal::prepare_if_possible(*actual_solver_, opts, 0);
+  } // ... prepare(...)
+
+  //! Copies the entries of the viewed block again and updates the setup of Solver<MatrixImp>, see Solver::update().
+  void update()
+  {
+    if (!prepared())
+      DUNE_THROW(Common::Exceptions::you_are_using_this_wrong, "Call prepare() before calling update()!");
+    if (!extractor_)
+      return;
+    extractor_->update();
+    internal::update_if_possible(*actual_solver_, 0);
+  } // ... update(...)
+
+  //! Drops the extracted block and the setup computed in prepare().
+  void invalidate()
+  {
+    actual_solver_ = nullptr;
+    extractor_ = nullptr;
+    prepared_type_.clear();
+  }
+
+  bool prepared() const
+  {
+    return !prepared_type_.empty();
+  }
+
   template <class VectorType>
   void apply(const VectorType& rhs, VectorType& solution) const
   {
@@ -95,9 +237,27 @@ public:
   template <class VectorType>
   void apply(const VectorType& rhs, VectorType& solution, const Common::Configuration& opts) const
   {
-    std::cerr << "Warning: Currently, Solver for MatrixView just copies everything to a new matrix, may be slow!"
-              << std::endl;
-    actual_solver_.apply(rhs, solution, opts);
+    const auto type = check_type(opts);
+    const std::string matrix_free_type = matrix_free_type_of(type);
+    if (!matrix_free_type.empty()) {
+      using OperatorSolverType = Solver<LinearOperatorInterface<VectorType>>;
+      const Common::Configuration default_opts = options(type);
+      auto operator_opts = OperatorSolverType::options(matrix_free_type);
+      for (const std::string key :
+           {"max_iter", "precision", "verbose", "post_check_solves_system", "post_check_reuses_residual"}) {
+        if (opts.has_key(key))
+          operator_opts[key] = opts.get<std::string>(key);
+        else if (default_opts.has_key(key))
+          operator_opts[key] = default_opts.get<std::string>(key);
+      }
+      const internal::MatrixViewOperator<MatrixImp, VectorType> op(matrix_view_);
+      OperatorSolverType(op).apply(rhs, solution, operator_opts);
+    } else if (actual_solver_ && type == prepared_type_)
+      actual_solver_->apply(rhs, solution, opts);
+    else {
+      const auto extractor = create_extractor();
+      ActualSolver(extractor->matrix()).apply(rhs, solution, opts);
+    }
   } // ... apply(...)
 
   template <class VectorType>
@@ -112,24 +272,61 @@ public:
     apply(rhs, solution, options(type));
   }
 
+  //! \note The given solution is used as initial guess for the iterative types.
   template <class VectorType>
   void
   apply(const VectorView<VectorType>& rhs, VectorView<VectorType>& solution, const Common::Configuration& opts) const
   {
-    std::cerr << "Warning: Currently, Solver for MatrixView just copies everything to a new matrix, may be slow!"
-              << std::endl;
     VectorType actual_rhs(rhs.size()), actual_solution(solution.size());
     for (size_t ii = 0; ii < rhs.size(); ++ii)
       actual_rhs[ii] = rhs[ii];
-    apply(actual_rhs, actual_solution, opts);
     for (size_t ii = 0; ii < solution.size(); ++ii)
       actual_solution[ii] = solution[ii];
+    apply(actual_rhs, actual_solution, opts);
+    for (size_t ii = 0; ii < solution.size(); ++ii)
+      solution[ii] = actual_solution[ii];
   } // ... apply(...)
 
 private:
+  static std::string check_type(const Common::Configuration& opts)
+  {
+    if (!opts.has_key("type"))
+      DUNE_THROW(Common::Exceptions::configuration_error,
+                 "Given options (see below) need to have at least the key 'type' set!\n\n"
+                     << opts);
+    const auto type = opts.get<std::string>("type");
+    internal::SolverUtils::check_given(type, types());
+    return type;
+  } // ... check_type(...)
+
+  // the type of Solver<LinearOperatorInterface<...>> equivalent to the given one, if it is an unpreconditioned Krylov
+  // method of dune-istl, an empty string otherwise (the Eigen types are solved with the extracted block, see above)
+  static std::string matrix_free_type_of(const std::string& type)
+  {
+    if (type == "cg" || type == "bicgstab")
+      return type;
+    return "";
+  }
+
+  // extracts the viewed block in one pass over the storage of the underlying matrix
+  std::unique_ptr<BlockMatrixAssembler<MatrixImp>> create_extractor() const
+  {
+    auto extractor = std::make_unique<BlockMatrixAssembler<MatrixImp>>(matrix_view_.rows(), matrix_view_.cols());
+    extractor->add_sub_block(0,
+                             0,
+                             matrix_view_.matrix(),
+                             matrix_view_.first_row(),
+                             matrix_view_.past_last_row(),
+                             matrix_view_.first_col(),
+                             matrix_view_.past_last_col());
+    extractor->assemble();
+    return extractor;
+  } // ... create_extractor(...)
+
   const MatrixType& matrix_view_;
-  MatrixImp matrix_;
-  ActualSolver actual_solver_;
+  std::string prepared_type_;
+  std::unique_ptr<BlockMatrixAssembler<MatrixImp>> extractor_;
+  std::unique_ptr<ActualSolver> actual_solver_;
 }; // class Solver< MatrixView< ... > >
 
 
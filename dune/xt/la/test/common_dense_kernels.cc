@@ -0,0 +1,238 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/common/test/main.hxx> // <- This one has to come first, includes config.h!
+#include <dune/xt/common/test/gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
+
+#include <dune/xt/la/container/common.hh>
+
+using namespace Dune;
+using XT::LA::internal::SimdInstructionSet;
+
+
+static const std::vector<SimdInstructionSet> instruction_sets = {
+    SimdInstructionSet::portable, SimdInstructionSet::avx2, SimdInstructionSet::avx512};
+
+// covers empty vectors, pure remainder loops and all combinations of full and partial simd registers
+static const std::vector<size_t> sizes = {0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 33, 1001};
+
+
+XT::LA::CommonDenseVector<double> create_vector(const size_t size, const double offset)
+{
+  XT::LA::CommonDenseVector<double> vector(size);
+  for (size_t ii = 0; ii < size; ++ii)
+    vector[ii] = std::sin(double(ii) + offset);
+  return vector;
+}
+
+
+template <XT::Common::StorageLayout layout>
+XT::LA::CommonDenseMatrix<double, layout> create_matrix(const size_t rows, const size_t cols)
+{
+  XT::LA::CommonDenseMatrix<double, layout> matrix(rows, cols);
+  for (size_t ii = 0; ii < rows; ++ii)
+    for (size_t jj = 0; jj < cols; ++jj)
+      matrix.set_entry(ii, jj, std::cos(double(3 * ii + jj)));
+  return matrix;
+}
+
+
+template <XT::Common::StorageLayout layout>
+void check_mv_and_mtv(const size_t rows, const size_t cols)
+{
+  const auto matrix = create_matrix<layout>(rows, cols);
+  const auto xx = create_vector(cols, 0.5);
+  const auto yy = create_vector(rows, 1.5);
+  XT::LA::CommonDenseVector<double> mv_result(rows, 42.), mtv_result(cols, 42.);
+  matrix.mv(xx, mv_result);
+  matrix.mtv(yy, mtv_result);
+  for (size_t ii = 0; ii < rows; ++ii) {
+    double expected = 0.;
+    for (size_t jj = 0; jj < cols; ++jj)
+      expected += matrix.get_entry(ii, jj) * xx[jj];
+    EXPECT_NEAR(expected, mv_result[ii], 1e-12 * (1. + cols));
+  }
+  for (size_t jj = 0; jj < cols; ++jj) {
+    double expected = 0.;
+    for (size_t ii = 0; ii < rows; ++ii)
+      expected += matrix.get_entry(ii, jj) * yy[ii];
+    EXPECT_NEAR(expected, mtv_result[jj], 1e-12 * (1. + rows));
+  }
+} // ... check_mv_and_mtv(...)
+
+
+GTEST_TEST(CommonDenseKernelsTest, vector_operations_match_naive_loops)
+{
+  for (const auto& instruction_set : instruction_sets) {
+    XT::LA::internal::set_simd_instruction_set(instruction_set);
+    for (const auto& size : sizes) {
+      const auto xx = create_vector(size, 0.);
+      const auto yy = create_vector(size, 1.);
+      double dot = 0., l1 = 0., l2 = 0., sum = 0., max = 0.;
+      size_t max_index = 0;
+      for (size_t ii = 0; ii < size; ++ii) {
+        dot += xx[ii] * yy[ii];
+        l1 += std::abs(xx[ii]);
+        l2 += xx[ii] * xx[ii];
+        sum += xx[ii];
+        if (std::abs(xx[ii]) > max) {
+          max = std::abs(xx[ii]);
+          max_index = ii;
+        }
+      }
+      const double tolerance = 1e-12 * (1. + size);
+      EXPECT_NEAR(dot, xx.dot(yy), tolerance);
+      EXPECT_NEAR(l1, xx.l1_norm(), tolerance);
+      EXPECT_NEAR(std::sqrt(l2), xx.l2_norm(), tolerance);
+      EXPECT_EQ(max, xx.sup_norm());
+      EXPECT_EQ(max_index, xx.amax().first);
+      if (size > 0)
+        EXPECT_NEAR(sum / size, xx.mean(), tolerance);
+      else
+        EXPECT_EQ(0., xx.mean());
+      auto zz = yy.copy();
+      zz.axpy(0.25, xx);
+      zz.scal(-2.);
+      for (size_t ii = 0; ii < size; ++ii)
+        EXPECT_NEAR(-2. * (yy[ii] + 0.25 * xx[ii]), zz[ii], 1e-15);
+    }
+  }
+  XT::LA::internal::set_simd_instruction_set(XT::LA::internal::detected_simd_instruction_set());
+} // GTEST_TEST(CommonDenseKernelsTest, vector_operations_match_naive_loops)
+
+
+GTEST_TEST(CommonDenseKernelsTest, amax_returns_first_index_of_maximum)
+{
+  for (const auto& instruction_set : instruction_sets) {
+    XT::LA::internal::set_simd_instruction_set(instruction_set);
+    XT::LA::CommonDenseVector<double> vector(19, 1.);
+    vector[5] = -3.;
+    vector[17] = 3.;
+    const auto amax = vector.amax();
+    EXPECT_EQ(size_t(5), amax.first);
+    EXPECT_EQ(3., amax.second);
+    EXPECT_EQ(size_t(0), XT::LA::CommonDenseVector<double>(7, 0.).amax().first);
+  }
+  XT::LA::internal::set_simd_instruction_set(XT::LA::internal::detected_simd_instruction_set());
+}
+
+
+// amax() skips NaN entries as VectorInterface::amax() does, while a NaN entry has to propagate to the sup norm,
+// otherwise the post checks of the solvers would miss it
+GTEST_TEST(CommonDenseKernelsTest, amax_skips_nan_sup_norm_propagates_nan)
+{
+  for (const auto& instruction_set : instruction_sets) {
+    XT::LA::internal::set_simd_instruction_set(instruction_set);
+    for (const auto& size : sizes) {
+      for (size_t nan_index = 0; nan_index < std::min(size, size_t(20)); ++nan_index) {
+        auto vector = create_vector(size, 0.);
+        vector[size - 1] = 42.;
+        vector[nan_index] = std::nan("");
+        auto expected = std::make_pair(size_t(0), 0.);
+        for (size_t ii = 0; ii < size; ++ii)
+          if (std::abs(vector[ii]) > expected.second)
+            expected = std::make_pair(ii, std::abs(vector[ii]));
+        const auto amax = vector.amax();
+        EXPECT_EQ(expected.first, amax.first) << "size = " << size << ", nan_index = " << nan_index;
+        EXPECT_EQ(expected.second, amax.second) << "size = " << size << ", nan_index = " << nan_index;
+        EXPECT_TRUE(std::isnan(vector.sup_norm())) << "size = " << size << ", nan_index = " << nan_index;
+      }
+    }
+    XT::LA::CommonDenseVector<double> only_nans(9, std::nan(""));
+    EXPECT_EQ(size_t(0), only_nans.amax().first);
+    EXPECT_EQ(0., only_nans.amax().second);
+  }
+  XT::LA::internal::set_simd_instruction_set(XT::LA::internal::detected_simd_instruction_set());
+}
+
+
+GTEST_TEST(CommonDenseKernelsTest, matrix_operations_match_naive_loops)
+{
+  for (const auto& instruction_set : instruction_sets) {
+    XT::LA::internal::set_simd_instruction_set(instruction_set);
+    for (const auto& rows : {size_t(0), size_t(1), size_t(7), size_t(18)}) {
+      for (const auto& cols : {size_t(0), size_t(1), size_t(5), size_t(17)}) {
+        check_mv_and_mtv<XT::Common::StorageLayout::dense_row_major>(rows, cols);
+        check_mv_and_mtv<XT::Common::StorageLayout::dense_column_major>(rows, cols);
+      }
+    }
+    auto matrix = create_matrix<XT::Common::StorageLayout::dense_row_major>(9, 11);
+    const auto other = create_matrix<XT::Common::StorageLayout::dense_row_major>(9, 11);
+    matrix.axpy(0.5, other);
+    matrix.scal(2.);
+    for (size_t ii = 0; ii < 9; ++ii)
+      for (size_t jj = 0; jj < 11; ++jj)
+        EXPECT_NEAR(3. * other.get_entry(ii, jj), matrix.get_entry(ii, jj), 1e-15);
+  }
+  XT::LA::internal::set_simd_instruction_set(XT::LA::internal::detected_simd_instruction_set());
+} // GTEST_TEST(CommonDenseKernelsTest, matrix_operations_match_naive_loops)
+
+
+template <XT::Common::StorageLayout layout, XT::Common::StorageLayout other_layout>
+void check_products(const size_t rows, const size_t inner, const size_t cols)
+{
+  const auto lhs = create_matrix<layout>(rows, inner);
+  const auto rhs = create_matrix<other_layout>(inner, cols);
+  XT::LA::CommonDenseMatrix<double, layout> expected(rows, cols, 0.);
+  for (size_t ii = 0; ii < rows; ++ii)
+    for (size_t jj = 0; jj < cols; ++jj)
+      for (size_t kk = 0; kk < inner; ++kk)
+        expected.add_to_entry(ii, jj, lhs.get_entry(ii, kk) * rhs.get_entry(kk, jj));
+  const auto product = lhs * rhs;
+  auto rightmultiplied = lhs.copy();
+  rightmultiplied.rightmultiply(rhs);
+  Dune::DynamicMatrix<double> rhs_dynamic(inner, cols);
+  for (size_t kk = 0; kk < inner; ++kk)
+    for (size_t jj = 0; jj < cols; ++jj)
+      rhs_dynamic[kk][jj] = rhs.get_entry(kk, jj);
+  auto rightmultiplied_by_dynamic = lhs.copy();
+  rightmultiplied_by_dynamic.rightmultiply(rhs_dynamic);
+  const auto check = [&](const XT::LA::CommonDenseMatrix<double, layout>& result) {
+    ASSERT_EQ(rows, result.rows());
+    ASSERT_EQ(cols, result.cols());
+    for (size_t ii = 0; ii < rows; ++ii)
+      for (size_t jj = 0; jj < cols; ++jj)
+        EXPECT_NEAR(expected.get_entry(ii, jj), result.get_entry(ii, jj), 1e-12 * (1. + inner));
+  };
+  check(product);
+  check(rightmultiplied);
+  check(rightmultiplied_by_dynamic);
+} // ... check_products(...)
+
+
+GTEST_TEST(CommonDenseKernelsTest, matrix_products_match_naive_loops)
+{
+  using XT::Common::StorageLayout;
+  for (const auto& instruction_set : instruction_sets) {
+    XT::LA::internal::set_simd_instruction_set(instruction_set);
+    // the inner dimension 300 exceeds one cache block
+    for (const auto& inner : {size_t(1), size_t(13), size_t(300)}) {
+      check_products<StorageLayout::dense_row_major, StorageLayout::dense_row_major>(9, inner, 17);
+      check_products<StorageLayout::dense_row_major, StorageLayout::dense_column_major>(130, inner, 5);
+      check_products<StorageLayout::dense_column_major, StorageLayout::dense_row_major>(3, inner, 33);
+      check_products<StorageLayout::dense_column_major, StorageLayout::dense_column_major>(1, inner, 1);
+    }
+  }
+  XT::LA::internal::set_simd_instruction_set(XT::LA::internal::detected_simd_instruction_set());
+  // the parallel variant has to produce the same result (is serial without TBB)
+  const size_t mm = 301, nn = 67, kk = 45;
+  const auto lhs = create_matrix<StorageLayout::dense_row_major>(mm, kk);
+  const auto rhs = create_matrix<StorageLayout::dense_row_major>(kk, nn);
+  std::vector<double> serial(mm * nn, 1.), parallel(mm * nn, 1.);
+  using Gemm = XT::LA::internal::CommonDenseGemm<double>;
+  Gemm::apply(mm, nn, kk, lhs.data(), kk, 1, rhs.data(), nn, 1, serial.data(), nn, 1, 1);
+  Gemm::apply(mm, nn, kk, lhs.data(), kk, 1, rhs.data(), nn, 1, parallel.data(), nn, 1, 4);
+  for (size_t ii = 0; ii < mm * nn; ++ii)
+    EXPECT_DOUBLE_EQ(serial[ii], parallel[ii]);
+} // GTEST_TEST(CommonDenseKernelsTest, matrix_products_match_naive_loops)
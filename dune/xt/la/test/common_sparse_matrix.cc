@@ -0,0 +1,318 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/common/test/main.hxx> // <- This one has to come first, includes config.h!
+#include <dune/xt/common/test/gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <dune/xt/common/parallel/threadmanager.hh>
+#include <dune/xt/la/algorithms/cholesky.hh>
+#include <dune/xt/la/algorithms/triangular_solves.hh>
+#include <dune/xt/la/container.hh>
+
+using namespace Dune;
+
+
+// non-symmetric matrix with a varying number of non-zeros per row (row ii has ii % 7 + 1 entries in the upper part)
+template <XT::Common::StorageLayout layout = XT::Common::StorageLayout::csr, class IndexType = size_t>
+XT::LA::CommonSparseMatrix<double, layout, IndexType> create_test_matrix(const size_t rows, const size_t cols)
+{
+  XT::LA::SparsityPatternDefault pattern(rows);
+  for (size_t ii = 0; ii < rows; ++ii)
+    for (size_t kk = 0; kk < ii % 7 + 1; ++kk)
+      pattern.insert(ii, (ii + 3 * kk) % cols);
+  pattern.sort();
+  XT::LA::CommonSparseMatrix<double, layout, IndexType> matrix(rows, cols, pattern);
+  for (size_t ii = 0; ii < rows; ++ii)
+    for (const auto& jj : pattern.inner(ii))
+      matrix.set_entry(ii, jj, 1. + double(ii) - 0.5 * double(jj));
+  return matrix;
+}
+
+
+GTEST_TEST(CommonSparseMatrixTest, parallel_mv_and_mtv_match_serial_ones)
+{
+  XT::Common::threadManager().set_max_threads(4);
+  const size_t rows = 1000, cols = 700;
+  auto matrix = create_test_matrix(rows, cols);
+  XT::LA::CommonDenseVector<double> xx(cols), yy(rows);
+  for (size_t ii = 0; ii < cols; ++ii)
+    xx[ii] = 1. / (1. + ii);
+  for (size_t ii = 0; ii < rows; ++ii)
+    yy[ii] = double(ii % 5);
+  XT::LA::CommonDenseVector<double> mv_serial(rows, 1.), mv_parallel(rows, 2.);
+  XT::LA::CommonDenseVector<double> mtv_serial(cols, 1.), mtv_parallel(cols, 2.);
+  matrix.set_parallel_threshold(std::numeric_limits<size_t>::max());
+  matrix.mv(xx, mv_serial);
+  matrix.mtv(yy, mtv_serial);
+  matrix.set_parallel_threshold(0);
+  EXPECT_EQ(size_t(0), matrix.parallel_threshold());
+  matrix.mv(xx, mv_parallel);
+  matrix.mtv(yy, mtv_parallel);
+  for (size_t ii = 0; ii < rows; ++ii)
+    EXPECT_DOUBLE_EQ(mv_serial[ii], mv_parallel[ii]);
+  for (size_t ii = 0; ii < cols; ++ii)
+    EXPECT_NEAR(mtv_serial[ii], mtv_parallel[ii], 1e-10 * std::abs(mtv_serial[ii]));
+  // the partial results of the parallel mtv() are reused by the next call
+  matrix.mtv(yy, mtv_parallel);
+  for (size_t ii = 0; ii < cols; ++ii)
+    EXPECT_NEAR(mtv_serial[ii], mtv_parallel[ii], 1e-10 * std::abs(mtv_serial[ii]));
+  // the threshold is kept by copies
+  const auto copy = matrix;
+  EXPECT_EQ(size_t(0), copy.parallel_threshold());
+}
+
+
+template <XT::Common::StorageLayout layout>
+void check_products(const size_t rows, const size_t inner, const size_t cols)
+{
+  const auto lhs = create_test_matrix<layout>(rows, inner);
+  const auto rhs = create_test_matrix<layout>(inner, cols);
+  XT::LA::CommonDenseMatrix<double> expected(rows, cols, 0.);
+  for (size_t ii = 0; ii < rows; ++ii)
+    for (size_t jj = 0; jj < cols; ++jj)
+      for (size_t kk = 0; kk < inner; ++kk)
+        expected.add_to_entry(ii, jj, lhs.get_entry(ii, kk) * rhs.get_entry(kk, jj));
+  const auto product = lhs * rhs;
+  auto rightmultiplied = lhs.copy();
+  rightmultiplied.rightmultiply(rhs);
+  // mixed products use the generic product of the MatrixInterface
+  const auto interface_product = lhs * XT::LA::CommonDenseMatrix<double>(rhs);
+  const auto check = [&](const auto& result) {
+    ASSERT_EQ(rows, result.rows());
+    ASSERT_EQ(cols, result.cols());
+    for (size_t ii = 0; ii < rows; ++ii)
+      for (size_t jj = 0; jj < cols; ++jj)
+        EXPECT_NEAR(expected.get_entry(ii, jj), result.get_entry(ii, jj), 1e-10 * (1. + inner));
+  };
+  check(product);
+  check(rightmultiplied);
+  check(interface_product);
+  // the product contains exactly the structural non-zeros, rightmultiply() additionally removes numerical zeros
+  EXPECT_EQ(XT::LA::multiplication_pattern(lhs.pattern(), rhs.pattern(), cols), product.pattern());
+  EXPECT_LE(rightmultiplied.non_zeros(), product.non_zeros());
+} // ... check_products(...)
+
+
+GTEST_TEST(CommonSparseMatrixTest, sparse_products_match_dense_ones)
+{
+  for (const auto& inner : {size_t(1), size_t(13), size_t(40)}) {
+    check_products<XT::Common::StorageLayout::csr>(30, inner, 20);
+    check_products<XT::Common::StorageLayout::csc>(30, inner, 20);
+  }
+  // galerkin product R A P of the 1d laplacian with linear interpolation P and restriction R = P^T
+  const size_t coarse = 10, fine = 2 * coarse - 1;
+  XT::LA::SparsityPatternDefault prolongation_pattern(fine);
+  for (size_t ii = 0; ii < coarse; ++ii) {
+    prolongation_pattern.insert(2 * ii, ii);
+    if (ii + 1 < coarse) {
+      prolongation_pattern.insert(2 * ii + 1, ii);
+      prolongation_pattern.insert(2 * ii + 1, ii + 1);
+    }
+  }
+  XT::LA::CommonSparseMatrixCsr<double> prolongation(fine, coarse, prolongation_pattern);
+  XT::LA::CommonSparseMatrixCsr<double> restriction(coarse, fine, prolongation_pattern.transposed(coarse));
+  XT::LA::CommonSparseMatrixCsr<double> laplace(fine, fine, XT::LA::tridiagonal_pattern(fine, fine));
+  for (size_t ii = 0; ii < fine; ++ii) {
+    for (const auto& jj : prolongation_pattern.inner(ii)) {
+      prolongation.set_entry(ii, jj, ii % 2 == 0 ? 1. : 0.5);
+      restriction.set_entry(jj, ii, ii % 2 == 0 ? 1. : 0.5);
+    }
+    for (size_t jj = (ii > 0 ? ii - 1 : 0); jj < std::min(ii + 2, fine); ++jj)
+      laplace.set_entry(ii, jj, ii == jj ? 2. : -1.);
+  }
+  const auto galerkin = restriction * laplace * prolongation;
+  auto rightmultiplied = restriction.copy();
+  rightmultiplied.rightmultiply(laplace);
+  rightmultiplied.rightmultiply(prolongation);
+  EXPECT_EQ(XT::LA::tridiagonal_pattern(coarse, coarse), galerkin.pattern());
+  EXPECT_EQ(XT::LA::tridiagonal_pattern(coarse, coarse), rightmultiplied.pattern());
+  // the interior rows are the coarse laplacian (scaled by 1/2)
+  for (size_t ii = 1; ii + 1 < coarse; ++ii) {
+    EXPECT_DOUBLE_EQ(1., galerkin.get_entry(ii, ii));
+    EXPECT_DOUBLE_EQ(-0.5, galerkin.get_entry(ii, ii - 1));
+    EXPECT_DOUBLE_EQ(-0.5, galerkin.get_entry(ii, ii + 1));
+    for (const auto& jj : {ii - 1, ii, ii + 1})
+      EXPECT_DOUBLE_EQ(galerkin.get_entry(ii, jj), rightmultiplied.get_entry(ii, jj));
+  }
+  EXPECT_THROW(laplace * restriction, XT::Common::Exceptions::shapes_do_not_match);
+} // GTEST_TEST(CommonSparseMatrixTest, sparse_products_match_dense_ones)
+
+
+GTEST_TEST(CommonSparseMatrixTest, parallel_spgemm_matches_serial_one)
+{
+  XT::Common::threadManager().set_max_threads(4);
+  const size_t mm = 1000, nn = 900, kk = 700;
+  const auto lhs = create_test_matrix(mm, kk);
+  const auto rhs = create_test_matrix(kk, nn);
+  using Spgemm = XT::LA::internal::CommonSparseSpgemm<double>;
+  std::vector<size_t> serial_row_pointers, serial_column_indices, parallel_row_pointers, parallel_column_indices;
+  std::vector<double> serial_entries, parallel_entries(3, 1.);
+  const auto apply = [&](std::vector<size_t>& row_pointers,
+                         std::vector<size_t>& column_indices,
+                         std::vector<double>& entries,
+                         const size_t threads) {
+    Spgemm::apply(mm,
+                  nn,
+                  lhs.outer_index_ptr(),
+                  lhs.inner_index_ptr(),
+                  lhs.entries(),
+                  rhs.outer_index_ptr(),
+                  rhs.inner_index_ptr(),
+                  rhs.entries(),
+                  row_pointers,
+                  column_indices,
+                  entries,
+                  threads);
+  };
+  apply(serial_row_pointers, serial_column_indices, serial_entries, 1);
+  apply(parallel_row_pointers, parallel_column_indices, parallel_entries, 4);
+  EXPECT_EQ(serial_row_pointers, parallel_row_pointers);
+  EXPECT_EQ(serial_column_indices, parallel_column_indices);
+  EXPECT_EQ(serial_entries, parallel_entries);
+  EXPECT_GE(Spgemm::multiply_adds(mm, lhs.outer_index_ptr(), lhs.inner_index_ptr(), rhs.outer_index_ptr()),
+            serial_entries.size());
+}
+
+
+GTEST_TEST(CommonSparseMatrixTest, compressed_patterns_give_the_same_matrices)
+{
+  const size_t rows = 50, cols = 30;
+  const auto expected = create_test_matrix(rows, cols);
+  const auto pattern = expected.pattern();
+  XT::LA::SparsityPatternCompressed<> compressed(pattern);
+  const XT::LA::SparsityPatternCompressed<uint32_t> compressed_32(pattern);
+  const auto* column_indices = compressed.column_indices().data();
+  // the arrays of an rvalue pattern are adopted
+  XT::LA::CommonSparseMatrixCsr<double> adopted(rows, cols, std::move(compressed));
+  EXPECT_EQ(column_indices, adopted.inner_index_ptr());
+  EXPECT_EQ(size_t(0), compressed.size());
+  XT::LA::CommonSparseMatrixCsr<double> csr(rows, cols, compressed_32);
+  XT::LA::CommonSparseMatrixCsc<double> csc(rows, cols, compressed_32);
+  XT::LA::CommonSparseMatrixCsc<double> csc_from_default(rows, cols, pattern);
+  XT::LA::CommonDenseMatrix<double> dense(rows, cols, compressed_32);
+  EXPECT_EQ(pattern, adopted.pattern());
+  EXPECT_EQ(pattern, csr.pattern());
+  EXPECT_EQ(pattern, csc.pattern());
+  EXPECT_EQ(csc_from_default.non_zeros(), csc.non_zeros());
+  for (size_t ii = 0; ii < rows; ++ii)
+    for (const auto& jj : pattern.inner(ii)) {
+      adopted.set_entry(ii, jj, expected.get_entry(ii, jj));
+      csr.set_entry(ii, jj, expected.get_entry(ii, jj));
+      csc.set_entry(ii, jj, expected.get_entry(ii, jj));
+      dense.set_entry(ii, jj, expected.get_entry(ii, jj));
+    }
+  for (size_t ii = 0; ii < rows; ++ii)
+    for (size_t jj = 0; jj < cols; ++jj) {
+      EXPECT_EQ(expected.get_entry(ii, jj), adopted.get_entry(ii, jj));
+      EXPECT_EQ(expected.get_entry(ii, jj), csr.get_entry(ii, jj));
+      EXPECT_EQ(expected.get_entry(ii, jj), csc.get_entry(ii, jj));
+      EXPECT_EQ(expected.get_entry(ii, jj), dense.get_entry(ii, jj));
+    }
+  EXPECT_THROW(XT::LA::CommonSparseMatrixCsr<double>(rows + 1, cols, compressed_32),
+               XT::Common::Exceptions::shapes_do_not_match);
+}
+
+
+// the column indices of a compressed pattern are checked against the number of columns, also in release builds
+template <class M>
+void check_pattern_columns()
+{
+  const XT::LA::SparsityPatternCompressed<> pattern({0, 1, 3}, {1, 0, 4});
+  EXPECT_NO_THROW(M(2, 5, pattern));
+  EXPECT_THROW(M(2, 4, pattern), XT::Common::Exceptions::shapes_do_not_match);
+}
+
+
+GTEST_TEST(CommonSparseMatrixTest, compressed_patterns_are_checked_against_the_columns)
+{
+  check_pattern_columns<XT::LA::CommonSparseMatrixCsr<double>>();
+  check_pattern_columns<XT::LA::CommonSparseMatrixCsc<double>>();
+#if HAVE_EIGEN
+  check_pattern_columns<XT::LA::EigenRowMajorSparseMatrix<double>>();
+#endif
+#if HAVE_DUNE_ISTL
+  check_pattern_columns<XT::LA::IstlRowMajorSparseMatrix<double>>();
+#endif
+}
+
+
+template <XT::Common::StorageLayout layout>
+void check_index_types(const size_t rows, const size_t cols)
+{
+  const auto matrix = create_test_matrix<layout>(rows, cols);
+  const auto matrix_32 = create_test_matrix<layout, uint32_t>(rows, cols);
+  static_assert(std::is_same<const uint32_t*, decltype(matrix_32.inner_index_ptr())>::value, "");
+  EXPECT_EQ(matrix.pattern(), matrix_32.pattern());
+  XT::LA::CommonDenseVector<double> xx(cols), yy(rows);
+  for (size_t ii = 0; ii < cols; ++ii)
+    xx[ii] = 1. / (1. + ii);
+  for (size_t ii = 0; ii < rows; ++ii)
+    yy[ii] = double(ii % 5);
+  XT::LA::CommonDenseVector<double> mv(rows), mv_32(rows), mtv(cols), mtv_32(cols);
+  matrix.mv(xx, mv);
+  matrix_32.mv(xx, mv_32);
+  matrix.mtv(yy, mtv);
+  matrix_32.mtv(yy, mtv_32);
+  for (size_t ii = 0; ii < rows; ++ii)
+    EXPECT_DOUBLE_EQ(mv[ii], mv_32[ii]);
+  for (size_t ii = 0; ii < cols; ++ii)
+    EXPECT_DOUBLE_EQ(mtv[ii], mtv_32[ii]);
+  const auto product = matrix * create_test_matrix<layout>(cols, rows);
+  const auto product_32 = matrix_32 * create_test_matrix<layout, uint32_t>(cols, rows);
+  EXPECT_EQ(product.pattern(), product_32.pattern());
+  for (size_t ii = 0; ii < rows; ++ii)
+    for (size_t jj = 0; jj < rows; ++jj)
+      EXPECT_DOUBLE_EQ(product.get_entry(ii, jj), product_32.get_entry(ii, jj));
+} // ... check_index_types(...)
+
+
+GTEST_TEST(CommonSparseMatrixTest, uint32_indices_give_the_same_results)
+{
+  check_index_types<XT::Common::StorageLayout::csr>(50, 30);
+  check_index_types<XT::Common::StorageLayout::csc>(50, 30);
+  // sparse vectors
+  XT::LA::CommonSparseVector<double, uint32_t> sparse_xx(10), sparse_yy(10);
+  sparse_xx.set_entry(7, 2.);
+  sparse_xx.set_entry(3, 1.);
+  sparse_yy.set_entry(3, 4.);
+  EXPECT_EQ(std::vector<uint32_t>({3, 7}), sparse_xx.indices());
+  EXPECT_DOUBLE_EQ(4., sparse_xx.dot(sparse_yy));
+  EXPECT_DOUBLE_EQ(2., sparse_xx.get_entry(7));
+  // cholesky factorization and triangular solves of the lower part of a symmetric positive definite matrix
+  const size_t size = 20;
+  using MatrixType = XT::LA::CommonSparseMatrixCsr<double, uint32_t>;
+  MatrixType factor(size, size, XT::LA::diagonal_pattern(size, size) + XT::LA::diagonal_pattern(size, size, -1));
+  for (size_t ii = 0; ii < size; ++ii) {
+    factor.set_entry(ii, ii, 4.);
+    if (ii > 0)
+      factor.set_entry(ii, ii - 1, -1.);
+  }
+  XT::LA::cholesky(factor);
+  XT::LA::CommonDenseVector<double> rhs(size, 1.), solution(size, 1.);
+  XT::LA::solve_cholesky_factorized(factor, solution);
+  for (size_t ii = 0; ii < size; ++ii) {
+    double residual = rhs[ii] - 4. * solution[ii];
+    if (ii > 0)
+      residual += solution[ii - 1];
+    if (ii + 1 < size)
+      residual += solution[ii + 1];
+    EXPECT_NEAR(0., residual, 1e-13);
+  }
+  // the same solves with the factor in compressed column storage
+  XT::LA::CommonSparseMatrixCsc<double, uint32_t> factor_csc(factor, true);
+  XT::LA::CommonDenseVector<double> tmp(size), solution_csc(size);
+  XT::LA::solve_lower_triangular(factor_csc, tmp, rhs);
+  XT::LA::solve_lower_triangular_transposed(factor_csc, solution_csc, tmp);
+  for (size_t ii = 0; ii < size; ++ii)
+    EXPECT_NEAR(solution[ii], solution_csc[ii], 1e-13);
+} // GTEST_TEST(CommonSparseMatrixTest, uint32_indices_give_the_same_results)
@@ -12,10 +12,13 @@
 #ifndef DUNE_XT_TEST_LA_CONTAINER_HH
 #define DUNE_XT_TEST_LA_CONTAINER_HH
 
+#include <cmath>
 #include <complex>
 #include <memory>
 #include <type_traits>
 
+#include <dune/xt/common/test/gtest/gtest.h>
+
 #include <dune/xt/common/exceptions.hh>
 #include <dune/xt/common/float_cmp.hh>
 #include <dune/xt/la/container/common.hh>
@@ -24,6 +27,7 @@
 #include <dune/xt/la/container/interfaces.hh>
 #include <dune/xt/la/container/istl.hh>
 #include <dune/xt/la/container.hh>
+#include <dune/xt/la/type_traits.hh>
 
 template <class ContainerImp>
 class ContainerFactory
@@ -191,6 +195,60 @@ public:
 };
 #endif // HAVE_EIGEN
 
+// tridiagonal (diagonal, off_diagonal) matrix
+template <class M>
+M create_tridiagonal_matrix(const size_t size, const double diagonal, const double off_diagonal)
+{
+  M matrix(size, size, Dune::XT::LA::tridiagonal_pattern(size, size));
+  for (size_t ii = 0; ii < size; ++ii) {
+    matrix.set_entry(ii, ii, diagonal);
+    if (ii > 0)
+      matrix.set_entry(ii, ii - 1, off_diagonal);
+    if (ii + 1 < size)
+      matrix.set_entry(ii, ii + 1, off_diagonal);
+  }
+  return matrix;
+}
+
+// tridiagonal (2, -1) matrix, i.e. symmetric and positive definite, and so is each of its diagonal blocks
+template <class M>
+M create_laplace_matrix(const size_t size)
+{
+  return create_tridiagonal_matrix<M>(size, 2., -1.);
+}
+
+// the entries are offset + sin(ii), i.e. all different
+template <class V>
+V create_vector(const size_t size, const double offset)
+{
+  V ret(size, 0.);
+  for (size_t ii = 0; ii < size; ++ii)
+    ret[ii] = offset + std::sin(double(ii));
+  return ret;
+}
+
+template <class V>
+typename std::enable_if<Dune::XT::LA::is_vector<V>::value>::type
+expect_equal(const V& expected, const V& actual, const double tolerance = 1e-13)
+{
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t ii = 0; ii < expected.size(); ++ii)
+    EXPECT_NEAR(std::abs(expected[ii] - actual[ii]), 0., tolerance) << "ii = " << ii;
+}
+
+// compares all entries, i.e. also those outside of the patterns, of the given matrices
+template <class M>
+typename std::enable_if<Dune::XT::LA::is_matrix<M>::value>::type
+expect_equal(const M& expected, const M& actual, const double tolerance = 1e-12)
+{
+  ASSERT_EQ(expected.rows(), actual.rows());
+  ASSERT_EQ(expected.cols(), actual.cols());
+  for (size_t ii = 0; ii < expected.rows(); ++ii)
+    for (size_t jj = 0; jj < expected.cols(); ++jj)
+      EXPECT_NEAR(std::abs(expected.get_entry(ii, jj) - actual.get_entry(ii, jj)), 0., tolerance)
+          << "ii = " << ii << ", jj = " << jj;
+}
+
 #define EXPECT_DOUBLE_OR_COMPLEX_EQ(expected, actual)                                                                  \
   {                                                                                                                    \
     auto expected_val = expected; /* avoids errors if macro is called e.g. with expected++ */                          \
@@ -0,0 +1,164 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/common/test/main.hxx> // <- This one has to come first, includes config.h!
+#include <dune/xt/common/test/gtest/gtest.h>
+
+#include <array>
+#include <complex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <dune/xt/la/container.hh>
+#include <dune/xt/la/test/container.hh>
+
+using namespace Dune;
+
+
+// the cells of a grid_size x grid_size grid of vertices, each cell writes to the rows of its four vertices
+struct Grid
+{
+  std::array<size_t, 4> vertices(const size_t cell) const
+  {
+    const size_t xx = cell % (grid_size - 1);
+    const size_t yy = cell / (grid_size - 1);
+    const size_t ll = yy * grid_size + xx;
+    return {{ll, ll + 1, ll + grid_size, ll + grid_size + 1}};
+  }
+
+  size_t num_cells() const
+  {
+    return (grid_size - 1) * (grid_size - 1);
+  }
+
+  size_t num_vertices() const
+  {
+    return grid_size * grid_size;
+  }
+
+  XT::LA::SparsityPatternDefault pattern() const
+  {
+    XT::LA::SparsityPatternDefault ret(num_vertices());
+    for (size_t cell = 0; cell < num_cells(); ++cell)
+      for (const auto& ii : vertices(cell))
+        for (const auto& jj : vertices(cell))
+          ret.insert(ii, jj);
+    ret.sort();
+    return ret;
+  }
+
+  // adds a (nonsymmetric) element matrix, the entries depend on the cell to detect lost updates
+  template <class M, class AddType>
+  void assemble(const size_t cell, M& matrix, const AddType& add) const
+  {
+    const auto vs = vertices(cell);
+    for (size_t ii = 0; ii < 4; ++ii)
+      for (size_t jj = 0; jj < 4; ++jj)
+        add(matrix, vs[ii], vs[jj], typename M::ScalarType(1. + ii + 0.25 * jj + 1e-3 * double(cell % 7)));
+  }
+
+  size_t grid_size;
+}; // struct Grid
+
+
+GTEST_TEST(RowColoringTest, colors_are_conflict_free)
+{
+  const Grid grid{17};
+  const XT::LA::RowColoring coloring(
+      grid.num_vertices(), grid.num_cells(), [&](const size_t cell) { return grid.vertices(cell); });
+  EXPECT_EQ(grid.num_cells(), coloring.num_tasks());
+  // the greedy coloring finds the optimal coloring for this numbering
+  EXPECT_EQ(4u, coloring.num_colors());
+  std::vector<size_t> number_of_colors_of_cell(grid.num_cells(), 0);
+  for (size_t color = 0; color < coloring.num_colors(); ++color) {
+    std::set<size_t> rows;
+    for (const auto& cell : coloring.tasks(color)) {
+      ++number_of_colors_of_cell[cell];
+      for (const auto& row : grid.vertices(cell))
+        EXPECT_TRUE(rows.insert(row).second) << "row " << row << " is written to twice in color " << color;
+    }
+  }
+  for (const auto& number_of_colors : number_of_colors_of_cell)
+    EXPECT_EQ(1u, number_of_colors);
+  EXPECT_THROW(coloring.tasks(4), XT::Common::Exceptions::index_out_of_range);
+  EXPECT_THROW(XT::LA::RowColoring(3, 1, [](const size_t) { return std::vector<size_t>{3}; }),
+               XT::Common::Exceptions::index_out_of_range);
+}
+
+
+template <class M>
+M assemble_serial(const Grid& grid)
+{
+  M matrix(grid.num_vertices(), grid.num_vertices(), grid.pattern());
+  for (size_t cell = 0; cell < grid.num_cells(); ++cell)
+    grid.assemble(cell, matrix, [](M& mat, const size_t ii, const size_t jj, const typename M::ScalarType& value) {
+      mat.add_to_entry(ii, jj, value);
+    });
+  return matrix;
+}
+
+
+template <class M>
+void check_atomic_add_to_entry(const size_t num_threads = 4)
+{
+  const Grid grid{33};
+  const auto expected = assemble_serial<M>(grid);
+  M matrix(grid.num_vertices(), grid.num_vertices(), grid.pattern(), 0);
+  // the cells are distributed round robin to maximize the conflicts
+  std::vector<std::thread> threads;
+  for (size_t tt = 0; tt < num_threads; ++tt)
+    threads.emplace_back([&, tt]() {
+      for (size_t cell = tt; cell < grid.num_cells(); cell += num_threads)
+        grid.assemble(cell, matrix, [](M& mat, const size_t ii, const size_t jj, const typename M::ScalarType& value) {
+          mat.atomic_add_to_entry(ii, jj, value);
+        });
+    });
+  for (auto& thread : threads)
+    thread.join();
+  expect_equal(expected, matrix);
+} // ... check_atomic_add_to_entry(...)
+
+
+template <class M>
+void check_colored_assembly()
+{
+  const Grid grid{33};
+  const auto expected = assemble_serial<M>(grid);
+  M matrix(grid.num_vertices(), grid.num_vertices(), grid.pattern(), 0);
+  const XT::LA::RowColoring coloring(
+      grid.num_vertices(), grid.num_cells(), [&](const size_t cell) { return grid.vertices(cell); });
+  XT::LA::for_each_colored_task(coloring, [&](const size_t cell) {
+    grid.assemble(cell, matrix, [](M& mat, const size_t ii, const size_t jj, const typename M::ScalarType& value) {
+      mat.add_to_entry(ii, jj, value);
+    });
+  });
+  expect_equal(expected, matrix);
+} // ... check_colored_assembly(...)
+
+
+GTEST_TEST(ConcurrentAssemblyTest, common_sparse)
+{
+  check_atomic_add_to_entry<XT::LA::CommonSparseMatrix<double>>();
+  check_colored_assembly<XT::LA::CommonSparseMatrix<double>>();
+}
+
+GTEST_TEST(ConcurrentAssemblyTest, common_sparse_complex)
+{
+  check_atomic_add_to_entry<XT::LA::CommonSparseMatrix<std::complex<double>>>();
+  check_colored_assembly<XT::LA::CommonSparseMatrix<std::complex<double>>>();
+}
+
+#if HAVE_DUNE_ISTL
+
+GTEST_TEST(ConcurrentAssemblyTest, istl_sparse)
+{
+  check_atomic_add_to_entry<XT::LA::IstlRowMajorSparseMatrix<double>>();
+  check_colored_assembly<XT::LA::IstlRowMajorSparseMatrix<double>>();
+}
+
+#endif // HAVE_DUNE_ISTL
@@ -0,0 +1,217 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/common/test/main.hxx> // <- This one has to come first, includes config.h!
+#include <dune/xt/common/test/gtest/gtest.h>
+
+#include <dune/xt/la/container.hh>
+
+using namespace Dune;
+
+
+// a rows x cols matrix with entries at (ii, jj) for (ii + jj) % 3 == 0, the entries depend on offset and the indices
+template <class M>
+M create_matrix(const size_t rows, const size_t cols, const double offset)
+{
+  XT::LA::SparsityPatternDefault pattern(rows);
+  for (size_t ii = 0; ii < rows; ++ii)
+    for (size_t jj = 0; jj < cols; ++jj)
+      if ((ii + jj) % 3 == 0)
+        pattern.insert(ii, jj);
+  pattern.sort();
+  M matrix(rows, cols, pattern);
+  for (size_t ii = 0; ii < rows; ++ii)
+    for (const auto& jj : pattern.inner(ii))
+      matrix.set_entry(ii, jj, offset + double(ii) + 0.1 * double(jj));
+  return matrix;
+}
+
+
+template <class M>
+size_t count_non_zeros(const M& matrix)
+{
+  const auto pattern = matrix.pattern();
+  size_t ret = 0;
+  for (size_t ii = 0; ii < pattern.size(); ++ii)
+    ret += pattern.inner(ii).size();
+  return ret;
+}
+
+
+// the saddle point matrix (A B; B^T C) has to be the same as assembled entry by entry
+template <class M>
+void check_saddle_point_matrix(const M& A, const M& B, const M& C, const M& actual)
+{
+  const size_t m = A.rows();
+  const size_t n = C.rows();
+  ASSERT_EQ(m + n, actual.rows());
+  ASSERT_EQ(m + n, actual.cols());
+  const auto pattern = actual.pattern();
+  size_t non_zeros = 0;
+  for (size_t ii = 0; ii < m + n; ++ii) {
+    non_zeros += pattern.inner(ii).size();
+    for (size_t jj = 0; jj < m + n; ++jj) {
+      double expected = 0.;
+      if (ii < m && jj < m)
+        expected = A.get_entry(ii, jj);
+      else if (ii < m)
+        expected = B.get_entry(ii, jj - m);
+      else if (jj < m)
+        expected = B.get_entry(jj, ii - m);
+      else
+        expected = C.get_entry(ii - m, jj - m);
+      EXPECT_DOUBLE_EQ(expected, actual.get_entry(ii, jj)) << "ii = " << ii << ", jj = " << jj;
+    }
+  }
+  EXPECT_EQ(count_non_zeros(A) + 2 * count_non_zeros(B) + count_non_zeros(C), non_zeros);
+} // ... check_saddle_point_matrix(...)
+
+
+template <class M>
+void check_block_matrix_assembler(const size_t m = 7, const size_t n = 4)
+{
+  auto A = create_matrix<M>(m, m, 1.);
+  auto B = create_matrix<M>(m, n, 2.);
+  auto C = create_matrix<M>(n, n, 3.);
+  XT::LA::BlockMatrixAssembler<M> assembler(m + n, m + n);
+  EXPECT_THROW(assembler.add_block(m, 0, B), XT::Common::Exceptions::shapes_do_not_match);
+  assembler.add_block(0, 0, A);
+  assembler.add_block(0, m, B);
+  assembler.add_block(m, 0, B, /*transposed=*/true);
+  assembler.add_block(m, m, C);
+  EXPECT_FALSE(assembler.assembled());
+  EXPECT_THROW(assembler.update(), XT::Common::Exceptions::you_are_using_this_wrong);
+  EXPECT_THROW(assembler.matrix(), XT::Common::Exceptions::you_are_using_this_wrong);
+  assembler.assemble();
+  EXPECT_TRUE(assembler.assembled());
+  check_saddle_point_matrix(A, B, C, assembler.matrix());
+  // the entries are only copied by update()
+  A.scal(2.);
+  B.scal(-1.);
+  C.set_entry(0, 0, 42.);
+  EXPECT_DOUBLE_EQ(1., assembler.matrix().get_entry(0, 0));
+  assembler.update();
+  check_saddle_point_matrix(A, B, C, assembler.matrix());
+} // ... check_block_matrix_assembler(...)
+
+
+// overlapping blocks are added up
+template <class M>
+void check_overlapping_blocks(const size_t size = 5)
+{
+  const auto A = create_matrix<M>(size, size, 1.);
+  XT::LA::BlockMatrixAssembler<M> assembler(size, size);
+  assembler.add_block(0, 0, A);
+  assembler.add_block(0, 0, A, /*transposed=*/true);
+  assembler.assemble();
+  for (size_t ii = 0; ii < size; ++ii)
+    for (size_t jj = 0; jj < size; ++jj)
+      EXPECT_DOUBLE_EQ(A.get_entry(ii, jj) + A.get_entry(jj, ii), assembler.matrix().get_entry(ii, jj));
+} // ... check_overlapping_blocks(...)
+
+
+// a changed pattern of a block has to be detected by update(), even if the number of entries stays the same
+template <class M>
+void check_changed_pattern(const size_t size = 5)
+{
+  XT::LA::SparsityPatternDefault diagonal_pattern(size), shifted_pattern(size);
+  for (size_t ii = 0; ii < size; ++ii) {
+    diagonal_pattern.insert(ii, ii);
+    shifted_pattern.insert(ii, (ii + 1) % size);
+  }
+  M block(size, size, diagonal_pattern);
+  for (size_t ii = 0; ii < size; ++ii)
+    block.set_entry(ii, ii, 1.);
+  XT::LA::BlockMatrixAssembler<M> assembler(size, size);
+  assembler.add_block(0, 0, block);
+  assembler.assemble();
+  M shifted_block(size, size, shifted_pattern);
+  for (size_t ii = 0; ii < size; ++ii)
+    shifted_block.set_entry(ii, (ii + 1) % size, 2.);
+  block = shifted_block;
+  EXPECT_THROW(assembler.update(), XT::Common::Exceptions::you_are_using_this_wrong);
+  // the matrix is left unchanged
+  for (size_t ii = 0; ii < size; ++ii)
+    EXPECT_DOUBLE_EQ(1., assembler.matrix().get_entry(ii, ii)) << "ii = " << ii;
+  assembler.assemble();
+  for (size_t ii = 0; ii < size; ++ii) {
+    EXPECT_DOUBLE_EQ(0., assembler.matrix().get_entry(ii, ii)) << "ii = " << ii;
+    EXPECT_DOUBLE_EQ(2., assembler.matrix().get_entry(ii, (ii + 1) % size)) << "ii = " << ii;
+  }
+  assembler.update();
+} // ... check_changed_pattern(...)
+
+
+// an empty row of the assembled matrix (eigen stores an additional entry in each empty row, which is not part of the
+// pattern)
+template <class M>
+void check_empty_row(const size_t size = 5, const size_t empty_row = 2)
+{
+  XT::LA::SparsityPatternDefault pattern(size);
+  for (size_t ii = 0; ii < size; ++ii)
+    if (ii != empty_row)
+      pattern.insert(ii, ii);
+  M block(size, size, pattern);
+  for (size_t ii = 0; ii < size; ++ii)
+    if (ii != empty_row)
+      block.set_entry(ii, ii, 1. + ii);
+  // leaves out the first column, which contains the additional entry of eigen for the empty row of the block
+  XT::LA::BlockMatrixAssembler<M> assembler(size - 1, size - 1);
+  assembler.add_sub_block(0, 0, block, 1, size, 1, size);
+  const auto check_entries = [&]() {
+    for (size_t ii = 0; ii + 1 < size; ++ii)
+      for (size_t jj = 0; jj + 1 < size; ++jj)
+        EXPECT_DOUBLE_EQ(block.get_entry(ii + 1, jj + 1), assembler.matrix().get_entry(ii, jj))
+            << "ii = " << ii << ", jj = " << jj;
+  };
+  assembler.assemble();
+  check_entries();
+  block.scal(2.);
+  assembler.update();
+  check_entries();
+} // ... check_empty_row(...)
+
+
+GTEST_TEST(BlockMatrixAssemblerTest, common_sparse)
+{
+  check_block_matrix_assembler<XT::LA::CommonSparseMatrix<double>>();
+  check_overlapping_blocks<XT::LA::CommonSparseMatrix<double>>();
+  check_changed_pattern<XT::LA::CommonSparseMatrix<double>>();
+  check_empty_row<XT::LA::CommonSparseMatrix<double>>();
+}
+
+GTEST_TEST(BlockMatrixAssemblerTest, common_sparse_csc)
+{
+  using M = XT::LA::CommonSparseMatrixCsc<double>;
+  check_block_matrix_assembler<M>();
+  check_overlapping_blocks<M>();
+  check_changed_pattern<M>();
+  check_empty_row<M>();
+}
+
+#if HAVE_EIGEN
+
+GTEST_TEST(BlockMatrixAssemblerTest, eigen_sparse)
+{
+  check_block_matrix_assembler<XT::LA::EigenRowMajorSparseMatrix<double>>();
+  check_overlapping_blocks<XT::LA::EigenRowMajorSparseMatrix<double>>();
+  check_changed_pattern<XT::LA::EigenRowMajorSparseMatrix<double>>();
+  check_empty_row<XT::LA::EigenRowMajorSparseMatrix<double>>();
+}
+
+#endif // HAVE_EIGEN
+#if HAVE_DUNE_ISTL
+
+GTEST_TEST(BlockMatrixAssemblerTest, istl_sparse)
+{
+  check_block_matrix_assembler<XT::LA::IstlRowMajorSparseMatrix<double>>();
+  check_overlapping_blocks<XT::LA::IstlRowMajorSparseMatrix<double>>();
+  check_changed_pattern<XT::LA::IstlRowMajorSparseMatrix<double>>();
+  check_empty_row<XT::LA::IstlRowMajorSparseMatrix<double>>();
+}
+
+#endif // HAVE_DUNE_ISTL
@@ -0,0 +1,338 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/common/test/main.hxx> // <- This one has to come first, includes config.h!
+#include <dune/xt/common/test/gtest/gtest.h>
+
+#include <cstdint>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <dune/xt/la/container.hh>
+#include <dune/xt/la/container/io.hh>
+
+using namespace Dune;
+
+
+// row 2 is empty, all other rows have ii % 3 + 1 entries
+template <class MatrixType>
+MatrixType create_io_test_matrix(const size_t rows, const size_t cols)
+{
+  XT::LA::SparsityPatternDefault pattern(rows);
+  for (size_t ii = 0; ii < rows; ++ii)
+    if (ii != 2)
+      for (size_t kk = 0; kk < ii % 3 + 1; ++kk)
+        pattern.insert(ii, (2 * ii + 5 * kk) % cols);
+  pattern.sort();
+  MatrixType matrix(rows, cols, pattern);
+  for (size_t ii = 0; ii < rows; ++ii)
+    for (const auto& jj : pattern.inner(ii))
+      matrix.set_entry(ii, jj, 0.5 + double(ii) - 1. / (1. + jj));
+  return matrix;
+}
+
+
+template <class MatrixType, class OtherMatrixType>
+void check_equal_matrices(const MatrixType& expected, const OtherMatrixType& actual)
+{
+  ASSERT_EQ(expected.rows(), actual.rows());
+  ASSERT_EQ(expected.cols(), actual.cols());
+  EXPECT_EQ(expected.pattern(), actual.pattern());
+  for (size_t ii = 0; ii < expected.rows(); ++ii)
+    for (size_t jj = 0; jj < expected.cols(); ++jj)
+      EXPECT_EQ(expected.get_entry(ii, jj), actual.get_entry(ii, jj));
+}
+
+
+template <class MatrixType, class OtherMatrixType = MatrixType>
+void check_binary_round_trip(const std::string& filename)
+{
+  const auto matrix = create_io_test_matrix<MatrixType>(11, 7);
+  XT::LA::to_file(matrix, filename, "binary");
+  check_equal_matrices(matrix, XT::LA::from_file<OtherMatrixType>(filename, -1, -1, "binary"));
+  std::remove(filename.c_str());
+}
+
+
+GTEST_TEST(ContainerIoTest, binary_matrices_round_trip)
+{
+  // compressed row storage is written and adopted directly, with any combination of index types
+  check_binary_round_trip<XT::LA::CommonSparseMatrixCsr<double>>("container_io_csr.bin");
+  check_binary_round_trip<XT::LA::CommonSparseMatrixCsr<double, uint32_t>>("container_io_csr_32.bin");
+  check_binary_round_trip<XT::LA::CommonSparseMatrixCsr<double, uint32_t>, XT::LA::CommonSparseMatrixCsr<double>>(
+      "container_io_csr_32_to_64.bin");
+  check_binary_round_trip<XT::LA::CommonSparseMatrixCsr<double>, XT::LA::CommonSparseMatrixCsr<double, uint32_t>>(
+      "container_io_csr_64_to_32.bin");
+  // all other matrices are written and read entry by entry
+  check_binary_round_trip<XT::LA::CommonSparseMatrixCsc<double>>("container_io_csc.bin");
+  check_binary_round_trip<XT::LA::CommonSparseMatrixCsc<double>, XT::LA::CommonSparseMatrixCsr<double>>(
+      "container_io_csc_to_csr.bin");
+#if HAVE_DUNE_ISTL
+  check_binary_round_trip<XT::LA::CommonSparseMatrixCsr<double>, XT::LA::IstlRowMajorSparseMatrix<double>>(
+      "container_io_csr_to_istl.bin");
+#endif
+#if HAVE_EIGEN
+  check_binary_round_trip<XT::LA::CommonSparseMatrixCsr<double>, XT::LA::EigenRowMajorSparseMatrix<double>>(
+      "container_io_csr_to_eigen.bin");
+#endif
+} // GTEST_TEST(ContainerIoTest, binary_matrices_round_trip)
+
+
+GTEST_TEST(ContainerIoTest, binary_matrices_are_extended_to_the_minimal_size)
+{
+  const std::string filename = "container_io_extended.bin";
+  const auto matrix = create_io_test_matrix<XT::LA::CommonSparseMatrixCsr<double>>(5, 4);
+  XT::LA::to_file(matrix, filename, "binary");
+  const auto extended = XT::LA::from_file<XT::LA::CommonSparseMatrixCsr<double>>(filename, 8, 6, "binary");
+  std::remove(filename.c_str());
+  ASSERT_EQ(size_t(8), extended.rows());
+  ASSERT_EQ(size_t(6), extended.cols());
+  EXPECT_EQ(matrix.non_zeros(), extended.non_zeros());
+  for (size_t ii = 0; ii < 5; ++ii)
+    for (size_t jj = 0; jj < 4; ++jj)
+      EXPECT_EQ(matrix.get_entry(ii, jj), extended.get_entry(ii, jj));
+}
+
+
+GTEST_TEST(ContainerIoTest, binary_vectors_round_trip)
+{
+  const std::string filename = "container_io_vector.bin";
+  XT::LA::CommonDenseVector<double> vector(13);
+  for (size_t ii = 0; ii < vector.size(); ++ii)
+    vector[ii] = 1. / (3. + ii);
+  XT::LA::to_file(vector, filename, "binary");
+  const auto read = XT::LA::from_file<XT::LA::CommonDenseVector<double>>(filename, 15, "binary");
+  std::remove(filename.c_str());
+  ASSERT_EQ(size_t(15), read.size());
+  for (size_t ii = 0; ii < vector.size(); ++ii)
+    EXPECT_EQ(vector[ii], read[ii]);
+  EXPECT_EQ(0., read[13]);
+  EXPECT_EQ(0., read[14]);
+}
+
+
+GTEST_TEST(ContainerIoTest, binary_reading_rejects_wrong_files)
+{
+  using MatrixType = XT::LA::CommonSparseMatrixCsr<double>;
+  const std::string filename = "container_io_wrong.bin";
+  {
+    std::ofstream file(filename);
+    file << "0 0 1.0\n";
+  }
+  EXPECT_THROW(XT::LA::from_file<MatrixType>(filename, -1, -1, "binary"), Dune::IOError);
+  // a vector is not a matrix
+  XT::LA::to_file(XT::LA::CommonDenseVector<double>(3, 1.), filename, "binary");
+  EXPECT_THROW(XT::LA::from_file<MatrixType>(filename, -1, -1, "binary"), Dune::IOError);
+  // truncated matrix
+  XT::LA::to_file(create_io_test_matrix<MatrixType>(5, 5), filename, "binary");
+  std::string contents;
+  {
+    std::ifstream file(filename, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream file(filename, std::ios::binary);
+    file.write(contents.data(), contents.size() - 1);
+  }
+  EXPECT_THROW(XT::LA::from_file<MatrixType>(filename, -1, -1, "binary"), Dune::IOError);
+  std::remove(filename.c_str());
+  EXPECT_THROW(XT::LA::from_file<MatrixType>(filename, -1, -1, "binary"), Dune::IOError);
+} // GTEST_TEST(ContainerIoTest, binary_reading_rejects_wrong_files)
+
+
+// writes a matrix in the binary format without checking the given arrays
+void write_unchecked_binary_matrix(const std::string& filename,
+                                   const size_t rows,
+                                   const size_t cols,
+                                   const std::vector<size_t>& row_pointers,
+                                   const std::vector<size_t>& column_indices)
+{
+  const std::vector<double> values(column_indices.size(), 1.);
+  XT::LA::internal::write_binary_matrix(
+      filename, rows, cols, row_pointers.data(), column_indices.data(), values.data());
+}
+
+
+// overwrites the 64-bit number at the given offset of the file
+void patch_binary_file(const std::string& filename, const size_t offset, const uint64_t value)
+{
+  std::string contents;
+  {
+    std::ifstream file(filename, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  std::memcpy(&contents[offset], &value, sizeof(value));
+  std::ofstream file(filename, std::ios::binary);
+  file.write(contents.data(), contents.size());
+}
+
+
+template <class MatrixType>
+void check_malformed_binary_matrices(const std::string& filename)
+{
+  write_unchecked_binary_matrix(filename, 2, 3, {0, 1, 2}, {2, 0});
+  EXPECT_NO_THROW(XT::LA::from_file<MatrixType>(filename, -1, -1, "binary"));
+  // decreasing row pointers
+  write_unchecked_binary_matrix(filename, 3, 3, {0, 2, 1, 3}, {0, 1, 2});
+  EXPECT_THROW(XT::LA::from_file<MatrixType>(filename, -1, -1, "binary"), Dune::IOError);
+  write_unchecked_binary_matrix(filename, 2, 3, {0, 3, 2}, {0, 1});
+  EXPECT_THROW(XT::LA::from_file<MatrixType>(filename, -1, -1, "binary"), Dune::IOError);
+  // column out of range
+  write_unchecked_binary_matrix(filename, 2, 3, {0, 1, 2}, {0, 3});
+  EXPECT_THROW(XT::LA::from_file<MatrixType>(filename, -1, -1, "binary"), Dune::IOError);
+  // unsorted and duplicate columns
+  write_unchecked_binary_matrix(filename, 2, 3, {0, 2, 2}, {2, 1});
+  EXPECT_THROW(XT::LA::from_file<MatrixType>(filename, -1, -1, "binary"), Dune::IOError);
+  write_unchecked_binary_matrix(filename, 2, 3, {0, 2, 2}, {1, 1});
+  EXPECT_THROW(XT::LA::from_file<MatrixType>(filename, -1, -1, "binary"), Dune::IOError);
+  // entries without columns
+  write_unchecked_binary_matrix(filename, 1, 0, {0, 1}, {0});
+  EXPECT_THROW(XT::LA::from_file<MatrixType>(filename, -1, -1, "binary"), Dune::IOError);
+  // sizes in the header which would overflow the offsets (rows at byte 24, non_zeros at byte 40)
+  write_unchecked_binary_matrix(filename, 2, 3, {0, 1, 2}, {2, 0});
+  patch_binary_file(filename, 40, uint64_t(1) << 62);
+  EXPECT_THROW(XT::LA::from_file<MatrixType>(filename, -1, -1, "binary"), Dune::IOError);
+  write_unchecked_binary_matrix(filename, 2, 3, {0, 1, 2}, {2, 0});
+  patch_binary_file(filename, 24, std::numeric_limits<uint64_t>::max());
+  EXPECT_THROW(XT::LA::from_file<MatrixType>(filename, -1, -1, "binary"), Dune::IOError);
+  std::remove(filename.c_str());
+} // ... check_malformed_binary_matrices(...)
+
+
+GTEST_TEST(ContainerIoTest, binary_reading_rejects_malformed_files)
+{
+  check_malformed_binary_matrices<XT::LA::CommonSparseMatrixCsr<double>>("container_io_malformed_csr.bin");
+  check_malformed_binary_matrices<XT::LA::CommonSparseMatrixCsr<double, uint32_t>>(
+      "container_io_malformed_csr_32.bin");
+  check_malformed_binary_matrices<XT::LA::CommonDenseMatrix<double>>("container_io_malformed_dense.bin");
+  // a vector whose size does not match the number of values
+  const std::string filename = "container_io_malformed_vector.bin";
+  XT::LA::to_file(XT::LA::CommonDenseVector<double>(3, 1.), filename, "binary");
+  patch_binary_file(filename, 24, 1000);
+  EXPECT_THROW(XT::LA::from_file<XT::LA::CommonDenseVector<double>>(filename, -1, "binary"), Dune::IOError);
+  std::remove(filename.c_str());
+} // GTEST_TEST(ContainerIoTest, binary_reading_rejects_malformed_files)
+
+
+GTEST_TEST(ContainerIoTest, matrix_market_matrices_round_trip)
+{
+  using MatrixType = XT::LA::CommonSparseMatrixCsr<double>;
+  const std::string filename = "container_io.mtx";
+  const auto matrix = create_io_test_matrix<MatrixType>(11, 7);
+  XT::LA::to_file(matrix, filename, "matrix-market");
+  check_equal_matrices(matrix, XT::LA::from_file<MatrixType>(filename, -1, -1, "matrix-market"));
+  check_equal_matrices(matrix,
+                       XT::LA::from_file<XT::LA::CommonSparseMatrixCsc<double>>(filename, -1, -1, "matrix-market"));
+  check_equal_matrices(
+      matrix, XT::LA::from_file<XT::LA::CommonSparseMatrixCsr<double, uint32_t>>(filename, -1, -1, "matrix-market"));
+  // symmetric matrices are written as such
+  const auto symmetric = matrix.transposed() * matrix;
+  XT::LA::to_file(symmetric, filename, "matrix-market");
+  {
+    std::ifstream file(filename);
+    std::string banner;
+    std::getline(file, banner);
+    EXPECT_EQ("%%MatrixMarket matrix coordinate real symmetric", banner);
+  }
+  check_equal_matrices(symmetric, XT::LA::from_file<MatrixType>(filename, -1, -1, "matrix-market"));
+  // the array format
+  XT::LA::CommonDenseMatrix<double> dense(4, 3);
+  for (size_t ii = 0; ii < 4; ++ii)
+    for (size_t jj = 0; jj < 3; ++jj)
+      dense.set_entry(ii, jj, 1. / (1. + ii + 7 * jj));
+  XT::LA::to_file(dense, filename, "matrix-market-array");
+  check_equal_matrices(dense, XT::LA::from_file<XT::LA::CommonDenseMatrix<double>>(filename, -1, -1, "matrix-market"));
+  // complex values
+  XT::LA::CommonDenseMatrix<std::complex<double>> complex_matrix(2, 2);
+  complex_matrix.set_entry(0, 1, std::complex<double>(1., -2.));
+  complex_matrix.set_entry(1, 1, std::complex<double>(0.5, 3.));
+  XT::LA::to_file(complex_matrix, filename, "matrix-market");
+  using ComplexMatrixType = XT::LA::CommonDenseMatrix<std::complex<double>>;
+  check_equal_matrices(complex_matrix, XT::LA::from_file<ComplexMatrixType>(filename, -1, -1, "matrix-market"));
+  EXPECT_THROW(XT::LA::from_file<MatrixType>(filename, -1, -1, "matrix-market"), Dune::IOError);
+  std::remove(filename.c_str());
+} // GTEST_TEST(ContainerIoTest, matrix_market_matrices_round_trip)
+
+
+GTEST_TEST(ContainerIoTest, matrix_market_reads_all_symmetries)
+{
+  const std::string filename = "container_io_symmetries.mtx";
+  const auto read = [&](const std::string& contents) {
+    {
+      std::ofstream file(filename);
+      file << contents;
+    }
+    auto ret = XT::LA::from_file<XT::LA::CommonDenseMatrix<double>>(filename, -1, -1, "matrix-market");
+    std::remove(filename.c_str());
+    return ret;
+  };
+  // comments, empty lines, duplicates (which are summed up) and a missing line break at the end
+  auto matrix = read("%%MatrixMarket matrix coordinate real general\n% comment\n\n2 3 3\n1 3 1.5\n2 1 -2\n1 3 1");
+  EXPECT_EQ(2.5, matrix.get_entry(0, 2));
+  EXPECT_EQ(-2., matrix.get_entry(1, 0));
+  EXPECT_EQ(0., matrix.get_entry(1, 1));
+  matrix = read("%%MatrixMarket matrix coordinate integer symmetric\n2 2 2\n1 1 3\n2 1 4\n");
+  EXPECT_EQ(4., matrix.get_entry(0, 1));
+  EXPECT_EQ(4., matrix.get_entry(1, 0));
+  matrix = read("%%MatrixMarket matrix coordinate pattern skew-symmetric\n2 2 1\n2 1\n");
+  EXPECT_EQ(1., matrix.get_entry(1, 0));
+  EXPECT_EQ(-1., matrix.get_entry(0, 1));
+  matrix = read("%%MatrixMarket matrix array real symmetric\n2 2\n1\n2\n3\n");
+  EXPECT_EQ(1., matrix.get_entry(0, 0));
+  EXPECT_EQ(2., matrix.get_entry(0, 1));
+  EXPECT_EQ(2., matrix.get_entry(1, 0));
+  EXPECT_EQ(3., matrix.get_entry(1, 1));
+  EXPECT_THROW(read("%%MatrixMarket matrix coordinate real general\n2 2 2\n1 1 1\n"), Dune::IOError);
+  EXPECT_THROW(read("%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 1\n"), Dune::IOError);
+  EXPECT_THROW(read("%%MatrixMarket matrix coordinate real general\n2 2 1\n1 1 one\n"), Dune::IOError);
+  EXPECT_THROW(read("0 0 1.0\n"), Dune::IOError);
+} // GTEST_TEST(ContainerIoTest, matrix_market_reads_all_symmetries)
+
+
+GTEST_TEST(ContainerIoTest, matrix_market_parsing_in_chunks_gives_the_same_result)
+{
+  const std::string filename = "container_io_chunks.mtx";
+  {
+    std::ofstream file(filename);
+    file << "%%MatrixMarket matrix coordinate real general\n50 40 2000\n";
+    for (size_t kk = 0; kk < 2000; ++kk)
+      file << (7 * kk) % 50 + 1 << " " << (13 * kk) % 40 + 1 << " " << kk << "\n";
+  }
+  const XT::LA::internal::MatrixMarketReader<double> reader(filename);
+  std::vector<size_t> row_pointers, column_indices, chunked_row_pointers, chunked_column_indices;
+  std::vector<double> values, chunked_values;
+  XT::LA::internal::entries_to_compressed_rows(50, reader.entries(1), 1, row_pointers, column_indices, values);
+  XT::LA::internal::entries_to_compressed_rows(
+      50, reader.entries(7), 7, chunked_row_pointers, chunked_column_indices, chunked_values);
+  std::remove(filename.c_str());
+  EXPECT_EQ(row_pointers, chunked_row_pointers);
+  EXPECT_EQ(column_indices, chunked_column_indices);
+  EXPECT_EQ(values, chunked_values);
+  EXPECT_EQ(size_t(200), values.size());
+}
+
+
+GTEST_TEST(ContainerIoTest, matrix_market_vectors_round_trip)
+{
+  const std::string filename = "container_io_vector.mtx";
+  XT::LA::CommonDenseVector<double> vector(9);
+  for (size_t ii = 0; ii < vector.size(); ++ii)
+    vector[ii] = std::sqrt(1. + ii);
+  XT::LA::to_file(vector, filename, "matrix-market");
+  const auto read = XT::LA::from_file<XT::LA::CommonDenseVector<double>>(filename, -1, "matrix-market");
+  std::remove(filename.c_str());
+  ASSERT_EQ(vector.size(), read.size());
+  for (size_t ii = 0; ii < vector.size(); ++ii)
+    EXPECT_EQ(vector[ii], read[ii]);
+}
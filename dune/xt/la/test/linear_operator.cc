@@ -0,0 +1,181 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/common/test/main.hxx> // <- This one has to come first, includes config.h!
+#include <dune/xt/common/test/gtest/gtest.h>
+
+#include <dune/xt/la/container.hh>
+#include <dune/xt/la/solver.hh>
+#include <dune/xt/la/test/container.hh>
+
+using namespace Dune;
+
+
+// a rows x cols matrix of full column rank (requires rows >= 2 * cols)
+template <class M>
+M create_constraint_matrix(const size_t rows, const size_t cols)
+{
+  XT::LA::SparsityPatternDefault pattern(rows);
+  for (size_t jj = 0; jj < cols; ++jj) {
+    pattern.insert(2 * jj, jj);
+    pattern.insert(2 * jj + 1, jj);
+  }
+  pattern.sort();
+  M matrix(rows, cols, pattern);
+  for (size_t jj = 0; jj < cols; ++jj) {
+    matrix.set_entry(2 * jj, jj, 1.);
+    matrix.set_entry(2 * jj + 1, jj, -0.5);
+  }
+  return matrix;
+}
+
+
+template <class M, class V>
+void check_operators(const size_t m = 10, const size_t n = 3)
+{
+  const auto A = create_tridiagonal_matrix<M>(m, 2., -1.);
+  const auto mass = create_tridiagonal_matrix<M>(m, 4. / 6., 1. / 6.);
+  const auto B = create_constraint_matrix<M>(m, n);
+  const auto C = create_tridiagonal_matrix<M>(n, 1., 0.5);
+  const auto u = create_vector<V>(m, 1.);
+  const auto p = create_vector<V>(n, -1.);
+  V tmp_m(m, 0.), tmp_n(n, 0.);
+
+  // M + dt A
+  const double dt = 0.1;
+  XT::LA::LinearCombinationOperator<V> combination(m, m);
+  combination.add(mass);
+  const size_t dt_index = combination.add(A, dt);
+  EXPECT_EQ(2u, combination.num_summands());
+  V expected = mass * u;
+  A.mv(u, tmp_m);
+  expected.axpy(dt, tmp_m);
+  V actual(m, 0.);
+  combination.mv(u, actual);
+  expect_equal(expected, actual);
+  combination.mtv(u, actual);
+  expect_equal(expected, actual);
+  combination.set_coefficient(dt_index, 2 * dt);
+  expected.axpy(dt, tmp_m);
+  combination.mv(u, actual);
+  expect_equal(expected, actual);
+  EXPECT_THROW(combination.add(B), XT::Common::Exceptions::shapes_do_not_match);
+  EXPECT_THROW(combination.set_coefficient(2, 1.), XT::Common::Exceptions::index_out_of_range);
+
+  // B^T
+  const XT::LA::TransposedOperator<V> B_transposed(B);
+  EXPECT_EQ(n, B_transposed.rows());
+  EXPECT_EQ(m, B_transposed.cols());
+  V actual_n(n, 0.);
+  B_transposed.mv(u, actual_n);
+  B.mtv(u, tmp_n);
+  expect_equal(tmp_n, actual_n);
+
+  // [A B; B^T C]
+  XT::LA::BlockOperator<V> saddle_point_op({m, n}, {m, n});
+  saddle_point_op.set_block(0, 0, A);
+  saddle_point_op.set_block(0, 1, B);
+  saddle_point_op.set_block(1, 0, B_transposed);
+  saddle_point_op.set_block(1, 1, C);
+  EXPECT_THROW(saddle_point_op.set_block(0, 1, A), XT::Common::Exceptions::shapes_do_not_match);
+  EXPECT_THROW(saddle_point_op.set_block(2, 0, A), XT::Common::Exceptions::index_out_of_range);
+  EXPECT_EQ(m + n, saddle_point_op.rows());
+  EXPECT_EQ(m + n, saddle_point_op.cols());
+  V x(m + n, 0.), y(m + n, 0.), expected_y(m + n, 0.);
+  for (size_t ii = 0; ii < m; ++ii)
+    x[ii] = u[ii];
+  for (size_t ii = 0; ii < n; ++ii)
+    x[m + ii] = p[ii];
+  // A u + B p
+  V expected_u = A * u;
+  B.mv(p, tmp_m);
+  expected_u += tmp_m;
+  // B^T u + C p
+  V expected_p = C * p;
+  B.mtv(u, tmp_n);
+  expected_p += tmp_n;
+  for (size_t ii = 0; ii < m; ++ii)
+    expected_y[ii] = expected_u[ii];
+  for (size_t ii = 0; ii < n; ++ii)
+    expected_y[m + ii] = expected_p[ii];
+  saddle_point_op.mv(x, y);
+  expect_equal(expected_y, y);
+  // the operator is symmetric, if C is
+  saddle_point_op.mtv(x, y);
+  expect_equal(expected_y, y);
+  EXPECT_THROW(saddle_point_op.mv(u, y), XT::Common::Exceptions::shapes_do_not_match);
+} // ... check_operators(...)
+
+
+template <class V>
+void check_solution(const XT::LA::LinearOperatorInterface<V>& op, const V& rhs, const V& solution)
+{
+  V residual(rhs.size(), 0.);
+  op.mv(solution, residual);
+  residual -= rhs;
+  EXPECT_LT(residual.sup_norm(), 1e-8);
+}
+
+
+template <class M, class V>
+void check_solver(const size_t m = 10, const size_t n = 3)
+{
+  const auto A = create_tridiagonal_matrix<M>(m, 2., -1.);
+  const auto mass = create_tridiagonal_matrix<M>(m, 4. / 6., 1. / 6.);
+  const auto B = create_constraint_matrix<M>(m, n);
+  // M + dt A is symmetric and positive definite
+  XT::LA::LinearCombinationOperator<V> combination(m, m);
+  combination.add(mass);
+  combination.add(A, 0.1);
+  XT::LA::Solver<XT::LA::LinearOperatorInterface<V>> solver(combination);
+  const auto rhs = create_vector<V>(m, 1.);
+  for (const auto& type : solver.types()) {
+    V solution(m, 0.);
+    solver.apply(rhs, solution, type);
+    check_solution(combination, rhs, solution);
+    EXPECT_EQ(type, solver.statistics().type);
+    EXPECT_GT(solver.statistics().iterations, 0u) << "type: " << type;
+  }
+  // [A B; B^T 0] is symmetric, but indefinite
+  const XT::LA::TransposedOperator<V> B_transposed(B);
+  XT::LA::BlockOperator<V> saddle_point_op({m, n}, {m, n});
+  saddle_point_op.set_block(0, 0, A);
+  saddle_point_op.set_block(0, 1, B);
+  saddle_point_op.set_block(1, 0, B_transposed);
+  const auto saddle_point_rhs = create_vector<V>(m + n, 0.5);
+  for (const std::string type : {"minres", "gmres"}) {
+    V solution(m + n, 0.);
+    XT::LA::solve(saddle_point_op, saddle_point_rhs, solution, type);
+    check_solution(saddle_point_op, saddle_point_rhs, solution);
+  }
+} // ... check_solver(...)
+
+
+GTEST_TEST(LinearOperatorTest, common_sparse)
+{
+  check_operators<XT::LA::CommonSparseMatrix<double>, XT::LA::CommonDenseVector<double>>();
+  check_solver<XT::LA::CommonSparseMatrix<double>, XT::LA::CommonDenseVector<double>>();
+}
+
+#if HAVE_EIGEN
+
+GTEST_TEST(LinearOperatorTest, eigen_sparse)
+{
+  check_operators<XT::LA::EigenRowMajorSparseMatrix<double>, XT::LA::EigenDenseVector<double>>();
+  check_solver<XT::LA::EigenRowMajorSparseMatrix<double>, XT::LA::EigenDenseVector<double>>();
+}
+
+#endif // HAVE_EIGEN
+#if HAVE_DUNE_ISTL
+
+GTEST_TEST(LinearOperatorTest, istl_sparse)
+{
+  check_operators<XT::LA::IstlRowMajorSparseMatrix<double>, XT::LA::IstlDenseVector<double>>();
+  check_solver<XT::LA::IstlRowMajorSparseMatrix<double>, XT::LA::IstlDenseVector<double>>();
+}
+
+#endif // HAVE_DUNE_ISTL
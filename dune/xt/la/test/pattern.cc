@@ -14,6 +14,9 @@
 #include <dune/xt/common/test/main.hxx> // <- This one has to come first, includes config.h!
 #include <dune/xt/common/test/gtest/gtest.h>
 
+#include <cstdint>
+#include <vector>
+
 #include <dune/xt/common/type_traits.hh>
 #include <dune/xt/la/container/pattern.hh>
 
@@ -157,3 +160,110 @@ GTEST_TEST(SparsityPatternDefaultTest, test_creation_functions)
     }
   }
 }
+
+
+GTEST_TEST(SparsityPatternDefaultTest, test_builder)
+{
+  using namespace Dune;
+  constexpr size_t ROWS = 7, COLS = 100;
+  XT::LA::SparsityPatternBuilder builder(ROWS);
+  XT::LA::SparsityPatternDefault expected(ROWS);
+  EXPECT_EQ(builder.size(), ROWS);
+  // insert each entry several times and in an arbitrary order, row 3 stays empty
+  for (size_t round = 0; round < 5; ++round) {
+    for (size_t ii = 0; ii < ROWS; ++ii) {
+      if (ii == 3)
+        continue;
+      for (size_t jj = 0; jj < 10 * ii; ++jj) {
+        const size_t col = (37 * jj + 11 * round) % COLS;
+        builder.insert(ii, col);
+        expected.insert(ii, col);
+      }
+    }
+  }
+  const std::vector<size_t> range = {99, 0, 42, 0};
+  builder.insert(6, range.begin(), range.end());
+  for (const auto& jj : range)
+    expected.insert(6, jj);
+  expected.sort();
+  // finalizing to compressed row storage
+  XT::LA::SparsityPatternBuilder builder_copy = builder;
+  std::vector<size_t> outer_index_ptr, inner_indices;
+  builder_copy.finalize(outer_index_ptr, inner_indices);
+  EXPECT_EQ(size_t(0), builder_copy.size());
+  ASSERT_EQ(ROWS + 1, outer_index_ptr.size());
+  EXPECT_EQ(inner_indices.size(), outer_index_ptr[ROWS]);
+  for (size_t ii = 0; ii < ROWS; ++ii)
+    EXPECT_EQ(expected.inner(ii),
+              std::vector<size_t>(inner_indices.begin() + outer_index_ptr[ii],
+                                  inner_indices.begin() + outer_index_ptr[ii + 1]));
+  // finalizing to a pattern
+  const auto pattern = builder.finalize();
+  EXPECT_EQ(expected, pattern);
+  EXPECT_EQ(size_t(0), builder.size());
+  EXPECT_TRUE(pattern.inner(3).empty());
+  // the functions using the builder
+  EXPECT_EQ(expected, pattern + XT::LA::SparsityPatternDefault(2));
+  EXPECT_EQ(expected, pattern.transposed(COLS).transposed(ROWS));
+  auto dense = XT::LA::dense_pattern(ROWS, COLS);
+  EXPECT_TRUE(dense.contains(pattern));
+  EXPECT_EQ(dense, dense + pattern);
+}
+
+
+GTEST_TEST(SparsityPatternDefaultTest, test_compressed)
+{
+  using namespace Dune;
+  constexpr size_t ROWS = 6, COLS = 9;
+  XT::LA::SparsityPatternDefault pattern(ROWS);
+  for (size_t ii = 0; ii < ROWS; ++ii)
+    if (ii != 2)
+      for (size_t jj = 0; jj <= ii; ++jj)
+        pattern.insert(ii, COLS - 1 - jj); // <- unsorted
+  auto sorted_pattern = pattern;
+  sorted_pattern.sort();
+  const XT::LA::SparsityPatternCompressed<> compressed(pattern);
+  const XT::LA::SparsityPatternCompressed<uint32_t> compressed_32(pattern);
+  EXPECT_EQ(ROWS, compressed.size());
+  EXPECT_EQ(ROWS, compressed_32.size());
+  EXPECT_EQ(size_t(18), compressed.non_zeros());
+  EXPECT_EQ(sorted_pattern, compressed.uncompressed());
+  EXPECT_EQ(sorted_pattern, compressed_32.uncompressed());
+  for (size_t ii = 0; ii < ROWS; ++ii) {
+    EXPECT_EQ(pattern.inner(ii).size(), compressed.inner_size(ii));
+    for (size_t jj = 0; jj < COLS; ++jj) {
+      EXPECT_EQ(pattern.contains(ii, jj), compressed.contains(ii, jj));
+      EXPECT_EQ(pattern.contains(ii, jj), compressed_32.contains(ii, jj));
+    }
+  }
+  // from arrays and from a builder
+  EXPECT_EQ(compressed, XT::LA::SparsityPatternCompressed<>(compressed.row_offsets(), compressed.column_indices()));
+  XT::LA::SparsityPatternBuilder builder(ROWS);
+  for (size_t ii = 0; ii < ROWS; ++ii)
+    builder.insert(ii, pattern.inner(ii).begin(), pattern.inner(ii).end());
+  EXPECT_EQ(compressed_32, XT::LA::SparsityPatternCompressed<uint32_t>(std::move(builder)));
+  EXPECT_THROW(XT::LA::SparsityPatternCompressed<>({0, 1}, {}), XT::Common::Exceptions::wrong_input_given);
+  EXPECT_THROW(XT::LA::SparsityPatternCompressed<>({1, 1}, {0}), XT::Common::Exceptions::wrong_input_given);
+  EXPECT_THROW(XT::LA::SparsityPatternCompressed<>({0, 3, 2}, {0, 1}), XT::Common::Exceptions::wrong_input_given);
+  EXPECT_THROW(XT::LA::SparsityPatternCompressed<>({0, 2}, {1, 0}), XT::Common::Exceptions::wrong_input_given);
+  EXPECT_THROW(XT::LA::SparsityPatternCompressed<>({0, 2}, {1, 1}), XT::Common::Exceptions::wrong_input_given);
+  // duplicates (which may be added through inner()) are removed
+  auto pattern_with_duplicates = pattern;
+  pattern_with_duplicates.inner(2).assign({4, 1, 4, 1, 0});
+  const XT::LA::SparsityPatternCompressed<> deduplicated(pattern_with_duplicates);
+  EXPECT_EQ(size_t(21), deduplicated.non_zeros());
+  EXPECT_EQ(std::vector<size_t>({0, 1, 4}),
+            std::vector<size_t>(deduplicated.inner_begin(2), deduplicated.inner_end(2)));
+  for (size_t ii = 0; ii < ROWS; ++ii)
+    if (ii != 2)
+      EXPECT_EQ(sorted_pattern.inner(ii),
+                std::vector<size_t>(deduplicated.inner_begin(ii), deduplicated.inner_end(ii)));
+  // releasing the arrays leaves an empty pattern
+  auto copy = compressed;
+  std::vector<size_t> row_offsets, column_indices;
+  copy.release(row_offsets, column_indices);
+  EXPECT_EQ(compressed.row_offsets(), row_offsets);
+  EXPECT_EQ(compressed.column_indices(), column_indices);
+  EXPECT_EQ(size_t(0), copy.size());
+  EXPECT_EQ(size_t(0), copy.non_zeros());
+}
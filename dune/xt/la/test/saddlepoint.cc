@@ -213,4 +213,112 @@ GTEST_TEST(SaddlePointSolver, test_cg_cg_schurcomplement)
   DXTC_EXPECT_FLOAT_EQ(0., (p - data.expected_p_).l2_norm(), 1e-12, 1e-12);
 }
 
+template <class Matrix, class Vector>
+void check_schur_preconditioners()
+{
+  SaddlePointTestData<Matrix, Vector> data;
+  const auto S_approx = XT::LA::approximate_schur_complement(data.A_, data.B_, data.B_, data.C_, "lumped");
+  XT::LA::SaddlePointSolver<Vector, Matrix> solver(data.A_, data.B_, data.B_, data.C_, S_approx);
+  auto opts = solver.options("cg_direct_schurcomplement");
+  Vector u(data.f_.size()), p(data.g_.size());
+  solver.apply(data.f_, data.g_, u, p, opts);
+  const size_t unpreconditioned_iterations = solver.statistics().iterations;
+  for (const std::string preconditioner : {"diagonal", "lumped", "matrix"}) {
+    opts["schur_preconditioner"] = preconditioner;
+    u.scal(0.);
+    p.scal(0.);
+    solver.apply(data.f_, data.g_, u, p, opts);
+    DXTC_EXPECT_FLOAT_EQ(0., (u - data.expected_u_).l2_norm(), 1e-12, 1e-12);
+    DXTC_EXPECT_FLOAT_EQ(0., (p - data.expected_p_).l2_norm(), 1e-12, 1e-12);
+    EXPECT_LE(solver.statistics().iterations, unpreconditioned_iterations) << "preconditioner: " << preconditioner;
+  }
+  // the approximation has to be given for "matrix"
+  XT::LA::SaddlePointSolver<Vector, Matrix> solver_without_approximation(data.A_, data.B_, data.B_, data.C_);
+  EXPECT_THROW(solver_without_approximation.apply(data.f_, data.g_, u, p, opts),
+               XT::Common::Exceptions::you_are_using_this_wrong);
+} // ... check_schur_preconditioners(...)
+
+GTEST_TEST(SaddlePointSolver, test_schur_preconditioners)
+{
+  check_schur_preconditioners<XT::LA::IstlRowMajorSparseMatrix<double>, XT::LA::IstlDenseVector<double>>();
+}
+
+GTEST_TEST(SaddlePointSolver, test_schur_preconditioners_eigen)
+{
+  check_schur_preconditioners<XT::LA::EigenRowMajorSparseMatrix<double>, XT::LA::EigenDenseVector<double>>();
+}
+
+// the prepared system matrix has to be reused until update() is called
+template <class Matrix, class Vector>
+void check_prepared_direct()
+{
+  SaddlePointTestData<Matrix, Vector> data;
+  XT::LA::SaddlePointSolver<Vector, Matrix> solver(data.A_, data.B_, data.B_, data.C_);
+  EXPECT_THROW(solver.update(), XT::Common::Exceptions::you_are_using_this_wrong);
+  solver.prepare("direct");
+  EXPECT_TRUE(solver.prepared());
+  Vector u(data.f_.size()), p(data.g_.size());
+  solver.apply(data.f_, data.g_, u, p, "direct");
+  EXPECT_TRUE(solver.statistics().setup_reused);
+  DXTC_EXPECT_FLOAT_EQ(0., (u - data.expected_u_).l2_norm(), 1e-12, 1e-12);
+  DXTC_EXPECT_FLOAT_EQ(0., (p - data.expected_p_).l2_norm(), 1e-12, 1e-12);
+  // scaling the system matrix by 2 halves the solution, but only after update()
+  data.A_.scal(2.);
+  data.B_.scal(2.);
+  data.C_.scal(2.);
+  solver.apply(data.f_, data.g_, u, p, "direct");
+  DXTC_EXPECT_FLOAT_EQ(0., (u - data.expected_u_).l2_norm(), 1e-12, 1e-12);
+  DXTC_EXPECT_FLOAT_EQ(0., (p - data.expected_p_).l2_norm(), 1e-12, 1e-12);
+  solver.update();
+  solver.apply(data.f_, data.g_, u, p, "direct");
+  EXPECT_TRUE(solver.statistics().setup_reused);
+  data.expected_u_.scal(0.5);
+  data.expected_p_.scal(0.5);
+  DXTC_EXPECT_FLOAT_EQ(0., (u - data.expected_u_).l2_norm(), 1e-12, 1e-12);
+  DXTC_EXPECT_FLOAT_EQ(0., (p - data.expected_p_).l2_norm(), 1e-12, 1e-12);
+  solver.invalidate();
+  EXPECT_FALSE(solver.prepared());
+  solver.apply(data.f_, data.g_, u, p, "direct");
+  EXPECT_FALSE(solver.statistics().setup_reused);
+  DXTC_EXPECT_FLOAT_EQ(0., (u - data.expected_u_).l2_norm(), 1e-12, 1e-12);
+  DXTC_EXPECT_FLOAT_EQ(0., (p - data.expected_p_).l2_norm(), 1e-12, 1e-12);
+} // ... check_prepared_direct(...)
+
+GTEST_TEST(SaddlePointSolver, test_prepared_direct)
+{
+  check_prepared_direct<XT::LA::IstlRowMajorSparseMatrix<double>, XT::LA::IstlDenseVector<double>>();
+}
+
+GTEST_TEST(SaddlePointSolver, test_prepared_direct_eigen)
+{
+  check_prepared_direct<XT::LA::EigenRowMajorSparseMatrix<double>, XT::LA::EigenDenseVector<double>>();
+}
+
+// the monolithic types only converge up to the given precision
+template <class Matrix, class Vector>
+void check_monolithic_types()
+{
+  SaddlePointTestData<Matrix, Vector> data;
+  XT::LA::SaddlePointSolver<Vector, Matrix> solver(data.A_, data.B_, data.B_, data.C_);
+  for (const std::string type : {"minres.blockdiag", "gmres.blocktriangular", "uzawa.inexact"}) {
+    auto opts = solver.options(type);
+    opts["precision"] = "1e-12";
+    Vector u(data.f_.size()), p(data.g_.size());
+    solver.apply(data.f_, data.g_, u, p, opts);
+    DXTC_EXPECT_FLOAT_EQ(0., (u - data.expected_u_).l2_norm(), 1e-7, 1e-7);
+    DXTC_EXPECT_FLOAT_EQ(0., (p - data.expected_p_).l2_norm(), 1e-7, 1e-7);
+    EXPECT_GT(solver.statistics().iterations, 0u) << "type: " << type;
+  }
+} // ... check_monolithic_types(...)
+
+GTEST_TEST(SaddlePointSolver, test_monolithic_types)
+{
+  check_monolithic_types<XT::LA::IstlRowMajorSparseMatrix<double>, XT::LA::IstlDenseVector<double>>();
+}
+
+GTEST_TEST(SaddlePointSolver, test_monolithic_types_eigen)
+{
+  check_monolithic_types<XT::LA::EigenRowMajorSparseMatrix<double>, XT::LA::EigenDenseVector<double>>();
+}
+
 #endif
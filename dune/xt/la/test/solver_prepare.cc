@@ -0,0 +1,324 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/common/test/main.hxx> // <- This one has to come first, includes config.h!
+#include <dune/xt/common/test/gtest/gtest.h>
+
+#include <dune/xt/la/container.hh>
+#include <dune/xt/la/solver.hh>
+#include <dune/xt/la/test/container.hh>
+
+using namespace Dune;
+
+
+// (2, -1) matrix with a diagonal pattern and one additional symmetric pair of entries at (0, coupled), (coupled, 0)
+template <class M>
+M create_coupled_diagonal_matrix(const size_t size, const size_t coupled)
+{
+  XT::LA::SparsityPatternDefault pattern(size);
+  for (size_t ii = 0; ii < size; ++ii)
+    pattern.insert(ii, ii);
+  pattern.insert(0, coupled);
+  pattern.insert(coupled, 0);
+  pattern.sort();
+  M matrix(size, size, pattern);
+  for (size_t ii = 0; ii < size; ++ii)
+    matrix.set_entry(ii, ii, 2.);
+  matrix.set_entry(0, coupled, -1.);
+  matrix.set_entry(coupled, 0, -1.);
+  return matrix;
+}
+
+
+template <class M, class V>
+void check_solves_system(const M& matrix, const V& rhs, const V& solution, const std::string& type)
+{
+  V residual(rhs.size(), 0.);
+  matrix.mv(solution, residual);
+  residual -= rhs;
+  EXPECT_LT(residual.sup_norm(), 1e-8) << "type: " << type;
+}
+
+
+// changes the entries of the matrix, but not its pattern, and checks that update() picks up the new entries
+template <class M, class V>
+void check_update(M& matrix, XT::LA::Solver<M>& solver, const std::string& type)
+{
+  const size_t size = matrix.rows();
+  solver.prepare(type);
+  for (size_t ii = 0; ii < size; ++ii)
+    matrix.set_entry(ii, ii, 3.);
+  solver.update();
+  EXPECT_TRUE(solver.prepared());
+  const V rhs(size, 1.);
+  V solution(size, 0.);
+  solver.apply(rhs, solution, type);
+  check_solves_system(matrix, rhs, solution, type);
+  for (size_t ii = 0; ii < size; ++ii)
+    matrix.set_entry(ii, ii, 2.);
+  solver.update();
+}
+
+
+// changes the pattern of the matrix, but not its number of entries, and checks that update() falls back to prepare()
+template <class M, class V>
+void check_update_with_changed_pattern(const size_t size = 10)
+{
+  auto matrix = create_coupled_diagonal_matrix<M>(size, 1);
+  XT::LA::Solver<M> solver(matrix);
+  for (const auto& type : solver.types()) {
+    matrix = create_coupled_diagonal_matrix<M>(size, 1);
+    solver.prepare(type);
+    matrix = create_coupled_diagonal_matrix<M>(size, size - 1);
+    solver.update();
+    EXPECT_TRUE(solver.prepared());
+    const V rhs(size, 1.);
+    V solution(size, 0.);
+    solver.apply(rhs, solution, type);
+    check_solves_system(matrix, rhs, solution, type);
+  }
+} // ... check_update_with_changed_pattern(...)
+
+
+// solves for several right hand sides at once, with and without given solution vectors
+template <class M, class V>
+void check_multiple_rhs(const size_t size = 10)
+{
+  const auto matrix = create_laplace_matrix<M>(size);
+  XT::LA::Solver<M> solver(matrix);
+  XT::LA::ListVectorArray<V> rhs(size);
+  for (size_t kk = 1; kk < 4; ++kk)
+    rhs.append(V(size, double(kk)));
+  for (const auto& type : solver.types()) {
+    XT::LA::ListVectorArray<V> solution(size);
+    solver.apply(rhs, solution, type);
+    ASSERT_EQ(rhs.length(), solution.length());
+    for (size_t jj = 0; jj < rhs.length(); ++jj)
+      check_solves_system(matrix, rhs[jj].vector(), solution[jj].vector(), type);
+    solver.apply(rhs, solution, solver.options(type));
+    for (size_t jj = 0; jj < rhs.length(); ++jj)
+      check_solves_system(matrix, rhs[jj].vector(), solution[jj].vector(), type);
+  }
+  XT::LA::ListVectorArray<V> too_short(size, 1);
+  EXPECT_THROW(solver.apply(rhs, too_short), XT::Common::Exceptions::shapes_do_not_match);
+  XT::LA::ListVectorArray<V> wrong_dim(size + 1);
+  EXPECT_THROW(solver.apply(rhs, wrong_dim), XT::Common::Exceptions::shapes_do_not_match);
+} // ... check_multiple_rhs(...)
+
+
+// the prepared setup must only be reused for the options it was computed with
+template <class M, class V>
+void check_setup_options(const std::string& type, const std::string& key, const std::string& other_value)
+{
+  const size_t size = 10;
+  const auto matrix = create_laplace_matrix<M>(size);
+  XT::LA::Solver<M> solver(matrix);
+  solver.prepare(type);
+  const V rhs(size, 1.);
+  V solution(size, 0.);
+  solver.apply(rhs, solution, type);
+  EXPECT_TRUE(solver.statistics().setup_reused);
+  auto opts = solver.options(type);
+  opts[key] = other_value;
+  solution.scal(0.);
+  solver.apply(rhs, solution, opts);
+  EXPECT_FALSE(solver.statistics().setup_reused);
+  check_solves_system(matrix, rhs, solution, type);
+  // options which do not affect the setup
+  opts = solver.options(type);
+  opts["post_check_solves_system"] = "1e-6";
+  solver.apply(rhs, solution, opts);
+  EXPECT_TRUE(solver.statistics().setup_reused);
+} // ... check_setup_options(...)
+
+
+GTEST_TEST(SolverMultipleRhsTest, common_dense)
+{
+  check_multiple_rhs<XT::LA::CommonDenseMatrix<double>, XT::LA::CommonDenseVector<double>>();
+}
+
+#if HAVE_EIGEN
+
+GTEST_TEST(SolverMultipleRhsTest, eigen_dense)
+{
+  check_multiple_rhs<XT::LA::EigenDenseMatrix<double>, XT::LA::EigenDenseVector<double>>();
+}
+
+GTEST_TEST(SolverMultipleRhsTest, eigen_sparse)
+{
+  check_multiple_rhs<XT::LA::EigenRowMajorSparseMatrix<double>, XT::LA::EigenDenseVector<double>>();
+}
+
+GTEST_TEST(SolverPrepareTest, eigen_sparse_reuses_factorization)
+{
+  using M = XT::LA::EigenRowMajorSparseMatrix<double>;
+  using V = XT::LA::EigenDenseVector<double>;
+  const size_t size = 10;
+  const auto matrix = create_laplace_matrix<M>(size);
+  XT::LA::Solver<M> solver(matrix);
+  EXPECT_FALSE(solver.prepared());
+  for (const auto& type : solver.types()) {
+    solver.prepare(type);
+    EXPECT_TRUE(solver.prepared());
+    for (size_t kk = 1; kk < 4; ++kk) {
+      const V rhs(size, double(kk));
+      V solution(size, 0.);
+      solver.apply(rhs, solution, type);
+      check_solves_system(matrix, rhs, solution, type);
+    }
+  }
+  solver.invalidate();
+  EXPECT_FALSE(solver.prepared());
+}
+
+GTEST_TEST(SolverPrepareTest, eigen_sparse_update_reuses_symbolic_factorization)
+{
+  using M = XT::LA::EigenRowMajorSparseMatrix<double>;
+  using V = XT::LA::EigenDenseVector<double>;
+  auto matrix = create_laplace_matrix<M>(10);
+  XT::LA::Solver<M> solver(matrix);
+  EXPECT_THROW(solver.update(), XT::Common::Exceptions::you_are_using_this_wrong);
+  for (const auto& type : solver.types())
+    check_update<M, V>(matrix, solver, type);
+}
+
+GTEST_TEST(SolverPrepareTest, eigen_sparse_update_detects_changed_pattern)
+{
+  check_update_with_changed_pattern<XT::LA::EigenRowMajorSparseMatrix<double>, XT::LA::EigenDenseVector<double>>();
+}
+
+// the cg.*.lower (cg.*.upper) types only read the lower (upper) triangle, which here describe different symmetric
+// matrices, so a swapped triangle solves the wrong system
+GTEST_TEST(SolverPrepareTest, eigen_sparse_cg_reads_the_requested_triangle)
+{
+  using M = XT::LA::EigenRowMajorSparseMatrix<double>;
+  using V = XT::LA::EigenDenseVector<double>;
+  const size_t size = 20;
+  const auto lower = create_tridiagonal_matrix<M>(size, 2., -1.);
+  const auto upper = create_tridiagonal_matrix<M>(size, 2., 0.5);
+  auto matrix = create_laplace_matrix<M>(size);
+  for (size_t ii = 0; ii + 1 < size; ++ii)
+    matrix.set_entry(ii, ii + 1, 0.5);
+  const auto rhs = create_vector<V>(size, 1.);
+  XT::LA::Solver<M> solver(matrix);
+  for (const std::string type : {"cg.diagonal.lower", "cg.diagonal.upper", "cg.identity.lower", "cg.identity.upper"}) {
+    const auto& expected_matrix = (type.find("lower") != std::string::npos) ? lower : upper;
+    auto opts = solver.options(type);
+    // the matrix itself is not symmetric
+    opts["post_check_solves_system"] = "0";
+    V solution(size, 0.);
+    solver.apply(rhs, solution, opts);
+    check_solves_system(expected_matrix, rhs, solution, type);
+    solver.prepare(opts);
+    V prepared_solution(size, 0.);
+    solver.apply(rhs, prepared_solution, opts);
+    EXPECT_TRUE(solver.statistics().setup_reused) << "type: " << type;
+    check_solves_system(expected_matrix, rhs, prepared_solution, type);
+  }
+}
+
+GTEST_TEST(SolverPrepareTest, eigen_sparse_compares_setup_options)
+{
+  using M = XT::LA::EigenRowMajorSparseMatrix<double>;
+  using V = XT::LA::EigenDenseVector<double>;
+  check_setup_options<M, V>("bicgstab.ilut", "preconditioner.drop_tol", "1e-2");
+  check_setup_options<M, V>("cg.diagonal.lower", "precision", "1e-12");
+}
+
+#endif // HAVE_EIGEN
+#if HAVE_DUNE_ISTL
+
+GTEST_TEST(SolverMultipleRhsTest, istl)
+{
+  check_multiple_rhs<XT::LA::IstlRowMajorSparseMatrix<double>, XT::LA::IstlDenseVector<double>>();
+}
+
+GTEST_TEST(SolverPrepareTest, istl_reuses_factorization)
+{
+  using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+  using V = XT::LA::IstlDenseVector<double>;
+  const size_t size = 10;
+  auto matrix = create_laplace_matrix<M>(size);
+  XT::LA::Solver<M> solver(matrix);
+  EXPECT_FALSE(solver.prepared());
+  for (const auto& type : solver.types()) {
+    solver.prepare(type);
+    EXPECT_TRUE(solver.prepared());
+    for (size_t kk = 1; kk < 4; ++kk) {
+      const V rhs(size, double(kk));
+      V solution(size, 0.);
+      solver.apply(rhs, solution, type);
+      check_solves_system(matrix, rhs, solution, type);
+    }
+    check_update<M, V>(matrix, solver, type);
+  }
+  solver.invalidate();
+  EXPECT_FALSE(solver.prepared());
+}
+
+GTEST_TEST(SolverPrepareTest, istl_update_detects_changed_pattern)
+{
+  check_update_with_changed_pattern<XT::LA::IstlRowMajorSparseMatrix<double>, XT::LA::IstlDenseVector<double>>();
+}
+
+GTEST_TEST(SolverPrepareTest, istl_amg_updates_hierarchy)
+{
+  using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+  using V = XT::LA::IstlDenseVector<double>;
+  const size_t size = 100;
+  auto matrix = create_laplace_matrix<M>(size);
+  XT::LA::Solver<M> solver(matrix);
+  for (const auto& type : {"bicgstab.amg.ilu0", "bicgstab.amg.ssor"}) {
+    const auto opts = solver.options(type);
+    solver.prepare(opts);
+    for (size_t ii = 0; ii < size; ++ii)
+      matrix.set_entry(ii, ii, 2.5);
+    solver.update();
+    const V rhs(size, 1.);
+    V solution(size, 0.);
+    solver.apply(rhs, solution, opts);
+    EXPECT_TRUE(solver.statistics().setup_reused);
+    check_solves_system(matrix, rhs, solution, type);
+    solver.recompute();
+    solver.apply(rhs, solution, opts);
+    check_solves_system(matrix, rhs, solution, type);
+    for (size_t ii = 0; ii < size; ++ii)
+      matrix.set_entry(ii, ii, 2.);
+  }
+}
+
+GTEST_TEST(SolverPrepareTest, istl_amg_reuses_hierarchy)
+{
+  using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+  using V = XT::LA::IstlDenseVector<double>;
+  const size_t size = 100;
+  auto matrix = create_laplace_matrix<M>(size);
+  XT::LA::Solver<M> solver(matrix);
+  for (const auto& type : {"bicgstab.amg.ilu0", "bicgstab.amg.ssor"}) {
+    auto opts = solver.options(type);
+    opts["preconditioner.reuse_hierarchy"] = "1";
+    solver.prepare(opts);
+    for (size_t ii = 0; ii < size; ++ii)
+      matrix.set_entry(ii, ii, 2.5);
+    solver.update();
+    const V rhs(size, 1.);
+    V solution(size, 0.);
+    solver.apply(rhs, solution, opts);
+    EXPECT_TRUE(solver.statistics().setup_reused);
+    check_solves_system(matrix, rhs, solution, type);
+    for (size_t ii = 0; ii < size; ++ii)
+      matrix.set_entry(ii, ii, 2.);
+  }
+}
+
+GTEST_TEST(SolverPrepareTest, istl_compares_setup_options)
+{
+  check_setup_options<XT::LA::IstlRowMajorSparseMatrix<double>, XT::LA::IstlDenseVector<double>>(
+      "bicgstab.amg.ilu0", "smoother.iterations", "2");
+}
+
+#endif // HAVE_DUNE_ISTL
@@ -0,0 +1,201 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/common/test/main.hxx> // <- This one has to come first, includes config.h!
+#include <dune/xt/common/test/gtest/gtest.h>
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include <dune/xt/la/container.hh>
+#include <dune/xt/la/solver.hh>
+#include <dune/xt/la/test/container.hh>
+
+using namespace Dune;
+
+
+// all types of the tested backends but the Krylov solvers are direct solvers
+bool is_direct(const std::string& type)
+{
+  return type.substr(0, 2) != "cg" && type.substr(0, 8) != "bicgstab";
+}
+
+
+template <class M, class V>
+void check_statistics(const size_t size = 20)
+{
+  const auto matrix = create_laplace_matrix<M>(size);
+  XT::LA::Solver<M> solver(matrix);
+  const V rhs(size, 1.);
+  for (const auto& type : solver.types()) {
+    V solution(size, 0.);
+    solver.apply(rhs, solution, type);
+    const auto& statistics = solver.statistics();
+    EXPECT_EQ(type, statistics.type);
+    EXPECT_FALSE(statistics.setup_reused) << "type: " << type;
+    EXPECT_GE(statistics.setup_time, 0.) << "type: " << type;
+    EXPECT_GE(statistics.solve_time, 0.) << "type: " << type;
+    EXPECT_GE(statistics.post_check_time, 0.) << "type: " << type;
+    EXPECT_GT(statistics.iterations, 0u) << "type: " << type;
+    if (is_direct(type))
+      EXPECT_EQ(1u, statistics.iterations) << "type: " << type;
+    EXPECT_DOUBLE_EQ(statistics.setup_time + statistics.solve_time + statistics.post_check_time,
+                     statistics.total_time());
+    // the history starts with the initial residual
+    if (!statistics.residual_history.empty())
+      EXPECT_GE(statistics.residual_history.size(), 2u) << "type: " << type;
+  }
+  XT::LA::ListVectorArray<V> multiple_rhs(size);
+  for (size_t kk = 1; kk < 4; ++kk)
+    multiple_rhs.append(V(size, double(kk)));
+  XT::LA::ListVectorArray<V> solution(size);
+  solver.apply(multiple_rhs, solution);
+  EXPECT_GE(solver.statistics().iterations, multiple_rhs.length());
+  if (is_direct(solver.types()[0]))
+    EXPECT_EQ(multiple_rhs.length(), solver.statistics().iterations);
+} // ... check_statistics(...)
+
+
+// the given type has to keep a setup, see Solver::prepare()
+template <class M, class V>
+void check_reused_setup(const std::string& type, const size_t size = 20)
+{
+  const auto matrix = create_laplace_matrix<M>(size);
+  XT::LA::Solver<M> solver(matrix);
+  solver.prepare(type);
+  EXPECT_EQ(type, solver.statistics().type);
+  EXPECT_FALSE(solver.statistics().setup_reused);
+  const V rhs(size, 1.);
+  V solution(size, 0.);
+  solver.apply(rhs, solution, type);
+  EXPECT_TRUE(solver.statistics().setup_reused);
+  EXPECT_EQ(0., solver.statistics().setup_time);
+  // each call starts with fresh statistics
+  solver.apply(rhs, solution, type);
+  EXPECT_TRUE(solver.statistics().setup_reused);
+  solver.invalidate();
+  solver.apply(rhs, solution, type);
+  EXPECT_FALSE(solver.statistics().setup_reused);
+  EXPECT_GE(solver.statistics().setup_time, 0.);
+  solver.prepare(type);
+  solver.apply(rhs, solution, type);
+  EXPECT_TRUE(solver.statistics().setup_reused);
+} // ... check_reused_setup(...)
+
+
+// the post check may reuse the residual of the iterative solvers, but has to give the same verdict
+template <class M, class V>
+void check_post_check_reuses_residual(const std::string& type, const size_t size = 20)
+{
+  const auto matrix = create_laplace_matrix<M>(size);
+  XT::LA::Solver<M> solver(matrix);
+  auto opts = solver.options(type);
+  opts["post_check_reuses_residual"] = "1";
+  const V rhs(size, 1.);
+  V solution(size, 0.);
+  solver.apply(rhs, solution, opts);
+  V residual(size, 0.);
+  matrix.mv(solution, residual);
+  residual -= rhs;
+  EXPECT_LT(residual.sup_norm(), opts.template get<double>("post_check_solves_system"));
+  // a too strict threshold has to be detected by computing the residual
+  opts["precision"] = "1e-2";
+  opts["post_check_solves_system"] = "1e-14";
+  solution.scal(0.);
+  EXPECT_THROW(solver.apply(rhs, solution, opts),
+               XT::LA::Exceptions::linear_solver_failed_bc_the_solution_does_not_solve_the_system);
+} // ... check_post_check_reuses_residual(...)
+
+
+// a solution containing NaNs must not pass the post check
+template <class M, class V>
+void check_post_check_detects_nan(const size_t size = 20)
+{
+  const auto matrix = create_laplace_matrix<M>(size);
+  XT::LA::Solver<M> solver(matrix);
+  V rhs(size, 1.);
+  rhs[size / 2] = std::nan("");
+  V solution(size, 0.);
+  EXPECT_THROW(solver.apply(rhs, solution),
+               XT::LA::Exceptions::linear_solver_failed_bc_the_solution_does_not_solve_the_system);
+}
+
+
+// the const apply() may be called concurrently, each call uses its own scratch vectors and statistics
+template <class M, class V>
+void check_concurrent_apply(const size_t size = 20, const size_t num_threads = 4)
+{
+  const auto matrix = create_laplace_matrix<M>(size);
+  const XT::LA::Solver<M> solver(matrix);
+  std::vector<V> solutions(num_threads, V(size, 0.));
+  std::vector<std::thread> threads;
+  for (size_t tt = 0; tt < num_threads; ++tt)
+    threads.emplace_back([&, tt]() {
+      const V rhs(size, double(tt + 1));
+      for (size_t kk = 0; kk < 10; ++kk)
+        solver.apply(rhs, solutions[tt]);
+    });
+  for (auto& thread : threads)
+    thread.join();
+  for (size_t tt = 0; tt < num_threads; ++tt) {
+    V residual(size, 0.);
+    matrix.mv(solutions[tt], residual);
+    residual -= V(size, double(tt + 1));
+    EXPECT_LT(residual.sup_norm(), 1e-8) << "thread: " << tt;
+  }
+  EXPECT_EQ(solver.types()[0], solver.statistics().type);
+} // ... check_concurrent_apply(...)
+
+
+GTEST_TEST(SolverStatisticsTest, common_dense)
+{
+  check_statistics<XT::LA::CommonDenseMatrix<double>, XT::LA::CommonDenseVector<double>>();
+  check_post_check_detects_nan<XT::LA::CommonDenseMatrix<double>, XT::LA::CommonDenseVector<double>>();
+  check_concurrent_apply<XT::LA::CommonDenseMatrix<double>, XT::LA::CommonDenseVector<double>>();
+}
+
+#if HAVE_EIGEN
+
+GTEST_TEST(SolverStatisticsTest, eigen_dense)
+{
+  check_statistics<XT::LA::EigenDenseMatrix<double>, XT::LA::EigenDenseVector<double>>();
+  check_concurrent_apply<XT::LA::EigenDenseMatrix<double>, XT::LA::EigenDenseVector<double>>();
+}
+
+GTEST_TEST(SolverStatisticsTest, eigen_sparse)
+{
+  check_statistics<XT::LA::EigenRowMajorSparseMatrix<double>, XT::LA::EigenDenseVector<double>>();
+  check_reused_setup<XT::LA::EigenRowMajorSparseMatrix<double>, XT::LA::EigenDenseVector<double>>("lu.sparse");
+  check_post_check_reuses_residual<XT::LA::EigenRowMajorSparseMatrix<double>, XT::LA::EigenDenseVector<double>>(
+      "cg.diagonal.lower");
+}
+
+#endif // HAVE_EIGEN
+#if HAVE_DUNE_ISTL
+
+GTEST_TEST(SolverStatisticsTest, istl_sparse)
+{
+  using M = XT::LA::IstlRowMajorSparseMatrix<double>;
+  using V = XT::LA::IstlDenseVector<double>;
+  check_statistics<M, V>();
+  check_reused_setup<M, V>("bicgstab.amg.ilu0");
+  check_post_check_reuses_residual<M, V>("cg");
+  check_concurrent_apply<M, V>();
+  // the Krylov solvers record their residuals
+  const size_t size = 20;
+  const auto matrix = create_laplace_matrix<M>(size);
+  XT::LA::Solver<M> solver(matrix);
+  const V rhs(size, 1.);
+  V solution(size, 0.);
+  solver.apply(rhs, solution, "cg");
+  // the initial residual and one per iteration
+  const auto statistics = solver.statistics();
+  EXPECT_EQ(statistics.iterations + 1, statistics.residual_history.size());
+}
+
+#endif // HAVE_DUNE_ISTL
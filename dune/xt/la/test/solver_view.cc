@@ -0,0 +1,160 @@
+// This file is part of the dune-xt-la project:
+//   https://github.com/dune-community/dune-xt-la
+// Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+// License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+//      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+//          with "runtime exception" (http://www.dune-project.org/license.html)
+
+#include <dune/xt/common/test/main.hxx> // <- This one has to come first, includes config.h!
+#include <dune/xt/common/test/gtest/gtest.h>
+
+#include <algorithm>
+
+#include <dune/xt/la/container.hh>
+#include <dune/xt/la/container/matrix-view.hh>
+#include <dune/xt/la/container/vector-view.hh>
+#include <dune/xt/la/solver.hh>
+#include <dune/xt/la/test/container.hh>
+
+using namespace Dune;
+
+
+template <class M, class V>
+void check_residual(const XT::LA::MatrixView<M>& matrix_view, const V& rhs, const V& solution)
+{
+  V residual(rhs.size(), 0.);
+  matrix_view.mv(solution, residual);
+  residual -= rhs;
+  EXPECT_LT(residual.sup_norm(), 1e-8);
+}
+
+
+// solves with the diagonal block [first, past_last) of a larger matrix, the entries coupling to the rest of the
+// matrix must not be taken into account
+template <class M, class V>
+void check_solver_for_matrix_view(const size_t size = 12, const size_t first = 3, const size_t past_last = 10)
+{
+  const size_t block_size = past_last - first;
+  auto matrix = create_laplace_matrix<M>(size);
+  XT::LA::MatrixView<M> matrix_view(matrix, first, past_last, first, past_last);
+  XT::LA::Solver<XT::LA::MatrixView<M>> solver(matrix_view);
+  const auto rhs = create_vector<V>(block_size, 1.);
+  for (const auto& type : solver.types()) {
+    V solution(block_size, 0.);
+    solver.apply(rhs, solution, type);
+    check_residual(matrix_view, rhs, solution);
+  }
+
+  // unless prepared, all types use the current entries of the underlying matrix
+  matrix.scal(2.);
+  for (const auto& type : solver.types()) {
+    V solution(block_size, 0.);
+    solver.apply(rhs, solution, type);
+    check_residual(matrix_view, rhs, solution);
+  }
+  matrix.scal(0.5);
+
+  // the block extracted by prepare() (the first type of each backend is not matrix free) is only renewed by update()
+  const auto type = solver.types()[0];
+  solver.prepare(type);
+  EXPECT_TRUE(solver.prepared());
+  V solution(block_size, 0.), outdated_solution(block_size, 0.), scaled_solution(block_size, 0.);
+  solver.apply(rhs, solution, type);
+  matrix.scal(2.);
+  solver.apply(rhs, outdated_solution, type);
+  for (size_t ii = 0; ii < block_size; ++ii)
+    EXPECT_NEAR(solution[ii], outdated_solution[ii], 1e-8) << "ii = " << ii;
+  solver.update();
+  solver.apply(rhs, scaled_solution, type);
+  for (size_t ii = 0; ii < block_size; ++ii)
+    EXPECT_NEAR(0.5 * solution[ii], scaled_solution[ii], 1e-8) << "ii = " << ii;
+  // the matrix free types have no setup
+  const auto types = solver.types();
+  if (std::find(types.begin(), types.end(), "cg") != types.end()) {
+    solver.prepare("cg");
+    matrix.scal(0.5);
+    V cg_solution(block_size, 0.);
+    solver.apply(rhs, cg_solution, "cg");
+    check_residual(matrix_view, rhs, cg_solution);
+    matrix.scal(2.);
+  }
+  solver.invalidate();
+  EXPECT_FALSE(solver.prepared());
+  EXPECT_THROW(solver.update(), XT::Common::Exceptions::you_are_using_this_wrong);
+
+  // the solution is written to the viewed part of the vector
+  auto full_rhs = create_vector<V>(size, 1.);
+  V full_solution(size, 42.);
+  const XT::LA::VectorView<V> rhs_view(full_rhs, first, past_last);
+  XT::LA::VectorView<V> solution_view(full_solution, first, past_last);
+  solver.apply(rhs_view, solution_view, type);
+  V block_rhs(block_size, 0.), block_solution(block_size, 0.);
+  for (size_t ii = 0; ii < block_size; ++ii) {
+    block_rhs[ii] = full_rhs[first + ii];
+    block_solution[ii] = full_solution[first + ii];
+  }
+  check_residual(matrix_view, block_rhs, block_solution);
+  for (size_t ii = 0; ii < size; ++ii)
+    if (ii < first || ii >= past_last)
+      EXPECT_DOUBLE_EQ(42., full_solution[ii]) << "ii = " << ii;
+} // ... check_solver_for_matrix_view(...)
+
+
+// the viewed block has an empty row and column (eigen stores an additional entry in the empty row of the underlying
+// matrix, which lies outside of the block), the system is solvable for a rhs which vanishes in that row
+template <class M, class V>
+void check_matrix_view_with_empty_row(const std::string& type,
+                                      const size_t size = 12,
+                                      const size_t first = 3,
+                                      const size_t past_last = 10,
+                                      const size_t empty_row = 6)
+{
+  const size_t block_size = past_last - first;
+  XT::LA::SparsityPatternDefault pattern(size);
+  for (size_t ii = 0; ii < size; ++ii)
+    for (size_t jj = (ii > 0 ? ii - 1 : 0); jj < std::min(ii + 2, size); ++jj)
+      if (ii != empty_row && jj != empty_row)
+        pattern.insert(ii, jj);
+  pattern.sort();
+  M matrix(size, size, pattern);
+  for (size_t ii = 0; ii < size; ++ii)
+    for (const auto& jj : pattern.inner(ii))
+      matrix.set_entry(ii, jj, ii == jj ? 2. : -1.);
+  XT::LA::MatrixView<M> matrix_view(matrix, first, past_last, first, past_last);
+  XT::LA::Solver<XT::LA::MatrixView<M>> solver(matrix_view);
+  auto rhs = create_vector<V>(block_size, 1.);
+  rhs[empty_row - first] = 0.;
+  V solution(block_size, 0.);
+  solver.apply(rhs, solution, type);
+  check_residual(matrix_view, rhs, solution);
+  EXPECT_NEAR(0., solution[empty_row - first], 1e-8);
+  solver.prepare(type);
+  V prepared_solution(block_size, 0.);
+  solver.apply(rhs, prepared_solution, type);
+  check_residual(matrix_view, rhs, prepared_solution);
+} // ... check_matrix_view_with_empty_row(...)
+
+
+GTEST_TEST(MatrixViewSolverTest, common_sparse)
+{
+  check_solver_for_matrix_view<XT::LA::CommonSparseMatrix<double>, XT::LA::CommonDenseVector<double>>();
+}
+
+#if HAVE_EIGEN
+
+GTEST_TEST(MatrixViewSolverTest, eigen_sparse)
+{
+  check_solver_for_matrix_view<XT::LA::EigenRowMajorSparseMatrix<double>, XT::LA::EigenDenseVector<double>>();
+  check_matrix_view_with_empty_row<XT::LA::EigenRowMajorSparseMatrix<double>, XT::LA::EigenDenseVector<double>>(
+      "cg.identity.lower");
+}
+
+#endif // HAVE_EIGEN
+#if HAVE_DUNE_ISTL
+
+GTEST_TEST(MatrixViewSolverTest, istl_sparse)
+{
+  check_solver_for_matrix_view<XT::LA::IstlRowMajorSparseMatrix<double>, XT::LA::IstlDenseVector<double>>();
+}
+
+#endif // HAVE_DUNE_ISTL
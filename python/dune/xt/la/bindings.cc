@@ -51,6 +51,7 @@ PYBIND11_MODULE(_la, m)
 #endif
 #if HAVE_EIGEN
   auto eigen_dense_vector_double = LA::bind_Vector<LA::EigenDenseVector<double>>(m);
+  LA::bind_Vector<LA::EigenMappedDenseVector<double>>(m);
 #endif
 
   LA::bind_SparsityPatternDefault(m);
@@ -58,7 +59,7 @@ PYBIND11_MODULE(_la, m)
 #define BIND_MATRIX(C, s, c) auto c = LA::bind_Matrix<C, s>(m);
 
   BIND_MATRIX(LA::CommonDenseMatrix<double>, false, common_dense_matrix_double);
-//  BIND_MATRIX(LA::CommonSparseMatrix<double>, true, common_sparse_matrix_double);
+  BIND_MATRIX(LA::CommonSparseMatrix<double>, true, common_sparse_matrix_double);
 #if HAVE_DUNE_ISTL
   BIND_MATRIX(LA::IstlRowMajorSparseMatrix<double>, true, istl_row_major_sparse_matrix_double);
 #endif
@@ -68,7 +69,7 @@ PYBIND11_MODULE(_la, m)
 #endif
 #undef BIND_MATRIX
   LA::addbind_Matrix_Vector_interaction(common_dense_matrix_double, common_dense_vector_double);
-//  LA::addbind_Matrix_Vector_interaction(common_sparse_matrix_double, common_dense_vector_double);
+  LA::addbind_Matrix_Vector_interaction(common_sparse_matrix_double, common_dense_vector_double);
 #if HAVE_DUNE_ISTL
   LA::addbind_Matrix_Vector_interaction(istl_row_major_sparse_matrix_double, istl_dense_vector_double);
 #endif
@@ -77,6 +78,7 @@ PYBIND11_MODULE(_la, m)
   LA::addbind_Matrix_Vector_interaction(eigen_row_major_sparse_matrix_double, eigen_dense_vector_double);
 #endif
 
+  LA::bind_SolverStatistics(m);
   LA::bind_Solver<LA::CommonDenseMatrix<double>>(m);
 //  LA::bind_Solver<LA::CommonSparseMatrix<double>>(m);
 #if HAVE_DUNE_ISTL
@@ -157,6 +157,15 @@ struct container_name<EigenDenseVector<double>>
   }
 };
 
+template <>
+struct container_name<EigenMappedDenseVector<double>>
+{
+  static std::string value()
+  {
+    return "eigen_mapped_dense_vector_double";
+  }
+};
+
 template <>
 struct container_name<EigenDenseMatrix<double>>
 {
@@ -11,9 +11,13 @@
 #ifndef DUNE_XT_LA_CONTAINER_MATRIX_INTERFACE_PBH
 #define DUNE_XT_LA_CONTAINER_MATRIX_INTERFACE_PBH
 
+#include <cstdint>
+#include <limits>
 #include <sstream>
+#include <type_traits>
 
 #include <dune/pybindxi/pybind11.h>
+#include <dune/pybindxi/numpy.h>
 #include <dune/pybindxi/operators.h>
 
 #include <dune/xt/common/numeric_cast.hh>
@@ -60,6 +64,159 @@ struct addbind_Matrix<T, true>
 };
 
 
+template <class M>
+struct is_dense_matrix
+  : public std::integral_constant<bool,
+                                  Common::MatrixAbstraction<M>::storage_layout
+                                          == Common::StorageLayout::dense_row_major
+                                      || Common::MatrixAbstraction<M>::storage_layout
+                                             == Common::StorageLayout::dense_column_major>
+{};
+
+
+//! Returns copies of (data, indices, indptr) of the matrix in compressed row storage as NumPy arrays.
+template <class M>
+pybind11::tuple copy_compressed_row_arrays(pybind11::object self)
+{
+  namespace py = pybind11;
+  typedef typename M::ScalarType S;
+  const auto& mat = self.cast<const M&>();
+  const SparsityPatternCompressed<size_t> pattern(mat.pattern());
+  const auto& row_pointers = pattern.row_offsets();
+  const auto& column_indices = pattern.column_indices();
+  py::array_t<int64_t> indptr(row_pointers.size()), indices(column_indices.size());
+  py::array_t<S> data(column_indices.size());
+  auto indptr_ref = indptr.mutable_unchecked<1>();
+  auto indices_ref = indices.mutable_unchecked<1>();
+  auto data_ref = data.template mutable_unchecked<1>();
+  for (size_t ii = 0; ii < row_pointers.size(); ++ii)
+    indptr_ref(ii) = static_cast<int64_t>(row_pointers[ii]);
+  for (size_t ii = 0; ii < pattern.size(); ++ii)
+    for (size_t kk = row_pointers[ii]; kk < row_pointers[ii + 1]; ++kk) {
+      indices_ref(kk) = static_cast<int64_t>(column_indices[kk]);
+      data_ref(kk) = mat.get_entry(ii, column_indices[kk]);
+    }
+  return py::make_tuple(data, indices, indptr);
+} // ... copy_compressed_row_arrays(...)
+
+
+/**
+ * \brief Returns (data, indices, indptr) of a matrix in compressed row storage as NumPy arrays.
+ *
+ * The arrays are copied, see the specializations below for backends whose arrays can be shared (if copy is false).
+ */
+template <class M>
+struct CompressedRowArrays
+{
+  static pybind11::tuple get(pybind11::object self, const bool /*copy*/)
+  {
+    return copy_compressed_row_arrays<M>(self);
+  }
+};
+
+/**
+ * \brief Copies or shares the arrays of the matrix, its indices are viewed as signed integers of the same size (as
+ *        SciPy expects).
+ *
+ * Shared arrays only keep the matrix alive, not its arrays: they are invalid once the matrix replaces or reallocates
+ * them (e.g. in rightmultiply() or an assignment).
+ */
+template <class S, class I>
+struct CompressedRowArrays<CommonSparseMatrix<S, Common::StorageLayout::csr, I>>
+{
+  using M = CommonSparseMatrix<S, Common::StorageLayout::csr, I>;
+  using SignedIndexType = typename std::make_signed<I>::type;
+
+  static pybind11::tuple get(pybind11::object self, const bool copy)
+  {
+    namespace py = pybind11;
+    auto& mat = self.cast<M&>();
+    const size_t nnz = mat.non_zeros();
+    if (std::max(nnz, mat.cols()) > size_t(std::numeric_limits<SignedIndexType>::max()))
+      return copy_compressed_row_arrays<M>(self);
+    // without a base object, the arrays are copied
+    const py::handle base = copy ? py::handle() : py::handle(self);
+    return py::make_tuple(
+        py::array_t<S>({nnz}, {sizeof(S)}, mat.entries(), base),
+        py::array_t<SignedIndexType>(
+            {nnz}, {sizeof(I)}, reinterpret_cast<SignedIndexType*>(mat.inner_index_ptr()), base),
+        py::array_t<SignedIndexType>(
+            {mat.rows() + 1}, {sizeof(I)}, reinterpret_cast<SignedIndexType*>(mat.outer_index_ptr()), base));
+  } // ... get(...)
+}; // struct CompressedRowArrays<CommonSparseMatrix<..., csr, ...>>
+
+#if HAVE_EIGEN
+
+/**
+ * \brief Copies or shares the arrays of the (compressed) Eigen backend.
+ *
+ * Shared arrays only keep the matrix alive, not its arrays: they are invalid once the backend reallocates them (e.g.
+ * when entries are inserted or the matrix is assigned to).
+ */
+template <class S>
+struct CompressedRowArrays<EigenRowMajorSparseMatrix<S>>
+{
+  static pybind11::tuple get(pybind11::object self, const bool copy)
+  {
+    namespace py = pybind11;
+    auto& backend = self.cast<EigenRowMajorSparseMatrix<S>&>().backend();
+    backend.makeCompressed();
+    using StorageIndex = typename std::decay_t<decltype(backend)>::StorageIndex;
+    const size_t nnz = backend.nonZeros();
+    // without a base object, the arrays are copied
+    const py::handle base = copy ? py::handle() : py::handle(self);
+    return py::make_tuple(
+        py::array_t<S>({nnz}, {sizeof(S)}, backend.valuePtr(), base),
+        py::array_t<StorageIndex>({nnz}, {sizeof(StorageIndex)}, backend.innerIndexPtr(), base),
+        py::array_t<StorageIndex>(
+            {size_t(backend.outerSize()) + 1}, {sizeof(StorageIndex)}, backend.outerIndexPtr(), base));
+  } // ... get(...)
+}; // struct CompressedRowArrays<EigenRowMajorSparseMatrix<...>>
+
+#endif // HAVE_EIGEN
+
+
+/**
+ * \brief Creates a matrix from the arrays of a scipy.sparse matrix (which is converted to canonical CSR first).
+ *
+ * The arrays are checked before the matrix is created: indptr has to be non-decreasing from 0 to len(indices) and all
+ * indices have to be smaller than the number of columns.
+ */
+template <class M>
+M matrix_from_scipy_csr(pybind11::object csr)
+{
+  namespace py = pybind11;
+  using IndexType = typename CompressedRowsToMatrix<M>::IndexType;
+  typedef typename M::ScalarType S;
+  csr = csr.attr("tocsr")();
+  if (!csr.attr("has_canonical_format").cast<bool>()) {
+    csr = csr.attr("copy")();
+    csr.attr("sum_duplicates")();
+  }
+  const auto shape = csr.attr("shape").cast<py::tuple>();
+  const size_t rows = shape[0].cast<size_t>();
+  const size_t cols = shape[1].cast<size_t>();
+  const auto indptr = csr.attr("indptr").cast<py::array_t<IndexType, py::array::c_style | py::array::forcecast>>();
+  const auto indices = csr.attr("indices").cast<py::array_t<IndexType, py::array::c_style | py::array::forcecast>>();
+  const auto data = csr.attr("data").cast<py::array_t<S, py::array::c_style | py::array::forcecast>>();
+  if (size_t(indptr.size()) != rows + 1 || indices.size() != data.size() || indptr.data()[0] != 0
+      || size_t(indptr.data()[rows]) != size_t(indices.size()))
+    throw py::value_error("The arrays of the given matrix do not fit together!");
+  for (size_t ii = 0; ii < rows; ++ii)
+    if (indptr.data()[ii] > indptr.data()[ii + 1])
+      throw py::value_error("The indptr array of the given matrix is not non-decreasing!");
+  for (ssize_t kk = 0; kk < indices.size(); ++kk)
+    if (size_t(indices.data()[kk]) >= cols)
+      throw py::value_error("The given matrix contains a column index which is not smaller than the number of "
+                            "columns!");
+  return CompressedRowsToMatrix<M>::create(rows,
+                                           cols,
+                                           std::vector<IndexType>(indptr.data(), indptr.data() + indptr.size()),
+                                           std::vector<IndexType>(indices.data(), indices.data() + indices.size()),
+                                           data.data());
+} // ... matrix_from_scipy_csr(...)
+
+
 template <class M>
 void print_row_sparsely(const M& self, const size_t row, std::stringstream& ss)
 {
@@ -83,6 +240,57 @@ void print_row_sparsely(const M& self, const size_t row, std::stringstream& ss)
 } // namespace internal
 
 
+/**
+ * \brief Allows the resulting dense matrix to be viewed as a two-dimensional NumPy array as in
+ *        `np.array(c, copy = False)` and to be created from one (by copying).
+ */
+template <class C>
+typename std::enable_if<internal::is_dense_matrix<C>::value, pybind11::class_<C>>::type
+bind_DenseMatrixDataAccess(pybind11::module& m, const std::string& class_id, const std::string& help_id)
+{
+  namespace py = pybind11;
+  using namespace pybind11::literals;
+  typedef typename C::ScalarType S;
+  static const constexpr bool row_major =
+      (Common::MatrixAbstraction<C>::storage_layout == Common::StorageLayout::dense_row_major);
+
+  py::class_<C> c(m, class_id.c_str(), help_id.c_str(), py::buffer_protocol());
+
+  c.def_buffer([](C& mat) -> py::buffer_info {
+    const size_t entry_size = sizeof(S);
+    return py::buffer_info(Common::MatrixAbstraction<C>::data(mat),
+                           entry_size,
+                           py::format_descriptor<S>::format(),
+                           2,
+                           {mat.rows(), mat.cols()},
+                           {row_major ? mat.cols() * entry_size : entry_size,
+                            row_major ? entry_size : mat.rows() * entry_size});
+  });
+  c.def(py::init([](py::array_t<S, py::array::forcecast> array) {
+          if (array.ndim() != 2)
+            throw py::value_error("Only two-dimensional arrays can be converted to a dense matrix!");
+          const auto values = array.template unchecked<2>();
+          C* ret = new C(Common::numeric_cast<size_t>(values.shape(0)), Common::numeric_cast<size_t>(values.shape(1)));
+          for (ssize_t ii = 0; ii < values.shape(0); ++ii)
+            for (ssize_t jj = 0; jj < values.shape(1); ++jj)
+              ret->set_entry(ii, jj, values(ii, jj));
+          return ret;
+        }),
+        "array"_a,
+        "Copies the entries of the two-dimensional array (e.g. a NumPy array) into the matrix.");
+
+  return c;
+} // ... bind_DenseMatrixDataAccess(...)
+
+template <class C>
+typename std::enable_if<!internal::is_dense_matrix<C>::value, pybind11::class_<C>>::type
+bind_DenseMatrixDataAccess(pybind11::module& m, const std::string& class_id, const std::string& help_id)
+{
+  namespace py = pybind11;
+  return py::class_<C>(m, class_id.c_str(), help_id.c_str());
+}
+
+
 template <class C, bool sparse>
 typename std::enable_if<is_matrix<C>::value, pybind11::class_<C>>::type bind_Matrix(pybind11::module& m)
 {
@@ -93,7 +301,7 @@ typename std::enable_if<is_matrix<C>::value, pybind11::class_<C>>::type bind_Mat
 
   const auto ClassName = Common::to_camel_case(bindings::container_name<C>::value());
 
-  py::class_<C> c(m, ClassName.c_str(), ClassName.c_str());
+  py::class_<C> c = bind_DenseMatrixDataAccess<C>(m, ClassName, ClassName);
 
   addbind_ProvidesBackend(c);
 
@@ -172,7 +380,7 @@ typename std::enable_if<is_matrix<C>::value, pybind11::class_<C>>::type bind_Mat
   c.def("unit_row", [](C& self, const ssize_t ii) { self.unit_row(Common::numeric_cast<size_t>(ii)); }, "ii"_a);
   c.def("unit_col", [](C& self, const ssize_t jj) { self.unit_col(Common::numeric_cast<size_t>(jj)); }, "jj"_a);
   c.def("valid", [](const C& self) { return self.valid(); });
-  c.def("sup_norm", [](const C& self) { return self.sup_norm(); });
+  c.def("sup_norm", [](const C& self) { return self.sup_norm(); }, py::call_guard<py::gil_scoped_release>());
   c.def_property_readonly("non_zeros", [](const C& self) { return self.non_zeros(); });
   c.def("pattern",
         [](const C& self, const bool prune, const S& eps) { return self.pattern(prune, eps); },
@@ -196,21 +404,56 @@ typename std::enable_if<is_matrix<C>::value, pybind11::class_<C>>::type bind_Mat
       "min_cols"_a = -1,
       "mode"_a = "ascii");
 
+  c.def("to_scipy_csr",
+        [](py::object self, const bool copy) {
+          const auto& mat = self.cast<const C&>();
+          return py::module::import("scipy.sparse")
+              .attr("csr_matrix")(internal::CompressedRowArrays<C>::get(self, copy),
+                                  "shape"_a = py::make_tuple(mat.rows(), mat.cols()),
+                                  "copy"_a = false);
+        },
+        "copy"_a = true,
+        "Returns the matrix as scipy.sparse.csr_matrix with copies of its arrays. With copy=False, the arrays are "
+        "shared with the matrix where the backend allows (CommonSparseMatrix, Eigen): the result then keeps the "
+        "matrix alive, but is only valid as long as the matrix keeps its arrays, i.e. until its sparsity pattern "
+        "changes or it is assigned to (e.g. by rightmultiply()).");
+  c.def_static("from_scipy_csr",
+               [](py::object csr) { return internal::matrix_from_scipy_csr<C>(csr); },
+               "csr"_a,
+               "Creates the matrix from the arrays of the given scipy.sparse matrix (copying them once).");
+
   addbind_ContainerInterface(c);
 
   return c;
 } // ... bind_Matrix(...)
 
 
+/**
+ * \brief Binds the products of M and V, which release the GIL.
+ *
+ * Products with the same matrix may run concurrently from several Python threads, as long as each thread writes to
+ * its own range vector and none of the involved containers is modified meanwhile.
+ */
 template <class M, class V>
 void addbind_Matrix_Vector_interaction(pybind11::class_<M>& mat, pybind11::class_<V>& vec)
 {
   namespace py = pybind11;
 
-  mat.def("mv", [](const M& self, const V& xx, V& yy) { self.mv(xx, yy); }, "source", "range");
-  mat.def("mtv", [](const M& self, const V& xx, V& yy) { self.mtv(xx, yy); }, "source", "range");
-
-  mat.def(py::self * V());
+  mat.def("mv",
+          [](const M& self, const V& xx, V& yy) { self.mv(xx, yy); },
+          "source",
+          "range",
+          py::call_guard<py::gil_scoped_release>());
+  mat.def("mtv",
+          [](const M& self, const V& xx, V& yy) { self.mtv(xx, yy); },
+          "source",
+          "range",
+          py::call_guard<py::gil_scoped_release>());
+
+  mat.def("__mul__",
+          [](const M& self, const V& xx) { return self * xx; },
+          py::is_operator(),
+          py::call_guard<py::gil_scoped_release>());
 
   mat.def("vector_type", [vec](M& /*self*/) { return vec; });
   vec.def("matrix_type", [mat](V& /*self*/) { return mat; });
@@ -14,6 +14,7 @@
 #include <sstream>
 
 #include <dune/pybindxi/pybind11.h>
+#include <dune/pybindxi/numpy.h>
 #include <dune/pybindxi/operators.h>
 
 #include <dune/xt/common/numeric_cast.hh>
@@ -30,6 +31,62 @@
 namespace Dune {
 namespace XT {
 namespace LA {
+namespace internal {
+
+
+//! Copies the elements of a one-dimensional array (of any stride) into a new vector.
+template <class C>
+C* vector_from_array(const pybind11::array_t<typename C::ScalarType, pybind11::array::forcecast>& array)
+{
+  if (array.ndim() != 1)
+    throw pybind11::value_error("Only one-dimensional arrays can be converted to a vector!");
+  const auto values = array.template unchecked<1>();
+  C* ret = new C(Common::numeric_cast<size_t>(values.shape(0)));
+  for (ssize_t ii = 0; ii < values.shape(0); ++ii)
+    (*ret)[ii] = values(ii);
+  return ret;
+} // ... vector_from_array(...)
+
+
+template <class C>
+void addbind_Vector_from_array(pybind11::class_<C>& c)
+{
+  namespace py = pybind11;
+  using namespace pybind11::literals;
+
+  c.def(py::init([](py::array_t<typename C::ScalarType, py::array::forcecast> array) {
+          return vector_from_array<C>(array);
+        }),
+        "array"_a,
+        "Copies the elements of the one-dimensional array (e.g. a NumPy array) into the vector.");
+}
+
+#if HAVE_EIGEN
+
+//! Mapped vectors wrap the memory of the array, which is kept alive as long as the vector exists.
+template <class S>
+void addbind_Vector_from_array(pybind11::class_<EigenMappedDenseVector<S>>& c)
+{
+  namespace py = pybind11;
+  using namespace pybind11::literals;
+
+  c.def(py::init([](py::array array) {
+          if (!py::isinstance<py::array_t<S>>(array) || array.ndim() != 1
+              || !(array.flags() & py::array::c_style) || !array.writeable())
+            throw py::value_error("Only writeable contiguous one-dimensional arrays of the vectors scalar type "
+                                  "can be wrapped!");
+          return new EigenMappedDenseVector<S>(static_cast<S*>(array.mutable_data()),
+                                               Common::numeric_cast<size_t>(array.shape(0)));
+        }),
+        "array"_a,
+        py::keep_alive<1, 2>(),
+        "Wraps the memory of the one-dimensional array (e.g. a NumPy array) without copying.");
+}
+
+#endif // HAVE_EIGEN
+
+
+} // namespace internal
 
 
 template <class C>
@@ -46,6 +103,7 @@ typename std::enable_if<is_vector<C>::value, pybind11::class_<C>>::type bind_Vec
   py::class_<C> c = bind_ProvidesDataAccess<C>(m, ClassName, ClassName);
   addbind_ProvidesBackend(c);
 
+  internal::addbind_Vector_from_array(c);
   c.def(py::init([](const ssize_t size, const S& value) { return new C(Common::numeric_cast<size_t>(size), value); }),
         "size"_a = 0,
         "value"_a = 0.0);
@@ -113,7 +171,10 @@ typename std::enable_if<is_vector<C>::value, pybind11::class_<C>>::type bind_Vec
   c.def(py::self + py::self);
   c.def(py::self += py::self);
   c.def(py::self -= py::self);
-  c.def(py::self * py::self);
+  c.def("__mul__",
+        [](const C& self, const C& other) { return self * other; },
+        py::is_operator(),
+        py::call_guard<py::gil_scoped_release>());
   c.def(py::self *= R());
   c.def(py::self /= R());
 
@@ -132,17 +193,21 @@ typename std::enable_if<is_vector<C>::value, pybind11::class_<C>>::type bind_Vec
   c.def("set_all", [](C& self, const S& value) { self.set_all(value); }, "value"_a);
   c.def("valid", [](const C& self) { return self.valid(); });
   c.def("dim", [](const C& self) { return self.size(); });
-  c.def("mean", [](const C& self) { return self.mean(); });
-  c.def("amax", [](const C& self) { return self.amax(); });
+  // the reductions release the GIL, they may be called concurrently as long as no thread modifies the vectors
+  c.def("mean", [](const C& self) { return self.mean(); }, py::call_guard<py::gil_scoped_release>());
+  c.def("amax", [](const C& self) { return self.amax(); }, py::call_guard<py::gil_scoped_release>());
   c.def("almost_equal",
         [](const C& self, const C& other, const S& epsilon) { return self.almost_equal(other, epsilon); },
         "other"_a,
-        "epsilon"_a = Common::FloatCmp::DefaultEpsilon<S>::value());
-  c.def("dot", [](const C& self, const C& other) { return self.dot(other); });
-  c.def("l1_norm", [](const C& self) { return self.l1_norm(); });
-  c.def("l2_norm", [](const C& self) { return self.l2_norm(); });
-  c.def("sup_norm", [](const C& self) { return self.sup_norm(); });
-  c.def("standard_deviation", [](const C& self) { return self.standard_deviation(); });
+        "epsilon"_a = Common::FloatCmp::DefaultEpsilon<S>::value(),
+        py::call_guard<py::gil_scoped_release>());
+  c.def("dot", [](const C& self, const C& other) { return self.dot(other); }, py::call_guard<py::gil_scoped_release>());
+  c.def("l1_norm", [](const C& self) { return self.l1_norm(); }, py::call_guard<py::gil_scoped_release>());
+  c.def("l2_norm", [](const C& self) { return self.l2_norm(); }, py::call_guard<py::gil_scoped_release>());
+  c.def("sup_norm", [](const C& self) { return self.sup_norm(); }, py::call_guard<py::gil_scoped_release>());
+  c.def("standard_deviation",
+        [](const C& self) { return self.standard_deviation(); },
+        py::call_guard<py::gil_scoped_release>());
   c.def("to_file",
         [](const C& self, const std::string& filename, const std::string& mode) { to_file(self, filename, mode); },
         "filename"_a,
@@ -155,17 +220,19 @@ typename std::enable_if<is_vector<C>::value, pybind11::class_<C>>::type bind_Vec
                "min_size"_a = -1,
                "mode"_a = "ascii");
 
-  c.def(py::pickle([](const C& self) { return py::make_tuple(std::vector<S>(self)); },
-                   [](py::tuple t) {
-                     if (t.size() != 1)
-                       throw std::runtime_error("Invalid state!");
-                     const auto data = t[0].cast<std::vector<S>>();
-                     C* ret = new C(data.size());
-                     /* Assign any additional state */
-                     for (size_t ii = 0; ii < ret->size(); ++ii)
-                       (*ret)[ii] = data[ii];
-                     return ret;
-                   }));
+  c.def(py::pickle(
+      [](const C& self) {
+        py::array_t<S> values(self.size());
+        auto values_ref = values.template mutable_unchecked<1>();
+        for (size_t ii = 0; ii < self.size(); ++ii)
+          values_ref(ii) = self[ii];
+        return py::make_tuple(values);
+      },
+      [](py::tuple t) {
+        if (t.size() != 1)
+          throw std::runtime_error("Invalid state!");
+        return internal::vector_from_array<C>(t[0].cast<py::array_t<S, py::array::forcecast>>());
+      }));
 
   addbind_ContainerInterface(c);
 
@@ -11,8 +11,11 @@
 #ifndef DUNE_XT_LA_SOLVER_PBH
 #define DUNE_XT_LA_SOLVER_PBH
 
+#include <sstream>
+
 #include <dune/pybindxi/pybind11.h>
 #include <dune/pybindxi/operators.h>
+#include <dune/pybindxi/stl.h>
 
 #include <python/dune/xt/common/configuration.hh>
 #include <python/dune/xt/la/container.bindings.hh>
@@ -26,6 +29,42 @@ namespace XT {
 namespace LA {
 
 
+//! Binds SolverStatistics to Python, with read only attributes.
+inline pybind11::class_<SolverStatistics> bind_SolverStatistics(pybind11::module& m)
+{
+  typedef SolverStatistics C;
+
+  namespace py = pybind11;
+
+  py::class_<C> c(m, "SolverStatistics", "SolverStatistics");
+
+  c.def_readonly("type", &C::type);
+  c.def_readonly("setup_reused", &C::setup_reused);
+  c.def_readonly("setup_time", &C::setup_time);
+  c.def_readonly("solve_time", &C::solve_time);
+  c.def_readonly("post_check_time", &C::post_check_time);
+  c.def_readonly("iterations", &C::iterations);
+  c.def_readonly("reduction", &C::reduction);
+  c.def_readonly("residual_history", &C::residual_history);
+  c.def_property_readonly("total_time", &C::total_time);
+  c.def("__repr__", [](const C& self) {
+    std::stringstream ss;
+    ss << self;
+    return ss.str();
+  });
+
+  return c;
+} // ... bind_SolverStatistics(...)
+
+
+/**
+ * \brief Binds Solver<M> to Python.
+ *
+ * The constructor and all variants of apply() release the GIL, so several solves may run concurrently from a Python
+ * thread pool. Each thread has to use its own solution vector, while the matrix and the right hand side are only read
+ * and may thus be shared, but none of them must be modified while a solve is running. A single solver may also be
+ * applied from several threads at once, the solves using a prepared setup are then carried out one after the other.
+ */
 template <class M, class V = typename Container<typename M::ScalarType, M::vector_type>::VectorType>
 typename std::enable_if<is_matrix<M>::value, pybind11::class_<Solver<M>>>::type bind_Solver(pybind11::module& m)
 {
@@ -41,21 +80,30 @@ typename std::enable_if<is_matrix<M>::value, pybind11::class_<Solver<M>>>::type
   c.def_static("types", &C::types);
   c.def_static("options", &C::options);
 
-  c.def(py::init<M>());
+  // the solver only holds a reference to the matrix
+  c.def(py::init<M>(), py::keep_alive<1, 2>(), py::call_guard<py::gil_scoped_release>());
 
-  c.def("apply", [](const C& self, const V& rhs, V& solution) { self.apply(rhs, solution); }, "rhs"_a, "solution"_a);
+  c.def("apply",
+        [](const C& self, const V& rhs, V& solution) { self.apply(rhs, solution); },
+        "rhs"_a,
+        "solution"_a,
+        py::call_guard<py::gil_scoped_release>());
   c.def("apply",
         [](const C& self, const V& rhs, V& solution, const std::string& type) { self.apply(rhs, solution, type); },
         "rhs"_a,
         "solution"_a,
-        "type"_a);
+        "type"_a,
+        py::call_guard<py::gil_scoped_release>());
   c.def("apply",
         [](const C& self, const V& rhs, V& solution, const Common::Configuration& options) {
           self.apply(rhs, solution, options);
         },
         "rhs"_a,
         "solution"_a,
-        "options"_a);
+        "options"_a,
+        py::call_guard<py::gil_scoped_release>());
+  // returns a copy, which is not affected by subsequent solves
+  c.def("statistics", [](const C& self) { return self.statistics(); });
 
   m.def("make_solver", [](const M& matrix) { return C(matrix); }, pybind11::keep_alive<0, 1>());
 
@@ -0,0 +1,101 @@
+# ~~~
+# This file is part of the dune-xt-la project:
+#   https://github.com/dune-community/dune-xt-la
+# Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+# License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+#      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+#          with "runtime exception" (http://www.dune-project.org/license.html)
+# ~~~
+
+import pickle
+
+import numpy as np
+import pytest
+
+
+def test_vector_shares_memory_with_numpy():
+    from dune.xt.la import CommonDenseVectorDouble
+    vec = CommonDenseVectorDouble(np.arange(5.))
+    assert vec.size == 5
+    arr = np.array(vec, copy=False)
+    arr[2] = 42.
+    assert vec[2] == 42.
+    restored = pickle.loads(pickle.dumps(vec))
+    assert np.array_equal(np.array(restored, copy=False), arr)
+
+
+def test_mapped_vector_wraps_numpy_array():
+    from dune.xt import la
+    if not hasattr(la, 'EigenMappedDenseVectorDouble'):
+        pytest.skip('requires Eigen')
+    arr = np.linspace(0., 1., 7)
+    vec = la.EigenMappedDenseVectorDouble(arr)
+    vec.scal(2.)
+    assert arr[-1] == 2.
+    with pytest.raises(ValueError):
+        la.EigenMappedDenseVectorDouble(np.arange(7, dtype=np.float32))
+
+
+def test_dense_matrix_shares_memory_with_numpy():
+    from dune.xt.la import CommonDenseMatrixDouble
+    values = np.arange(6.).reshape(2, 3)
+    mat = CommonDenseMatrixDouble(values)
+    assert (mat.rows, mat.cols) == (2, 3)
+    arr = np.array(mat, copy=False)
+    assert np.array_equal(arr, values)
+    arr[1, 0] = -1.
+    assert mat.get_entry(1, 0) == -1.
+
+
+def test_sparse_matrices_exchange_csr_arrays_with_scipy():
+    sparse = pytest.importorskip('scipy.sparse')
+    from dune.xt import la
+    csr = sparse.random(20, 13, density=0.2, format='csr', random_state=1)
+    for name in ('CommonSparseMatrixDouble', 'IstlRowMajorSparseMatrixDouble', 'EigenRowMajorSparseMatrixDouble'):
+        if not hasattr(la, name):
+            continue
+        mat = getattr(la, name).from_scipy_csr(csr)
+        assert (mat.rows, mat.cols) == csr.shape
+        assert mat.non_zeros == csr.nnz
+        back = mat.to_scipy_csr()
+        assert (back != csr).nnz == 0
+    # by default, the arrays are copied
+    mat = la.CommonSparseMatrixDouble.from_scipy_csr(csr)
+    row = np.searchsorted(csr.indptr, 0, side='right') - 1
+    copied = mat.to_scipy_csr()
+    copied.data[0] = 42.
+    assert mat.get_entry(row, csr.indices[0]) == csr.data[0]
+    # on request, the arrays of CommonSparseMatrix are shared
+    shared = mat.to_scipy_csr(copy=False)
+    shared.data[0] = 42.
+    assert mat.get_entry(row, shared.indices[0]) == 42.
+
+
+class MalformedCsr:
+    """Provides the attributes of a scipy.sparse.csr_matrix used by from_scipy_csr, without any checks."""
+
+    def __init__(self, shape, data, indices, indptr):
+        self.shape = shape
+        self.data = np.array(data, dtype=float)
+        self.indices = np.array(indices, dtype=np.int64)
+        self.indptr = np.array(indptr, dtype=np.int64)
+        self.has_canonical_format = True
+
+    def tocsr(self):
+        return self
+
+
+def test_from_scipy_csr_rejects_malformed_arrays():
+    from dune.xt import la
+    for name in ('CommonSparseMatrixDouble', 'IstlRowMajorSparseMatrixDouble', 'EigenRowMajorSparseMatrixDouble'):
+        if not hasattr(la, name):
+            continue
+        matrix_type = getattr(la, name)
+        mat = matrix_type.from_scipy_csr(MalformedCsr((2, 3), [1., 2.], [2, 0], [0, 1, 2]))
+        assert mat.get_entry(0, 2) == 1.
+        for indices, indptr in (([0, 1, 2], [0, 2, 1, 3]),  # decreasing indptr
+                                ([2, 0, 1], [0, 1, 2, 2]),  # indptr[-1] != len(indices)
+                                ([2, 0, 1], [1, 1, 2, 3]),  # indptr[0] != 0
+                                ([3, 0, 1], [0, 1, 2, 3])):  # column out of range
+            with pytest.raises(ValueError):
+                matrix_type.from_scipy_csr(MalformedCsr((3, 3), [1., 2., 3.], indices, indptr))
@@ -0,0 +1,37 @@
+# ~~~
+# This file is part of the dune-xt-la project:
+#   https://github.com/dune-community/dune-xt-la
+# Copyright 2009-2018 dune-xt-la developers and contributors. All rights reserved.
+# License: Dual licensed as BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+#      or  GPL-2.0+ (http://opensource.org/licenses/gpl-license)
+#          with "runtime exception" (http://www.dune-project.org/license.html)
+# ~~~
+
+from concurrent.futures import ThreadPoolExecutor
+
+import numpy as np
+
+
+def test_independent_solves_from_a_thread_pool():
+    from dune.xt.la import CommonDenseMatrixDouble, CommonDenseMatrixDoubleSolver, CommonDenseVectorDouble
+    size = 50
+    dense = np.eye(size) * 4. + np.eye(size, k=1) + np.eye(size, k=-1)
+    matrix = CommonDenseMatrixDouble(dense)
+
+    def solve(ii):
+        # the matrix is shared, the solver and the vectors are private to each task
+        solver = CommonDenseMatrixDoubleSolver(matrix)
+        rhs = CommonDenseVectorDouble(np.full(size, float(ii)))
+        solution = CommonDenseVectorDouble(size, 0.)
+        solver.apply(rhs, solution)
+        residual = CommonDenseVectorDouble(size, 0.)
+        matrix.mv(solution, residual)
+        residual -= rhs
+        return residual.sup_norm(), solution.dot(rhs)
+
+    with ThreadPoolExecutor(max_workers=4) as pool:
+        results = list(pool.map(solve, range(16)))
+    reference = np.linalg.solve(dense, np.ones(size))
+    for ii, (residual, product) in enumerate(results):
+        assert residual < 1e-12 * (1 + ii)
+        assert np.isclose(product, ii * ii * reference.sum())